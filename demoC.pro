@@ -29,14 +29,25 @@ SOURCES += \
     src/wall_extraction/line_info_panel.cpp \
     src/wall_extraction/line_list_widget.cpp \
     src/wall_extraction/wall_fitting_algorithm.cpp \
+    src/wall_extraction/efficient_ransac.cpp \
+    src/wall_extraction/region_growing.cpp \
+    src/wall_extraction/plane_fitting.cpp \
+    src/wall_extraction/wall_regularization.cpp \
+    src/wall_extraction/wall_thickness.cpp \
+    src/wall_extraction/incremental_wall_fitter.cpp \
+    src/wall_extraction/wall_fitting_job.cpp \
     src/wall_extraction/wireframe_generator.cpp \
     src/wall_extraction/wall_fitting_progress_dialog.cpp \
     src/wall_extraction/wall_fitting_result_dialog.cpp \
     src/wall_extraction/ui_integration_helper.cpp \
     src/wall_extraction/las_reader.cpp \
     src/wall_extraction/point_cloud_processor.cpp \
+    src/wall_extraction/point_cloud_statistics.cpp \
+    src/wall_extraction/oriented_bounding_box.cpp \
+    src/wall_extraction/coordinate_transform.cpp \
     src/wall_extraction/point_cloud_lod_manager.cpp \
     src/wall_extraction/spatial_index.cpp \
+    src/wall_extraction/normal_estimation.cpp \
     src/wall_extraction/point_cloud_memory_manager.cpp \
     src/wall_extraction/top_down_view_renderer.cpp \
     src/wall_extraction/color_mapping_manager.cpp \
@@ -60,14 +71,27 @@ HEADERS += \
     src/wall_extraction/line_info_panel.h \
     src/wall_extraction/line_list_widget.h \
     src/wall_extraction/wall_fitting_algorithm.h \
+    src/wall_extraction/efficient_ransac.h \
+    src/wall_extraction/region_growing.h \
+    src/wall_extraction/plane_fitting.h \
+    src/wall_extraction/wall_regularization.h \
+    src/wall_extraction/wall_thickness.h \
+    src/wall_extraction/incremental_wall_fitter.h \
+    src/wall_extraction/wall_fitting_job.h \
     src/wall_extraction/wireframe_generator.h \
     src/wall_extraction/wall_fitting_progress_dialog.h \
     src/wall_extraction/wall_fitting_result_dialog.h \
     src/wall_extraction/ui_integration_helper.h \
     src/wall_extraction/las_reader.h \
     src/wall_extraction/point_cloud_processor.h \
+    src/wall_extraction/point_cloud_statistics.h \
+    src/wall_extraction/oriented_bounding_box.h \
+    src/wall_extraction/coordinate_transform.h \
     src/wall_extraction/point_cloud_lod_manager.h \
     src/wall_extraction/spatial_index.h \
+    src/wall_extraction/normal_estimation.h \
+    src/wall_extraction/parallel_utils.h \
+    src/wall_extraction/symmetric_eigen_solver.h \
     src/wall_extraction/point_cloud_memory_manager.h \
     src/wall_extraction/top_down_view_renderer.h \
     src/wall_extraction/color_mapping_manager.h \
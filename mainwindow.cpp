@@ -1286,7 +1286,7 @@ void MainWindow::PointCloud()
 // 使用PCDReader类读取PCD文件
 std::vector<QVector3D> MainWindow::ReadVec3PointCloudPCD(const QString &filename)
 {
-    return PCDReader::ReadVec3PointCloudPCD(filename);
+    return PCDReader::ReadVec3PointCloudPCD(filename, m_decodeTransform, nullptr);
 }
 
 // PCD文件分析函数（调试用）
@@ -1493,6 +1493,7 @@ std::vector<QVector3D> MainWindow::ReadVec3PointCloudTXT(const QString& filename
     QTextStream in(&file);
     QString line;
     int lineNumber = 0;
+    WallExtraction::PointDecodeTransform transform = m_decodeTransform;
 
     while(!in.atEnd()) {
         line = in.readLine().trimmed();
@@ -1508,12 +1509,13 @@ std::vector<QVector3D> MainWindow::ReadVec3PointCloudTXT(const QString& filename
 
         if(parts.size() >= 3) {
             bool ok1, ok2, ok3;
-            float x = parts[0].toFloat(&ok1);
-            float y = parts[1].toFloat(&ok2);
-            float z = parts[2].toFloat(&ok3);
+            double x = parts[0].toDouble(&ok1);
+            double y = parts[1].toDouble(&ok2);
+            double z = parts[2].toDouble(&ok3);
 
-            if(ok1 && ok2 && ok3) {
-                cloud.push_back(QVector3D(x, y, z));
+            QVector3D point;
+            if(ok1 && ok2 && ok3 && transform.apply(x, y, z, point)) {
+                cloud.push_back(point);
             }
             else {
                 qDebug() << "TXT文件第" << lineNumber << "行数据格式错误：" << line;
@@ -1551,6 +1553,7 @@ std::vector<QVector3D> MainWindow::ReadVec3PointCloudPLY(QString path)
     QString line;
     int vertexCount = 0;
     int readCount = 0;
+    WallExtraction::PointDecodeTransform transform = m_decodeTransform;
 
     // 读取文件头
     while (!in.atEnd()) {
@@ -1590,12 +1593,13 @@ std::vector<QVector3D> MainWindow::ReadVec3PointCloudPLY(QString path)
         QStringList parts = line.split(QRegularExpression("\\s+"), Qt::SkipEmptyParts);
         if (parts.size() >= 3) {
             bool okX, okY, okZ;
-            float x = parts[0].toFloat(&okX);
-            float y = parts[1].toFloat(&okY);
-            float z = parts[2].toFloat(&okZ);
+            double x = parts[0].toDouble(&okX);
+            double y = parts[1].toDouble(&okY);
+            double z = parts[2].toDouble(&okZ);
 
-            if (okX && okY && okZ) {
-                cloud.emplace_back(x, y, z);
+            QVector3D point;
+            if (okX && okY && okZ && transform.apply(x, y, z, point)) {
+                cloud.push_back(point);
                 readCount++;
             }
         }
@@ -1631,17 +1635,18 @@ std::vector<QVector3D> MainWindow::ReadVec3PointCloudASC(QString path)
     QStringList list = ramData.split("\n");
 
     // 预分配内存（行数-1是考虑最后可能有空行）
-    cloud.resize(list.count()-1);
+    cloud.reserve(list.count()-1);
+    WallExtraction::PointDecodeTransform transform = m_decodeTransform;
 
     // 逐行解析数据
     for (int i = 0; i < list.count() - 1; i++) {
         QStringList listline = list.at(i).split(" ");
 
         // 确保至少有XYZ三个坐标值
-        if(listline.size() >= 3) {
-            cloud[i].setX(listline.at(0).toFloat());
-            cloud[i].setY(listline.at(1).toFloat());
-            cloud[i].setZ(listline.at(2).toFloat());
+        QVector3D point;
+        if(listline.size() >= 3 &&
+           transform.apply(listline.at(0).toDouble(), listline.at(1).toDouble(), listline.at(2).toDouble(), point)) {
+            cloud.push_back(point);
         }
     }
     return cloud;
@@ -1651,12 +1656,15 @@ std::vector<QVector3D> MainWindow::ReadVec3PointCloudASC(QString path)
 
 
 
-/* 将点云单位从毫米转换为米 */
-void MainWindow::unitMillimeter2UnitMeter(std::vector<QVector3D> &inOutCloud)
+/* 设置解码变换，毫米转米等归一化在读取循环中完成，不再单独遍历点云 */
+void MainWindow::setDecodeTransform(const WallExtraction::PointDecodeTransform& transform)
 {
-    for(auto& point : inOutCloud) {
-        point /= 1000.0f; // 每个坐标分量除以1000
-    }
+    m_decodeTransform = transform;
+}
+
+WallExtraction::PointDecodeTransform MainWindow::getDecodeTransform() const
+{
+    return m_decodeTransform;
 }
 
 /* 生成测试点云数据 */
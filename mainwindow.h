@@ -52,6 +52,10 @@ public:
     MainWindow(QWidget *parent = nullptr);
     ~MainWindow();
 
+    // 读取ASC/PLY/PCD/TXT点云时逐点应用的解码变换（单位、坐标轴、原点）
+    void setDecodeTransform(const WallExtraction::PointDecodeTransform& transform);
+    WallExtraction::PointDecodeTransform getDecodeTransform() const;
+
 private slots:
     void openProject();
     void newProject();  // 新建项目槽函数
@@ -134,11 +138,11 @@ private:
     std::vector<QVector3D> ReadVec3PointCloudPLY(QString path);
     std::vector<QVector3D> ReadVec3PointCloudPCD(const QString& filename);
     std::vector<QVector3D> ReadVec3PointCloudTXT(const QString& filename);
-    void unitMillimeter2UnitMeter(std::vector<QVector3D> &inOutCloud);
     std::vector<QVector3D> testData(int pointsNum);
     QVector3D randomVec3f();
 
     std::vector<QVector3D> m_currentCloud; // 新增当前点云存储
+    WallExtraction::PointDecodeTransform m_decodeTransform; // 读取点云时的解码变换
 
     // 墙面提取模块
     std::unique_ptr<WallExtraction::WallExtractionManager> m_wallExtractionManager;
@@ -1,6 +1,7 @@
 // MinBoundingBox.cpp
 #include "MinBoundingBox.h"
 #include <cmath>  // 添加数学函数支持
+#include "src/wall_extraction/point_cloud_statistics.h"
 
 
 //没有使用过
@@ -44,22 +45,56 @@ bool MinBoundingBox::calculateMinBoundingBox(const std::vector<QVector3D>& cloud
     }
     // 多点处理
     else {
-        bool bfirst = false;   // 首个有效点标记
+        // 首个有效点用于初始化（与逐点更新的行为保持一致）
         for (int i = 0; i < size; i++) {
-            if (!bfirst) {
-                if (isValid(cloud[i])) {  // 过滤无效点
-                    firstPoint(cloud[i]); // 初始化包围盒
-                    bfirst = true;
-                }
-            } else {
-                nextPoint(cloud[i]);  // 扩展包围盒范围
+            if (isValid(cloud[i])) {  // 过滤无效点
+                firstPoint(cloud[i]);
+                break;
             }
         }
+        // 极值由共享的SIMD并行归约计算，无效点判定与isValid一致
+        WallExtraction::PointCloudBounds bounds = WallExtraction::computePointCloudBounds(cloud, m_finvalidDis);
+        if (bounds.isValid()) {
+            m_min = bounds.minPoint;
+            m_max = bounds.maxPoint;
+            index = static_cast<int>(bounds.validCount);  // 有效点计数
+        }
         m_center = QVector3D(midX(), midY(), midZ());  // 计算包围盒中心
     }
     return true;
 }
 
+/**
+ * @brief 计算点云的有向包围盒
+ * @param cloud 输入点云数据
+ * @return bool 计算是否成功（至少包含2个有效点时返回true）
+ *
+ * 无效点（非有限值或超出m_finvalidDis）不参与计算。
+ */
+bool MinBoundingBox::calculateOrientedBoundingBox(const std::vector<QVector3D>& cloud)
+{
+    m_orientedBox = WallExtraction::OrientedBoundingBox();
+
+    WallExtraction::PointCloudBounds bounds = WallExtraction::computePointCloudBounds(cloud, m_finvalidDis);
+    if (bounds.validCount < 2) {
+        return false;
+    }
+
+    if (bounds.validCount == cloud.size()) {
+        m_orientedBox = WallExtraction::computeOrientedBoundingBox(cloud);
+    } else {
+        std::vector<QVector3D> validPoints;
+        validPoints.reserve(bounds.validCount);
+        for (const QVector3D& point : cloud) {
+            if (isValid(point)) {
+                validPoints.push_back(point);
+            }
+        }
+        m_orientedBox = WallExtraction::computeOrientedBoundingBox(validPoints);
+    }
+    return m_orientedBox.valid;
+}
+
 /**
  * @brief 更新最小/最大坐标值
  * @param point 输入点坐标
@@ -90,6 +125,7 @@ MinBoundingBox& MinBoundingBox::operator=(MinBoundingBox &box)
     this->m_mean = box.m_mean;
     this->m_center = box.m_center;
     this->index = box.index;
+    this->m_orientedBox = box.m_orientedBox;
     return *this;  // 支持链式赋值
 }
 
@@ -2,6 +2,7 @@
 #include <vector>
 #include <math.h>
 #include <QVector3D>
+#include "src/wall_extraction/oriented_bounding_box.h"
 
 class MinBoundingBox
 {
@@ -13,6 +14,10 @@ public:
 
     bool calculateMinBoundingBox(const std::vector<QVector3D>& cloud);
 
+    // 有向包围盒：水平方向为最小面积矩形，竖直轴取PCA结果
+    bool calculateOrientedBoundingBox(const std::vector<QVector3D>& cloud);
+    inline const WallExtraction::OrientedBoundingBox& getOrientedBoundingBox() const { return m_orientedBox; }
+
     inline QVector3D getMinPoint() { return m_min; }
     inline QVector3D getMaxPoint() { return m_max; }
     inline QVector3D getMeanPoint() { return m_mean; }
@@ -28,9 +33,14 @@ public:
     inline void zerolize(void) {
         m_min = m_max = m_center = m_mean = QVector3D(0.0, 0.0, 0.0);
         index = 1;
+        m_orientedBox = WallExtraction::OrientedBoundingBox();
     }
     inline void setMin(QVector3D point) { m_min = point; }
     inline void setMax(QVector3D point) { m_max = point; }
+    // 平移包围盒（点云整体平移后无需重新遍历）
+    inline void translate(QVector3D offset) {
+        m_min += offset; m_max += offset; m_center += offset; m_mean += offset;
+    }
 
     inline bool Iszerolized() {
         return	(abs(m_min.x()) < 0.00001 && abs(m_min.y()) < 0.00001 && abs(m_min.z()) < 0.00001 &&
@@ -53,6 +63,7 @@ private:
     QVector3D m_max;
     QVector3D m_center;
     QVector3D m_mean;
+    WallExtraction::OrientedBoundingBox m_orientedBox;
 
     bool isContain(QVector3D point);
     bool isValid(QVector3D point);
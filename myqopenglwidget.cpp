@@ -365,24 +365,19 @@ void MyQOpenglWidget::initPointCloud(const std::vector<QVector3D> &cloud)
     qDebug() << "   中心点：" << center;
     qDebug() << "   尺寸：" << m_box.width() << "×" << m_box.height() << "×" << m_box.depth();
 
-    // 移动点云到原点并重新计算包围盒
-    std::vector<QVector3D> movedCloud;
-    movedCloud.reserve(cloud.size());
-    for (const auto& p : cloud) {
-        movedCloud.emplace_back(p.x() - center.x(), p.y() - center.y(), p.z() - center.z());
-    }
-    m_box.calculateMinBoundingBox(movedCloud); // 更新为移动后的包围盒
+    // 点云移动到原点：包围盒直接平移，点在写入顶点时减去中心，不再构造移动后的副本
+    m_box.translate(-center);
 
     addAxisData();
 
-    for(size_t i = 0; i < movedCloud.size(); ++i)
+    for(size_t i = 0; i < cloud.size(); ++i)
     {
         //move cloud center to origin
-        const auto& p = movedCloud[i];
+        const QVector3D p = cloud[i] - center;
         m_PointsVertex[i + 6].pos[0] = p.x();
         m_PointsVertex[i + 6].pos[1] = p.y();
         m_PointsVertex[i + 6].pos[2] = p.z();
-        gray2Pseudocolor(QVector3D(p.x(), p.y(), p.z()), m_PointsVertex[i + 6].color);
+        gray2Pseudocolor(p, m_PointsVertex[i + 6].color);
         m_PointsVertex[i+6].normal[0] = 0.0f;
         m_PointsVertex[i+6].normal[1] = 1.0f;
         m_PointsVertex[i+6].normal[2] = 0.0f;
@@ -1,4 +1,5 @@
 #include "PCDReader.h"
+#include "src/wall_extraction/point_cloud_statistics.h"
 // 暂时注释掉外部库依赖
 // #include <lz4.h>  // 需要添加LZ4库
 
@@ -8,8 +9,25 @@
 /* 修复后的PCD文件读取函数 */
 /* 完全重写的PCD文件读取函数 - 支持多种压缩格式和大文件处理 */
 std::vector<QVector3D> PCDReader::ReadVec3PointCloudPCD(const QString& filename) {
+    return ReadVec3PointCloudPCD(filename, nullptr);
+}
+
+std::vector<QVector3D> PCDReader::ReadVec3PointCloudPCD(const QString& filename,
+                                                        WallExtraction::CoordinateOrigin* origin) {
+    // 不需要原点的调用方得到绝对坐标
+    WallExtraction::PointDecodeTransform transform;
+    transform.autoOrigin = (origin != nullptr);
+    return ReadVec3PointCloudPCD(filename, transform, origin);
+}
+
+std::vector<QVector3D> PCDReader::ReadVec3PointCloudPCD(const QString& filename,
+                                                        const WallExtraction::PointDecodeTransform& transform,
+                                                        WallExtraction::CoordinateOrigin* origin) {
     std::vector<QVector3D> cloud;
 
+    // 每次读取使用独立副本，自动原点不会串到下一个文件
+    WallExtraction::PointDecodeTransform decodeTransform = transform;
+
     qDebug() << "=== 开始读取PCD文件 ===";
     qDebug() << "文件路径：" << filename;
 
@@ -58,11 +76,11 @@ std::vector<QVector3D> PCDReader::ReadVec3PointCloudPCD(const QString& filename)
 
     try {
         if (header.dataType == "ascii") {
-            cloud = readAsciiData(file, header, xIndex, yIndex, zIndex);
+            cloud = readAsciiData(file, header, xIndex, yIndex, zIndex, decodeTransform);
         } else if (header.dataType == "binary") {
-            cloud = readBinaryData(file, header, xIndex, yIndex, zIndex);
+            cloud = readBinaryData(file, header, xIndex, yIndex, zIndex, decodeTransform);
         } else if (header.dataType == "binary_compressed") {
-            cloud = readBinaryCompressedDataAdvanced(file, header, xIndex, yIndex, zIndex);
+            cloud = readBinaryCompressedDataAdvanced(file, header, xIndex, yIndex, zIndex, decodeTransform);
         } else {
             qDebug() << "❌ 错误：未知的数据格式：" << header.dataType;
         }
@@ -80,6 +98,14 @@ std::vector<QVector3D> PCDReader::ReadVec3PointCloudPCD(const QString& filename)
     qDebug() << "成功读取点数：" << cloud.size() << "/" << header.points;
     qDebug() << "成功率：" << (header.points > 0 ? (double)cloud.size() / header.points * 100 : 0) << "%";
 
+    if (origin) {
+        *origin = decodeTransform.origin;
+        if (!origin->isZero()) {
+            qDebug() << "坐标原点：" << QString::number(origin->x, 'f', 3)
+                     << QString::number(origin->y, 'f', 3) << QString::number(origin->z, 'f', 3);
+        }
+    }
+
     return cloud;
 }
 
@@ -195,7 +221,7 @@ PCDReader::PCDHeader PCDReader::parseHeader(QFile& file) {
 
 /* 高级压缩数据读取函数 */
 std::vector<QVector3D> PCDReader::readBinaryCompressedDataAdvanced(QFile& file, const PCDHeader& header,
-                                                                   int xIndex, int yIndex, int zIndex) {
+                                                                   int xIndex, int yIndex, int zIndex, WallExtraction::PointDecodeTransform& transform) {
     std::vector<QVector3D> cloud;
 
     qDebug() << "开始解析Binary_Compressed格式（高级模式）...";
@@ -221,11 +247,11 @@ std::vector<QVector3D> PCDReader::readBinaryCompressedDataAdvanced(QFile& file,
 
     if (decompressedData.isEmpty()) {
         qDebug() << "所有解压缩方法都失败，尝试智能解析原始数据...";
-        return intelligentRawDataParsing(allData, header, xIndex, yIndex, zIndex);
+        return intelligentRawDataParsing(allData, header, xIndex, yIndex, zIndex, transform);
     }
 
     qDebug() << "解压缩成功，数据大小：" << decompressedData.size() << "字节";
-    return parseBinaryPointDataAdvanced(decompressedData, header, xIndex, yIndex, zIndex);
+    return parseBinaryPointDataAdvanced(decompressedData, header, xIndex, yIndex, zIndex, transform);
 }
 
 /* 尝试多种解压缩方法 */
@@ -347,7 +373,7 @@ QByteArray PCDReader::tryLZ4Decompression(const QByteArray& data, const PCDHeade
 
 /* 智能原始数据解析 */
 std::vector<QVector3D> PCDReader::intelligentRawDataParsing(const QByteArray& data, const PCDHeader& header,
-                                                            int xIndex, int yIndex, int zIndex) {
+                                                            int xIndex, int yIndex, int zIndex, WallExtraction::PointDecodeTransform& transform) {
     qDebug() << "开始智能原始数据解析...";
 
     // 计算每个点的字节大小
@@ -369,19 +395,22 @@ std::vector<QVector3D> PCDReader::intelligentRawDataParsing(const QByteArray& da
         qDebug() << "尝试偏移量：" << offset;
 
         QByteArray testData = data.mid(offset);
-        std::vector<QVector3D> testCloud = parseBinaryPointDataAdvanced(testData, header, xIndex, yIndex, zIndex);
+        // 每次尝试使用独立的原点，避免失败的偏移量确定原点
+        WallExtraction::PointDecodeTransform testTransform = transform;
+        std::vector<QVector3D> testCloud = parseBinaryPointDataAdvanced(testData, header, xIndex, yIndex, zIndex, testTransform);
 
         if (!testCloud.empty()) {
             // 验证解析结果的合理性
             if (validatePointCloud(testCloud)) {
                 qDebug() << "在偏移量" << offset << "处找到有效的点云数据，点数：" << testCloud.size();
+                transform = testTransform;
                 return testCloud;
             }
         }
     }
 
     qDebug() << "智能解析失败，尝试直接解析...";
-    return parseBinaryPointDataAdvanced(data, header, xIndex, yIndex, zIndex);
+    return parseBinaryPointDataAdvanced(data, header, xIndex, yIndex, zIndex, transform);
 }
 
 /* 验证点云数据的合理性 */
@@ -436,7 +465,7 @@ bool PCDReader::validatePointCloud(const std::vector<QVector3D>& cloud) {
 
 /* 高级二进制点数据解析 */
 std::vector<QVector3D> PCDReader::parseBinaryPointDataAdvanced(const QByteArray& data, const PCDHeader& header,
-                                                               int xIndex, int yIndex, int zIndex) {
+                                                               int xIndex, int yIndex, int zIndex, WallExtraction::PointDecodeTransform& transform) {
     std::vector<QVector3D> cloud;
 
     // 计算每个点的字节大小
@@ -468,6 +497,9 @@ std::vector<QVector3D> PCDReader::parseBinaryPointDataAdvanced(const QByteArray&
     int xOffset = calculateOffset(header.sizes, xIndex);
     int yOffset = calculateOffset(header.sizes, yIndex);
     int zOffset = calculateOffset(header.sizes, zIndex);
+    int xSize = header.sizes.value(xIndex).toInt();
+    int ySize = header.sizes.value(yIndex).toInt();
+    int zSize = header.sizes.value(zIndex).toInt();
 
     qDebug() << "坐标字段索引 - X:" << xIndex << ", Y:" << yIndex << ", Z:" << zIndex;
     qDebug() << "坐标偏移量 - X:" << xOffset << ", Y:" << yOffset << ", Z:" << zOffset;
@@ -476,14 +508,6 @@ std::vector<QVector3D> PCDReader::parseBinaryPointDataAdvanced(const QByteArray&
     int invalidPoints = 0;
     const char* dataPtr = data.data();
 
-    // 统计坐标范围
-    float minX = std::numeric_limits<float>::max();
-    float maxX = std::numeric_limits<float>::lowest();
-    float minY = std::numeric_limits<float>::max();
-    float maxY = std::numeric_limits<float>::lowest();
-    float minZ = std::numeric_limits<float>::max();
-    float maxZ = std::numeric_limits<float>::lowest();
-
     qDebug() << "开始解析点数据（最多处理" << maxPoints << "个点）...";
     qDebug() << "前10个点的坐标：";
 
@@ -496,12 +520,10 @@ std::vector<QVector3D> PCDReader::parseBinaryPointDataAdvanced(const QByteArray&
             break;
         }
 
-        float x, y, z;
-
         // 安全地复制数据
-        memcpy(&x, pointPtr + xOffset, sizeof(float));
-        memcpy(&y, pointPtr + yOffset, sizeof(float));
-        memcpy(&z, pointPtr + zOffset, sizeof(float));
+        double x = readCoordinate(pointPtr + xOffset, xSize);
+        double y = readCoordinate(pointPtr + yOffset, ySize);
+        double z = readCoordinate(pointPtr + zOffset, zSize);
 
         // 调试前10个点
         if (i < 10) {
@@ -509,19 +531,13 @@ std::vector<QVector3D> PCDReader::parseBinaryPointDataAdvanced(const QByteArray&
         }
 
         // 检查坐标值是否有效
-        if (std::isfinite(x) && std::isfinite(y) && std::isfinite(z)) {
-            // 合理性检查：排除极端值
-            if (std::abs(x) < 1e6 && std::abs(y) < 1e6 && std::abs(z) < 1e6) {
-                cloud.push_back(QVector3D(x, y, z));
+        // 解码变换内完成有限性检查与归一化
+        QVector3D local;
+        if (transform.apply(x, y, z, local)) {
+            // 合理性检查：排除极端值（相对原点判断，地理参考坐标不会被误删）
+            if (std::abs(local.x()) < 1e6f && std::abs(local.y()) < 1e6f && std::abs(local.z()) < 1e6f) {
+                cloud.push_back(local);
                 validPoints++;
-
-                // 更新坐标范围
-                minX = std::min(minX, x);
-                maxX = std::max(maxX, x);
-                minY = std::min(minY, y);
-                maxY = std::max(maxY, y);
-                minZ = std::min(minZ, z);
-                maxZ = std::max(maxZ, z);
             } else {
                 invalidPoints++;
             }
@@ -538,10 +554,7 @@ std::vector<QVector3D> PCDReader::parseBinaryPointDataAdvanced(const QByteArray&
     qDebug() << "解析完成，有效点数：" << validPoints << "，无效点数：" << invalidPoints;
 
     if (validPoints > 0) {
-        qDebug() << QString("坐标范围 - X:[%1, %2], Y:[%3, %4], Z:[%5, %6]")
-                        .arg(minX, 0, 'f', 3).arg(maxX, 0, 'f', 3)
-                        .arg(minY, 0, 'f', 3).arg(maxY, 0, 'f', 3)
-                        .arg(minZ, 0, 'f', 3).arg(maxZ, 0, 'f', 3);
+        logCoordinateRange(cloud);
     }
 
     return cloud;
@@ -549,7 +562,7 @@ std::vector<QVector3D> PCDReader::parseBinaryPointDataAdvanced(const QByteArray&
 
 /* 读取ASCII格式数据 */
 std::vector<QVector3D> PCDReader::readAsciiData(QFile& file, const PCDHeader& header,
-                                                int xIndex, int yIndex, int zIndex) {
+                                                int xIndex, int yIndex, int zIndex, WallExtraction::PointDecodeTransform& transform) {
     std::vector<QVector3D> cloud;
     cloud.reserve(header.points);
 
@@ -566,13 +579,15 @@ std::vector<QVector3D> PCDReader::readAsciiData(QFile& file, const PCDHeader& he
 
         if (values.size() < header.fields.size()) continue;
 
+        // 按双精度解析，减去原点后再转换为float
         bool xOk, yOk, zOk;
-        float x = values[xIndex].toFloat(&xOk);
-        float y = values[yIndex].toFloat(&yOk);
-        float z = values[zIndex].toFloat(&zOk);
+        double x = values[xIndex].toDouble(&xOk);
+        double y = values[yIndex].toDouble(&yOk);
+        double z = values[zIndex].toDouble(&zOk);
 
-        if (xOk && yOk && zOk && std::isfinite(x) && std::isfinite(y) && std::isfinite(z)) {
-            cloud.push_back(QVector3D(x, y, z));
+        QVector3D local;
+        if (xOk && yOk && zOk && transform.apply(x, y, z, local)) {
+            cloud.push_back(local);
             validPoints++;
         }
     }
@@ -584,7 +599,7 @@ std::vector<QVector3D> PCDReader::readAsciiData(QFile& file, const PCDHeader& he
 /* 读取Binary格式数据 */
 /* 修复后的读取Binary格式数据函数 - 优化大文件处理 */
 std::vector<QVector3D> PCDReader::readBinaryData(QFile& file, const PCDHeader& header,
-                                                 int xIndex, int yIndex, int zIndex) {
+                                                 int xIndex, int yIndex, int zIndex, WallExtraction::PointDecodeTransform& transform) {
     std::vector<QVector3D> cloud;
     cloud.reserve(header.points);
 
@@ -601,6 +616,9 @@ std::vector<QVector3D> PCDReader::readBinaryData(QFile& file, const PCDHeader& h
     int xOffset = calculateOffset(header.sizes, xIndex);
     int yOffset = calculateOffset(header.sizes, yIndex);
     int zOffset = calculateOffset(header.sizes, zIndex);
+    int xSize = header.sizes.value(xIndex).toInt();
+    int ySize = header.sizes.value(yIndex).toInt();
+    int zSize = header.sizes.value(zIndex).toInt();
 
     qDebug() << "坐标偏移量 - X:" << xOffset << ", Y:" << yOffset << ", Z:" << zOffset;
 
@@ -662,14 +680,6 @@ std::vector<QVector3D> PCDReader::readBinaryData(QFile& file, const PCDHeader& h
     int validPoints = 0;
     int processedPoints = 0;
 
-    // 用于统计坐标范围，帮助诊断问题
-    float minX = std::numeric_limits<float>::max();
-    float maxX = std::numeric_limits<float>::lowest();
-    float minY = std::numeric_limits<float>::max();
-    float maxY = std::numeric_limits<float>::lowest();
-    float minZ = std::numeric_limits<float>::max();
-    float maxZ = std::numeric_limits<float>::lowest();
-
     while (processedPoints < header.points && !file.atEnd()) {
         int pointsToRead = qMin(BATCH_SIZE, header.points - processedPoints);
         qint64 batchSize = static_cast<qint64>(pointsToRead) * pointSize;
@@ -689,29 +699,22 @@ std::vector<QVector3D> PCDReader::readBinaryData(QFile& file, const PCDHeader& h
                 break;
             }
 
-            float x, y, z;
-            memcpy(&x, batchData.data() + offset + xOffset, sizeof(float));
-            memcpy(&y, batchData.data() + offset + yOffset, sizeof(float));
-            memcpy(&z, batchData.data() + offset + zOffset, sizeof(float));
+            double x = readCoordinate(batchData.data() + offset + xOffset, xSize);
+            double y = readCoordinate(batchData.data() + offset + yOffset, ySize);
+            double z = readCoordinate(batchData.data() + offset + zOffset, zSize);
 
             // 调试前10个点
             if (processedPoints + i < 10) {
                 qDebug() << QString("点%1: X=%2, Y=%3, Z=%4").arg(processedPoints + i).arg(x).arg(y).arg(z);
             }
 
-            // 🔧 修复：更严格的坐标验证，过滤异常值
-            if (std::isfinite(x) && std::isfinite(y) && std::isfinite(z) &&
-                std::abs(x) < 1e6f && std::abs(y) < 1e6f && std::abs(z) < 1e6f) {  // 限制在合理范围内
-                cloud.push_back(QVector3D(x, y, z));
-                validPoints++;
-
-                // 更新坐标范围统计
-                minX = std::min(minX, x);
-                maxX = std::max(maxX, x);
-                minY = std::min(minY, y);
-                maxY = std::max(maxY, y);
-                minZ = std::min(minZ, z);
-                maxZ = std::max(maxZ, z);
+            // 🔧 修复：更严格的坐标验证，过滤异常值（相对原点判断）
+            QVector3D local;
+            if (transform.apply(x, y, z, local)) {
+                if (std::abs(local.x()) < 1e6f && std::abs(local.y()) < 1e6f && std::abs(local.z()) < 1e6f) {
+                    cloud.push_back(local);
+                    validPoints++;
+                }
             }
         }
 
@@ -729,13 +732,7 @@ std::vector<QVector3D> PCDReader::readBinaryData(QFile& file, const PCDHeader& h
 
     // 输出最终的坐标范围统计
     if (validPoints > 0) {
-        qDebug() << "📊 坐标范围统计：";
-        qDebug() << QString("   X: [%1, %2] (范围: %3)")
-                        .arg(minX, 0, 'f', 3).arg(maxX, 0, 'f', 3).arg(maxX - minX, 0, 'f', 3);
-        qDebug() << QString("   Y: [%1, %2] (范围: %3)")
-                        .arg(minY, 0, 'f', 3).arg(maxY, 0, 'f', 3).arg(maxY - minY, 0, 'f', 3);
-        qDebug() << QString("   Z: [%1, %2] (范围: %3)")
-                        .arg(minZ, 0, 'f', 3).arg(maxZ, 0, 'f', 3).arg(maxZ - minZ, 0, 'f', 3);
+        logCoordinateRange(cloud);
     }
 
     return cloud;
@@ -743,7 +740,7 @@ std::vector<QVector3D> PCDReader::readBinaryData(QFile& file, const PCDHeader& h
 
 /* 读取Binary_Compressed格式数据 */
 std::vector<QVector3D> PCDReader::readBinaryCompressedData(QFile& file, const PCDHeader& header,
-                                                           int xIndex, int yIndex, int zIndex) {
+                                                           int xIndex, int yIndex, int zIndex, WallExtraction::PointDecodeTransform& transform) {
     std::vector<QVector3D> cloud;
 
     qDebug() << "开始解析Binary_Compressed格式...";
@@ -855,20 +852,20 @@ std::vector<QVector3D> PCDReader::readBinaryCompressedData(QFile& file, const PC
         qDebug() << "可处理的点数：" << (allData.size() / pointSize);
 
         // 直接解析原始数据
-        return parseBinaryPointData(allData, header, xIndex, yIndex, zIndex);
+        return parseBinaryPointData(allData, header, xIndex, yIndex, zIndex, transform);
     }
 
     qDebug() << "解压缩成功，数据大小：" << decompressedData.size() << "字节";
 
     // 解析解压缩后的数据
-    cloud = parseBinaryPointData(decompressedData, header, xIndex, yIndex, zIndex);
+    cloud = parseBinaryPointData(decompressedData, header, xIndex, yIndex, zIndex, transform);
 
     return cloud;
 }
 
 /* 解析二进制点数据 */
 std::vector<QVector3D> PCDReader::parseBinaryPointData(const QByteArray& data, const PCDHeader& header,
-                                                       int xIndex, int yIndex, int zIndex) {
+                                                       int xIndex, int yIndex, int zIndex, WallExtraction::PointDecodeTransform& transform) {
     std::vector<QVector3D> cloud;
 
     // 计算每个点的字节大小
@@ -907,6 +904,9 @@ std::vector<QVector3D> PCDReader::parseBinaryPointData(const QByteArray& data, c
     int xOffset = calculateOffset(header.sizes, xIndex);
     int yOffset = calculateOffset(header.sizes, yIndex);
     int zOffset = calculateOffset(header.sizes, zIndex);
+    int xSize = header.sizes.value(xIndex).toInt();
+    int ySize = header.sizes.value(yIndex).toInt();
+    int zSize = header.sizes.value(zIndex).toInt();
 
     qDebug() << "坐标字段索引 - X:" << xIndex << ", Y:" << yIndex << ", Z:" << zIndex;
     qDebug() << "坐标偏移量 - X:" << xOffset << ", Y:" << yOffset << ", Z:" << zOffset;
@@ -915,30 +915,20 @@ std::vector<QVector3D> PCDReader::parseBinaryPointData(const QByteArray& data, c
     int invalidPoints = 0;
     const char* dataPtr = data.data();
 
-    // 用于统计坐标范围
-    float minX = std::numeric_limits<float>::max();
-    float maxX = std::numeric_limits<float>::lowest();
-    float minY = std::numeric_limits<float>::max();
-    float maxY = std::numeric_limits<float>::lowest();
-    float minZ = std::numeric_limits<float>::max();
-    float maxZ = std::numeric_limits<float>::lowest();
-
     // 用于调试的前几个点
     qDebug() << "前10个点的坐标：";
 
     for (int i = 0; i < actualPoints; ++i) {
         const char* pointPtr = dataPtr + (i * pointSize);
 
-        float x, y, z;
-
         // 安全地复制数据，确保不会越界
-        if (pointPtr + xOffset + sizeof(float) <= dataPtr + data.size() &&
-            pointPtr + yOffset + sizeof(float) <= dataPtr + data.size() &&
-            pointPtr + zOffset + sizeof(float) <= dataPtr + data.size()) {
+        if (pointPtr + xOffset + xSize <= dataPtr + data.size() &&
+            pointPtr + yOffset + ySize <= dataPtr + data.size() &&
+            pointPtr + zOffset + zSize <= dataPtr + data.size()) {
 
-            memcpy(&x, pointPtr + xOffset, sizeof(float));
-            memcpy(&y, pointPtr + yOffset, sizeof(float));
-            memcpy(&z, pointPtr + zOffset, sizeof(float));
+            double x = readCoordinate(pointPtr + xOffset, xSize);
+            double y = readCoordinate(pointPtr + yOffset, ySize);
+            double z = readCoordinate(pointPtr + zOffset, zSize);
 
             // 调试前10个点
             if (i < 10) {
@@ -946,19 +936,12 @@ std::vector<QVector3D> PCDReader::parseBinaryPointData(const QByteArray& data, c
             }
 
             // 检查坐标值是否有效
-            if (std::isfinite(x) && std::isfinite(y) && std::isfinite(z)) {
-                // 合理性检查：排除极端值
-                if (std::abs(x) < 1e6 && std::abs(y) < 1e6 && std::abs(z) < 1e6) {
-                    cloud.push_back(QVector3D(x, y, z));
+            QVector3D local;
+            if (transform.apply(x, y, z, local)) {
+                // 合理性检查：排除极端值（相对原点判断）
+                if (std::abs(local.x()) < 1e6f && std::abs(local.y()) < 1e6f && std::abs(local.z()) < 1e6f) {
+                    cloud.push_back(local);
                     validPoints++;
-
-                    // 更新坐标范围
-                    minX = std::min(minX, x);
-                    maxX = std::max(maxX, x);
-                    minY = std::min(minY, y);
-                    maxY = std::max(maxY, y);
-                    minZ = std::min(minZ, z);
-                    maxZ = std::max(maxZ, z);
                 } else {
                     invalidPoints++;
                     if (invalidPoints <= 5) { // 只显示前5个无效点的信息
@@ -985,15 +968,39 @@ std::vector<QVector3D> PCDReader::parseBinaryPointData(const QByteArray& data, c
     qDebug() << "Binary_Compressed格式读取完成，有效点数：" << validPoints << "，无效点数：" << invalidPoints;
 
     if (validPoints > 0) {
-        qDebug() << QString("坐标范围 - X:[%1, %2], Y:[%3, %4], Z:[%5, %6]")
-                        .arg(minX, 0, 'f', 3).arg(maxX, 0, 'f', 3)
-                        .arg(minY, 0, 'f', 3).arg(maxY, 0, 'f', 3)
-                        .arg(minZ, 0, 'f', 3).arg(maxZ, 0, 'f', 3);
+        logCoordinateRange(cloud);
     }
 
     return cloud;
 }
 
+/* 输出坐标范围（解析完成后一次性并行归约，不在逐点循环中维护极值） */
+void PCDReader::logCoordinateRange(const std::vector<QVector3D>& cloud) {
+    WallExtraction::PointCloudBounds bounds = WallExtraction::computePointCloudBounds(cloud);
+    if (!bounds.isValid()) {
+        return;
+    }
+
+    const QVector3D& minPoint = bounds.minPoint;
+    const QVector3D& maxPoint = bounds.maxPoint;
+    qDebug() << QString("坐标范围 - X:[%1, %2], Y:[%3, %4], Z:[%5, %6]")
+                    .arg(minPoint.x(), 0, 'f', 3).arg(maxPoint.x(), 0, 'f', 3)
+                    .arg(minPoint.y(), 0, 'f', 3).arg(maxPoint.y(), 0, 'f', 3)
+                    .arg(minPoint.z(), 0, 'f', 3).arg(maxPoint.z(), 0, 'f', 3);
+}
+
+/* 读取坐标字段：8字节按double解码，其余按float */
+double PCDReader::readCoordinate(const char* ptr, int size) {
+    if (size == 8) {
+        double value;
+        memcpy(&value, ptr, sizeof(double));
+        return value;
+    }
+    float value;
+    memcpy(&value, ptr, sizeof(float));
+    return value;
+}
+
 /* 计算字段偏移量 */
 int PCDReader::calculateOffset(const QStringList& sizes, int index) {
     int offset = 0;
@@ -14,6 +14,7 @@
 #include <vector>
 #include <cmath>
 #include <algorithm>
+#include "src/wall_extraction/coordinate_transform.h"
 
 // 如果使用LZ4压缩，需要包含LZ4头文件
 // #include <lz4.h>
@@ -47,6 +48,30 @@ public:
      */
     static std::vector<QVector3D> ReadVec3PointCloudPCD(const QString& filename);
 
+    /**
+     * @brief 读取PCD文件，坐标相对自动选择的双精度原点保存
+     *
+     * 原点由第一个有效点确定（局部范围内为0），ASCII和F8字段按双精度解码后再减去原点，
+     * 避免UTM等大坐标在转换为float时丢失厘米级精度。
+     *
+     * @param filename PCD文件路径
+     * @param origin 输出坐标原点
+     * @return 相对origin的3D点
+     */
+    static std::vector<QVector3D> ReadVec3PointCloudPCD(const QString& filename,
+                                                       WallExtraction::CoordinateOrigin* origin);
+
+    /**
+     * @brief 读取PCD文件，在解码循环中完成单位、坐标轴和原点归一化
+     * @param filename PCD文件路径
+     * @param transform 解码变换（开启autoOrigin时由首个有效点确定原点）
+     * @param origin 输出实际使用的坐标原点（可为空）
+     * @return 归一化后的3D点
+     */
+    static std::vector<QVector3D> ReadVec3PointCloudPCD(const QString& filename,
+                                                       const WallExtraction::PointDecodeTransform& transform,
+                                                       WallExtraction::CoordinateOrigin* origin);
+
 private:
     /**
      * @brief 解析PCD文件头部信息
@@ -62,10 +87,11 @@ private:
      * @param xIndex X坐标字段索引
      * @param yIndex Y坐标字段索引
      * @param zIndex Z坐标字段索引
+     * @param transform 解码变换
      * @return 3D点的向量
      */
     static std::vector<QVector3D> readAsciiData(QFile& file, const PCDHeader& header,
-                                                int xIndex, int yIndex, int zIndex);
+                                                int xIndex, int yIndex, int zIndex, WallExtraction::PointDecodeTransform& transform);
 
     /**
      * @brief 读取Binary格式的点云数据
@@ -74,10 +100,11 @@ private:
      * @param xIndex X坐标字段索引
      * @param yIndex Y坐标字段索引
      * @param zIndex Z坐标字段索引
+     * @param transform 解码变换
      * @return 3D点的向量
      */
     static std::vector<QVector3D> readBinaryData(QFile& file, const PCDHeader& header,
-                                                 int xIndex, int yIndex, int zIndex);
+                                                 int xIndex, int yIndex, int zIndex, WallExtraction::PointDecodeTransform& transform);
 
     /**
      * @brief 读取Binary_Compressed格式的点云数据
@@ -86,10 +113,11 @@ private:
      * @param xIndex X坐标字段索引
      * @param yIndex Y坐标字段索引
      * @param zIndex Z坐标字段索引
+     * @param transform 解码变换
      * @return 3D点的向量
      */
     static std::vector<QVector3D> readBinaryCompressedData(QFile& file, const PCDHeader& header,
-                                                           int xIndex, int yIndex, int zIndex);
+                                                           int xIndex, int yIndex, int zIndex, WallExtraction::PointDecodeTransform& transform);
 
     /**
      * @brief 解析二进制点数据
@@ -98,10 +126,11 @@ private:
      * @param xIndex X坐标字段索引
      * @param yIndex Y坐标字段索引
      * @param zIndex Z坐标字段索引
+     * @param transform 解码变换
      * @return 3D点的向量
      */
     static std::vector<QVector3D> parseBinaryPointData(const QByteArray& data, const PCDHeader& header,
-                                                       int xIndex, int yIndex, int zIndex);
+                                                       int xIndex, int yIndex, int zIndex, WallExtraction::PointDecodeTransform& transform);
 
     /**
      * @brief 计算字段在数据中的偏移量
@@ -111,14 +140,28 @@ private:
      */
     static int calculateOffset(const QStringList& sizes, int index);
 
+    /**
+     * @brief 读取一个坐标字段（4字节float或8字节double）
+     * @param ptr 字段起始地址
+     * @param size 字段字节数
+     * @return 坐标值
+     */
+    static double readCoordinate(const char* ptr, int size);
+
+    /**
+     * @brief 输出点云坐标范围（调试信息）
+     * @param cloud 解析得到的点云
+     */
+    static void logCoordinateRange(const std::vector<QVector3D>& cloud);
+
     // 新增函数声明
-    static std::vector<QVector3D> readBinaryCompressedDataAdvanced(QFile& file, const PCDHeader& header, int xIndex, int yIndex, int zIndex);
+    static std::vector<QVector3D> readBinaryCompressedDataAdvanced(QFile& file, const PCDHeader& header, int xIndex, int yIndex, int zIndex, WallExtraction::PointDecodeTransform& transform);
     static QByteArray tryMultipleDecompressionMethods(const QByteArray& data, const PCDHeader& header);
     static QByteArray tryZlibDecompression(const QByteArray& data);
     static QByteArray tryLZ4Decompression(const QByteArray& data, const PCDHeader& header);
-    static std::vector<QVector3D> intelligentRawDataParsing(const QByteArray& data, const PCDHeader& header, int xIndex, int yIndex, int zIndex);
+    static std::vector<QVector3D> intelligentRawDataParsing(const QByteArray& data, const PCDHeader& header, int xIndex, int yIndex, int zIndex, WallExtraction::PointDecodeTransform& transform);
     static bool validatePointCloud(const std::vector<QVector3D>& cloud);
-    static std::vector<QVector3D> parseBinaryPointDataAdvanced(const QByteArray& data, const PCDHeader& header, int xIndex, int yIndex, int zIndex);
+    static std::vector<QVector3D> parseBinaryPointDataAdvanced(const QByteArray& data, const PCDHeader& header, int xIndex, int yIndex, int zIndex, WallExtraction::PointDecodeTransform& transform);
 };
 
 #endif // PCDREADER_H
@@ -0,0 +1,615 @@
+#include "coordinate_transform.h"
+#include "parallel_utils.h"
+#include <QStringList>
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define WALL_EXTRACTION_HAS_SSE2 1
+#endif
+
+namespace WallExtraction {
+
+namespace {
+
+// 投影步骤每个点的计算量较大，分段长度可以比纯归约小
+const size_t kMinPointsPerRange = 1 << 14;
+
+// 分块长度：每块依次执行全部步骤，三列数据保持在缓存中
+const size_t kChunkSize = 2048;
+
+const double kPi = 3.14159265358979323846;
+const double kDegreesToRadians = kPi / 180.0;
+const double kRadiansToDegrees = 180.0 / kPi;
+const double kArcSecondsToRadians = kDegreesToRadians / 3600.0;
+
+enum class EpsgKind {
+    Unsupported,
+    Geographic,
+    Projected
+};
+
+struct EpsgDefinition {
+    EpsgKind kind = EpsgKind::Unsupported;
+    Ellipsoid ellipsoid;
+    int zone = 0;
+    bool north = true;
+};
+
+EpsgDefinition lookupEpsg(int epsg)
+{
+    EpsgDefinition definition;
+    if (epsg == 4326) {
+        definition.kind = EpsgKind::Geographic;
+        definition.ellipsoid = Ellipsoid::wgs84();
+    } else if (epsg == 4258) {
+        definition.kind = EpsgKind::Geographic;
+        definition.ellipsoid = Ellipsoid::grs80();
+    } else if (epsg >= 32601 && epsg <= 32660) {
+        definition.kind = EpsgKind::Projected;
+        definition.ellipsoid = Ellipsoid::wgs84();
+        definition.zone = epsg - 32600;
+        definition.north = true;
+    } else if (epsg >= 32701 && epsg <= 32760) {
+        definition.kind = EpsgKind::Projected;
+        definition.ellipsoid = Ellipsoid::wgs84();
+        definition.zone = epsg - 32700;
+        definition.north = false;
+    } else if (epsg >= 25801 && epsg <= 25860) {
+        definition.kind = EpsgKind::Projected;
+        definition.ellipsoid = Ellipsoid::grs80();
+        definition.zone = epsg - 25800;
+        definition.north = true;
+    }
+    return definition;
+}
+
+void applyAffineColumns(const AffineTransform& transform, double* x, double* y, double* z, size_t count)
+{
+    const double (&m)[3][4] = transform.m;
+    size_t i = 0;
+
+#ifdef WALL_EXTRACTION_HAS_SSE2
+    const __m128d m00 = _mm_set1_pd(m[0][0]), m01 = _mm_set1_pd(m[0][1]);
+    const __m128d m02 = _mm_set1_pd(m[0][2]), m03 = _mm_set1_pd(m[0][3]);
+    const __m128d m10 = _mm_set1_pd(m[1][0]), m11 = _mm_set1_pd(m[1][1]);
+    const __m128d m12 = _mm_set1_pd(m[1][2]), m13 = _mm_set1_pd(m[1][3]);
+    const __m128d m20 = _mm_set1_pd(m[2][0]), m21 = _mm_set1_pd(m[2][1]);
+    const __m128d m22 = _mm_set1_pd(m[2][2]), m23 = _mm_set1_pd(m[2][3]);
+
+    for (; i + 2 <= count; i += 2) {
+        const __m128d vx = _mm_loadu_pd(x + i);
+        const __m128d vy = _mm_loadu_pd(y + i);
+        const __m128d vz = _mm_loadu_pd(z + i);
+
+        __m128d rx = _mm_add_pd(_mm_add_pd(_mm_mul_pd(m00, vx), _mm_mul_pd(m01, vy)),
+                                _mm_add_pd(_mm_mul_pd(m02, vz), m03));
+        __m128d ry = _mm_add_pd(_mm_add_pd(_mm_mul_pd(m10, vx), _mm_mul_pd(m11, vy)),
+                                _mm_add_pd(_mm_mul_pd(m12, vz), m13));
+        __m128d rz = _mm_add_pd(_mm_add_pd(_mm_mul_pd(m20, vx), _mm_mul_pd(m21, vy)),
+                                _mm_add_pd(_mm_mul_pd(m22, vz), m23));
+
+        _mm_storeu_pd(x + i, rx);
+        _mm_storeu_pd(y + i, ry);
+        _mm_storeu_pd(z + i, rz);
+    }
+#endif
+
+    for (; i < count; ++i) {
+        transform.apply(x[i], y[i], z[i]);
+    }
+}
+
+// 大地坐标（经度、纬度为度，高程为米）转地心坐标
+inline void geodeticToGeocentric(const Ellipsoid& ellipsoid, double& x, double& y, double& z)
+{
+    const double e2 = ellipsoid.eccentricitySquared();
+    const double lambda = x * kDegreesToRadians;
+    const double phi = y * kDegreesToRadians;
+    const double height = z;
+    const double sinPhi = std::sin(phi);
+    const double cosPhi = std::cos(phi);
+    const double primeVertical = ellipsoid.semiMajorAxis / std::sqrt(1.0 - e2 * sinPhi * sinPhi);
+
+    x = (primeVertical + height) * cosPhi * std::cos(lambda);
+    y = (primeVertical + height) * cosPhi * std::sin(lambda);
+    z = (primeVertical * (1.0 - e2) + height) * sinPhi;
+}
+
+// 地心坐标转大地坐标（Bowring闭式解，地表附近亚毫米精度）
+inline void geocentricToGeodetic(const Ellipsoid& ellipsoid, double& x, double& y, double& z)
+{
+    const double a = ellipsoid.semiMajorAxis;
+    const double f = ellipsoid.flattening();
+    const double b = a * (1.0 - f);
+    const double e2 = ellipsoid.eccentricitySquared();
+    const double ep2 = e2 / (1.0 - e2);
+
+    const double p = std::sqrt(x * x + y * y);
+    const double theta = std::atan2(z * a, p * b);
+    const double sinTheta = std::sin(theta);
+    const double cosTheta = std::cos(theta);
+    const double phi = std::atan2(z + ep2 * b * sinTheta * sinTheta * sinTheta,
+                                  p - e2 * a * cosTheta * cosTheta * cosTheta);
+    const double lambda = std::atan2(y, x);
+    const double sinPhi = std::sin(phi);
+    const double primeVertical = a / std::sqrt(1.0 - e2 * sinPhi * sinPhi);
+
+    // 极点附近cosφ趋于0，改用Z分量求高程
+    const double cosPhi = std::cos(phi);
+    const double height = std::fabs(cosPhi) > 1e-10
+        ? p / cosPhi - primeVertical
+        : std::fabs(z) - b;
+
+    x = lambda * kRadiansToDegrees;
+    y = phi * kRadiansToDegrees;
+    z = height;
+}
+
+} // anonymous namespace
+
+QString formatGlobalPoint(const CoordinateOrigin& origin, const QVector3D& local, int precision)
+{
+    double x, y, z;
+    origin.toGlobal(local, x, y, z);
+    return QString("(%1, %2, %3)")
+        .arg(x, 0, 'f', precision)
+        .arg(y, 0, 'f', precision)
+        .arg(z, 0, 'f', precision);
+}
+
+// TransverseMercator 实现
+TransverseMercator::TransverseMercator(const Ellipsoid& ellipsoid,
+                                       double centralMeridian,
+                                       double scaleFactor,
+                                       double falseEasting,
+                                       double falseNorthing,
+                                       double latitudeOfOrigin)
+    : m_ellipsoid(ellipsoid)
+    , m_centralMeridian(centralMeridian)
+    , m_centralMeridianRad(centralMeridian * kDegreesToRadians)
+    , m_scaleFactor(scaleFactor)
+    , m_falseEasting(falseEasting)
+    , m_falseNorthing(falseNorthing)
+    , m_originNorthing(0.0)
+{
+    const double f = ellipsoid.flattening();
+    const double n = f / (2.0 - f);
+    const double n2 = n * n;
+    const double n3 = n2 * n;
+    const double n4 = n3 * n;
+    const double n5 = n4 * n;
+    const double n6 = n5 * n;
+
+    m_eccentricity = std::sqrt(ellipsoid.eccentricitySquared());
+    const double rectifyingRadius = ellipsoid.semiMajorAxis / (1.0 + n) *
+                                    (1.0 + n2 / 4.0 + n4 / 64.0 + n6 / 256.0);
+    m_scaledRadius = scaleFactor * rectifyingRadius;
+
+    m_alpha[0] = n / 2.0 - 2.0 * n2 / 3.0 + 5.0 * n3 / 16.0 + 41.0 * n4 / 180.0
+                 - 127.0 * n5 / 288.0 + 7891.0 * n6 / 37800.0;
+    m_alpha[1] = 13.0 * n2 / 48.0 - 3.0 * n3 / 5.0 + 557.0 * n4 / 1440.0
+                 + 281.0 * n5 / 630.0 - 1983433.0 * n6 / 1935360.0;
+    m_alpha[2] = 61.0 * n3 / 240.0 - 103.0 * n4 / 140.0 + 15061.0 * n5 / 26880.0
+                 + 167603.0 * n6 / 181440.0;
+    m_alpha[3] = 49561.0 * n4 / 161280.0 - 179.0 * n5 / 168.0 + 6601661.0 * n6 / 7257600.0;
+    m_alpha[4] = 34729.0 * n5 / 80640.0 - 3418889.0 * n6 / 1995840.0;
+    m_alpha[5] = 212378941.0 * n6 / 319334400.0;
+
+    m_beta[0] = n / 2.0 - 2.0 * n2 / 3.0 + 37.0 * n3 / 96.0 - n4 / 360.0
+                - 81.0 * n5 / 512.0 + 96199.0 * n6 / 604800.0;
+    m_beta[1] = n2 / 48.0 + n3 / 15.0 - 437.0 * n4 / 1440.0 + 46.0 * n5 / 105.0
+                - 1118711.0 * n6 / 3870720.0;
+    m_beta[2] = 17.0 * n3 / 480.0 - 37.0 * n4 / 840.0 - 209.0 * n5 / 4480.0
+                + 5569.0 * n6 / 90720.0;
+    m_beta[3] = 4397.0 * n4 / 161280.0 - 11.0 * n5 / 504.0 - 830251.0 * n6 / 7257600.0;
+    m_beta[4] = 4583.0 * n5 / 161280.0 - 108847.0 * n6 / 3991680.0;
+    m_beta[5] = 20648693.0 * n6 / 638668800.0;
+
+    // 原点纬度不为0时，北坐标需减去该纬度处的子午线弧长
+    if (latitudeOfOrigin != 0.0) {
+        double easting = 0.0;
+        double northing = 0.0;
+        forward(centralMeridian, latitudeOfOrigin, easting, northing);
+        m_originNorthing = northing - falseNorthing;
+    }
+}
+
+TransverseMercator TransverseMercator::utm(int zone, bool north, const Ellipsoid& ellipsoid)
+{
+    zone = std::max(1, std::min(60, zone));
+    return TransverseMercator(ellipsoid, zone * 6.0 - 183.0, 0.9996, 500000.0, north ? 0.0 : 10000000.0);
+}
+
+void TransverseMercator::forward(double longitude, double latitude, double& easting, double& northing) const
+{
+    const double phi = latitude * kDegreesToRadians;
+    double lambda = longitude * kDegreesToRadians - m_centralMeridianRad;
+    lambda = std::remainder(lambda, 2.0 * kPi);
+
+    // 共形纬度的正切
+    const double sinPhi = std::sin(phi);
+    const double t = std::sinh(std::atanh(sinPhi) - m_eccentricity * std::atanh(m_eccentricity * sinPhi));
+    const double xiPrime = std::atan2(t, std::cos(lambda));
+    const double etaPrime = std::atanh(std::sin(lambda) / std::sqrt(1.0 + t * t));
+
+    double xi = xiPrime;
+    double eta = etaPrime;
+    for (int j = 0; j < 6; ++j) {
+        const double k = 2.0 * (j + 1);
+        xi += m_alpha[j] * std::sin(k * xiPrime) * std::cosh(k * etaPrime);
+        eta += m_alpha[j] * std::cos(k * xiPrime) * std::sinh(k * etaPrime);
+    }
+
+    easting = m_falseEasting + m_scaledRadius * eta;
+    northing = m_falseNorthing + m_scaledRadius * xi - m_originNorthing;
+}
+
+void TransverseMercator::inverse(double easting, double northing, double& longitude, double& latitude) const
+{
+    const double xi = (northing - m_falseNorthing + m_originNorthing) / m_scaledRadius;
+    const double eta = (easting - m_falseEasting) / m_scaledRadius;
+
+    double xiPrime = xi;
+    double etaPrime = eta;
+    for (int j = 0; j < 6; ++j) {
+        const double k = 2.0 * (j + 1);
+        xiPrime -= m_beta[j] * std::sin(k * xi) * std::cosh(k * eta);
+        etaPrime -= m_beta[j] * std::cos(k * xi) * std::sinh(k * eta);
+    }
+
+    const double sinhEta = std::sinh(etaPrime);
+    const double sinXi = std::sin(xiPrime);
+    const double cosXi = std::cos(xiPrime);
+    const double tauPrime = sinXi / std::sqrt(sinhEta * sinhEta + cosXi * cosXi);
+
+    // 由共形纬度正切τ'求大地纬度正切τ（牛顿迭代，通常2~3次收敛）
+    const double e = m_eccentricity;
+    const double e2 = e * e;
+    double tau = tauPrime;
+    for (int iteration = 0; iteration < 5; ++iteration) {
+        const double sqrtOnePlusTau2 = std::sqrt(1.0 + tau * tau);
+        const double sigma = std::sinh(e * std::atanh(e * tau / sqrtOnePlusTau2));
+        const double tauPrimeI = tau * std::sqrt(1.0 + sigma * sigma) - sigma * sqrtOnePlusTau2;
+        const double delta = (tauPrime - tauPrimeI) / std::sqrt(1.0 + tauPrimeI * tauPrimeI) *
+                             (1.0 + (1.0 - e2) * tau * tau) / ((1.0 - e2) * sqrtOnePlusTau2);
+        tau += delta;
+        if (std::fabs(delta) < 1e-14) {
+            break;
+        }
+    }
+
+    latitude = std::atan(tau) * kRadiansToDegrees;
+    longitude = (std::atan2(sinhEta, cosXi) + m_centralMeridianRad) * kRadiansToDegrees;
+}
+
+void TransverseMercator::forward(double* x, double* y, size_t count) const
+{
+    for (size_t i = 0; i < count; ++i) {
+        forward(x[i], y[i], x[i], y[i]);
+    }
+}
+
+void TransverseMercator::inverse(double* x, double* y, size_t count) const
+{
+    for (size_t i = 0; i < count; ++i) {
+        inverse(x[i], y[i], x[i], y[i]);
+    }
+}
+
+// HelmertParameters 实现
+HelmertParameters HelmertParameters::inverse() const
+{
+    HelmertParameters result = *this;
+    result.tx = -tx;
+    result.ty = -ty;
+    result.tz = -tz;
+    result.rx = -rx;
+    result.ry = -ry;
+    result.rz = -rz;
+    result.scalePpm = -scalePpm;
+    return result;
+}
+
+// AffineTransform 实现
+AffineTransform AffineTransform::translation(double tx, double ty, double tz)
+{
+    AffineTransform transform;
+    transform.m[0][3] = tx;
+    transform.m[1][3] = ty;
+    transform.m[2][3] = tz;
+    return transform;
+}
+
+AffineTransform AffineTransform::similarity2D(double rotationDegrees, double scale,
+                                              double tx, double ty, double tz)
+{
+    const double angle = rotationDegrees * kDegreesToRadians;
+    const double c = std::cos(angle) * scale;
+    const double s = std::sin(angle) * scale;
+
+    AffineTransform transform;
+    transform.m[0][0] = c;
+    transform.m[0][1] = -s;
+    transform.m[0][3] = tx;
+    transform.m[1][0] = s;
+    transform.m[1][1] = c;
+    transform.m[1][3] = ty;
+    transform.m[2][3] = tz;
+    return transform;
+}
+
+AffineTransform AffineTransform::fromHelmert(const HelmertParameters& parameters)
+{
+    // 位置矢量约定的旋转矩阵；坐标框架约定旋转角取反
+    const double sign = parameters.convention == HelmertParameters::Convention::PositionVector ? 1.0 : -1.0;
+    const double rx = sign * parameters.rx * kArcSecondsToRadians;
+    const double ry = sign * parameters.ry * kArcSecondsToRadians;
+    const double rz = sign * parameters.rz * kArcSecondsToRadians;
+    const double scale = 1.0 + parameters.scalePpm * 1e-6;
+
+    AffineTransform transform;
+    transform.m[0][0] = scale;
+    transform.m[0][1] = -rz * scale;
+    transform.m[0][2] = ry * scale;
+    transform.m[0][3] = parameters.tx;
+    transform.m[1][0] = rz * scale;
+    transform.m[1][1] = scale;
+    transform.m[1][2] = -rx * scale;
+    transform.m[1][3] = parameters.ty;
+    transform.m[2][0] = -ry * scale;
+    transform.m[2][1] = rx * scale;
+    transform.m[2][2] = scale;
+    transform.m[2][3] = parameters.tz;
+    return transform;
+}
+
+AffineTransform AffineTransform::compose(const AffineTransform& first) const
+{
+    AffineTransform result;
+    for (int row = 0; row < 3; ++row) {
+        for (int column = 0; column < 4; ++column) {
+            double value = column == 3 ? m[row][3] : 0.0;
+            for (int k = 0; k < 3; ++k) {
+                value += m[row][k] * first.m[k][column];
+            }
+            result.m[row][column] = value;
+        }
+    }
+    return result;
+}
+
+AffineTransform AffineTransform::inverse() const
+{
+    const double c00 = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+    const double c01 = m[0][2] * m[2][1] - m[0][1] * m[2][2];
+    const double c02 = m[0][1] * m[1][2] - m[0][2] * m[1][1];
+    const double c10 = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+    const double c11 = m[0][0] * m[2][2] - m[0][2] * m[2][0];
+    const double c12 = m[0][2] * m[1][0] - m[0][0] * m[1][2];
+    const double c20 = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+    const double c21 = m[0][1] * m[2][0] - m[0][0] * m[2][1];
+    const double c22 = m[0][0] * m[1][1] - m[0][1] * m[1][0];
+
+    const double determinant = m[0][0] * c00 + m[0][1] * c10 + m[0][2] * c20;
+    if (std::fabs(determinant) < 1e-300) {
+        return AffineTransform();
+    }
+    const double inverseDeterminant = 1.0 / determinant;
+
+    AffineTransform result;
+    const double rotation[3][3] = {{c00, c01, c02}, {c10, c11, c12}, {c20, c21, c22}};
+    for (int row = 0; row < 3; ++row) {
+        for (int column = 0; column < 3; ++column) {
+            result.m[row][column] = rotation[row][column] * inverseDeterminant;
+        }
+    }
+    for (int row = 0; row < 3; ++row) {
+        result.m[row][3] = -(result.m[row][0] * m[0][3] + result.m[row][1] * m[1][3] + result.m[row][2] * m[2][3]);
+    }
+    return result;
+}
+
+void AffineTransform::apply(double& x, double& y, double& z) const
+{
+    const double ox = x;
+    const double oy = y;
+    const double oz = z;
+    x = m[0][0] * ox + m[0][1] * oy + m[0][2] * oz + m[0][3];
+    y = m[1][0] * ox + m[1][1] * oy + m[1][2] * oz + m[1][3];
+    z = m[2][0] * ox + m[2][1] * oy + m[2][2] * oz + m[2][3];
+}
+
+// CoordinateTransformer 实现
+CoordinateTransformer CoordinateTransformer::fromEpsg(int sourceEpsg, int targetEpsg)
+{
+    CoordinateTransformer transformer;
+
+    EpsgDefinition source = lookupEpsg(sourceEpsg);
+    EpsgDefinition target = lookupEpsg(targetEpsg);
+    if (source.kind == EpsgKind::Unsupported || target.kind == EpsgKind::Unsupported) {
+        transformer.m_valid = false;
+        return transformer;
+    }
+    if (sourceEpsg == targetEpsg) {
+        return transformer;
+    }
+
+    if (source.kind == EpsgKind::Projected) {
+        transformer.addInverseProjection(TransverseMercator::utm(source.zone, source.north, source.ellipsoid));
+    }
+    if (target.kind == EpsgKind::Projected) {
+        transformer.addForwardProjection(TransverseMercator::utm(target.zone, target.north, target.ellipsoid));
+    }
+    return transformer;
+}
+
+CoordinateTransformer& CoordinateTransformer::addForwardProjection(const TransverseMercator& projection)
+{
+    m_steps.push_back({StepType::ForwardProjection, projection, projection.ellipsoid(), AffineTransform()});
+    return *this;
+}
+
+CoordinateTransformer& CoordinateTransformer::addInverseProjection(const TransverseMercator& projection)
+{
+    m_steps.push_back({StepType::InverseProjection, projection, projection.ellipsoid(), AffineTransform()});
+    return *this;
+}
+
+CoordinateTransformer& CoordinateTransformer::addGeodeticToGeocentric(const Ellipsoid& ellipsoid)
+{
+    m_steps.push_back({StepType::GeodeticToGeocentric, TransverseMercator(), ellipsoid, AffineTransform()});
+    return *this;
+}
+
+CoordinateTransformer& CoordinateTransformer::addGeocentricToGeodetic(const Ellipsoid& ellipsoid)
+{
+    m_steps.push_back({StepType::GeocentricToGeodetic, TransverseMercator(), ellipsoid, AffineTransform()});
+    return *this;
+}
+
+CoordinateTransformer& CoordinateTransformer::addHelmert(const HelmertParameters& parameters)
+{
+    return addAffine(AffineTransform::fromHelmert(parameters));
+}
+
+CoordinateTransformer& CoordinateTransformer::addAffine(const AffineTransform& transform)
+{
+    // 相邻的线性步骤合并为一个矩阵
+    if (!m_steps.empty() && m_steps.back().type == StepType::Affine) {
+        m_steps.back().affine = transform.compose(m_steps.back().affine);
+        return *this;
+    }
+    m_steps.push_back({StepType::Affine, TransverseMercator(), Ellipsoid(), transform});
+    return *this;
+}
+
+CoordinateTransformer& CoordinateTransformer::addDatumShift(const Ellipsoid& source,
+                                                            const HelmertParameters& parameters,
+                                                            const Ellipsoid& target)
+{
+    addGeodeticToGeocentric(source);
+    addHelmert(parameters);
+    addGeocentricToGeodetic(target);
+    return *this;
+}
+
+QString CoordinateTransformer::description() const
+{
+    if (!m_valid) {
+        return "Invalid";
+    }
+    if (m_steps.empty()) {
+        return "Identity";
+    }
+
+    QStringList names;
+    for (const Step& step : m_steps) {
+        switch (step.type) {
+            case StepType::ForwardProjection:
+                names << QString("TM(%1)").arg(step.projection.centralMeridian());
+                break;
+            case StepType::InverseProjection:
+                names << QString("InverseTM(%1)").arg(step.projection.centralMeridian());
+                break;
+            case StepType::GeodeticToGeocentric:
+                names << "Geodetic->Geocentric";
+                break;
+            case StepType::GeocentricToGeodetic:
+                names << "Geocentric->Geodetic";
+                break;
+            case StepType::Affine:
+                names << "Affine";
+                break;
+        }
+    }
+    return names.join(" -> ");
+}
+
+void CoordinateTransformer::applyStep(const Step& step, double* x, double* y, double* z, size_t count) const
+{
+    switch (step.type) {
+        case StepType::ForwardProjection:
+            step.projection.forward(x, y, count);
+            break;
+        case StepType::InverseProjection:
+            step.projection.inverse(x, y, count);
+            break;
+        case StepType::GeodeticToGeocentric:
+            for (size_t i = 0; i < count; ++i) {
+                geodeticToGeocentric(step.ellipsoid, x[i], y[i], z[i]);
+            }
+            break;
+        case StepType::GeocentricToGeodetic:
+            for (size_t i = 0; i < count; ++i) {
+                geocentricToGeodetic(step.ellipsoid, x[i], y[i], z[i]);
+            }
+            break;
+        case StepType::Affine:
+            applyAffineColumns(step.affine, x, y, z, count);
+            break;
+    }
+}
+
+void CoordinateTransformer::transform(double& x, double& y, double& z) const
+{
+    for (const Step& step : m_steps) {
+        applyStep(step, &x, &y, &z, 1);
+    }
+}
+
+void CoordinateTransformer::transform(CoordinateColumns& columns) const
+{
+    if (m_steps.empty()) {
+        return;
+    }
+
+    double* x = columns.x.data();
+    double* y = columns.y.data();
+    double* z = columns.z.data();
+    parallelForRange(0, columns.size(), [&](size_t rangeBegin, size_t rangeEnd, size_t) {
+        for (size_t chunkBegin = rangeBegin; chunkBegin < rangeEnd; chunkBegin += kChunkSize) {
+            const size_t count = std::min(kChunkSize, rangeEnd - chunkBegin);
+            for (const Step& step : m_steps) {
+                applyStep(step, x + chunkBegin, y + chunkBegin, z + chunkBegin, count);
+            }
+        }
+    }, kMinPointsPerRange);
+}
+
+std::vector<QVector3D> CoordinateTransformer::transformPoints(const std::vector<QVector3D>& points,
+                                                              const CoordinateOrigin& sourceOrigin,
+                                                              CoordinateOrigin* targetOrigin) const
+{
+    CoordinateOrigin outputOrigin;
+    if (targetOrigin) {
+        outputOrigin = sourceOrigin;
+        transform(outputOrigin.x, outputOrigin.y, outputOrigin.z);
+        *targetOrigin = outputOrigin;
+    }
+
+    const size_t count = points.size();
+    std::vector<QVector3D> result(count);
+    parallelForRange(0, count, [&](size_t rangeBegin, size_t rangeEnd, size_t) {
+        double x[kChunkSize];
+        double y[kChunkSize];
+        double z[kChunkSize];
+        for (size_t chunkBegin = rangeBegin; chunkBegin < rangeEnd; chunkBegin += kChunkSize) {
+            const size_t chunkCount = std::min(kChunkSize, rangeEnd - chunkBegin);
+            for (size_t i = 0; i < chunkCount; ++i) {
+                sourceOrigin.toGlobal(points[chunkBegin + i], x[i], y[i], z[i]);
+            }
+            for (const Step& step : m_steps) {
+                applyStep(step, x, y, z, chunkCount);
+            }
+            for (size_t i = 0; i < chunkCount; ++i) {
+                result[chunkBegin + i] = outputOrigin.toLocal(x[i], y[i], z[i]);
+            }
+        }
+    }, kMinPointsPerRange);
+
+    return result;
+}
+
+} // namespace WallExtraction
@@ -0,0 +1,434 @@
+#ifndef COORDINATE_TRANSFORM_H
+#define COORDINATE_TRANSFORM_H
+
+#include <QVector3D>
+#include <QString>
+#include <cmath>
+#include <vector>
+
+namespace WallExtraction {
+
+/**
+ * @brief 双精度坐标原点
+ *
+ * 大坐标（如UTM）以 原点 + float局部坐标 的形式保存，局部坐标保持毫米级精度。
+ */
+struct CoordinateOrigin {
+    double x = 0.0;
+    double y = 0.0;
+    double z = 0.0;
+
+    bool isZero() const { return x == 0.0 && y == 0.0 && z == 0.0; }
+
+    /**
+     * @brief 为给定位置选择原点
+     *
+     * 坐标绝对值不超过kLocalRange的轴保持0（局部扫描不受影响），
+     * 其余轴取到kOriginGrid米整倍数，便于人工核对。
+     */
+    static CoordinateOrigin forPoint(double px, double py, double pz)
+    {
+        auto snap = [](double value) {
+            return std::fabs(value) <= kLocalRange ? 0.0 : std::round(value / kOriginGrid) * kOriginGrid;
+        };
+        return {snap(px), snap(py), snap(pz)};
+    }
+
+    /**
+     * @brief 以包围盒中心选择原点
+     */
+    static CoordinateOrigin forBounds(double minX, double minY, double minZ,
+                                      double maxX, double maxY, double maxZ)
+    {
+        return forPoint((minX + maxX) * 0.5, (minY + maxY) * 0.5, (minZ + maxZ) * 0.5);
+    }
+
+    static constexpr double kLocalRange = 1000.0;   // float在该范围内的分辨率优于0.1毫米
+    static constexpr double kOriginGrid = 1000.0;
+
+    /**
+     * @brief 全局坐标转换为局部float坐标
+     */
+    QVector3D toLocal(double globalX, double globalY, double globalZ) const
+    {
+        return QVector3D(static_cast<float>(globalX - x),
+                         static_cast<float>(globalY - y),
+                         static_cast<float>(globalZ - z));
+    }
+
+    /**
+     * @brief 局部float坐标还原为全局坐标
+     */
+    void toGlobal(const QVector3D& local, double& globalX, double& globalY, double& globalZ) const
+    {
+        globalX = x + local.x();
+        globalY = y + local.y();
+        globalZ = z + local.z();
+    }
+};
+
+/**
+ * @brief 解码时坐标归一化（单位缩放、轴置换、重定中心、有限性检查）
+ *
+ * 由读取器在逐点解码循环中调用，原始双精度坐标依次经过
+ * 轴置换/取反 → 缩放 → 有限性检查 → 减去原点 后才转换为float，
+ * 归一化不需要额外遍历点云，也不产生额外副本。
+ * 开启autoOrigin时原点由首个有效点确定，因此每次读取应使用独立副本。
+ */
+struct PointDecodeTransform {
+    double scale = 1.0;                     // 单位缩放（如毫米→米为0.001）
+    int axisOrder[3] = {0, 1, 2};           // 输出第i轴取自输入第axisOrder[i]轴
+    double axisSign[3] = {1.0, 1.0, 1.0};   // 输出第i轴的符号
+    CoordinateOrigin origin;                // 从归一化坐标中减去的原点
+    bool autoOrigin = false;                // 由首个有效点确定原点
+    bool rebase = true;                     // 未指定原点时允许读取器自动选择原点，false时保持绝对坐标
+
+    static PointDecodeTransform identity() { return PointDecodeTransform(); }
+
+    /**
+     * @brief 不重定中心，输出绝对坐标（大坐标会损失float精度）
+     */
+    static PointDecodeTransform absolute()
+    {
+        PointDecodeTransform transform;
+        transform.rebase = false;
+        return transform;
+    }
+
+    static PointDecodeTransform millimetersToMeters()
+    {
+        PointDecodeTransform transform;
+        transform.scale = 0.001;
+        return transform;
+    }
+
+    /**
+     * @brief Y轴向上的坐标（多数建模软件导出）转换为Z轴向上：(x, y, z) → (x, -z, y)
+     */
+    static PointDecodeTransform yUpToZUp()
+    {
+        PointDecodeTransform transform;
+        transform.axisOrder[1] = 2;
+        transform.axisOrder[2] = 1;
+        transform.axisSign[1] = -1.0;
+        return transform;
+    }
+
+    bool hasAxisChange() const
+    {
+        return axisOrder[0] != 0 || axisOrder[1] != 1 || axisOrder[2] != 2 ||
+               axisSign[0] != 1.0 || axisSign[1] != 1.0 || axisSign[2] != 1.0;
+    }
+
+    bool isIdentity() const
+    {
+        return scale == 1.0 && !hasAxisChange() && origin.isZero() && !autoOrigin;
+    }
+
+    /**
+     * @brief 解码一个点
+     * @param x 原始X
+     * @param y 原始Y
+     * @param z 原始Z
+     * @param out 归一化后的局部坐标
+     * @return 坐标非有限值时返回false，out不变
+     */
+    bool apply(double x, double y, double z, QVector3D& out)
+    {
+        const double raw[3] = {x, y, z};
+        const double nx = axisSign[0] * raw[axisOrder[0]] * scale;
+        const double ny = axisSign[1] * raw[axisOrder[1]] * scale;
+        const double nz = axisSign[2] * raw[axisOrder[2]] * scale;
+
+        if (!std::isfinite(nx) || !std::isfinite(ny) || !std::isfinite(nz)) {
+            return false;
+        }
+
+        if (autoOrigin) {
+            origin = CoordinateOrigin::forPoint(nx, ny, nz);
+            autoOrigin = false;
+        }
+
+        out = origin.toLocal(nx, ny, nz);
+        return true;
+    }
+};
+
+/**
+ * @brief 将局部点加回原点后格式化为 "(x, y, z)"
+ * @param origin 坐标原点
+ * @param local 局部坐标
+ * @param precision 小数位数
+ * @return 全局坐标文本
+ */
+QString formatGlobalPoint(const CoordinateOrigin& origin, const QVector3D& local, int precision = 2);
+
+/**
+ * @brief 按列存储（SoA）的双精度坐标
+ */
+struct CoordinateColumns {
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> z;
+
+    size_t size() const { return x.size(); }
+    void resize(size_t count)
+    {
+        x.resize(count);
+        y.resize(count);
+        z.resize(count);
+    }
+};
+
+/**
+ * @brief 参考椭球
+ */
+struct Ellipsoid {
+    double semiMajorAxis = 6378137.0;           // 长半轴（米）
+    double inverseFlattening = 298.257223563;   // 扁率倒数
+
+    double flattening() const { return 1.0 / inverseFlattening; }
+    double eccentricitySquared() const { return flattening() * (2.0 - flattening()); }
+
+    static Ellipsoid wgs84() { return {6378137.0, 298.257223563}; }
+    static Ellipsoid grs80() { return {6378137.0, 298.257222101}; }
+    static Ellipsoid bessel1841() { return {6377397.155, 299.1528128}; }
+    static Ellipsoid krassowsky1940() { return {6378245.0, 298.3}; }
+};
+
+/**
+ * @brief 横轴墨卡托投影（Krüger 6阶级数）
+ *
+ * 构造时预计算全部级数系数，正反算均不需要迭代求子午线弧长；
+ * 在中央经线两侧4000公里内精度优于1毫米。
+ */
+class TransverseMercator
+{
+public:
+    /**
+     * @brief 构造投影
+     * @param ellipsoid 参考椭球
+     * @param centralMeridian 中央经线（度）
+     * @param scaleFactor 中央经线比例因子
+     * @param falseEasting 东向假偏移（米）
+     * @param falseNorthing 北向假偏移（米）
+     * @param latitudeOfOrigin 原点纬度（度）
+     */
+    TransverseMercator(const Ellipsoid& ellipsoid = Ellipsoid::wgs84(),
+                       double centralMeridian = 0.0,
+                       double scaleFactor = 1.0,
+                       double falseEasting = 0.0,
+                       double falseNorthing = 0.0,
+                       double latitudeOfOrigin = 0.0);
+
+    /**
+     * @brief 构造UTM投影
+     * @param zone 带号 1-60
+     * @param north 北半球
+     * @param ellipsoid 参考椭球
+     * @return 投影
+     */
+    static TransverseMercator utm(int zone, bool north, const Ellipsoid& ellipsoid = Ellipsoid::wgs84());
+
+    /**
+     * @brief 正算：经纬度（度）到投影坐标（米）
+     */
+    void forward(double longitude, double latitude, double& easting, double& northing) const;
+
+    /**
+     * @brief 反算：投影坐标（米）到经纬度（度）
+     */
+    void inverse(double easting, double northing, double& longitude, double& latitude) const;
+
+    /**
+     * @brief 批量正算，x列为经度、y列为纬度，原地写回东坐标和北坐标
+     */
+    void forward(double* x, double* y, size_t count) const;
+
+    /**
+     * @brief 批量反算，x列为东坐标、y列为北坐标，原地写回经度和纬度
+     */
+    void inverse(double* x, double* y, size_t count) const;
+
+    const Ellipsoid& ellipsoid() const { return m_ellipsoid; }
+    double centralMeridian() const { return m_centralMeridian; }
+
+private:
+    Ellipsoid m_ellipsoid;
+    double m_centralMeridian;       // 度
+    double m_centralMeridianRad;
+    double m_scaleFactor;
+    double m_falseEasting;
+    double m_falseNorthing;
+    double m_eccentricity;
+    double m_scaledRadius;          // k0 * A，A为矫正纬度对应的子午线半径
+    double m_originNorthing;        // 原点纬度处的子午线弧长（已乘k0）
+    double m_alpha[6];              // 正算级数系数
+    double m_beta[6];               // 反算级数系数
+};
+
+/**
+ * @brief Helmert七参数
+ *
+ * 平移单位为米，旋转单位为角秒，尺度单位为ppm。
+ */
+struct HelmertParameters {
+    enum class Convention {
+        PositionVector,     // 位置矢量约定（EPSG:9606）
+        CoordinateFrame     // 坐标框架约定（EPSG:9607）
+    };
+
+    double tx = 0.0;
+    double ty = 0.0;
+    double tz = 0.0;
+    double rx = 0.0;
+    double ry = 0.0;
+    double rz = 0.0;
+    double scalePpm = 0.0;
+    Convention convention = Convention::PositionVector;
+
+    /**
+     * @brief 反向参数（小角度近似，与EPSG反算做法一致）
+     */
+    HelmertParameters inverse() const;
+};
+
+/**
+ * @brief 三维仿射变换（3x4矩阵，双精度）
+ */
+struct AffineTransform {
+    double m[3][4] = {{1.0, 0.0, 0.0, 0.0},
+                      {0.0, 1.0, 0.0, 0.0},
+                      {0.0, 0.0, 1.0, 0.0}};
+
+    static AffineTransform identity() { return AffineTransform(); }
+
+    /**
+     * @brief 平移
+     */
+    static AffineTransform translation(double tx, double ty, double tz);
+
+    /**
+     * @brief 平面四参数相似变换（地方网格常用），高程加偏移
+     * @param rotationDegrees 旋转角（度，逆时针）
+     * @param scale 尺度
+     * @param tx X平移
+     * @param ty Y平移
+     * @param tz 高程偏移
+     */
+    static AffineTransform similarity2D(double rotationDegrees, double scale,
+                                        double tx, double ty, double tz = 0.0);
+
+    /**
+     * @brief 由Helmert七参数构造地心坐标系下的仿射变换（不做小角度以外的近似）
+     */
+    static AffineTransform fromHelmert(const HelmertParameters& parameters);
+
+    /**
+     * @brief 复合变换：先应用first，再应用本变换
+     */
+    AffineTransform compose(const AffineTransform& first) const;
+
+    /**
+     * @brief 逆变换
+     * @return 逆变换（矩阵奇异时返回单位变换）
+     */
+    AffineTransform inverse() const;
+
+    void apply(double& x, double& y, double& z) const;
+};
+
+/**
+ * @brief 批量坐标变换引擎
+ *
+ * 由投影正反算、大地坐标与地心坐标互换、Helmert、仿射等步骤组成流水线，
+ * 数据按SoA列存储，分块并行处理，每块依次执行全部步骤以保持缓存命中；
+ * 线性步骤（仿射、Helmert）用SSE2双精度向量实现。
+ */
+class CoordinateTransformer
+{
+public:
+    CoordinateTransformer() = default;
+
+    /**
+     * @brief 由EPSG代码构造变换
+     *
+     * 支持 4326（WGS84经纬度）、4258（ETRS89经纬度）、326xx/327xx（WGS84 UTM北/南）、
+     * 258xx（ETRS89 UTM）。ETRS89与WGS84按米级精度视为相同基准。
+     *
+     * @param sourceEpsg 源EPSG代码
+     * @param targetEpsg 目标EPSG代码
+     * @return 变换，不支持时isValid()为false
+     */
+    static CoordinateTransformer fromEpsg(int sourceEpsg, int targetEpsg);
+
+    // 流水线构建
+    CoordinateTransformer& addForwardProjection(const TransverseMercator& projection);
+    CoordinateTransformer& addInverseProjection(const TransverseMercator& projection);
+    CoordinateTransformer& addGeodeticToGeocentric(const Ellipsoid& ellipsoid);
+    CoordinateTransformer& addGeocentricToGeodetic(const Ellipsoid& ellipsoid);
+    CoordinateTransformer& addHelmert(const HelmertParameters& parameters);
+    CoordinateTransformer& addAffine(const AffineTransform& transform);
+
+    /**
+     * @brief 基准转换：大地坐标 → 地心坐标 → Helmert → 大地坐标
+     */
+    CoordinateTransformer& addDatumShift(const Ellipsoid& source, const HelmertParameters& parameters,
+                                         const Ellipsoid& target);
+
+    bool isValid() const { return m_valid; }
+    bool isIdentity() const { return m_valid && m_steps.empty(); }
+    size_t stepCount() const { return m_steps.size(); }
+    QString description() const;
+
+    /**
+     * @brief 变换单个点
+     */
+    void transform(double& x, double& y, double& z) const;
+
+    /**
+     * @brief 原地批量变换SoA列
+     */
+    void transform(CoordinateColumns& columns) const;
+
+    /**
+     * @brief 批量变换float点云
+     *
+     * 输入按 sourceOrigin + 局部坐标 解码为双精度，输出相对targetOrigin保存。
+     * targetOrigin为空指针时输出为绝对坐标；否则写入变换后的源原点，
+     * 使远离原点的结果仍保持毫米级精度。
+     *
+     * @param points 局部坐标点云
+     * @param sourceOrigin 输入原点
+     * @param targetOrigin 输出原点（可为空）
+     * @return 变换后的点云
+     */
+    std::vector<QVector3D> transformPoints(const std::vector<QVector3D>& points,
+                                           const CoordinateOrigin& sourceOrigin = CoordinateOrigin(),
+                                           CoordinateOrigin* targetOrigin = nullptr) const;
+
+private:
+    enum class StepType {
+        ForwardProjection,
+        InverseProjection,
+        GeodeticToGeocentric,
+        GeocentricToGeodetic,
+        Affine
+    };
+
+    struct Step {
+        StepType type;
+        TransverseMercator projection;
+        Ellipsoid ellipsoid;
+        AffineTransform affine;
+    };
+
+    void applyStep(const Step& step, double* x, double* y, double* z, size_t count) const;
+
+    std::vector<Step> m_steps;
+    bool m_valid = true;
+};
+
+} // namespace WallExtraction
+
+#endif // COORDINATE_TRANSFORM_H
@@ -0,0 +1,676 @@
+#include "efficient_ransac.h"
+#include "normal_estimation.h"
+#include "parallel_utils.h"
+#include "point_cloud_statistics.h"
+#include "spatial_index.h"
+#include "symmetric_eigen_solver.h"
+#include <QElapsedTimer>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+
+namespace WallExtraction {
+
+namespace {
+
+// 八叉树深度（每轴10位，Morton码占30位）
+const int kOctreeDepth = 10;
+
+// 最粗的采样层级，更粗的单元与全局采样无异
+const int kMinSampleLevel = 2;
+
+// 首级评分子集大小，后续每级加倍
+const size_t kFirstSubsetSize = 1024;
+
+// 每批生成的候选数
+const size_t kCandidatesPerBatch = 64;
+
+// 候选池上限，超出时丢弃估计得分最低的候选
+const size_t kMaxCandidatePool = 256;
+
+// 每个候选的采样重试次数
+const int kMaxSampleRetries = 16;
+
+// 法向量估计的邻居数
+const int kNormalNeighbors = 12;
+
+// 子集中的兼容点数达到该值时估计的相对误差约5%，不再细化
+const size_t kPreciseHits = 1600;
+
+// 剩余点数组中已移除点的比例超过该值时压缩
+const double kCompactRatio = 0.125;
+
+// 每段至少处理的点数
+const size_t kMinPointsPerRange = 1 << 14;
+
+struct Candidate {
+    QVector3D normal;
+    float d = 0.0f;                 // 平面方程 normal·p = d
+    int level = kMinSampleLevel;    // 生成该候选的八叉树层级
+    size_t evaluated = 0;           // 已计数的评分前缀长度
+    size_t valid = 0;               // 前缀中未移除的点数
+    size_t hits = 0;                // 前缀中的兼容点数
+    bool exact = false;             // 已在全部剩余点上精确评估（含连通性过滤）
+    std::vector<quint32> inliers;   // 精确评估得到的内点
+
+    double scale(size_t remaining) const
+    {
+        return valid > 0 ? static_cast<double>(remaining) / valid : static_cast<double>(remaining);
+    }
+
+    double estimate(size_t remaining) const
+    {
+        return exact ? static_cast<double>(inliers.size()) : hits * scale(remaining);
+    }
+
+    double lowerBound(size_t remaining) const
+    {
+        if (exact) {
+            return static_cast<double>(inliers.size());
+        }
+        double h = static_cast<double>(hits);
+        return std::max(0.0, h - 2.0 * std::sqrt(h)) * scale(remaining);
+    }
+
+    double upperBound(size_t remaining) const
+    {
+        if (exact) {
+            return static_cast<double>(inliers.size());
+        }
+        double h = static_cast<double>(hits);
+        return (h + 2.0 * std::sqrt(h) + 1.0) * scale(remaining);
+    }
+    // 得分已足够确定，继续细化无助于区分
+    bool settled(size_t prefixSize) const
+    {
+        return exact || evaluated >= prefixSize || hits >= kPreciseHits;
+    }
+};
+
+inline quint32 spreadBits(quint32 value)
+{
+    value &= 0x3ff;
+    value = (value | (value << 16)) & 0x030000ff;
+    value = (value | (value << 8)) & 0x0300f00f;
+    value = (value | (value << 4)) & 0x030c30c3;
+    value = (value | (value << 2)) & 0x09249249;
+    return value;
+}
+
+/**
+ * @brief 栅格单元并查集的查找（路径减半）
+ */
+inline size_t findRoot(std::vector<size_t>& parent, size_t i)
+{
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+/**
+ * @brief 连通性过滤：内点投影到平面栅格化，返回最大8连通分量中的点
+ */
+std::vector<quint32> largestConnectedComponent(const std::vector<QVector3D>& points,
+                                               const std::vector<quint32>& inliers,
+                                               const QVector3D& normal, float cellSize)
+{
+    if (cellSize <= 0.0f || inliers.size() < 2) {
+        return inliers;
+    }
+
+    // 平面内坐标轴：竖直墙面取水平方向和Z轴
+    QVector3D u = std::fabs(normal.z()) < 0.9f ? QVector3D::crossProduct(QVector3D(0, 0, 1), normal)
+                                              : QVector3D::crossProduct(normal, QVector3D(1, 0, 0));
+    u.normalize();
+    QVector3D v = QVector3D::crossProduct(normal, u).normalized();
+
+    // 单元坐标截断到±2^31后加偏移转为无符号，两轴各占32位打包成键
+    const double inverseCell = 1.0 / cellSize;
+    const qint64 bias = qint64(1) << 31;
+    auto packCell = [bias](qint64 cu, qint64 cv) -> quint64 {
+        return (static_cast<quint64>(cu + bias) << 32) | static_cast<quint64>(cv + bias);
+    };
+    auto cellCoordinate = [&](float value) {
+        return qBound<qint64>(-bias + 1, static_cast<qint64>(std::floor(value * inverseCell)), bias - 2);
+    };
+
+    std::vector<std::pair<quint64, quint32>> keyed(inliers.size());
+    parallelFor(0, inliers.size(), [&](size_t i) {
+        const QVector3D& p = points[inliers[i]];
+        keyed[i] = {packCell(cellCoordinate(QVector3D::dotProduct(p, u)), cellCoordinate(QVector3D::dotProduct(p, v))),
+                    inliers[i]};
+    }, kMinPointsPerRange);
+    std::sort(keyed.begin(), keyed.end());
+
+    std::vector<quint64> cells;
+    std::vector<size_t> cellStart;
+    for (size_t i = 0; i < keyed.size(); ++i) {
+        if (i == 0 || keyed[i].first != keyed[i - 1].first) {
+            cells.push_back(keyed[i].first);
+            cellStart.push_back(i);
+        }
+    }
+    cellStart.push_back(keyed.size());
+
+    std::vector<size_t> parent(cells.size());
+    std::iota(parent.begin(), parent.end(), size_t(0));
+    for (size_t c = 0; c < cells.size(); ++c) {
+        qint64 cu = static_cast<qint64>(cells[c] >> 32) - bias;
+        qint64 cv = static_cast<qint64>(cells[c] & 0xffffffffULL) - bias;
+        // 只查找"后方"四个邻居，每对相邻单元合并一次
+        const qint64 offsets[4][2] = {{0, 1}, {1, -1}, {1, 0}, {1, 1}};
+        for (const auto& offset : offsets) {
+            quint64 key = packCell(cu + offset[0], cv + offset[1]);
+            auto it = std::lower_bound(cells.begin(), cells.end(), key);
+            if (it != cells.end() && *it == key) {
+                size_t a = findRoot(parent, c);
+                size_t b = findRoot(parent, static_cast<size_t>(it - cells.begin()));
+                if (a != b) {
+                    parent[b] = a;
+                }
+            }
+        }
+    }
+
+    std::vector<size_t> componentSize(cells.size(), 0);
+    for (size_t c = 0; c < cells.size(); ++c) {
+        componentSize[findRoot(parent, c)] += cellStart[c + 1] - cellStart[c];
+    }
+    size_t bestRoot = static_cast<size_t>(std::max_element(componentSize.begin(), componentSize.end()) -
+                                          componentSize.begin());
+
+    std::vector<quint32> component;
+    component.reserve(componentSize[bestRoot]);
+    for (size_t c = 0; c < cells.size(); ++c) {
+        if (findRoot(parent, c) == bestRoot) {
+            for (size_t i = cellStart[c]; i < cellStart[c + 1]; ++i) {
+                component.push_back(keyed[i].second);
+            }
+        }
+    }
+    std::sort(component.begin(), component.end());
+    return component;
+}
+
+} // namespace
+
+EfficientRANSAC::EfficientRANSAC(const RANSACParameters& parameters)
+    : m_parameters(parameters)
+{
+}
+
+void EfficientRANSAC::setParameters(const RANSACParameters& parameters)
+{
+    m_parameters = parameters;
+}
+
+RANSACParameters EfficientRANSAC::getParameters() const
+{
+    return m_parameters;
+}
+
+void EfficientRANSAC::setProgressCallback(std::function<void(int)> callback)
+{
+    m_progressCallback = callback;
+}
+
+void EfficientRANSAC::setPlaneCallback(std::function<void(const Plane3D&)> callback)
+{
+    m_planeCallback = callback;
+}
+
+void EfficientRANSAC::setCancellationCallback(std::function<bool()> callback)
+{
+    m_cancellationCallback = callback;
+}
+
+QVariantMap EfficientRANSAC::getStatistics() const
+{
+    return m_statistics;
+}
+
+std::vector<QVector3D> EfficientRANSAC::estimateNormals(const std::vector<QVector3D>& points, int neighborCount)
+{
+    const size_t k = static_cast<size_t>(std::max(3, neighborCount));
+    if (points.size() < k) {
+        return std::vector<QVector3D>(points.size());
+    }
+
+    PointKDTree tree(points);
+    return computePointNormals(points, tree, neighborCount);
+}
+
+std::vector<Plane3D> EfficientRANSAC::detect(const std::vector<QVector3D>& points,
+                                             const std::vector<QVector3D>& inputNormals)
+{
+    std::vector<Plane3D> planes;
+    m_statistics.clear();
+
+    QElapsedTimer timer;
+    timer.start();
+
+    const size_t minPoints = static_cast<size_t>(std::max(3, m_parameters.minPoints));
+    if (points.size() < minPoints || points.size() > std::numeric_limits<quint32>::max()) {
+        return planes;
+    }
+
+    std::vector<QVector3D> estimatedNormals;
+    if (inputNormals.size() != points.size()) {
+        estimatedNormals = estimateNormals(points, kNormalNeighbors);
+    }
+    const std::vector<QVector3D>& normals = inputNormals.size() == points.size() ? inputNormals : estimatedNormals;
+    const qint64 normalTime = timer.elapsed();
+
+    PointCloudBounds bounds = computePointCloudBounds(points);
+    if (!bounds.isValid()) {
+        return planes;
+    }
+    const QVector3D extent = bounds.size();
+    const float cubeSize = std::max({extent.x(), extent.y(), extent.z(), 1e-6f});
+    const float cellScale = static_cast<float>(1 << kOctreeDepth) / cubeSize;
+
+    // 参与检测的点：坐标有限且有法向量
+    std::vector<char> removed(points.size(), 1);
+    parallelFor(0, points.size(), [&](size_t i) {
+        const QVector3D& p = points[i];
+        removed[i] = !(std::isfinite(p.x()) && std::isfinite(p.y()) && std::isfinite(p.z()) &&
+                       normals[i].lengthSquared() > 0.5f);
+    }, kMinPointsPerRange);
+
+    std::vector<quint32> codes(points.size(), 0);
+    parallelFor(0, points.size(), [&](size_t i) {
+        if (removed[i]) {
+            return;
+        }
+        QVector3D q = (points[i] - bounds.minPoint) * cellScale;
+        const quint32 maxCell = (1u << kOctreeDepth) - 1;
+        quint32 x = std::min(maxCell, static_cast<quint32>(std::max(0.0f, q.x())));
+        quint32 y = std::min(maxCell, static_cast<quint32>(std::max(0.0f, q.y())));
+        quint32 z = std::min(maxCell, static_cast<quint32>(std::max(0.0f, q.z())));
+        codes[i] = spreadBits(x) | (spreadBits(y) << 1) | (spreadBits(z) << 2);
+    }, kMinPointsPerRange);
+
+    // 八叉树顺序（采样用）和随机顺序（评分用）的剩余点数组
+    std::vector<quint32> octreeOrder;
+    octreeOrder.reserve(points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        if (!removed[i]) {
+            octreeOrder.push_back(static_cast<quint32>(i));
+        }
+    }
+    std::sort(octreeOrder.begin(), octreeOrder.end(), [&codes](quint32 a, quint32 b) {
+        return codes[a] < codes[b] || (codes[a] == codes[b] && a < b);
+    });
+    std::vector<quint32> octreeCodes(octreeOrder.size());
+    for (size_t i = 0; i < octreeOrder.size(); ++i) {
+        octreeCodes[i] = codes[octreeOrder[i]];
+    }
+    std::vector<quint32>().swap(codes);
+
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::vector<quint32> scoringOrder = octreeOrder;
+    std::shuffle(scoringOrder.begin(), scoringOrder.end(), gen);
+
+    const size_t totalPoints = octreeOrder.size();
+    if (totalPoints < minPoints) {
+        return planes;
+    }
+    size_t remaining = totalPoints;
+    size_t staleEntries = 0;
+
+    const float epsilon = m_parameters.epsilon;
+    const float normalThreshold = m_parameters.normalThreshold;
+    auto isCompatible = [&](const Candidate& c, quint32 index) {
+        return std::fabs(QVector3D::dotProduct(c.normal, points[index]) - c.d) <= epsilon &&
+               std::fabs(QVector3D::dotProduct(c.normal, normals[index])) >= normalThreshold;
+    };
+
+    // 在评分前缀上扩展计数到newEnd
+    auto refine = [&](Candidate& c, size_t newEnd) {
+        newEnd = std::min(newEnd, scoringOrder.size());
+        if (newEnd <= c.evaluated) {
+            return;
+        }
+        std::vector<size_t> rangeValid(parallelRangeCount(newEnd - c.evaluated, kMinPointsPerRange), 0);
+        std::vector<size_t> rangeHits(rangeValid.size(), 0);
+        parallelForRange(c.evaluated, newEnd, [&](size_t begin, size_t end, size_t range) {
+            size_t valid = 0;
+            size_t hits = 0;
+            for (size_t i = begin; i < end; ++i) {
+                quint32 index = scoringOrder[i];
+                if (removed[index]) {
+                    continue;
+                }
+                ++valid;
+                hits += isCompatible(c, index) ? 1 : 0;
+            }
+            rangeValid[range] = valid;
+            rangeHits[range] = hits;
+        }, kMinPointsPerRange);
+        c.valid += std::accumulate(rangeValid.begin(), rangeValid.end(), size_t(0));
+        c.hits += std::accumulate(rangeHits.begin(), rangeHits.end(), size_t(0));
+        c.evaluated = newEnd;
+    };
+
+    // 精确评估：全部剩余点中的兼容点，再做连通性过滤
+    auto evaluateExact = [&](Candidate& c) {
+        std::vector<std::vector<quint32>> rangeInliers(parallelRangeCount(octreeOrder.size(), kMinPointsPerRange));
+        parallelForRange(0, octreeOrder.size(), [&](size_t begin, size_t end, size_t range) {
+            for (size_t i = begin; i < end; ++i) {
+                quint32 index = octreeOrder[i];
+                if (!removed[index] && isCompatible(c, index)) {
+                    rangeInliers[range].push_back(index);
+                }
+            }
+        }, kMinPointsPerRange);
+        std::vector<quint32> inliers;
+        for (const auto& local : rangeInliers) {
+            inliers.insert(inliers.end(), local.begin(), local.end());
+        }
+        c.inliers = largestConnectedComponent(points, inliers, c.normal, m_parameters.clusterEpsilon);
+        c.exact = true;
+    };
+
+    // 法向一致且偏移相差不超过2ε的候选视为同一平面
+    auto isSamePlane = [&](const Candidate& a, const Candidate& b) {
+        float cosine = QVector3D::dotProduct(a.normal, b.normal);
+        float offset = cosine >= 0.0f ? b.d : -b.d;
+        return std::fabs(cosine) >= normalThreshold && std::fabs(a.d - offset) <= 2.0f * epsilon;
+    };
+
+    auto resetScore = [&](Candidate& c) {
+        c.evaluated = 0;
+        c.valid = 0;
+        c.hits = 0;
+        c.exact = false;
+        c.inliers.clear();
+        refine(c, kFirstSubsetSize);
+    };
+
+    // 各层级的采样得分，初始均匀
+    const int levelCount = kOctreeDepth - kMinSampleLevel + 1;
+    std::vector<double> levelScore(levelCount, 1.0);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    auto sampleLevel = [&]() {
+        double total = std::accumulate(levelScore.begin(), levelScore.end(), 0.0);
+        double r = unit(gen);
+        for (int l = 0; l < levelCount; ++l) {
+            r -= 0.9 * levelScore[l] / total + 0.1 / levelCount;
+            if (r <= 0.0) {
+                return kMinSampleLevel + l;
+            }
+        }
+        return kOctreeDepth;
+    };
+
+    // 在八叉树单元内采样3个点生成候选
+    auto drawCandidate = [&](Candidate& c) {
+        std::uniform_int_distribution<size_t> anyPosition(0, octreeOrder.size() - 1);
+        size_t first = anyPosition(gen);
+        quint32 i1 = octreeOrder[first];
+        if (removed[i1]) {
+            return false;
+        }
+
+        c.level = sampleLevel();
+        const int shift = 3 * (kOctreeDepth - c.level);
+        const quint32 prefix = octreeCodes[first] >> shift;
+        auto cellBegin = std::lower_bound(octreeCodes.begin(), octreeCodes.end(), prefix << shift);
+        auto cellEnd = std::lower_bound(cellBegin, octreeCodes.end(), (prefix + 1) << shift);
+        size_t begin = static_cast<size_t>(cellBegin - octreeCodes.begin());
+        size_t end = static_cast<size_t>(cellEnd - octreeCodes.begin());
+        if (end - begin < 3) {
+            return false;
+        }
+
+        std::uniform_int_distribution<size_t> inCell(begin, end - 1);
+        quint32 samples[3] = {i1, 0, 0};
+        for (int s = 1; s < 3; ++s) {
+            bool found = false;
+            for (int retry = 0; retry < kMaxSampleRetries && !found; ++retry) {
+                quint32 index = octreeOrder[inCell(gen)];
+                found = !removed[index] && index != samples[0] && (s == 1 || index != samples[1]);
+                samples[s] = index;
+            }
+            if (!found) {
+                return false;
+            }
+        }
+
+        const QVector3D& p1 = points[samples[0]];
+        QVector3D normal = QVector3D::crossProduct(points[samples[1]] - p1, points[samples[2]] - p1);
+        if (normal.length() < 1e-9f) {
+            return false;
+        }
+        normal.normalize();
+
+        // 样本点法向量须与平面法向一致
+        for (quint32 index : samples) {
+            if (std::fabs(QVector3D::dotProduct(normal, normals[index])) < normalThreshold) {
+                return false;
+            }
+        }
+
+        c.normal = normal;
+        c.d = QVector3D::dotProduct(normal, p1);
+        return true;
+    };
+
+    const double logFailure = std::log(1.0 - std::clamp(static_cast<double>(m_parameters.probability), 0.5, 0.999999));
+    const size_t drawBudget = static_cast<size_t>(std::max(1000, m_parameters.maxIterations)) * 20;
+    // 局部采样下大小为n的平面被一次抽中的概率下界 n / (R · 层数 · 2^(k-1))，k=3
+    auto detectionProbabilityMet = [&](double n, size_t draws) {
+        double p = n / (static_cast<double>(remaining) * levelCount * 4.0);
+        if (p >= 1.0) {
+            return true;
+        }
+        return p > 0.0 && draws * std::log1p(-p) <= logFailure;
+    };
+
+    std::vector<Candidate> pool;
+    size_t drawsSinceExtraction = 0;
+    size_t totalDraws = 0;
+
+    while (remaining >= minPoints && !(m_cancellationCallback && m_cancellationCallback())) {
+        // 1. 生成一批候选并在首级子集上评分
+        std::vector<Candidate> batch;
+        batch.reserve(kCandidatesPerBatch);
+        for (size_t draw = 0; draw < kCandidatesPerBatch; ++draw) {
+            Candidate c;
+            if (drawCandidate(c)) {
+                batch.push_back(std::move(c));
+            }
+        }
+        drawsSinceExtraction += kCandidatesPerBatch;
+        totalDraws += kCandidatesPerBatch;
+
+        parallelFor(0, batch.size(), [&](size_t i) {
+            refine(batch[i], kFirstSubsetSize);
+        }, 1);
+        for (Candidate& c : batch) {
+            pool.push_back(std::move(c));
+        }
+        if (pool.size() > kMaxCandidatePool) {
+            std::sort(pool.begin(), pool.end(), [&](const Candidate& a, const Candidate& b) {
+                return a.estimate(remaining) > b.estimate(remaining);
+            });
+            pool.resize(kMaxCandidatePool);
+        }
+        if (pool.empty()) {
+            if (drawsSinceExtraction >= drawBudget) {
+                break;
+            }
+            continue;
+        }
+
+        // 2. 最优候选与其他平面的候选置信区间重叠时逐级加倍评分子集
+        //    （同一平面的重复候选不构成竞争，不必细化；最优候选尚不可能提取时也不必细化）
+        const bool budgetExhausted = drawsSinceExtraction >= drawBudget;
+        size_t best = 0;
+        while (true) {
+            best = 0;
+            for (size_t i = 1; i < pool.size(); ++i) {
+                if (pool[i].estimate(remaining) > pool[best].estimate(remaining)) {
+                    best = i;
+                }
+            }
+            double bestUpper = pool[best].upperBound(remaining);
+            if (bestUpper < minPoints || (!budgetExhausted && !detectionProbabilityMet(bestUpper, drawsSinceExtraction))) {
+                break;
+            }
+            size_t rival = pool.size();
+            for (size_t i = 0; i < pool.size(); ++i) {
+                if (i != best && !isSamePlane(pool[i], pool[best]) &&
+                    pool[i].upperBound(remaining) > pool[best].lowerBound(remaining) &&
+                    (rival == pool.size() || pool[i].upperBound(remaining) > pool[rival].upperBound(remaining))) {
+                    rival = i;
+                }
+            }
+            bool bestDone = pool[best].settled(scoringOrder.size());
+            bool rivalDone = rival == pool.size() || pool[rival].settled(scoringOrder.size());
+            if (rival == pool.size() || (bestDone && rivalDone)) {
+                break;
+            }
+            if (!bestDone) {
+                refine(pool[best], std::max(kFirstSubsetSize, pool[best].evaluated * 2));
+            }
+            if (!rivalDone) {
+                refine(pool[rival], std::max(kFirstSubsetSize, pool[rival].evaluated * 2));
+            }
+        }
+
+        // 3. 达到检测概率（或采样预算用尽）时提取最优候选
+        bool extract = false;
+        while (!pool.empty()) {
+            best = 0;
+            for (size_t i = 1; i < pool.size(); ++i) {
+                if (pool[i].estimate(remaining) > pool[best].estimate(remaining)) {
+                    best = i;
+                }
+            }
+            if (pool[best].upperBound(remaining) < minPoints ||
+                (!budgetExhausted && !detectionProbabilityMet(pool[best].lowerBound(remaining), drawsSinceExtraction))) {
+                break;
+            }
+
+            // 子集得分偶然偏高的候选先细化，确认可能达到minPoints后才做全量评估
+            Candidate& candidate = pool[best];
+            while (!candidate.settled(scoringOrder.size()) && candidate.lowerBound(remaining) < minPoints &&
+                   candidate.upperBound(remaining) >= minPoints) {
+                refine(candidate, std::max(kFirstSubsetSize, candidate.evaluated * 2));
+            }
+            if (candidate.upperBound(remaining) < minPoints) {
+                pool.erase(pool.begin() + best);
+                continue;
+            }
+
+            if (!pool[best].exact) {
+                evaluateExact(pool[best]);
+            }
+            if (pool[best].inliers.size() < minPoints) {
+                pool.erase(pool.begin() + best);
+                continue;
+            }
+
+            // 精确得分（已做连通性过滤）明显低于其他平面的候选时，留待下一轮比较
+            double rivalLower = 0.0;
+            for (size_t i = 0; i < pool.size(); ++i) {
+                if (i != best && !isSamePlane(pool[i], pool[best])) {
+                    rivalLower = std::max(rivalLower, pool[i].lowerBound(remaining));
+                }
+            }
+            extract = budgetExhausted || pool[best].inliers.size() >= rivalLower;
+            break;
+        }
+        if (!extract) {
+            if (budgetExhausted) {
+                break;      // 预算内没有可提取的平面
+            }
+            continue;
+        }
+
+        // 提取：PCA精化并移除内点
+        Candidate extracted = std::move(pool[best]);
+        pool.erase(pool.begin() + best);
+        pool.erase(std::remove_if(pool.begin(), pool.end(), [&](const Candidate& c) {
+            return isSamePlane(c, extracted);
+        }), pool.end());
+
+        QVector3D centroid;
+        SymmetricEigen3 eigen = computeSymmetricEigen3(computeCovariance(points, extracted.inliers, centroid));
+        QVector3D normal = eigen.eigenvectors[2];
+        if (normal.isNull()) {
+            normal = extracted.normal;
+        } else if (QVector3D::dotProduct(normal, extracted.normal) < 0.0f) {
+            normal = -normal;
+        }
+
+        Plane3D plane;
+        plane.point = centroid;
+        plane.normal = normal;
+        plane.distance = QVector3D::dotProduct(normal, centroid);
+        plane.inlierIndices.assign(extracted.inliers.begin(), extracted.inliers.end());
+        plane.confidence = static_cast<float>(extracted.inliers.size()) / totalPoints;
+        planes.push_back(std::move(plane));
+        if (m_planeCallback) {
+            m_planeCallback(planes.back());
+        }
+
+        for (quint32 index : extracted.inliers) {
+            removed[index] = 1;
+        }
+        remaining -= extracted.inliers.size();
+        staleEntries += extracted.inliers.size();
+        levelScore[extracted.level - kMinSampleLevel] += static_cast<double>(extracted.inliers.size()) / totalPoints;
+        drawsSinceExtraction = 0;
+
+        if (m_progressCallback) {
+            m_progressCallback(static_cast<int>(100 * (totalPoints - remaining) / totalPoints));
+        }
+
+        // 已移除的点较多时压缩剩余点数组（保持各自顺序）
+        if (staleEntries > kCompactRatio * octreeOrder.size()) {
+            size_t write = 0;
+            for (size_t i = 0; i < octreeOrder.size(); ++i) {
+                if (!removed[octreeOrder[i]]) {
+                    octreeOrder[write] = octreeOrder[i];
+                    octreeCodes[write] = octreeCodes[i];
+                    ++write;
+                }
+            }
+            octreeOrder.resize(write);
+            octreeCodes.resize(write);
+            scoringOrder.erase(std::remove_if(scoringOrder.begin(), scoringOrder.end(),
+                                              [&removed](quint32 index) { return removed[index] != 0; }),
+                               scoringOrder.end());
+            staleEntries = 0;
+        }
+        if (octreeOrder.empty()) {
+            break;
+        }
+
+        // 内点移除后候选得分失效，重新在首级子集上评分并淘汰不可能达标的候选
+        parallelFor(0, pool.size(), [&](size_t i) {
+            resetScore(pool[i]);
+        }, 1);
+        pool.erase(std::remove_if(pool.begin(), pool.end(), [&](const Candidate& c) {
+            return c.upperBound(remaining) < minPoints;
+        }), pool.end());
+    }
+
+    m_statistics["candidates_generated"] = static_cast<qulonglong>(totalDraws);
+    m_statistics["planes_detected"] = static_cast<int>(planes.size());
+    m_statistics["assigned_points"] = static_cast<qulonglong>(totalPoints - remaining);
+    m_statistics["remaining_points"] = static_cast<qulonglong>(remaining);
+    m_statistics["normal_estimation_ms"] = normalTime;
+    m_statistics["detection_ms"] = timer.elapsed() - normalTime;
+    return planes;
+}
+
+} // namespace WallExtraction
@@ -0,0 +1,85 @@
+#ifndef EFFICIENT_RANSAC_H
+#define EFFICIENT_RANSAC_H
+
+#include <QVector3D>
+#include <QVariantMap>
+#include <functional>
+#include <vector>
+#include "wall_fitting_algorithm.h"
+
+namespace WallExtraction {
+
+/**
+ * @brief 高效RANSAC多平面检测引擎（Schnabel等, 2007）
+ *
+ * 与逐个平面重复运行RANSAC相比：
+ * - 采样局部化：点按八叉树（Morton码）排序，后两个样本点取自第一个点所在的八叉树单元，
+ *   单元层级按各层历史得分自适应选择；
+ * - 法向一致性：样本点和内点的法向量都必须与候选平面法向一致（normalThreshold）；
+ * - 分级评分：候选平面先在剩余点随机排列的前缀子集上计数，置信区间重叠时逐级加倍子集；
+ * - 连通性过滤：内点投影到平面后按clusterEpsilon栅格化，只保留最大连通分量；
+ * - 增量移除：提取平面后仅标记其内点，候选池重新评分，不重建点集。
+ *
+ * 候选数满足 1-(1-P(n))^t ≥ probability 时提取当前最优平面，
+ * 直到剩余点数不足minPoints或长时间没有可提取的平面。
+ */
+class EfficientRANSAC
+{
+public:
+    explicit EfficientRANSAC(const RANSACParameters& parameters = RANSACParameters());
+
+    void setParameters(const RANSACParameters& parameters);
+    RANSACParameters getParameters() const;
+
+    /**
+     * @brief 设置进度回调
+     * @param callback 回调 callback(已分配点的百分比)
+     */
+    void setProgressCallback(std::function<void(int)> callback);
+
+    /**
+     * @brief 设置平面回调，每提取一个平面调用一次（在检测线程中）
+     * @param callback 回调 callback(平面)
+     */
+    void setPlaneCallback(std::function<void(const Plane3D&)> callback);
+
+    /**
+     * @brief 设置取消检查，返回true时在下一批候选之前停止，返回已提取的平面
+     * @param callback 取消检查回调
+     */
+    void setCancellationCallback(std::function<bool()> callback);
+
+    /**
+     * @brief 检测平面
+     * @param points 点云数据
+     * @param normals 点法向量（为空时按K近邻PCA估计）
+     * @return 检测到的平面，按提取顺序排列，内点互不重叠
+     */
+    std::vector<Plane3D> detect(const std::vector<QVector3D>& points,
+                                const std::vector<QVector3D>& normals = std::vector<QVector3D>());
+
+    /**
+     * @brief 获取上一次检测的统计信息
+     * @return 统计信息（candidates_generated、planes_detected等）
+     */
+    QVariantMap getStatistics() const;
+
+    /**
+     * @brief 按K近邻PCA估计法向量（并行）
+     * @param points 点云数据
+     * @param neighborCount 邻居数量
+     * @return 单位法向量，邻居不足的点为零向量
+     */
+    static std::vector<QVector3D> estimateNormals(const std::vector<QVector3D>& points, int neighborCount);
+
+private:
+    RANSACParameters m_parameters;
+    std::function<void(int)> m_progressCallback;
+    std::function<void(const Plane3D&)> m_planeCallback;
+    std::function<bool()> m_cancellationCallback;
+    QVariantMap m_statistics;
+};
+
+} // namespace WallExtraction
+
+#endif // EFFICIENT_RANSAC_H
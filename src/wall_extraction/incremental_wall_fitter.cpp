@@ -0,0 +1,480 @@
+#include "incremental_wall_fitter.h"
+#include "parallel_utils.h"
+#include "spatial_index.h"
+#include <QElapsedTimer>
+#include <QMutexLocker>
+#include <QVector2D>
+
+namespace WallExtraction {
+
+namespace {
+
+inline bool sameGeometry(const LineSegment& a, const LineSegment& b)
+{
+    return a.startPoint == b.startPoint && a.endPoint == b.endPoint;
+}
+
+} // namespace
+
+IncrementalWallFitter::IncrementalWallFitter(QObject* parent)
+    : QObject(parent)
+    , m_workerActive(false)
+    , m_algorithm(std::make_unique<WallFittingAlgorithm>())
+    , m_generation(0)
+{
+    // 单个工作线程，线段之间的并行在批内完成
+    m_pool.setMaxThreadCount(1);
+}
+
+IncrementalWallFitter::~IncrementalWallFitter()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        ++m_generation;
+        m_dirtyLines.clear();
+        m_pendingJoins.clear();
+    }
+    m_pool.waitForDone();
+}
+
+void IncrementalWallFitter::setParameters(const RANSACParameters& parameters)
+{
+    QMutexLocker locker(&m_mutex);
+    m_parameters = parameters;
+    ++m_generation;
+    invalidateAll(true);
+    scheduleUpdate();
+}
+
+RANSACParameters IncrementalWallFitter::getParameters() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_parameters;
+}
+
+void IncrementalWallFitter::setPointCloud(std::shared_ptr<const std::vector<QVector3D>> points)
+{
+    QMutexLocker locker(&m_mutex);
+    m_points = std::move(points);
+    m_grid.reset();
+    ++m_generation;
+    invalidateAll(false);
+    scheduleUpdate();
+}
+
+void IncrementalWallFitter::setPointCloud(const std::vector<QVector3D>& points)
+{
+    setPointCloud(std::make_shared<const std::vector<QVector3D>>(points));
+}
+
+void IncrementalWallFitter::setRegularizationOptions(const WallRegularizationOptions& options)
+{
+    QMutexLocker locker(&m_mutex);
+    m_regularizationOptions = options;
+    for (const auto& item : m_lines) {
+        m_pendingJoins.insert(item.first);
+    }
+    scheduleUpdate();
+}
+
+WallRegularizationOptions IncrementalWallFitter::getRegularizationOptions() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_regularizationOptions;
+}
+
+void IncrementalWallFitter::seedWalls(std::shared_ptr<const std::vector<QVector3D>> points,
+                                      const RANSACParameters& parameters,
+                                      const std::vector<LineSegment>& lines,
+                                      const std::vector<WallSegment>& walls)
+{
+    QMutexLocker locker(&m_mutex);
+    m_points = std::move(points);
+    m_grid.reset();
+    m_parameters = parameters;
+    ++m_generation;
+    m_lines.clear();
+    m_dirtyLines.clear();
+    m_pendingJoins.clear();
+    for (const LineSegment& line : lines) {
+        applyLine(line);
+    }
+
+    // 只来自一条线段的墙面即该线段的拟合结果（已求交，再次求交不变）；
+    // 合并过的墙面无法还原各线段的结果，这些线段保留在待更新集合中重新拟合
+    std::map<int, const WallSegment*> wallByLine;
+    std::set<int> mergedLines;
+    for (const WallSegment& wall : walls) {
+        for (int segmentId : wall.sourceLineIds) {
+            if (wall.sourceLineIds.size() == 1) {
+                wallByLine[segmentId] = &wall;
+            } else {
+                mergedLines.insert(segmentId);
+            }
+        }
+    }
+    for (auto& item : m_lines) {
+        if (mergedLines.count(item.first)) {
+            continue;
+        }
+        const auto wall = wallByLine.find(item.first);
+        item.second.hasWall = wall != wallByLine.end();
+        item.second.seeded = item.second.hasWall;
+        if (item.second.hasWall) {
+            item.second.rawWall = *wall->second;
+        }
+        m_dirtyLines.erase(item.first);
+    }
+    scheduleUpdate();
+}
+
+bool IncrementalWallFitter::hasPointCloud() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_points != nullptr;
+}
+
+void IncrementalWallFitter::setLines(const std::vector<LineSegment>& lines)
+{
+    QMutexLocker locker(&m_mutex);
+
+    std::set<int> present;
+    for (const LineSegment& line : lines) {
+        present.insert(line.id);
+    }
+    std::vector<int> removed;
+    for (const auto& item : m_lines) {
+        if (!present.count(item.first)) {
+            removed.push_back(item.first);
+        }
+    }
+    for (int segmentId : removed) {
+        eraseLine(segmentId);
+    }
+    for (const LineSegment& line : lines) {
+        applyLine(line);
+    }
+    scheduleUpdate();
+}
+
+void IncrementalWallFitter::clear()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        ++m_generation;
+        m_lines.clear();
+        m_dirtyLines.clear();
+        m_pendingJoins.clear();
+        m_points.reset();
+        m_grid.reset();
+        m_walls.clear();
+        m_statistics.clear();
+    }
+    emit wallsUpdated(std::vector<WallSegment>());
+}
+
+std::vector<WallSegment> IncrementalWallFitter::getWalls() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_walls;
+}
+
+bool IncrementalWallFitter::isBusy() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_workerActive;
+}
+
+bool IncrementalWallFitter::waitForDone(int msecs)
+{
+    return m_pool.waitForDone(msecs);
+}
+
+QVariantMap IncrementalWallFitter::getStatistics() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_statistics;
+}
+
+void IncrementalWallFitter::onLineSegmentAdded(const LineSegment& segment)
+{
+    QMutexLocker locker(&m_mutex);
+    if (applyLine(segment)) {
+        scheduleUpdate();
+    }
+}
+
+void IncrementalWallFitter::onLineSegmentRemoved(int segmentId)
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_lines.count(segmentId)) {
+        eraseLine(segmentId);
+        scheduleUpdate();
+    }
+}
+
+void IncrementalWallFitter::onLineSegmentUpdated(int segmentId, const LineSegment& segment)
+{
+    LineSegment line = segment;
+    line.id = segmentId;
+
+    QMutexLocker locker(&m_mutex);
+    if (applyLine(line)) {
+        scheduleUpdate();
+    }
+}
+
+bool IncrementalWallFitter::applyLine(const LineSegment& segment)
+{
+    auto it = m_lines.find(segment.id);
+    if (it != m_lines.end() && sameGeometry(it->second.line, segment)) {
+        it->second.line = segment;     // 只有描述、选中状态等属性变化，墙面不受影响
+        return false;
+    }
+
+    // 新旧邻居的交点都需要重新计算
+    LineEntry& entry = m_lines[segment.id];
+    touchNeighbors(entry.neighbors);
+    unlinkNeighbors(segment.id);
+
+    entry.line = segment;
+    ++entry.revision;
+    entry.corridor.reset();
+    entry.seeded = false;
+    linkNeighbors(segment.id);
+
+    touchNeighbors(entry.neighbors);
+    m_pendingJoins.insert(segment.id);
+    m_dirtyLines.insert(segment.id);
+    return true;
+}
+
+void IncrementalWallFitter::eraseLine(int segmentId)
+{
+    auto it = m_lines.find(segmentId);
+    if (it == m_lines.end()) {
+        return;
+    }
+    touchNeighbors(it->second.neighbors);
+    m_pendingJoins.insert(segmentId);
+    unlinkNeighbors(segmentId);
+    m_lines.erase(segmentId);
+    m_dirtyLines.erase(segmentId);
+}
+
+void IncrementalWallFitter::linkNeighbors(int segmentId)
+{
+    // 线段通常只有数百条，线性扫描即可
+    LineEntry& entry = m_lines.at(segmentId);
+    QVector2D junction;
+    for (auto& item : m_lines) {
+        if (item.first != segmentId &&
+            WallFittingAlgorithm::findLineJunction(entry.line, item.second.line, junction)) {
+            entry.neighbors.insert(item.first);
+            item.second.neighbors.insert(segmentId);
+        }
+    }
+}
+
+void IncrementalWallFitter::unlinkNeighbors(int segmentId)
+{
+    LineEntry& entry = m_lines.at(segmentId);
+    for (int neighborId : entry.neighbors) {
+        auto neighbor = m_lines.find(neighborId);
+        if (neighbor != m_lines.end()) {
+            neighbor->second.neighbors.erase(segmentId);
+        }
+    }
+    entry.neighbors.clear();
+}
+
+void IncrementalWallFitter::invalidateAll(bool keepCorridors)
+{
+    for (auto& item : m_lines) {
+        if (!keepCorridors) {
+            item.second.corridor.reset();
+        }
+        m_dirtyLines.insert(item.first);
+        m_pendingJoins.insert(item.first);
+    }
+}
+
+void IncrementalWallFitter::touchNeighbors(const std::set<int>& neighbors)
+{
+    // 邻居需要重新求交；取自完整拟合结果的墙面端点已移到旧交点，需要重新拟合
+    for (int neighborId : neighbors) {
+        m_pendingJoins.insert(neighborId);
+        auto neighbor = m_lines.find(neighborId);
+        if (neighbor != m_lines.end() && neighbor->second.seeded) {
+            neighbor->second.seeded = false;
+            m_dirtyLines.insert(neighborId);
+        }
+    }
+}
+
+void IncrementalWallFitter::rejoinWall(int segmentId)
+{
+    auto it = m_lines.find(segmentId);
+    if (it == m_lines.end() || !it->second.hasWall) {
+        return;
+    }
+
+    // 与邻居单独拟合的墙面按线段ID顺序求交，与完整拟合的joinWallsAtLineJunctions一致
+    LineEntry& entry = it->second;
+    entry.joinedWall = entry.rawWall;
+    QVector2D junction;
+    for (int neighborId : entry.neighbors) {
+        const LineEntry& neighbor = m_lines.at(neighborId);
+        if (neighbor.hasWall && WallFittingAlgorithm::findLineJunction(entry.line, neighbor.line, junction)) {
+            WallFittingAlgorithm::joinWallEnd(entry.joinedWall, neighbor.rawWall, junction);
+        }
+    }
+}
+
+std::vector<WallSegment> IncrementalWallFitter::collectWalls() const
+{
+    std::vector<WallSegment> walls;
+    for (const auto& item : m_lines) {
+        if (item.second.hasWall) {
+            walls.push_back(item.second.joinedWall);
+            walls.back().id = static_cast<int>(walls.size()) - 1;
+        }
+    }
+    return walls;
+}
+
+void IncrementalWallFitter::scheduleUpdate()
+{
+    if (m_workerActive || !m_points || (m_dirtyLines.empty() && m_pendingJoins.empty())) {
+        return;
+    }
+    m_workerActive = true;
+    m_pool.start([this]() { runWorker(); });
+}
+
+void IncrementalWallFitter::runWorker()
+{
+    struct Task {
+        int segmentId;
+        quint64 revision;
+        LineSegment line;
+        std::shared_ptr<const std::vector<int>> corridor;
+        WallSegment wall;
+        bool hasWall;
+    };
+
+    for (;;) {
+        // 1. 取出当前所有待更新的线段，拖动过程中积累的多次编辑只拟合最新的几何
+        std::vector<Task> tasks;
+        std::shared_ptr<const std::vector<QVector3D>> points;
+        std::shared_ptr<const PointGrid2D> grid;
+        RANSACParameters parameters;
+        WallRegularizationOptions regularization;
+        quint64 generation = 0;
+        {
+            QMutexLocker locker(&m_mutex);
+            if (!m_points || (m_dirtyLines.empty() && m_pendingJoins.empty())) {
+                m_workerActive = false;
+                return;
+            }
+            points = m_points;
+            grid = m_grid;
+            parameters = m_parameters;
+            regularization = m_regularizationOptions;
+            generation = m_generation;
+            for (int segmentId : m_dirtyLines) {
+                const LineEntry& entry = m_lines.at(segmentId);
+                Task task;
+                task.segmentId = segmentId;
+                task.revision = entry.revision;
+                task.line = entry.line;
+                task.corridor = entry.corridor;
+                task.hasWall = false;
+                tasks.push_back(std::move(task));
+            }
+            m_dirtyLines.clear();
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+
+        // 2. 锁外计算：走廊只为几何变化的线段重新查询，栅格索引每个点云只在第一次查询时建一次
+        size_t corridorQueries = 0;
+        for (const Task& task : tasks) {
+            corridorQueries += task.corridor ? 0 : 1;
+        }
+        if (!grid && corridorQueries > 0) {
+            grid = std::make_shared<const PointGrid2D>(*points);
+        }
+        m_algorithm->setRANSACParameters(parameters);
+        m_algorithm->setRegularizationOptions(regularization);
+        parallelFor(0, tasks.size(), [&](size_t i) {
+            Task& task = tasks[i];
+            if (!task.corridor) {
+                task.corridor = std::make_shared<const std::vector<int>>(
+                    m_algorithm->findLineCorridor(*grid, task.line));
+            }
+            task.hasWall = m_algorithm->fitWallAlongLine(*points, task.line, *task.corridor, task.wall);
+        }, 1);
+
+        // 3. 写回：点云或参数已变化时整批作废；线段已删除或再次编辑时丢弃该线段的结果，
+        //    它仍在待更新集合中
+        std::vector<WallSegment> walls;
+        {
+            QMutexLocker locker(&m_mutex);
+            if (!m_grid && grid && m_points == points) {
+                m_grid = grid;
+            }
+            if (generation != m_generation) {
+                continue;
+            }
+
+            size_t refitted = 0;
+            for (Task& task : tasks) {
+                auto it = m_lines.find(task.segmentId);
+                if (it == m_lines.end() || it->second.revision != task.revision) {
+                    continue;
+                }
+                LineEntry& entry = it->second;
+                entry.corridor = task.corridor;
+                entry.rawWall = std::move(task.wall);
+                entry.hasWall = task.hasWall;
+                entry.seeded = false;
+                m_pendingJoins.insert(task.segmentId);
+                m_pendingJoins.insert(entry.neighbors.begin(), entry.neighbors.end());
+                ++refitted;
+            }
+
+            const size_t rejoined = m_pendingJoins.size();
+            for (int segmentId : m_pendingJoins) {
+                rejoinWall(segmentId);
+            }
+            m_pendingJoins.clear();
+
+            walls = collectWalls();
+
+            m_statistics["cached_lines"] = static_cast<int>(m_lines.size());
+            m_statistics["refitted_lines"] = static_cast<int>(refitted);
+            m_statistics["corridor_queries"] = static_cast<int>(corridorQueries);
+            m_statistics["rejoined_walls"] = static_cast<int>(rejoined);
+        }
+
+        // 4. 与完整拟合相同的几何优化（合并平行墙面，按applyToLineFits规则化），锁外执行
+        m_algorithm->optimizeWallGeometry(walls, regularization.applyToLineFits);
+        {
+            QMutexLocker locker(&m_mutex);
+            if (generation != m_generation) {
+                continue;
+            }
+            m_walls = walls;
+            m_statistics["walls"] = static_cast<int>(walls.size());
+            m_statistics["update_ms"] = timer.elapsed();
+        }
+
+        QMetaObject::invokeMethod(this, [this, walls]() {
+            emit wallsUpdated(walls);
+        }, Qt::QueuedConnection);
+    }
+}
+
+} // namespace WallExtraction
@@ -0,0 +1,181 @@
+#ifndef INCREMENTAL_WALL_FITTER_H
+#define INCREMENTAL_WALL_FITTER_H
+
+#include <QObject>
+#include <QMutex>
+#include <QThreadPool>
+#include <QVariantMap>
+#include <QVector3D>
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+#include "line_drawing_tool.h"
+#include "wall_fitting_algorithm.h"
+
+namespace WallExtraction {
+
+class PointGrid2D;
+
+/**
+ * @brief 基于用户线段的增量墙面拟合
+ *
+ * 为每条线段缓存走廊点索引和拟合出的墙面，线段编辑后只重新拟合几何发生变化的线段，
+ * 并重新计算受影响的墙面交点：
+ * - 依赖关系：端点重合的线段互为邻居，线段变化时它的新旧邻居都需要重新求交；
+ * - 走廊缓存：只依赖线段几何和点云，拟合参数变化时保留，只重新拟合平面；
+ * - 后台计算：单个工作线程循环处理待更新的线段，拖动端点产生的连续编辑合并到同一批，
+ *   按版本号丢弃过期结果，每批完成后在主线程发射wallsUpdated；
+ * - 与完整拟合一致：求交规则与WallFittingAlgorithm::joinWallsAtLineJunctions相同，
+ *   发布前同样经过optimizeWallGeometry（合并平行墙面，按applyToLineFits规则化）。
+ */
+class IncrementalWallFitter : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit IncrementalWallFitter(QObject* parent = nullptr);
+    ~IncrementalWallFitter();
+
+    /**
+     * @brief 设置拟合参数，全部墙面重新拟合，走廊缓存保留
+     * @param parameters RANSAC参数
+     */
+    void setParameters(const RANSACParameters& parameters);
+    RANSACParameters getParameters() const;
+
+    /**
+     * @brief 设置点云，全部缓存失效，XY栅格索引在后台构建一次
+     * @param points 共享的点云数据（局部坐标，只读，不复制）
+     */
+    void setPointCloud(std::shared_ptr<const std::vector<QVector3D>> points);
+    void setPointCloud(const std::vector<QVector3D>& points);
+    bool hasPointCloud() const;
+
+    /**
+     * @brief 设置墙面规则化选项，只重新发布墙面，不重新拟合
+     * @param options 规则化选项（applyToLineFits关闭时只合并平行墙面）
+     */
+    void setRegularizationOptions(const WallRegularizationOptions& options);
+    WallRegularizationOptions getRegularizationOptions() const;
+
+    /**
+     * @brief 用一次完整拟合的结果填充缓存，替换全部线段，不重新拟合
+     *
+     * 只来自一条线段的墙面直接作为该线段的缓存结果，没有墙面的线段视为拟合失败；
+     * 由多条线段合并成的墙面无法拆分，对应线段重新拟合。这些墙面已经与邻居求交，
+     * 单独拟合的范围无法还原，之后邻接关系变化时重新拟合。走廊在需要拟合时才查询。
+     *
+     * @param points 拟合使用的共享点云
+     * @param parameters 拟合使用的参数
+     * @param lines 拟合使用的线段
+     * @param walls 拟合结果中的墙面
+     */
+    void seedWalls(std::shared_ptr<const std::vector<QVector3D>> points,
+                   const RANSACParameters& parameters,
+                   const std::vector<LineSegment>& lines,
+                   const std::vector<WallSegment>& walls);
+
+    /**
+     * @brief 与当前的全部线段同步，只有新增、删除和几何变化的线段需要更新
+     * @param lines 全部线段
+     */
+    void setLines(const std::vector<LineSegment>& lines);
+
+    /**
+     * @brief 清除线段、点云和全部缓存
+     */
+    void clear();
+
+    /**
+     * @brief 获取最近一次发布的墙面预览
+     * @return 墙面（按线段ID排序，经过几何优化）
+     */
+    std::vector<WallSegment> getWalls() const;
+
+    /**
+     * @brief 后台是否正在更新
+     */
+    bool isBusy() const;
+
+    /**
+     * @brief 等待后台更新完成
+     * @param msecs 超时时间（毫秒），-1表示一直等待
+     * @return 是否在超时前完成
+     */
+    bool waitForDone(int msecs = -1);
+
+    /**
+     * @brief 获取最近一批更新的统计信息
+     * @return 统计信息（cached_lines、refitted_lines、corridor_queries等）
+     */
+    QVariantMap getStatistics() const;
+
+public slots:
+    void onLineSegmentAdded(const LineSegment& segment);
+    void onLineSegmentRemoved(int segmentId);
+    void onLineSegmentUpdated(int segmentId, const LineSegment& segment);
+
+signals:
+    /**
+     * @brief 墙面预览更新（主线程发射）
+     * @param walls 全部墙面
+     */
+    void wallsUpdated(const std::vector<WallSegment>& walls);
+
+private:
+    // 单条线段的缓存
+    struct LineEntry {
+        LineSegment line;
+        quint64 revision;                               // 几何版本，几何每变化一次加一
+        std::shared_ptr<const std::vector<int>> corridor;   // 走廊内的点索引（为空表示需要重新查询）
+        WallSegment rawWall;                            // 单独拟合的墙面
+        WallSegment joinedWall;                         // 与相邻墙面求交后的墙面
+        bool hasWall;
+        bool seeded;                                    // 墙面取自完整拟合结果（已求交），邻接变化时需重新拟合
+        std::set<int> neighbors;                        // 端点重合的线段ID
+
+        LineEntry() : revision(0), hasWall(false), seeded(false) {}
+    };
+
+    // 以下方法需持有m_mutex
+    bool applyLine(const LineSegment& segment);
+    void eraseLine(int segmentId);
+    void linkNeighbors(int segmentId);
+    void unlinkNeighbors(int segmentId);
+    void invalidateAll(bool keepCorridors);
+    void touchNeighbors(const std::set<int>& neighbors);
+    void rejoinWall(int segmentId);
+    std::vector<WallSegment> collectWalls() const;
+    void scheduleUpdate();
+
+    /**
+     * @brief 工作线程主循环：取出待更新的线段，锁外拟合，写回后发布结果
+     */
+    void runWorker();
+
+private:
+    mutable QMutex m_mutex;
+    QThreadPool m_pool;
+    bool m_workerActive;
+
+    // 仅由工作线程使用
+    std::unique_ptr<WallFittingAlgorithm> m_algorithm;
+
+    RANSACParameters m_parameters;
+    WallRegularizationOptions m_regularizationOptions;
+    std::shared_ptr<const std::vector<QVector3D>> m_points;
+    std::shared_ptr<const PointGrid2D> m_grid;
+    quint64 m_generation;               // 点云或参数变化时加一，之前开始的计算结果作废
+
+    std::map<int, LineEntry> m_lines;
+    std::set<int> m_dirtyLines;         // 需要重新拟合的线段
+    std::set<int> m_pendingJoins;       // 需要重新求交的线段（含已删除的线段，用于触发发布）
+    std::vector<WallSegment> m_walls;   // 最近一次发布的墙面
+
+    QVariantMap m_statistics;
+};
+
+} // namespace WallExtraction
+
+#endif // INCREMENTAL_WALL_FITTER_H
@@ -189,12 +189,51 @@ CoordinateSystemInfo LASReader::parseCoordinateSystem(const QString& filename) c
     return header.coordinateSystem;
 }
 
+CoordinateOrigin LASReader::getCoordinateOrigin(const QString& filename) const
+{
+    return createDecodeTransform(parseHeader(filename)).origin;
+}
+
+void LASReader::setDecodeTransform(const PointDecodeTransform& transform)
+{
+    m_decodeTransform = transform;
+}
+
+PointDecodeTransform LASReader::getDecodeTransform() const
+{
+    return m_decodeTransform;
+}
+
+PointDecodeTransform LASReader::createDecodeTransform(const LASHeader& header) const
+{
+    PointDecodeTransform transform = m_decodeTransform;
+    
+    // 未指定原点时，大坐标（如UTM）以包围盒中心经同一归一化后的位置为原点，
+    // 局部坐标保持毫米级精度；包围盒无效时退化为由首个有效点确定。
+    // 调用方关闭rebase时保持绝对坐标
+    if (transform.rebase && transform.origin.isZero()) {
+        transform.autoOrigin = true;
+        QVector3D center;
+        transform.apply((header.xMin + header.xMax) * 0.5,
+                        (header.yMin + header.yMax) * 0.5,
+                        (header.zMin + header.zMax) * 0.5, center);
+    }
+    
+    if (!transform.origin.isZero()) {
+        qDebug() << "Coordinate origin:" << QString::number(transform.origin.x, 'f', 3)
+                 << QString::number(transform.origin.y, 'f', 3) << QString::number(transform.origin.z, 'f', 3);
+    }
+    
+    return transform;
+}
+
 std::vector<QVector3D> LASReader::readPointCloud(const QString& filename) const
 {
     QElapsedTimer timer;
     timer.start();
     
     LASHeader header = parseHeader(filename);
+    PointDecodeTransform transform = createDecodeTransform(header);
     std::vector<QVector3D> points;
     points.reserve(header.pointCount);
     
@@ -226,7 +265,10 @@ std::vector<QVector3D> LASReader::readPointCloud(const QString& filename) const
         double y = applyScaleAndOffset(rawY, header.yScale, header.yOffset);
         double z = applyScaleAndOffset(rawZ, header.zScale, header.zOffset);
         
-        points.emplace_back(static_cast<float>(x), static_cast<float>(y), static_cast<float>(z));
+        QVector3D local;
+        if (transform.apply(x, y, z, local)) {
+            points.push_back(local);
+        }
         
         // 发送进度信号
         if (i % 10000 == 0) {
@@ -246,6 +288,7 @@ std::vector<QVector3D> LASReader::readPointCloud(const QString& filename) const
 std::vector<PointWithAttributes> LASReader::readPointCloudWithAttributes(const QString& filename) const
 {
     LASHeader header = parseHeader(filename);
+    PointDecodeTransform transform = createDecodeTransform(header);
     std::vector<PointWithAttributes> points;
     points.reserve(header.pointCount);
     
@@ -264,8 +307,10 @@ std::vector<PointWithAttributes> LASReader::readPointCloudWithAttributes(const Q
             throw LASReaderException(QString("Unexpected end of file at point %1").arg(i));
         }
         
-        PointWithAttributes point = parsePointRecord(pointData, header.pointDataRecordFormat, header);
-        points.push_back(point);
+        PointWithAttributes point;
+        if (parsePointRecord(pointData, header.pointDataRecordFormat, header, transform, point)) {
+            points.push_back(point);
+        }
         
         // 发送进度信号
         if (i % 10000 == 0) {
@@ -304,41 +349,59 @@ QVector3D LASReader::transformCoordinates(const QVector3D& point,
                                          CoordinateSystem sourceSystem,
                                          CoordinateSystem targetSystem) const
 {
-    // 简化的坐标转换实现
-    // 实际应用中需要使用专业的坐标转换库如PROJ
-    
     if (sourceSystem == targetSystem) {
         return point;
     }
-    
-    // 这里只是示例转换，实际需要实现完整的坐标转换
-    QVector3D transformed = point;
-    
-    // 简单的偏移转换示例
-    if (sourceSystem == CoordinateSystem::UTM_Zone33N && targetSystem == CoordinateSystem::WGS84) {
-        // UTM到地理坐标的简化转换
-        transformed.setX(point.x() / 100000.0); // 简化的经度转换
-        transformed.setY(point.y() / 100000.0); // 简化的纬度转换
-    }
-    
-    return transformed;
+
+    CoordinateTransformer transformer = createTransformer(sourceSystem, targetSystem);
+    double x = point.x();
+    double y = point.y();
+    double z = point.z();
+    transformer.transform(x, y, z);
+    return QVector3D(static_cast<float>(x), static_cast<float>(y), static_cast<float>(z));
 }
 
 std::vector<QVector3D> LASReader::transformCoordinates(const std::vector<QVector3D>& points,
                                                        CoordinateSystem sourceSystem,
-                                                       CoordinateSystem targetSystem) const
+                                                       CoordinateSystem targetSystem,
+                                                       const CoordinateOrigin& sourceOrigin,
+                                                       CoordinateOrigin* targetOrigin) const
 {
-    std::vector<QVector3D> transformed;
-    transformed.reserve(points.size());
-    
-    for (const auto& point : points) {
-        transformed.push_back(transformCoordinates(point, sourceSystem, targetSystem));
+    if (sourceSystem == targetSystem) {
+        if (targetOrigin) {
+            *targetOrigin = sourceOrigin;
+        }
+        return points;
     }
-    
-    return transformed;
+
+    CoordinateTransformer transformer = createTransformer(sourceSystem, targetSystem);
+    return transformer.transformPoints(points, sourceOrigin, targetOrigin);
 }
 
 // 私有方法实现
+CoordinateTransformer LASReader::createTransformer(CoordinateSystem sourceSystem,
+                                                  CoordinateSystem targetSystem) const
+{
+    auto epsgCode = [](CoordinateSystem system) {
+        switch (system) {
+            case CoordinateSystem::WGS84:
+                return 4326;
+            case CoordinateSystem::UTM_Zone33N:
+                return 32633;
+            case CoordinateSystem::UTM_Zone34N:
+                return 32634;
+            default:
+                return 0;
+        }
+    };
+
+    CoordinateTransformer transformer = CoordinateTransformer::fromEpsg(epsgCode(sourceSystem), epsgCode(targetSystem));
+    if (!transformer.isValid()) {
+        throw LASReaderException("Unsupported coordinate transformation: unknown coordinate system");
+    }
+    return transformer;
+}
+
 bool LASReader::validateLASSignature(const QString& filename) const
 {
     QFile file(filename);
@@ -366,12 +429,12 @@ QByteArray LASReader::readLASHeader(const QString& filename) const
     return header;
 }
 
-PointWithAttributes LASReader::parsePointRecord(const QByteArray& data, 
-                                               quint8 format, 
-                                               const LASHeader& header) const
+bool LASReader::parsePointRecord(const QByteArray& data,
+                                 quint8 format,
+                                 const LASHeader& header,
+                                 PointDecodeTransform& transform,
+                                 PointWithAttributes& point) const
 {
-    PointWithAttributes point;
-    
     // 解析坐标
     qint32 rawX = *reinterpret_cast<const qint32*>(data.data() + 0);
     qint32 rawY = *reinterpret_cast<const qint32*>(data.data() + 4);
@@ -381,7 +444,10 @@ PointWithAttributes LASReader::parsePointRecord(const QByteArray& data,
     double y = applyScaleAndOffset(rawY, header.yScale, header.yOffset);
     double z = applyScaleAndOffset(rawZ, header.zScale, header.zOffset);
     
-    point.position = QVector3D(static_cast<float>(x), static_cast<float>(y), static_cast<float>(z));
+    // 非有限坐标的记录与readPointCloud一致地跳过
+    if (!transform.apply(x, y, z, point.position)) {
+        return false;
+    }
     
     // 解析强度
     quint16 intensity = *reinterpret_cast<const quint16*>(data.data() + 12);
@@ -404,7 +470,7 @@ PointWithAttributes LASReader::parsePointRecord(const QByteArray& data,
         }
     }
     
-    return point;
+    return true;
 }
 
 double LASReader::applyScaleAndOffset(qint32 rawCoord, double scale, double offset) const
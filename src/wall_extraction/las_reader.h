@@ -8,6 +8,7 @@
 #include <QVariantMap>
 #include <vector>
 #include <stdexcept>
+#include "coordinate_transform.h"
 
 namespace WallExtraction {
 
@@ -148,6 +149,35 @@ public:
      */
     CoordinateSystemInfo parseCoordinateSystem(const QString& filename) const;
 
+    /**
+     * @brief 获取文件的坐标原点
+     *
+     * 读取得到的点坐标均为相对该原点的局部坐标，还原全局坐标时需加回。
+     * 原点由文件头包围盒中心确定（经解码变换归一化），局部范围内的文件原点为0。
+     *
+     * @param filename 文件路径
+     * @return 坐标原点
+     * @throws LASReaderException
+     */
+    CoordinateOrigin getCoordinateOrigin(const QString& filename) const;
+
+    /**
+     * @brief 设置解码变换
+     *
+     * 单位缩放、坐标轴置换和原点在读取循环中逐点应用。
+     * 变换未指定原点时，原点由归一化后的文件头包围盒中心确定；
+     * rebase为false时不选择原点，输出绝对坐标。
+     *
+     * @param transform 解码变换
+     */
+    void setDecodeTransform(const PointDecodeTransform& transform);
+
+    /**
+     * @brief 获取解码变换
+     * @return 解码变换
+     */
+    PointDecodeTransform getDecodeTransform() const;
+
     /**
      * @brief 读取点云数据（仅坐标）
      * @param filename 文件路径
@@ -186,15 +216,23 @@ public:
 
     /**
      * @brief 批量坐标系统转换
+     *
+     * 点按 sourceOrigin + 局部坐标 以双精度参与投影计算，
+     * 给出targetOrigin时结果相对变换后的原点保存。
+     *
      * @param points 原始点坐标数组
      * @param sourceSystem 源坐标系统
      * @param targetSystem 目标坐标系统
+     * @param sourceOrigin 输入点的坐标原点
+     * @param targetOrigin 输出点的坐标原点（可为空，为空时输出绝对坐标）
      * @return 转换后的坐标数组
      * @throws LASReaderException
      */
     std::vector<QVector3D> transformCoordinates(const std::vector<QVector3D>& points,
                                                 CoordinateSystem sourceSystem,
-                                                CoordinateSystem targetSystem) const;
+                                                CoordinateSystem targetSystem,
+                                                const CoordinateOrigin& sourceOrigin = CoordinateOrigin(),
+                                                CoordinateOrigin* targetOrigin = nullptr) const;
 
 signals:
     /**
@@ -230,11 +268,22 @@ private:
      * @param data 点数据
      * @param format 点记录格式
      * @param header LAS文件头
-     * @return 解析后的点信息
+     * @param transform 解码变换
+     * @param point 输出：解析后的点信息
+     * @return 坐标非有限值时返回false，该记录应跳过
      */
-    PointWithAttributes parsePointRecord(const QByteArray& data, 
-                                        quint8 format, 
-                                        const LASHeader& header) const;
+    bool parsePointRecord(const QByteArray& data,
+                          quint8 format,
+                          const LASHeader& header,
+                          PointDecodeTransform& transform,
+                          PointWithAttributes& point) const;
+
+    /**
+     * @brief 为文件构造本次读取使用的解码变换（含已确定的原点）
+     * @param header LAS文件头
+     * @return 解码变换
+     */
+    PointDecodeTransform createDecodeTransform(const LASHeader& header) const;
 
     /**
      * @brief 应用坐标缩放和偏移
@@ -252,6 +301,16 @@ private:
      */
     CoordinateSystemInfo parseWKTString(const QString& wktString) const;
 
+    /**
+     * @brief 构造两个坐标系统之间的变换
+     * @param sourceSystem 源坐标系统
+     * @param targetSystem 目标坐标系统
+     * @return 坐标变换
+     * @throws LASReaderException 坐标系统未知或不支持时
+     */
+    CoordinateTransformer createTransformer(CoordinateSystem sourceSystem,
+                                            CoordinateSystem targetSystem) const;
+
     /**
      * @brief 检查是否为LAZ压缩文件
      * @param filename 文件路径
@@ -281,6 +340,9 @@ private:
     
     // 缓存的文件头信息
     mutable QHash<QString, LASHeader> m_headerCache;
+    
+    // 解码变换
+    PointDecodeTransform m_decodeTransform;
 };
 
 } // namespace WallExtraction
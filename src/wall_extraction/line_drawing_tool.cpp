@@ -12,12 +12,17 @@
 namespace WallExtraction {
 
 // LineSegment 方法实现
-QJsonObject LineSegment::toJson() const
+QJsonObject LineSegment::toJson(const CoordinateOrigin& origin) const
 {
+    double startX, startY, startZ;
+    double endX, endY, endZ;
+    origin.toGlobal(startPoint, startX, startY, startZ);
+    origin.toGlobal(endPoint, endX, endY, endZ);
+
     QJsonObject obj;
     obj["id"] = id;
-    obj["startPoint"] = QJsonArray{startPoint.x(), startPoint.y(), startPoint.z()};
-    obj["endPoint"] = QJsonArray{endPoint.x(), endPoint.y(), endPoint.z()};
+    obj["startPoint"] = QJsonArray{startX, startY, startZ};
+    obj["endPoint"] = QJsonArray{endX, endY, endZ};
     obj["polylineId"] = polylineId;
     obj["description"] = description;
     obj["createdTime"] = createdTime.toString(Qt::ISODate);
@@ -25,20 +30,20 @@ QJsonObject LineSegment::toJson() const
     return obj;
 }
 
-LineSegment LineSegment::fromJson(const QJsonObject& json)
+LineSegment LineSegment::fromJson(const QJsonObject& json, const CoordinateOrigin& origin)
 {
     LineSegment segment;
     segment.id = json["id"].toInt();
 
     QJsonArray startArray = json["startPoint"].toArray();
-    segment.startPoint = QVector3D(startArray[0].toDouble(),
-                                  startArray[1].toDouble(),
-                                  startArray[2].toDouble());
+    segment.startPoint = origin.toLocal(startArray[0].toDouble(),
+                                        startArray[1].toDouble(),
+                                        startArray[2].toDouble());
 
     QJsonArray endArray = json["endPoint"].toArray();
-    segment.endPoint = QVector3D(endArray[0].toDouble(),
-                                endArray[1].toDouble(),
-                                endArray[2].toDouble());
+    segment.endPoint = origin.toLocal(endArray[0].toDouble(),
+                                      endArray[1].toDouble(),
+                                      endArray[2].toDouble());
 
     segment.polylineId = json["polylineId"].toInt();
     segment.description = json["description"].toString();
@@ -771,10 +776,13 @@ QJsonDocument LineDrawingTool::exportToJson() const
     root["version"] = "1.0";
     root["created"] = QDateTime::currentDateTime().toString(Qt::ISODate);
 
+    // 坐标原点（线段端点按全局坐标写出，原点仅供参考）
+    root["coordinateOrigin"] = QJsonArray{m_coordinateOrigin.x, m_coordinateOrigin.y, m_coordinateOrigin.z};
+
     // 线段数据
     QJsonArray segmentsArray;
     for (const auto& segment : m_lineSegments) {
-        segmentsArray.append(segment.toJson());
+        segmentsArray.append(segment.toJson(m_coordinateOrigin));
     }
     root["lineSegments"] = segmentsArray;
 
@@ -810,10 +818,13 @@ bool LineDrawingTool::importFromJson(const QJsonDocument& document)
         // 清除现有数据
         clearAll();
 
+        // 带坐标原点的文件保存的是全局坐标，需减去当前点云原点；旧文件保存的是局部坐标
+        const CoordinateOrigin importOrigin = root.contains("coordinateOrigin") ? m_coordinateOrigin : CoordinateOrigin();
+
         // 导入线段数据
         QJsonArray segmentsArray = root["lineSegments"].toArray();
         for (const QJsonValue& value : segmentsArray) {
-            LineSegment segment = LineSegment::fromJson(value.toObject());
+            LineSegment segment = LineSegment::fromJson(value.toObject(), importOrigin);
             m_lineSegments.push_back(segment);
 
             // 更新ID计数器
@@ -848,6 +859,16 @@ bool LineDrawingTool::importFromJson(const QJsonDocument& document)
     }
 }
 
+void LineDrawingTool::setCoordinateOrigin(const CoordinateOrigin& origin)
+{
+    m_coordinateOrigin = origin;
+}
+
+CoordinateOrigin LineDrawingTool::getCoordinateOrigin() const
+{
+    return m_coordinateOrigin;
+}
+
 void LineDrawingTool::validateDataIntegrity()
 {
     // 验证多段线中的线段ID是否都存在
@@ -890,9 +911,10 @@ bool LineDrawingTool::splitSegment(int segmentId, const QVector3D& splitPoint)
     // 第一段：原起点到分割点
     segment->endPoint = splitPoint;
 
-    // 第二段：分割点到原终点
+    // 第二段：分割点到原终点（添加线段可能使容器重新分配，之后重新获取原线段）
     int newSegmentId = addLineSegment(splitPoint, originalEnd, segment->polylineId,
                                      segment->description + " (分割)");
+    segment = getLineSegment(segmentId);
 
     // 如果属于多段线，更新多段线的线段列表
     if (segment->polylineId != -1) {
@@ -959,8 +981,9 @@ bool LineDrawingTool::mergeSegments(int segmentId1, int segmentId2)
     segment1->endPoint = newEnd;
     segment1->description += " (合并)";
 
-    // 删除第二个线段
+    // 删除第二个线段（删除会移动后面的元素，之后重新获取第一个线段）
     removeLineSegment(segmentId2);
+    segment1 = getLineSegment(segmentId1);
 
     emit lineSegmentUpdated(segmentId1, *segment1);
     qDebug() << "Segments merged:" << segmentId1 << "and" << segmentId2;
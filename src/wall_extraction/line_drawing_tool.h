@@ -15,6 +15,7 @@
 #include <memory>
 #include <unordered_set>
 #include <functional>
+#include "coordinate_transform.h"
 
 namespace WallExtraction {
 
@@ -64,11 +65,11 @@ struct LineSegment {
         return startPoint.distanceToPoint(endPoint);
     }
 
-    // 转换为JSON
-    QJsonObject toJson() const;
+    // 转换为JSON（端点加上origin，写出全局坐标）
+    QJsonObject toJson(const CoordinateOrigin& origin = CoordinateOrigin()) const;
 
-    // 从JSON创建
-    static LineSegment fromJson(const QJsonObject& json);
+    // 从JSON创建（端点减去origin，还原为局部坐标）
+    static LineSegment fromJson(const QJsonObject& json, const CoordinateOrigin& origin = CoordinateOrigin());
 };
 
 // 多段线数据结构
@@ -177,6 +178,10 @@ public:
     QJsonDocument exportToJson() const;
     bool importFromJson(const QJsonDocument& document);
 
+    // 坐标原点：线段端点为相对原点的局部坐标，导出时写出全局坐标
+    void setCoordinateOrigin(const CoordinateOrigin& origin);
+    CoordinateOrigin getCoordinateOrigin() const;
+
     // 设置外部坐标转换函数（用于与渲染系统集成）
     void setCoordinateConverter(std::function<QVector3D(const QVector2D&)> screenToWorldFunc,
                                std::function<QVector2D(const QVector3D&)> worldToScreenFunc);
@@ -287,6 +292,9 @@ private:
     int m_nextSegmentId;
     int m_nextPolylineId;
 
+    // 点云坐标原点
+    CoordinateOrigin m_coordinateOrigin;
+
     // 交互状态
     bool m_isDrawing;
     bool m_isEditing;
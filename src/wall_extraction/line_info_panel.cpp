@@ -205,14 +205,9 @@ void LineInfoPanel::updateSelectedSegmentInfo()
     
     // 更新基本信息
     m_segmentIdLabel->setText(QString("ID: %1").arg(info.id));
-    m_startPointLabel->setText(QString("起点: (%.2f, %.2f, %.2f)")
-                              .arg(info.startPoint.x())
-                              .arg(info.startPoint.y())
-                              .arg(info.startPoint.z()));
-    m_endPointLabel->setText(QString("终点: (%.2f, %.2f, %.2f)")
-                            .arg(info.endPoint.x())
-                            .arg(info.endPoint.y())
-                            .arg(info.endPoint.z()));
+    const CoordinateOrigin origin = m_lineDrawingTool->getCoordinateOrigin();
+    m_startPointLabel->setText(QString("起点: %1").arg(formatGlobalPoint(origin, info.startPoint)));
+    m_endPointLabel->setText(QString("终点: %1").arg(formatGlobalPoint(origin, info.endPoint)));
     m_lengthLabel->setText(QString("长度: %.3f").arg(info.length));
     
     if (info.polylineId != -1) {
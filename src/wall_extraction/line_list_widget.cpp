@@ -365,8 +365,9 @@ void LineListWidget::populateTable()
         filteredInfos.push_back(info);
     }
 
-    // 更新表格
+    // 更新表格（坐标显示为全局坐标）
     m_tableWidget->setRowCount(filteredInfos.size());
+    const CoordinateOrigin origin = m_lineDrawingTool->getCoordinateOrigin();
 
     for (size_t i = 0; i < filteredInfos.size(); ++i) {
         const LineSegmentInfo& info = filteredInfos[i];
@@ -378,19 +379,13 @@ void LineListWidget::populateTable()
         m_tableWidget->setItem(row, COL_ID, idItem);
 
         // 起点列
-        QString startPointText = QString("(%.2f, %.2f, %.2f)")
-                                .arg(info.startPoint.x())
-                                .arg(info.startPoint.y())
-                                .arg(info.startPoint.z());
+        QString startPointText = formatGlobalPoint(origin, info.startPoint);
         QTableWidgetItem* startItem = new QTableWidgetItem(startPointText);
         startItem->setFlags(startItem->flags() & ~Qt::ItemIsEditable);
         m_tableWidget->setItem(row, COL_START_POINT, startItem);
 
         // 终点列
-        QString endPointText = QString("(%.2f, %.2f, %.2f)")
-                              .arg(info.endPoint.x())
-                              .arg(info.endPoint.y())
-                              .arg(info.endPoint.z());
+        QString endPointText = formatGlobalPoint(origin, info.endPoint);
         QTableWidgetItem* endItem = new QTableWidgetItem(endPointText);
         endItem->setFlags(endItem->flags() & ~Qt::ItemIsEditable);
         m_tableWidget->setItem(row, COL_END_POINT, endItem);
@@ -0,0 +1,69 @@
+#include "normal_estimation.h"
+#include "parallel_utils.h"
+#include "spatial_index.h"
+#include "symmetric_eigen_solver.h"
+#include <QtMath>
+
+namespace WallExtraction {
+
+std::vector<QVector3D> computePointNormals(const std::vector<QVector3D>& points,
+                                           const PointKDTree& tree,
+                                           int neighborCount,
+                                           float radius,
+                                           NormalOrientation orientation,
+                                           const QVector3D& viewpoint,
+                                           std::vector<float>* curvatures)
+{
+    std::vector<QVector3D> normals(points.size());
+    if (curvatures) {
+        curvatures->assign(points.size(), 0.0f);
+    }
+
+    const bool useRadius = radius > 0.0f;
+    const size_t k = static_cast<size_t>(qMax(3, neighborCount));
+    if (!useRadius && points.size() < 3) {
+        return normals;
+    }
+
+    // 按树布局顺序处理，相邻查询访问的节点基本相同
+    parallelForRange(0, tree.size(), [&](size_t begin, size_t end, size_t) {
+        std::vector<quint32> indices;
+        std::vector<float> squaredDistances;
+
+        for (size_t position = begin; position < end; ++position) {
+            const QVector3D& point = tree.layoutPoint(position);
+            size_t found = useRadius ? tree.radiusSearch(point, radius, indices)
+                                     : tree.knnSearch(point, k, indices, squaredDistances);
+            if (found < 3) {
+                continue;
+            }
+
+            QVector3D centroid;
+            SymmetricMatrix3 covariance = computeCovariance(points, indices, centroid);
+            SymmetricEigen3 eigen = computeSymmetricEigen3(covariance);
+
+            QVector3D normal = eigen.eigenvectors[2];
+            if (orientation == NormalOrientation::TowardViewpoint) {
+                if (QVector3D::dotProduct(normal, viewpoint - point) < 0.0f) {
+                    normal = -normal;
+                }
+            } else if (orientation == NormalOrientation::PositiveZ) {
+                if (normal.z() < 0.0f) {
+                    normal = -normal;
+                }
+            }
+
+            quint32 index = tree.layoutIndex(position);
+            normals[index] = normal;
+
+            if (curvatures) {
+                double sum = eigen.eigenvalues[0] + eigen.eigenvalues[1] + eigen.eigenvalues[2];
+                (*curvatures)[index] = sum > 0.0 ? static_cast<float>(qMax(0.0, eigen.eigenvalues[2]) / sum) : 0.0f;
+            }
+        }
+    }, 1024);
+
+    return normals;
+}
+
+} // namespace WallExtraction
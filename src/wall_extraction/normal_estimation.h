@@ -0,0 +1,39 @@
+#ifndef NORMAL_ESTIMATION_H
+#define NORMAL_ESTIMATION_H
+
+#include <QVector3D>
+#include <vector>
+
+namespace WallExtraction {
+
+class PointKDTree;
+
+// 法向量定向方式
+enum class NormalOrientation {
+    None,               // 不定向（PCA结果符号任意）
+    TowardViewpoint,    // 朝向视点
+    PositiveZ           // 朝向+Z
+};
+
+/**
+ * @brief 基于已构建的KD树按邻域PCA估计法向量（并行，不发出信号，可在任意线程调用）
+ * @param points 点云数据
+ * @param tree 基于points构建的KD树
+ * @param neighborCount k近邻数量（含点自身）
+ * @param radius 邻域半径，0表示使用k近邻
+ * @param orientation 法向量定向方式
+ * @param viewpoint 视点（orientation为TowardViewpoint时使用）
+ * @param curvatures 可选输出，每个点的曲率 λ3/(λ1+λ2+λ3)
+ * @return 与points一一对应的单位法向量，邻域点不足3个或不在树中的点为零向量
+ */
+std::vector<QVector3D> computePointNormals(const std::vector<QVector3D>& points,
+                                           const PointKDTree& tree,
+                                           int neighborCount,
+                                           float radius = 0.0f,
+                                           NormalOrientation orientation = NormalOrientation::None,
+                                           const QVector3D& viewpoint = QVector3D(0, 0, 0),
+                                           std::vector<float>* curvatures = nullptr);
+
+} // namespace WallExtraction
+
+#endif // NORMAL_ESTIMATION_H
@@ -0,0 +1,494 @@
+#include "oriented_bounding_box.h"
+#include "parallel_utils.h"
+#include "symmetric_eigen_solver.h"
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+namespace WallExtraction {
+
+namespace {
+
+// 每段至少处理的点数，避免小点云的线程开销
+const size_t kMinPointsPerRange = 1 << 16;
+
+const double kHalfPi = 1.57079632679489661923;
+
+// 竖直轴的最小有效倾角（度）
+const float kMinTiltDegrees = 1.0f;
+
+struct Point2D {
+    double x;
+    double y;
+};
+
+inline double cross2D(const Point2D& o, const Point2D& a, const Point2D& b)
+{
+    return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+}
+
+inline bool isFinitePoint(const QVector3D& point)
+{
+    return std::isfinite(point.x()) && std::isfinite(point.y()) && std::isfinite(point.z());
+}
+
+/**
+ * @brief Andrew单调链凸包（逆时针，去除共线点）
+ */
+std::vector<Point2D> convexHull(std::vector<Point2D> points)
+{
+    std::sort(points.begin(), points.end(), [](const Point2D& a, const Point2D& b) {
+        return a.x < b.x || (a.x == b.x && a.y < b.y);
+    });
+    points.erase(std::unique(points.begin(), points.end(), [](const Point2D& a, const Point2D& b) {
+        return a.x == b.x && a.y == b.y;
+    }), points.end());
+
+    if (points.size() < 3) {
+        return points;
+    }
+
+    std::vector<Point2D> hull(points.size() * 2);
+    size_t k = 0;
+    for (size_t i = 0; i < points.size(); ++i) {
+        while (k >= 2 && cross2D(hull[k - 2], hull[k - 1], points[i]) <= 0.0) {
+            --k;
+        }
+        hull[k++] = points[i];
+    }
+    for (size_t i = points.size() - 1, lower = k + 1; i > 0; --i) {
+        while (k >= lower && cross2D(hull[k - 2], hull[k - 1], points[i - 1]) <= 0.0) {
+            --k;
+        }
+        hull[k++] = points[i - 1];
+    }
+    hull.resize(k - 1);
+    return hull;
+}
+
+/**
+ * @brief 旋转卡壳求凸包的最小面积外接矩形
+ *
+ * 最小面积矩形必有一边与凸包某条边共线；沿凸包逐边推进时，
+ * 边方向上的最远点、最近点和法向上的最远点都单调前进，总复杂度O(h)。
+ *
+ * @return 矩形一边的方向角（弧度）
+ */
+double minimumAreaRectangleAngle(const std::vector<Point2D>& hull)
+{
+    const size_t count = hull.size();
+    if (count < 2) {
+        return 0.0;
+    }
+    if (count == 2) {
+        return std::atan2(hull[1].y - hull[0].y, hull[1].x - hull[0].x);
+    }
+
+    auto next = [count](size_t index) { return (index + 1) % count; };
+    auto project = [](const Point2D& p, double ux, double uy) { return p.x * ux + p.y * uy; };
+
+    double bestArea = std::numeric_limits<double>::max();
+    double bestAngle = 0.0;
+    size_t right = 0;
+    size_t top = 0;
+    size_t left = 0;
+
+    for (size_t i = 0; i < count; ++i) {
+        const Point2D& a = hull[i];
+        const Point2D& b = hull[next(i)];
+        double ex = b.x - a.x;
+        double ey = b.y - a.y;
+        double length = std::sqrt(ex * ex + ey * ey);
+        if (length <= 0.0) {
+            continue;
+        }
+        ex /= length;
+        ey /= length;
+        // 逆时针凸包，左法向指向内部
+        const double nx = -ey;
+        const double ny = ex;
+
+        if (i == 0) {
+            right = next(i);
+        }
+        while (project(hull[next(right)], ex, ey) > project(hull[right], ex, ey)) {
+            right = next(right);
+        }
+        if (i == 0) {
+            top = right;
+        }
+        while (project(hull[next(top)], nx, ny) > project(hull[top], nx, ny)) {
+            top = next(top);
+        }
+        if (i == 0) {
+            left = top;
+        }
+        while (project(hull[next(left)], ex, ey) < project(hull[left], ex, ey)) {
+            left = next(left);
+        }
+
+        double width = project(hull[right], ex, ey) - project(hull[left], ex, ey);
+        double height = project(hull[top], nx, ny) - project(a, nx, ny);
+        double area = width * height;
+        if (area < bestArea) {
+            bestArea = area;
+            bestAngle = std::atan2(ey, ex);
+        }
+    }
+
+    return bestAngle;
+}
+
+// 角度折叠到[-π/4, π/4)
+inline double foldQuarterTurn(double angle)
+{
+    angle = std::fmod(angle, kHalfPi);
+    if (angle < 0.0) {
+        angle += kHalfPi;
+    }
+    if (angle >= kHalfPi * 0.5) {
+        angle -= kHalfPi;
+    }
+    return angle;
+}
+
+} // anonymous namespace
+
+// DominantAxisAlignment 方法实现
+QVector3D DominantAxisAlignment::directionToAligned(const QVector3D& direction) const
+{
+    const float c = std::cos(angle);
+    const float s = std::sin(angle);
+    return QVector3D(c * direction.x() + s * direction.y(),
+                     -s * direction.x() + c * direction.y(),
+                     direction.z());
+}
+
+QVector3D DominantAxisAlignment::directionToWorld(const QVector3D& direction) const
+{
+    const float c = std::cos(angle);
+    const float s = std::sin(angle);
+    return QVector3D(c * direction.x() - s * direction.y(),
+                     s * direction.x() + c * direction.y(),
+                     direction.z());
+}
+
+QVector3D DominantAxisAlignment::toAligned(const QVector3D& point) const
+{
+    return directionToAligned(point - pivot) + pivot;
+}
+
+QVector3D DominantAxisAlignment::toWorld(const QVector3D& point) const
+{
+    return directionToWorld(point - pivot) + pivot;
+}
+
+// OrientedBoundingBox 方法实现
+QVector3D OrientedBoundingBox::toLocal(const QVector3D& point) const
+{
+    QVector3D offset = point - center;
+    return QVector3D(QVector3D::dotProduct(offset, axes[0]),
+                     QVector3D::dotProduct(offset, axes[1]),
+                     QVector3D::dotProduct(offset, axes[2]));
+}
+
+QVector3D OrientedBoundingBox::toWorld(const QVector3D& local) const
+{
+    return center + axes[0] * local.x() + axes[1] * local.y() + axes[2] * local.z();
+}
+
+std::array<QVector3D, 8> OrientedBoundingBox::corners() const
+{
+    std::array<QVector3D, 8> result;
+    for (int i = 0; i < 8; ++i) {
+        QVector3D local((i & 1) ? halfExtents.x() : -halfExtents.x(),
+                        (i & 2) ? halfExtents.y() : -halfExtents.y(),
+                        (i & 4) ? halfExtents.z() : -halfExtents.z());
+        result[i] = toWorld(local);
+    }
+    return result;
+}
+
+DominantAxisAlignment OrientedBoundingBox::alignment() const
+{
+    DominantAxisAlignment result;
+    if (!valid) {
+        return result;
+    }
+    result.valid = true;
+    result.angle = static_cast<float>(foldQuarterTurn(yaw));
+    result.pivot = center;
+    result.confidence = 1.0f;
+    return result;
+}
+
+QVariantMap OrientedBoundingBox::toVariantMap() const
+{
+    QVariantMap map;
+    map["valid"] = valid;
+    map["center_x"] = center.x();
+    map["center_y"] = center.y();
+    map["center_z"] = center.z();
+    map["size_x"] = halfExtents.x() * 2.0f;
+    map["size_y"] = halfExtents.y() * 2.0f;
+    map["size_z"] = halfExtents.z() * 2.0f;
+    map["yaw_degrees"] = qRadiansToDegrees(yaw);
+    map["volume"] = volume();
+    return map;
+}
+
+OrientedBoundingBox computeOrientedBoundingBox(const std::vector<QVector3D>& points,
+                                               size_t maxHullSamples,
+                                               float maxTiltDegrees)
+{
+    OrientedBoundingBox box;
+
+    // 分块子采样：每stride个点随机取一个（固定种子），避免等间隔采样与点的排列周期混叠
+    const size_t stride = std::max<size_t>(1, (points.size() + std::max<size_t>(1, maxHullSamples) - 1) /
+                                                  std::max<size_t>(1, maxHullSamples));
+    std::mt19937 generator(42);
+    std::vector<size_t> samples;
+    samples.reserve(points.size() / stride + 1);
+    for (size_t blockBegin = 0; blockBegin < points.size(); blockBegin += stride) {
+        size_t blockSize = std::min(stride, points.size() - blockBegin);
+        size_t index = blockBegin + (blockSize > 1 ? generator() % blockSize : 0);
+        if (isFinitePoint(points[index])) {
+            samples.push_back(index);
+        }
+    }
+    if (samples.empty()) {
+        return box;
+    }
+
+    // 竖直轴：协方差特征向量中最接近Z轴的一个，倾角过大或过小时用Z轴
+    QVector3D up(0.0f, 0.0f, 1.0f);
+    if (samples.size() >= 3) {
+        QVector3D centroid;
+        SymmetricEigen3 eigen = computeSymmetricEigen3(computeCovariance(points, samples, centroid));
+        int best = 0;
+        for (int i = 1; i < 3; ++i) {
+            if (std::fabs(eigen.eigenvectors[i].z()) > std::fabs(eigen.eigenvectors[best].z())) {
+                best = i;
+            }
+        }
+        QVector3D candidate = eigen.eigenvectors[best];
+        if (candidate.z() < 0.0f) {
+            candidate = -candidate;
+        }
+        // 小于kMinTiltDegrees的倾角视为采样噪声，保持Z轴，避免竖直范围被放大
+        if (candidate.z() >= std::cos(qDegreesToRadians(maxTiltDegrees)) &&
+            candidate.z() < std::cos(qDegreesToRadians(kMinTiltDegrees))) {
+            up = candidate.normalized();
+        }
+    }
+
+    // 水平面的参考基
+    QVector3D reference = QVector3D(1.0f, 0.0f, 0.0f) - up * up.x();
+    if (reference.lengthSquared() < 1e-6f) {
+        reference = QVector3D(0.0f, 1.0f, 0.0f) - up * up.y();
+    }
+    const QVector3D baseU = reference.normalized();
+    const QVector3D baseV = QVector3D::crossProduct(up, baseU);
+
+    // 以首个采样点为原点投影，避免大坐标下的float精度损失
+    const QVector3D origin = points[samples.front()];
+    std::vector<Point2D> projected;
+    projected.reserve(samples.size());
+    for (size_t index : samples) {
+        const QVector3D offset = points[index] - origin;
+        projected.push_back({static_cast<double>(QVector3D::dotProduct(offset, baseU)),
+                             static_cast<double>(QVector3D::dotProduct(offset, baseV))});
+    }
+
+    const double angle = minimumAreaRectangleAngle(convexHull(std::move(projected)));
+    QVector3D axisA = (baseU * static_cast<float>(std::cos(angle)) +
+                       baseV * static_cast<float>(std::sin(angle))).normalized();
+    QVector3D axisB = QVector3D::crossProduct(up, axisA);
+
+    // 对全部点投影求精确范围
+    const QVector3D axes[3] = {axisA, axisB, up};
+    struct PartialRange {
+        float minValue[3] = {std::numeric_limits<float>::max(),
+                             std::numeric_limits<float>::max(),
+                             std::numeric_limits<float>::max()};
+        float maxValue[3] = {std::numeric_limits<float>::lowest(),
+                             std::numeric_limits<float>::lowest(),
+                             std::numeric_limits<float>::lowest()};
+        size_t count = 0;
+    };
+    std::vector<PartialRange> partials(parallelRangeCount(points.size(), kMinPointsPerRange));
+    parallelForRange(0, points.size(), [&](size_t rangeBegin, size_t rangeEnd, size_t rangeIndex) {
+        PartialRange& range = partials[rangeIndex];
+        for (size_t i = rangeBegin; i < rangeEnd; ++i) {
+            if (!isFinitePoint(points[i])) {
+                continue;
+            }
+            const QVector3D offset = points[i] - origin;
+            for (int axis = 0; axis < 3; ++axis) {
+                float value = QVector3D::dotProduct(offset, axes[axis]);
+                range.minValue[axis] = std::min(range.minValue[axis], value);
+                range.maxValue[axis] = std::max(range.maxValue[axis], value);
+            }
+            ++range.count;
+        }
+    }, kMinPointsPerRange);
+
+    PartialRange total;
+    for (const auto& range : partials) {
+        for (int axis = 0; axis < 3; ++axis) {
+            total.minValue[axis] = std::min(total.minValue[axis], range.minValue[axis]);
+            total.maxValue[axis] = std::max(total.maxValue[axis], range.maxValue[axis]);
+        }
+        total.count += range.count;
+    }
+    if (total.count == 0) {
+        return box;
+    }
+
+    float extent[3];
+    QVector3D center = origin;
+    for (int axis = 0; axis < 3; ++axis) {
+        extent[axis] = 0.5f * (total.maxValue[axis] - total.minValue[axis]);
+        center += axes[axis] * (0.5f * (total.maxValue[axis] + total.minValue[axis]));
+    }
+
+    // 较长的水平边作为axes[0]
+    if (extent[1] > extent[0]) {
+        std::swap(extent[0], extent[1]);
+        QVector3D previousA = axisA;
+        axisA = axisB;
+        axisB = -previousA;
+    }
+
+    // 朝向取在(-90°, 90°]内，便于与对齐角比较
+    if (axisA.x() < 0.0f || (axisA.x() == 0.0f && axisA.y() < 0.0f)) {
+        axisA = -axisA;
+        axisB = -axisB;
+    }
+
+    box.valid = true;
+    box.center = center;
+    box.axes = {{axisA, axisB, up}};
+    box.halfExtents = QVector3D(extent[0], extent[1], extent[2]);
+    box.yaw = std::atan2(axisA.y(), axisA.x());
+    return box;
+}
+
+DominantAxisAlignment estimateDominantAxisAlignment(const std::vector<QVector3D>& normals,
+                                                    const QVector3D& pivot,
+                                                    int binCount,
+                                                    float maxVerticalComponent)
+{
+    DominantAxisAlignment result;
+    result.pivot = pivot;
+
+    binCount = std::max(4, binCount);
+    const double binWidth = kHalfPi / binCount;
+
+    // 并行累计每段的局部直方图；每格同时累计4倍角的圆周分量，
+    // 4倍角把90°周期映射为360°周期，细化时不受格宽量化影响
+    struct AngleBin {
+        double weight = 0.0;
+        double sumCos = 0.0;
+        double sumSin = 0.0;
+    };
+    std::vector<std::vector<AngleBin>> partials(parallelRangeCount(normals.size(), kMinPointsPerRange),
+                                                std::vector<AngleBin>(binCount));
+    parallelForRange(0, normals.size(), [&](size_t rangeBegin, size_t rangeEnd, size_t rangeIndex) {
+        std::vector<AngleBin>& histogram = partials[rangeIndex];
+        for (size_t i = rangeBegin; i < rangeEnd; ++i) {
+            const QVector3D& normal = normals[i];
+            if (!isFinitePoint(normal) || std::fabs(normal.z()) > maxVerticalComponent) {
+                continue;
+            }
+            const double nx = normal.x();
+            const double ny = normal.y();
+            const double horizontal = std::sqrt(nx * nx + ny * ny);
+            if (horizontal < 1e-6) {
+                continue;
+            }
+            double folded = std::fmod(std::atan2(ny, nx), kHalfPi);
+            if (folded < 0.0) {
+                folded += kHalfPi;
+            }
+            int bin = std::min(binCount - 1, static_cast<int>(folded / binWidth));
+
+            // 倍角公式求cos4φ、sin4φ
+            const double hx = nx / horizontal;
+            const double hy = ny / horizontal;
+            const double cos2 = hx * hx - hy * hy;
+            const double sin2 = 2.0 * hx * hy;
+            AngleBin& entry = histogram[bin];
+            entry.weight += horizontal;
+            entry.sumCos += horizontal * (cos2 * cos2 - sin2 * sin2);
+            entry.sumSin += horizontal * (2.0 * cos2 * sin2);
+        }
+    }, kMinPointsPerRange);
+
+    std::vector<AngleBin> histogram(binCount);
+    double totalWeight = 0.0;
+    for (const auto& partial : partials) {
+        for (int bin = 0; bin < binCount; ++bin) {
+            histogram[bin].weight += partial[bin].weight;
+            histogram[bin].sumCos += partial[bin].sumCos;
+            histogram[bin].sumSin += partial[bin].sumSin;
+            totalWeight += partial[bin].weight;
+        }
+    }
+    if (totalWeight <= 0.0) {
+        return result;
+    }
+
+    // 90°周期上的[1,2,1]平滑，找峰值
+    auto wrap = [binCount](int bin) { return (bin % binCount + binCount) % binCount; };
+    int peak = 0;
+    double peakValue = -1.0;
+    for (int bin = 0; bin < binCount; ++bin) {
+        double smoothed = histogram[wrap(bin - 1)].weight + 2.0 * histogram[bin].weight +
+                          histogram[wrap(bin + 1)].weight;
+        if (smoothed > peakValue) {
+            peakValue = smoothed;
+            peak = bin;
+        }
+    }
+
+    // 峰值±1格内的加权圆周均值
+    double sumCos = 0.0;
+    double sumSin = 0.0;
+    double windowWeight = 0.0;
+    for (int offset = -1; offset <= 1; ++offset) {
+        const AngleBin& entry = histogram[wrap(peak + offset)];
+        sumCos += entry.sumCos;
+        sumSin += entry.sumSin;
+        windowWeight += entry.weight;
+    }
+    double refined = std::atan2(sumSin, sumCos) / 4.0;
+
+    result.valid = true;
+    result.angle = static_cast<float>(foldQuarterTurn(refined));
+    result.confidence = static_cast<float>(windowWeight / totalWeight);
+    return result;
+}
+
+std::vector<QVector3D> alignPoints(const std::vector<QVector3D>& points,
+                                   const DominantAxisAlignment& alignment)
+{
+    if (!alignment.valid) {
+        return points;
+    }
+
+    const float c = std::cos(alignment.angle);
+    const float s = std::sin(alignment.angle);
+    const QVector3D pivot = alignment.pivot;
+    std::vector<QVector3D> aligned(points.size());
+    parallelFor(0, points.size(), [&](size_t i) {
+        const float dx = points[i].x() - pivot.x();
+        const float dy = points[i].y() - pivot.y();
+        aligned[i] = QVector3D(c * dx + s * dy + pivot.x(), -s * dx + c * dy + pivot.y(), points[i].z());
+    }, kMinPointsPerRange);
+    return aligned;
+}
+
+} // namespace WallExtraction
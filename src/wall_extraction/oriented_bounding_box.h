@@ -0,0 +1,144 @@
+#ifndef ORIENTED_BOUNDING_BOX_H
+#define ORIENTED_BOUNDING_BOX_H
+
+#include <QVector3D>
+#include <QVariantMap>
+#include <array>
+#include <vector>
+
+namespace WallExtraction {
+
+/**
+ * @brief 绕竖直轴的主方向对齐变换
+ *
+ * 将点绕经过pivot的Z轴旋转-angle，使建筑主墙方向与X/Y轴平行。
+ */
+struct DominantAxisAlignment {
+    bool valid = false;
+    float angle = 0.0f;         // 主方向相对X轴的角度（弧度），范围[-π/4, π/4)
+    QVector3D pivot;            // 旋转中心
+    float confidence = 0.0f;    // 主方向邻域内的权重占比 [0,1]
+
+    /**
+     * @brief 世界坐标转换到对齐坐标
+     * @param point 世界坐标
+     * @return 对齐坐标
+     */
+    QVector3D toAligned(const QVector3D& point) const;
+
+    /**
+     * @brief 对齐坐标转换回世界坐标
+     * @param point 对齐坐标
+     * @return 世界坐标
+     */
+    QVector3D toWorld(const QVector3D& point) const;
+
+    /**
+     * @brief 旋转方向向量到对齐坐标（不含平移）
+     * @param direction 世界坐标系下的方向
+     * @return 对齐坐标系下的方向
+     */
+    QVector3D directionToAligned(const QVector3D& direction) const;
+
+    /**
+     * @brief 旋转方向向量回世界坐标（不含平移）
+     * @param direction 对齐坐标系下的方向
+     * @return 世界坐标系下的方向
+     */
+    QVector3D directionToWorld(const QVector3D& direction) const;
+};
+
+/**
+ * @brief 有向包围盒
+ *
+ * axes[0]、axes[1]为水平面内的两个轴（axes[0]对应较长边），axes[2]为竖直轴。
+ */
+struct OrientedBoundingBox {
+    bool valid = false;
+    QVector3D center;
+    std::array<QVector3D, 3> axes = {{QVector3D(1, 0, 0), QVector3D(0, 1, 0), QVector3D(0, 0, 1)}};
+    QVector3D halfExtents;      // 沿各轴的半边长
+    float yaw = 0.0f;           // axes[0]在XY平面内相对X轴的角度（弧度）
+
+    QVector3D size() const { return halfExtents * 2.0f; }
+    float volume() const { return 8.0f * halfExtents.x() * halfExtents.y() * halfExtents.z(); }
+    float footprintArea() const { return 4.0f * halfExtents.x() * halfExtents.y(); }
+
+    /**
+     * @brief 世界坐标转换到包围盒局部坐标（原点为中心）
+     * @param point 世界坐标
+     * @return 局部坐标
+     */
+    QVector3D toLocal(const QVector3D& point) const;
+
+    /**
+     * @brief 包围盒局部坐标转换到世界坐标
+     * @param local 局部坐标
+     * @return 世界坐标
+     */
+    QVector3D toWorld(const QVector3D& local) const;
+
+    /**
+     * @brief 获取8个角点
+     * @return 角点世界坐标
+     */
+    std::array<QVector3D, 8> corners() const;
+
+    /**
+     * @brief 以包围盒水平朝向构造对齐变换
+     * @return 对齐变换（角度折叠到[-π/4, π/4)）
+     */
+    DominantAxisAlignment alignment() const;
+
+    /**
+     * @brief 转换为QVariantMap
+     * @return 包围盒信息
+     */
+    QVariantMap toVariantMap() const;
+};
+
+/**
+ * @brief 计算点云的有向包围盒
+ *
+ * 竖直轴取子采样点协方差中最接近Z轴的特征向量（倾角在1°到maxTiltDegrees之间时采用，否则用Z轴），
+ * 水平朝向由子采样点投影到水平面后的凸包经旋转卡壳求最小面积矩形得到，
+ * 最后对全部点做一次投影得到精确的半边长，因此结果总是包含所有有效点。
+ *
+ * @param points 点云数据
+ * @param maxHullSamples 参与PCA和凸包计算的最大点数
+ * @param maxTiltDegrees 竖直轴允许的最大倾角（度）
+ * @return 有向包围盒，有效点不足时valid为false
+ */
+OrientedBoundingBox computeOrientedBoundingBox(const std::vector<QVector3D>& points,
+                                               size_t maxHullSamples = 20000,
+                                               float maxTiltDegrees = 15.0f);
+
+/**
+ * @brief 由法向量角度直方图估计主墙方向
+ *
+ * 只统计接近水平的法向量（|n.z| ≤ maxVerticalComponent），角度按90°折叠，
+ * 使互相垂直的墙落入同一峰值；权重为法向量水平分量的长度。
+ *
+ * @param normals 法向量
+ * @param pivot 对齐变换的旋转中心
+ * @param binCount 直方图格数（覆盖90°）
+ * @param maxVerticalComponent 法向量Z分量绝对值上限
+ * @return 对齐变换，没有合格法向量时valid为false
+ */
+DominantAxisAlignment estimateDominantAxisAlignment(const std::vector<QVector3D>& normals,
+                                                    const QVector3D& pivot,
+                                                    int binCount = 90,
+                                                    float maxVerticalComponent = 0.3f);
+
+/**
+ * @brief 将点云变换到对齐坐标
+ * @param points 点云数据
+ * @param alignment 对齐变换
+ * @return 变换后的点云（alignment无效时原样返回）
+ */
+std::vector<QVector3D> alignPoints(const std::vector<QVector3D>& points,
+                                   const DominantAxisAlignment& alignment);
+
+} // namespace WallExtraction
+
+#endif // ORIENTED_BOUNDING_BOX_H
@@ -0,0 +1,102 @@
+#ifndef PARALLEL_UTILS_H
+#define PARALLEL_UTILS_H
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace WallExtraction {
+
+/**
+ * @brief 获取数据并行计算使用的线程数
+ * @return 线程数（至少为1）
+ */
+inline size_t parallelThreadCount()
+{
+    unsigned int hardwareThreads = std::thread::hardware_concurrency();
+    return hardwareThreads > 0 ? hardwareThreads : 1;
+}
+
+/**
+ * @brief 计算区间会被划分成的段数
+ * @param count 元素数量
+ * @param minRangeSize 每段的最小长度
+ * @return 段数，调用方可据此预分配每段的局部累加器
+ */
+inline size_t parallelRangeCount(size_t count, size_t minRangeSize = 4096)
+{
+    if (count == 0) {
+        return 0;
+    }
+    size_t maxRanges = (count + std::max<size_t>(1, minRangeSize) - 1) / std::max<size_t>(1, minRangeSize);
+    return std::max<size_t>(1, std::min(parallelThreadCount(), maxRanges));
+}
+
+/**
+ * @brief 将[begin, end)均分为若干段并行执行
+ *
+ * 调用线程自身处理最后一段；区间较小时直接在调用线程中执行。
+ * 回调不得抛出异常，也不应直接操作界面对象。
+ *
+ * @param begin 起始索引
+ * @param end 结束索引（不含）
+ * @param body 回调 body(rangeBegin, rangeEnd, rangeIndex)
+ * @param minRangeSize 每段的最小长度
+ */
+template <typename Body>
+void parallelForRange(size_t begin, size_t end, Body&& body, size_t minRangeSize = 4096)
+{
+    if (end <= begin) {
+        return;
+    }
+
+    size_t count = end - begin;
+    size_t rangeCount = parallelRangeCount(count, minRangeSize);
+    if (rangeCount <= 1) {
+        body(begin, end, static_cast<size_t>(0));
+        return;
+    }
+
+    size_t rangeSize = (count + rangeCount - 1) / rangeCount;
+    std::vector<std::thread> threads;
+    threads.reserve(rangeCount - 1);
+
+    for (size_t range = 0; range + 1 < rangeCount; ++range) {
+        size_t rangeBegin = begin + range * rangeSize;
+        if (rangeBegin >= end) {
+            break;
+        }
+        size_t rangeEnd = std::min(end, rangeBegin + rangeSize);
+        threads.emplace_back([&body, rangeBegin, rangeEnd, range]() { body(rangeBegin, rangeEnd, range); });
+    }
+
+    size_t lastBegin = begin + (rangeCount - 1) * rangeSize;
+    if (lastBegin < end) {
+        body(lastBegin, end, rangeCount - 1);
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+/**
+ * @brief 并行执行 function(i)，i ∈ [begin, end)
+ * @param begin 起始索引
+ * @param end 结束索引（不含）
+ * @param function 回调
+ * @param minRangeSize 每段的最小长度
+ */
+template <typename Function>
+void parallelFor(size_t begin, size_t end, Function&& function, size_t minRangeSize = 4096)
+{
+    parallelForRange(begin, end, [&function](size_t rangeBegin, size_t rangeEnd, size_t) {
+        for (size_t i = rangeBegin; i < rangeEnd; ++i) {
+            function(i);
+        }
+    }, minRangeSize);
+}
+
+} // namespace WallExtraction
+
+#endif // PARALLEL_UTILS_H
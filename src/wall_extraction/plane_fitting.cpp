@@ -0,0 +1,131 @@
+#include "plane_fitting.h"
+#include "parallel_utils.h"
+#include "symmetric_eigen_solver.h"
+#include <algorithm>
+#include <cmath>
+
+namespace WallExtraction {
+
+namespace {
+
+// 每段至少处理的点数
+const size_t kMinPointsPerRange = 1 << 14;
+
+// MAD到正态分布标准差的换算系数
+const double kMadToSigma = 1.4826;
+
+/**
+ * @brief 并行分段累加加权协方差，按段序合并
+ * @param count 点数
+ * @param pointAt 第i个点
+ * @param weightAt 第i个点的权重
+ */
+template <typename PointAt, typename WeightAt>
+CovarianceAccumulator accumulateCovariance(size_t count, const PointAt& pointAt, const WeightAt& weightAt)
+{
+    std::vector<CovarianceAccumulator> rangeAccumulators(parallelRangeCount(count, kMinPointsPerRange));
+    parallelForRange(0, count, [&](size_t begin, size_t end, size_t range) {
+        CovarianceAccumulator& local = rangeAccumulators[range];
+        for (size_t i = begin; i < end; ++i) {
+            local.add(pointAt(i), weightAt(i));
+        }
+    }, kMinPointsPerRange);
+
+    CovarianceAccumulator total;
+    for (const CovarianceAccumulator& local : rangeAccumulators) {
+        total.merge(local);
+    }
+    return total;
+}
+
+/**
+ * @brief 由累加结果求平面，法向量方向与reference一致（reference为零向量时不调整）
+ */
+bool solvePlane(const CovarianceAccumulator& accumulator, const QVector3D& reference, PlaneFitResult& result)
+{
+    if (accumulator.count() < 3 || !(accumulator.totalWeight() > 0.0)) {
+        return false;
+    }
+    SymmetricEigen3 eigen = computeSymmetricEigen3(accumulator.covariance());
+    if (!(eigen.eigenvalues[1] > 0.0)) {
+        return false;   // 点集共线或重合
+    }
+
+    QVector3D normal = eigen.eigenvectors[2];
+    if (QVector3D::dotProduct(normal, reference) < 0.0f) {
+        normal = -normal;
+    }
+    const double sum = eigen.eigenvalues[0] + eigen.eigenvalues[1] + eigen.eigenvalues[2];
+    result.centroid = accumulator.mean();
+    result.normal = normal;
+    result.rms = std::sqrt(std::max(0.0, eigen.eigenvalues[2]));
+    result.curvature = sum > 0.0 ? std::max(0.0, eigen.eigenvalues[2]) / sum : 0.0;
+    result.valid = true;
+    return true;
+}
+
+template <typename PointAt>
+PlaneFitResult fitPlane(size_t count, const PointAt& pointAt, const PlaneFitOptions& options)
+{
+    PlaneFitResult result;
+    if (count < 3) {
+        return result;
+    }
+
+    CovarianceAccumulator accumulator = accumulateCovariance(count, pointAt, [](size_t) { return 1.0; });
+    if (!solvePlane(accumulator, QVector3D(), result) || !options.robust) {
+        return result;
+    }
+
+    // IRLS：Tukey双权重加权，尺度由上一轮残差的MAD估计
+    std::vector<float> residuals(count);
+    std::vector<float> absoluteResiduals(count);
+    for (int iteration = 0; iteration < options.maxIterations; ++iteration) {
+        const QVector3D centroid = result.centroid;
+        const QVector3D normal = result.normal;
+        parallelFor(0, count, [&](size_t i) {
+            residuals[i] = QVector3D::dotProduct(pointAt(i) - centroid, normal);
+            absoluteResiduals[i] = std::fabs(residuals[i]);
+        }, kMinPointsPerRange);
+
+        auto median = absoluteResiduals.begin() + count / 2;
+        std::nth_element(absoluteResiduals.begin(), median, absoluteResiduals.end());
+        const double scale = std::max(kMadToSigma * *median, options.minScale);
+        const double cutoff = options.tukeyConstant * scale;
+
+        auto weightAt = [&](size_t i) {
+            const double u = residuals[i] / cutoff;
+            return std::fabs(u) < 1.0 ? (1.0 - u * u) * (1.0 - u * u) : 0.0;
+        };
+        PlaneFitResult reweighted;
+        if (!solvePlane(accumulateCovariance(count, pointAt, weightAt), normal, reweighted)) {
+            break;
+        }
+        reweighted.iterations = iteration + 1;
+
+        // 法向和偏移都稳定后停止
+        const double cosine = std::min(1.0, static_cast<double>(QVector3D::dotProduct(reweighted.normal, normal)));
+        const double shift = std::fabs(QVector3D::dotProduct(reweighted.centroid - centroid, reweighted.normal));
+        result = reweighted;
+        if (std::acos(cosine) < options.convergenceAngle && shift < options.minScale) {
+            break;
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+PlaneFitResult fitPlaneLeastSquares(const std::vector<QVector3D>& points,
+                                    const std::vector<int>& indices,
+                                    const PlaneFitOptions& options)
+{
+    return fitPlane(indices.size(), [&](size_t i) -> const QVector3D& { return points[indices[i]]; }, options);
+}
+
+PlaneFitResult fitPlaneLeastSquares(const std::vector<QVector3D>& points, const PlaneFitOptions& options)
+{
+    return fitPlane(points.size(), [&](size_t i) -> const QVector3D& { return points[i]; }, options);
+}
+
+} // namespace WallExtraction
@@ -0,0 +1,65 @@
+#ifndef PLANE_FITTING_H
+#define PLANE_FITTING_H
+
+#include <QVector3D>
+#include <vector>
+
+namespace WallExtraction {
+
+// 平面拟合选项
+struct PlaneFitOptions {
+    bool robust;                // 启用IRLS/Tukey双权重加权
+    int maxIterations;          // 最大重加权次数 (10)
+    double tukeyConstant;       // Tukey常数，以残差尺度（1.4826·MAD）为单位 (4.685)
+    double minScale;            // 残差尺度下限，避免内点完全共面时尺度塌缩为0 (1e-4m)
+    double convergenceAngle;    // 法向变化小于该角度（弧度）且偏移变化小于minScale时停止重加权 (1e-5)
+
+    PlaneFitOptions()
+        : robust(false)
+        , maxIterations(10)
+        , tukeyConstant(4.685)
+        , minScale(1e-4)
+        , convergenceAngle(1e-5)
+    {}
+};
+
+// 平面拟合结果
+struct PlaneFitResult {
+    QVector3D centroid;         // 加权质心
+    QVector3D normal;           // 单位法向量（加权协方差最小特征值方向）
+    double rms;                 // 点到平面距离的加权均方根
+    double curvature;           // 最小特征值占特征值之和的比例
+    int iterations;             // 实际执行的重加权次数
+    bool valid;                 // 有效点不足3个或点集退化时为false
+
+    PlaneFitResult() : rms(0.0), curvature(0.0), iterations(0), valid(false) {}
+};
+
+/**
+ * @brief 最小二乘平面拟合
+ *
+ * 协方差按线程分段流式累加（Welford + Kahan）后合并，法向量由3x3闭式特征分解得到，
+ * 结果与点的输入顺序无关。启用robust时在最小二乘解的基础上做IRLS：
+ * 每轮并行计算残差，以1.4826·MAD为尺度计算Tukey双权权重并重新加权拟合。
+ *
+ * @param points 点云数据
+ * @param indices 参与拟合的点索引
+ * @param options 拟合选项
+ * @return 拟合结果
+ */
+PlaneFitResult fitPlaneLeastSquares(const std::vector<QVector3D>& points,
+                                    const std::vector<int>& indices,
+                                    const PlaneFitOptions& options = PlaneFitOptions());
+
+/**
+ * @brief 最小二乘平面拟合（全部点参与）
+ * @param points 点云数据
+ * @param options 拟合选项
+ * @return 拟合结果
+ */
+PlaneFitResult fitPlaneLeastSquares(const std::vector<QVector3D>& points,
+                                    const PlaneFitOptions& options = PlaneFitOptions());
+
+} // namespace WallExtraction
+
+#endif // PLANE_FITTING_H
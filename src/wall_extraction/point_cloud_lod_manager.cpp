@@ -1,4 +1,5 @@
 #include "point_cloud_lod_manager.h"
+#include "point_cloud_statistics.h"
 #include <QDebug>
 #include <QElapsedTimer>
 #include <QtMath>
@@ -102,6 +103,7 @@ bool PointCloudLODManager::generateLODLevels(const std::vector<QVector3D>& origi
     
     // 计算边界框用于自适应阈值
     auto boundingBox = computeBoundingBox(originalPoints);
+    m_boundingBox = boundingBox;
     if (m_adaptiveLODEnabled) {
         m_distanceThresholds = computeDefaultDistanceThresholds(boundingBox);
     }
@@ -199,9 +201,8 @@ int PointCloudLODManager::selectLODLevel(const QVector3D& viewPosition,
         return -1;
     }
     
-    // 简化实现：计算视点到点云中心的距离
-    auto boundingBox = computeBoundingBox(m_lodLevels[0].points);
-    QVector3D center = (boundingBox.first + boundingBox.second) * 0.5f;
+    // 简化实现：计算视点到点云中心的距离（边界框在生成LOD时已缓存）
+    QVector3D center = (m_boundingBox.first + m_boundingBox.second) * 0.5f;
     float distance = (viewPosition - center).length();
     
     // 根据视野角度调整距离
@@ -238,6 +239,7 @@ std::vector<LODLevel> PointCloudLODManager::getAllLODLevels() const
 void PointCloudLODManager::clearLODData()
 {
     m_lodLevels.clear();
+    m_boundingBox = {QVector3D(), QVector3D()};
     m_originalPointCount = 0;
     m_totalMemoryUsage = 0;
     m_currentLODLevel = -1;
@@ -452,24 +454,12 @@ float PointCloudLODManager::calculateImportanceScore(const std::vector<QVector3D
 
 std::pair<QVector3D, QVector3D> PointCloudLODManager::computeBoundingBox(const std::vector<QVector3D>& points) const
 {
-    if (points.empty()) {
+    PointCloudBounds bounds = computePointCloudBounds(points);
+    if (!bounds.isValid()) {
         return {QVector3D(), QVector3D()};
     }
 
-    QVector3D minPoint = points[0];
-    QVector3D maxPoint = points[0];
-
-    for (const auto& point : points) {
-        minPoint.setX(qMin(minPoint.x(), point.x()));
-        minPoint.setY(qMin(minPoint.y(), point.y()));
-        minPoint.setZ(qMin(minPoint.z(), point.z()));
-
-        maxPoint.setX(qMax(maxPoint.x(), point.x()));
-        maxPoint.setY(qMax(maxPoint.y(), point.y()));
-        maxPoint.setZ(qMax(maxPoint.z(), point.z()));
-    }
-
-    return {minPoint, maxPoint};
+    return {bounds.minPoint, bounds.maxPoint};
 }
 
 std::vector<float> PointCloudLODManager::computeDefaultDistanceThresholds(const std::pair<QVector3D, QVector3D>& boundingBox) const
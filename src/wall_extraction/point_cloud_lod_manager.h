@@ -258,6 +258,7 @@ private:
     std::vector<LODLevel> m_lodLevels;
     std::vector<float> m_distanceThresholds;
     size_t m_originalPointCount;
+    std::pair<QVector3D, QVector3D> m_boundingBox;  // 原始点云边界框，生成LOD时计算一次
     
     int m_currentLODLevel;
     
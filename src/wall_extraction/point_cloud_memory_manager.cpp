@@ -1,11 +1,66 @@
 #include "point_cloud_memory_manager.h"
 #include <QDebug>
 #include <QElapsedTimer>
+#include <QThread>
 #include <QtMath>
 #include <algorithm>
+#include <cstring>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define WALL_EXTRACTION_HAS_SSE2 1
+#endif
 
 namespace WallExtraction {
 
+namespace {
+
+// Morton编码每轴的量化位数（3 x 21 = 63位）
+constexpr int kMortonBitsPerAxis = 21;
+
+// 将21位整数的各位之间插入两个0位
+quint64 expandMortonBits(quint64 value)
+{
+    value &= 0x1fffff;
+    value = (value | (value << 32)) & 0x1f00000000ffffULL;
+    value = (value | (value << 16)) & 0x1f0000ff0000ffULL;
+    value = (value | (value << 8))  & 0x100f00f00f00f00fULL;
+    value = (value | (value << 4))  & 0x10c30c30c30c30c3ULL;
+    value = (value | (value << 2))  & 0x1249249249249249ULL;
+    return value;
+}
+
+// 计算点在给定边界框内的Morton编码
+quint64 computeMortonCode(const QVector3D& point, const QVector3D& minPoint, const QVector3D& scale)
+{
+    const float maxCell = static_cast<float>((1u << kMortonBitsPerAxis) - 1);
+    quint64 x = static_cast<quint64>(qBound(0.0f, (point.x() - minPoint.x()) * scale.x(), maxCell));
+    quint64 y = static_cast<quint64>(qBound(0.0f, (point.y() - minPoint.y()) * scale.y(), maxCell));
+    quint64 z = static_cast<quint64>(qBound(0.0f, (point.z() - minPoint.z()) * scale.z(), maxCell));
+    return expandMortonBits(x) | (expandMortonBits(y) << 1) | (expandMortonBits(z) << 2);
+}
+
+// 未压缩块从内存副本重载的吞吐量估计（字节/毫秒）与固定开销（毫秒）
+constexpr double kRawReloadBytesPerMs = 2.0e6;
+constexpr double kReloadOverheadMs = 0.05;
+
+// 压缩块解压吞吐量估计（按压缩后字节计，字节/毫秒）
+constexpr double kCompressedReloadBytesPerMs = 2.0e5;
+
+// 16位量化的网格级数
+constexpr float kQuantizationLevels = 65535.0f;
+
+// 冷块压缩级别：解压速度优先
+constexpr int kColdCompressionLevel = 1;
+
+static_assert(sizeof(QVector3D) == 3 * sizeof(float), "QVector3D must be three tightly packed floats");
+
+// 访问计数达到该值时整体减半，使历史热点逐渐冷却
+constexpr quint32 kAccessCountAgingThreshold = 1u << 16;
+
+} // namespace
+
 PointCloudMemoryManager::PointCloudMemoryManager(QObject* parent)
     : QObject(parent)
     , m_initialized(false)
@@ -18,10 +73,23 @@ PointCloudMemoryManager::PointCloudMemoryManager(QObject* parent)
     , m_totalUnloadOperations(0)
     , m_totalLoadTime(0)
     , m_totalUnloadTime(0)
+    , m_arcTargetT1(0.0)
+    , m_gdsfInflation(0.0)
+    , m_chunkEncoding(ChunkEncoding::Quantized16)
+    , m_maxQuantizationError(0.001f)
+    , m_coldCompressionEnabled(true)
+    , m_activePrefetchWorkers(0)
+    , m_prefetchGeneration(0)
+    , m_prefetchEnabled(true)
+    , m_prefetchLookahead(0.5f)
 {
     // 注册元类型
     qRegisterMetaType<MemoryStrategy>("MemoryStrategy");
     qRegisterMetaType<PointCloudChunk>("PointCloudChunk");
+    qRegisterMetaType<CameraMotionState>("CameraMotionState");
+    
+    // 预取线程数取一半核心，避免与渲染线程争抢
+    m_prefetchPool.setMaxThreadCount(qMax(1, QThread::idealThreadCount() / 2));
     
     m_initialized = true;
     qDebug() << "PointCloudMemoryManager created with max memory:" << (m_maxMemoryUsage / (1024*1024)) << "MB";
@@ -42,7 +110,7 @@ void PointCloudMemoryManager::setMemoryStrategy(MemoryStrategy strategy)
 {
     if (m_strategy != strategy) {
         m_strategy = strategy;
-        emit statusMessage(QString("Memory strategy changed to %1").arg(static_cast<int>(strategy)));
+        emit statusMessage(QString("Memory strategy changed to %1").arg(memoryStrategyName(strategy)));
     }
 }
 
@@ -51,6 +119,19 @@ MemoryStrategy PointCloudMemoryManager::getMemoryStrategy() const
     return m_strategy;
 }
 
+QString PointCloudMemoryManager::memoryStrategyName(MemoryStrategy strategy)
+{
+    switch (strategy) {
+        case MemoryStrategy::LRU:       return "LRU";
+        case MemoryStrategy::LFU:       return "LFU";
+        case MemoryStrategy::FIFO:      return "FIFO";
+        case MemoryStrategy::Priority:  return "Priority";
+        case MemoryStrategy::ARC:       return "ARC";
+        case MemoryStrategy::CostAware: return "CostAware";
+    }
+    return "Unknown";
+}
+
 void PointCloudMemoryManager::setMaxMemoryUsage(size_t maxMemoryMB)
 {
     size_t newMaxMemory = maxMemoryMB * 1024 * 1024;
@@ -88,30 +169,39 @@ bool PointCloudMemoryManager::loadPointCloudChunked(const std::vector<QVector3D>
     // 清除现有数据
     clearAllData();
     
+    QMutexLocker locker(&m_stateMutex);
+    
     try {
         // 计算需要的块数量
         size_t totalChunks = (points.size() + chunkSize - 1) / chunkSize;
         m_chunks.reserve(totalChunks);
         
-        // 创建块
-        for (size_t i = 0; i < points.size(); i += chunkSize) {
-            size_t endIndex = qMin(i + chunkSize, points.size());
+        // 按Morton编码对点进行空间排序，使每个块在空间上紧凑
+        std::vector<size_t> spatialOrder = computeSpatialOrder(points);
+        
+        // 将排序后的序列切分为固定大小的块
+        for (size_t i = 0; i < spatialOrder.size(); i += chunkSize) {
+            size_t endIndex = qMin(i + chunkSize, spatialOrder.size());
             
-            auto chunk = createChunk(points, i, endIndex);
+            auto chunk = createChunk(points, spatialOrder, i, endIndex);
             if (chunk) {
                 m_chunks.push_back(std::move(chunk));
             }
         }
         
+        {
+            QMutexLocker prefetchLocker(&m_prefetchMutex);
+            m_prefetchQueuedPriority.assign(m_chunks.size(), std::numeric_limits<float>::infinity());
+        }
+        
+        m_cacheState.assign(m_chunks.size(), ChunkCacheState());
+        m_arcTargetT1 = 0.0;
+        m_gdsfInflation = 0.0;
+        
         // 初始加载一些块
         size_t initialLoadCount = qMin(static_cast<size_t>(4), m_chunks.size());
         for (size_t i = 0; i < initialLoadCount; ++i) {
-            if (m_chunks[i] && !m_chunks[i]->isLoaded) {
-                m_chunks[i]->isLoaded = true;
-                m_chunks[i]->lastAccessTime = QDateTime::currentMSecsSinceEpoch();
-                m_loadedChunks.push_back(i);
-                m_currentMemoryUsage += m_chunks[i]->memoryUsage;
-                
+            if (loadChunkLocked(i, false)) {
                 emit chunkLoaded(i);
             }
         }
@@ -137,67 +227,104 @@ bool PointCloudMemoryManager::loadPointCloudChunked(const std::vector<QVector3D>
 
 size_t PointCloudMemoryManager::getLoadedChunkCount() const
 {
+    QMutexLocker locker(&m_stateMutex);
     return m_loadedChunks.size();
 }
 
 size_t PointCloudMemoryManager::getTotalChunkCount() const
 {
+    QMutexLocker locker(&m_stateMutex);
     return m_chunks.size();
 }
 
 std::vector<QVector3D> PointCloudMemoryManager::getChunkPoints(size_t chunkIndex) const
 {
-    if (chunkIndex >= m_chunks.size()) {
-        qWarning() << "Invalid chunk index:" << chunkIndex;
-        return {};
+    std::vector<QVector3D> points;
+    bool loadedNow = false;
+    
+    {
+        QMutexLocker locker(&m_stateMutex);
+        
+        if (chunkIndex >= m_chunks.size()) {
+            qWarning() << "Invalid chunk index:" << chunkIndex;
+            return {};
+        }
+        
+        readChunkLocked(chunkIndex, false, points, loadedNow);
     }
     
-    auto& chunk = m_chunks[chunkIndex];
-    if (!chunk) {
-        return {};
+    if (loadedNow) {
+        auto* self = const_cast<PointCloudMemoryManager*>(this);
+        self->emitChunkLoaded(chunkIndex);
+        self->emitMemoryUsageChanged(getCurrentMemoryUsage(), m_maxMemoryUsage);
+    }
+    
+    return points;
+}
+
+bool PointCloudMemoryManager::readChunkLocked(size_t chunkIndex, bool queueIfMissing,
+                                              std::vector<QVector3D>& points, bool& loadedNow) const
+{
+    auto* self = const_cast<PointCloudMemoryManager*>(this);
+    loadedNow = false;
+    
+    if (chunkIndex >= m_chunks.size() || !m_chunks[chunkIndex]) {
+        return false;
     }
+    auto& chunk = m_chunks[chunkIndex];
     
-    // 更新访问时间
-    const_cast<PointCloudMemoryManager*>(this)->updateChunkAccessTime(chunkIndex);
+    // 更新访问时间（未驻留时计为一次未命中）
+    self->updateChunkAccessTime(chunkIndex);
     
-    // 如果块未加载，尝试加载
     if (!chunk->isLoaded) {
-        // 检查内存限制
-        if (m_currentMemoryUsage + chunk->memoryUsage > m_maxMemoryUsage) {
-            if (m_autoMemoryManagement) {
-                const_cast<PointCloudMemoryManager*>(this)->performMemoryCleanup(
-                    m_maxMemoryUsage - chunk->memoryUsage);
-            } else {
-                const_cast<PointCloudMemoryManager*>(this)->emitMemoryWarning("Memory limit would be exceeded");
-                return {};
-            }
+        // 异步预取模式下不在渲染路径上加载，排队后跳过
+        if (queueIfMissing) {
+            self->schedulePrefetch(chunkIndex, -1.0f);
+            return false;
         }
-        
-        // 加载块
-        chunk->isLoaded = true;
-        chunk->lastAccessTime = QDateTime::currentMSecsSinceEpoch();
-        const_cast<PointCloudMemoryManager*>(this)->m_loadedChunks.push_back(chunkIndex);
-        const_cast<PointCloudMemoryManager*>(this)->m_currentMemoryUsage += chunk->memoryUsage;
+        loadedNow = self->loadChunkLocked(chunkIndex, m_autoMemoryManagement);
+        if (!chunk->isLoaded) {
+            self->emitMemoryWarning("Memory limit would be exceeded");
+            return false;
+        }
+    }
+    
+    points = decodeChunkPoints(*chunk);
+    return true;
+}
 
-        const_cast<PointCloudMemoryManager*>(this)->emitChunkLoaded(chunkIndex);
-        const_cast<PointCloudMemoryManager*>(this)->emitMemoryUsageChanged(m_currentMemoryUsage, m_maxMemoryUsage);
+std::pair<QVector3D, QVector3D> PointCloudMemoryManager::getChunkBoundingBox(size_t chunkIndex) const
+{
+    QMutexLocker locker(&m_stateMutex);
+    
+    if (chunkIndex >= m_chunks.size() || !m_chunks[chunkIndex]) {
+        return {QVector3D(), QVector3D()};
     }
     
-    return chunk->points;
+    return {m_chunks[chunkIndex]->boundingBoxMin, m_chunks[chunkIndex]->boundingBoxMax};
 }
 
 std::vector<QVector3D> PointCloudMemoryManager::getPointsForRendering(int lodLevel) const
 {
     std::vector<QVector3D> renderPoints;
     
-    // 根据LOD级别决定加载哪些块
-    size_t maxChunks = qMax(1, static_cast<int>(m_chunks.size()) >> lodLevel);
+    // 所有块使用相同的抽样步长，粗LOD不再丢弃整片区域
+    size_t step = static_cast<size_t>(1) << qBound(0, lodLevel, 30); // 2^lodLevel
     
-    for (size_t i = 0; i < qMin(maxChunks, m_chunks.size()); ++i) {
-        auto chunkPoints = getChunkPoints(i);
+    for (size_t i = 0; i < getTotalChunkCount(); ++i) {
+        std::vector<QVector3D> chunkPoints;
+        bool loadedNow = false;
+        {
+            QMutexLocker locker(&m_stateMutex);
+            readChunkLocked(i, m_prefetchEnabled, chunkPoints, loadedNow);
+        }
+        if (loadedNow) {
+            auto* self = const_cast<PointCloudMemoryManager*>(this);
+            self->emitChunkLoaded(i);
+            self->emitMemoryUsageChanged(getCurrentMemoryUsage(), m_maxMemoryUsage);
+        }
         
         // 根据LOD级别进行下采样
-        size_t step = 1 << lodLevel; // 2^lodLevel
         for (size_t j = 0; j < chunkPoints.size(); j += step) {
             renderPoints.push_back(chunkPoints[j]);
         }
@@ -214,38 +341,199 @@ std::vector<QVector3D> PointCloudMemoryManager::getVisiblePoints(const QVector3D
 {
     std::vector<QVector3D> visiblePoints;
     
-    for (size_t i = 0; i < m_chunks.size(); ++i) {
-        if (m_chunks[i] && isChunkVisible(*m_chunks[i], viewPosition, viewDirection, fov, nearPlane, farPlane)) {
-            auto chunkPoints = getChunkPoints(i);
-            visiblePoints.insert(visiblePoints.end(), chunkPoints.begin(), chunkPoints.end());
+    for (size_t i = 0; i < getTotalChunkCount(); ++i) {
+        std::vector<QVector3D> chunkPoints;
+        bool loadedNow = false;
+        {
+            QMutexLocker locker(&m_stateMutex);
+            if (i >= m_chunks.size() || !m_chunks[i] ||
+                !isChunkVisible(*m_chunks[i], viewPosition, viewDirection, fov, nearPlane, farPlane)) {
+                continue;
+            }
+            readChunkLocked(i, m_prefetchEnabled, chunkPoints, loadedNow);
+        }
+        if (loadedNow) {
+            auto* self = const_cast<PointCloudMemoryManager*>(this);
+            self->emitChunkLoaded(i);
+            self->emitMemoryUsageChanged(getCurrentMemoryUsage(), m_maxMemoryUsage);
         }
+        
+        visiblePoints.insert(visiblePoints.end(), chunkPoints.begin(), chunkPoints.end());
     }
     
     return visiblePoints;
 }
 
+std::vector<ChunkRenderView> PointCloudMemoryManager::selectPointBudget(const QVector3D& viewPosition,
+                                                                       const QVector3D& viewDirection,
+                                                                       float fov,
+                                                                       float nearPlane,
+                                                                       float farPlane,
+                                                                       size_t pointBudget) const
+{
+    auto* self = const_cast<PointCloudMemoryManager*>(this);
+    std::vector<ChunkRenderView> views;
+    std::vector<size_t> loadedNow;
+    
+    {
+        QMutexLocker locker(&m_stateMutex);
+        
+        // 上一帧的视图失效
+        for (auto& state : self->m_cacheState) {
+            state.renderPinned = false;
+        }
+        
+        CameraMotionState frustum;
+        frustum.fov = fov;
+        frustum.nearPlane = nearPlane;
+        frustum.farPlane = farPlane;
+        
+        QVector3D direction = viewDirection.normalized();
+        float tanHalfFov = qMax(1e-6f, qTan(qDegreesToRadians(fov * 0.5f)));
+        
+        // 视锥体内的块及其屏幕覆盖比例（包围球投影面积 / 视口面积）
+        std::vector<std::pair<size_t, float>> candidates;
+        for (size_t i = 0; i < m_chunks.size(); ++i) {
+            const auto& chunk = m_chunks[i];
+            if (!chunk || chunk->pointCount == 0 ||
+                distanceToViewFrustum(*chunk, viewPosition, direction, frustum) > 0.0f) {
+                continue;
+            }
+            
+            QVector3D chunkCenter = (chunk->boundingBoxMin + chunk->boundingBoxMax) * 0.5f;
+            float chunkRadius = (chunk->boundingBoxMax - chunk->boundingBoxMin).length() * 0.5f;
+            float depth = qMax(nearPlane, QVector3D::dotProduct(chunkCenter - viewPosition, direction));
+            float projected = chunkRadius / (depth * tanHalfFov);
+            
+            candidates.emplace_back(i, qBound(1e-6f, projected * projected, 1.0f));
+        }
+        
+        std::sort(candidates.begin(), candidates.end(),
+                  [](const auto& a, const auto& b) { return a.second > b.second; });
+        
+        // 确保块驻留并固定，后续加载不会淘汰本帧已选中的块
+        std::vector<std::pair<size_t, float>> resident;
+        for (const auto& candidate : candidates) {
+            size_t chunkIndex = candidate.first;
+            self->updateChunkAccessTime(chunkIndex);
+            
+            if (!m_chunks[chunkIndex]->isLoaded) {
+                if (m_prefetchEnabled) {
+                    self->schedulePrefetch(chunkIndex, -1.0f);
+                    continue;
+                }
+                if (!self->loadChunkLocked(chunkIndex, m_autoMemoryManagement)) {
+                    continue;
+                }
+                loadedNow.push_back(chunkIndex);
+            }
+            
+            self->m_cacheState[chunkIndex].renderPinned = true;
+            resident.push_back(candidate);
+        }
+        
+        // 水位填充：按覆盖比例分配预算，从点数/覆盖比最小的块开始，
+        // 点数不足分配额的块全部保留，余量按比例留给剩余的块
+        std::vector<size_t> fillOrder(resident.size());
+        for (size_t k = 0; k < fillOrder.size(); ++k) {
+            fillOrder[k] = k;
+        }
+        std::sort(fillOrder.begin(), fillOrder.end(), [&](size_t a, size_t b) {
+            return m_chunks[resident[a].first]->pointCount / resident[a].second <
+                   m_chunks[resident[b].first]->pointCount / resident[b].second;
+        });
+        
+        double remainingBudget = static_cast<double>(pointBudget);
+        double remainingCoverage = 0.0;
+        for (const auto& entry : resident) {
+            remainingCoverage += entry.second;
+        }
+        
+        std::vector<size_t> allocation(resident.size(), 0);
+        for (size_t k : fillOrder) {
+            size_t pointCount = m_chunks[resident[k].first]->pointCount;
+            double share = remainingCoverage > 0.0 ? remainingBudget * resident[k].second / remainingCoverage : 0.0;
+            allocation[k] = qMin(pointCount, static_cast<size_t>(share));
+            remainingBudget -= allocation[k];
+            remainingCoverage -= resident[k].second;
+        }
+        
+        // 生成视图（保持屏幕覆盖降序）
+        for (size_t k = 0; k < resident.size(); ++k) {
+            if (allocation[k] == 0) {
+                continue;
+            }
+            
+            const auto& chunk = m_chunks[resident[k].first];
+            
+            ChunkRenderView view;
+            view.chunkIndex = resident[k].first;
+            view.stride = (chunk->pointCount + allocation[k] - 1) / allocation[k];
+            view.pointCount = (chunk->pointCount + view.stride - 1) / view.stride;
+            view.screenCoverage = resident[k].second;
+            view.encoding = chunk->encoding;
+            view.points = chunk->points.data();
+            view.quantizedPoints = chunk->quantizedPoints.data();
+            view.origin = chunk->boundingBoxMin;
+            view.quantizationStep = chunk->quantizationStep;
+            views.push_back(view);
+        }
+    }
+    
+    for (size_t chunkIndex : loadedNow) {
+        self->emitChunkLoaded(chunkIndex);
+    }
+    if (!loadedNow.empty()) {
+        self->emitMemoryUsageChanged(getCurrentMemoryUsage(), m_maxMemoryUsage);
+    }
+    
+    return views;
+}
+
+void PointCloudMemoryManager::releaseRenderViews() const
+{
+    QMutexLocker locker(&m_stateMutex);
+    for (auto& state : const_cast<PointCloudMemoryManager*>(this)->m_cacheState) {
+        state.renderPinned = false;
+    }
+}
+
 bool PointCloudMemoryManager::preloadRegion(const QVector3D& center, float radius)
 {
     QElapsedTimer timer;
     timer.start();
     
+    // 收集区域内未加载的块及其距离
+    std::vector<std::pair<float, size_t>> candidates;
+    {
+        QMutexLocker locker(&m_stateMutex);
+        for (size_t i = 0; i < m_chunks.size(); ++i) {
+            if (m_chunks[i] && !m_chunks[i]->isLoaded) {
+                // 检查块是否在指定区域内
+                QVector3D chunkCenter = (m_chunks[i]->boundingBoxMin + m_chunks[i]->boundingBoxMax) * 0.5f;
+                float distance = (chunkCenter - center).length();
+                
+                if (distance <= radius) {
+                    candidates.emplace_back(distance, i);
+                }
+            }
+        }
+    }
+    
     size_t loadedCount = 0;
     
-    for (size_t i = 0; i < m_chunks.size(); ++i) {
-        if (m_chunks[i] && !m_chunks[i]->isLoaded) {
-            // 检查块是否在指定区域内
-            QVector3D chunkCenter = (m_chunks[i]->boundingBoxMin + m_chunks[i]->boundingBoxMax) * 0.5f;
-            float distance = (chunkCenter - center).length();
-            
-            if (distance <= radius) {
-                // 预加载这个块
-                getChunkPoints(i); // 这会触发加载
-                loadedCount++;
-            }
+    for (const auto& candidate : candidates) {
+        if (m_prefetchEnabled) {
+            // 交给后台线程加载，距离越近优先级越高
+            schedulePrefetch(candidate.second, candidate.first);
+        } else {
+            getChunkPoints(candidate.second); // 这会触发加载
         }
+        loadedCount++;
     }
     
-    emit statusMessage(QString("Preloaded %1 chunks in region (center: %2, radius: %3) in %4 ms")
+    emit statusMessage(QString("%1 %2 chunks in region (center: %3, radius: %4) in %5 ms")
+                      .arg(m_prefetchEnabled ? "Queued" : "Preloaded")
                       .arg(loadedCount)
                       .arg(QString("(%1,%2,%3)").arg(center.x()).arg(center.y()).arg(center.z()))
                       .arg(radius)
@@ -254,34 +542,148 @@ bool PointCloudMemoryManager::preloadRegion(const QVector3D& center, float radiu
     return loadedCount > 0;
 }
 
-bool PointCloudMemoryManager::unloadChunk(size_t chunkIndex)
+void PointCloudMemoryManager::setPrefetchEnabled(bool enabled)
 {
-    if (chunkIndex >= m_chunks.size() || !m_chunks[chunkIndex] || !m_chunks[chunkIndex]->isLoaded) {
-        return false;
+    if (m_prefetchEnabled == enabled) {
+        return;
     }
     
-    QElapsedTimer timer;
-    timer.start();
-    
-    auto& chunk = m_chunks[chunkIndex];
+    if (!enabled) {
+        cancelPrefetch();
+    }
     
-    // 从加载队列中移除
-    auto it = std::find(m_loadedChunks.begin(), m_loadedChunks.end(), chunkIndex);
-    if (it != m_loadedChunks.end()) {
-        m_loadedChunks.erase(it);
+    m_prefetchEnabled = enabled;
+    emit statusMessage(QString("Asynchronous prefetch %1").arg(enabled ? "enabled" : "disabled"));
+}
+
+bool PointCloudMemoryManager::isPrefetchEnabled() const
+{
+    return m_prefetchEnabled;
+}
+
+void PointCloudMemoryManager::setPrefetchThreadCount(int threadCount)
+{
+    if (threadCount > 0) {
+        m_prefetchPool.setMaxThreadCount(threadCount);
+    }
+}
+
+void PointCloudMemoryManager::setPrefetchLookahead(float seconds)
+{
+    m_prefetchLookahead = qMax(0.0f, seconds);
+}
+
+void PointCloudMemoryManager::setPrefetchFrustum(float fov, float nearPlane, float farPlane)
+{
+    QMutexLocker locker(&m_stateMutex);
+    m_cameraState.fov = fov;
+    m_cameraState.nearPlane = nearPlane;
+    m_cameraState.farPlane = farPlane;
+}
+
+CameraMotionState PointCloudMemoryManager::getCameraMotionState() const
+{
+    QMutexLocker locker(&m_stateMutex);
+    return m_cameraState;
+}
+
+bool PointCloudMemoryManager::isChunkResident(size_t chunkIndex) const
+{
+    QMutexLocker locker(&m_stateMutex);
+    return chunkIndex < m_chunks.size() && m_chunks[chunkIndex] && m_chunks[chunkIndex]->isLoaded;
+}
+
+size_t PointCloudMemoryManager::getPendingPrefetchCount() const
+{
+    QMutexLocker locker(&m_prefetchMutex);
+    return m_prefetchQueue.size();
+}
+
+bool PointCloudMemoryManager::waitForPrefetch(int msecs)
+{
+    return m_prefetchPool.waitForDone(msecs);
+}
+
+void PointCloudMemoryManager::updateCameraState(const QVector3D& position, const QVector3D& viewDirection)
+{
+    {
+        QMutexLocker locker(&m_stateMutex);
+        
+        QVector3D direction = viewDirection.normalized();
+        if (direction.isNull()) {
+            direction = m_cameraState.viewDirection;
+        }
+        
+        if (m_cameraState.isValid && m_cameraTimer.isValid()) {
+            float dt = m_cameraTimer.restart() / 1000.0f;
+            
+            if (dt >= 0.5f) {
+                // 长时间无操作，视为静止
+                m_cameraState.velocity = QVector3D();
+                m_cameraState.angularVelocity = QVector3D();
+            } else if (dt > 0.0f) {
+                // 指数平滑速度估计，抑制鼠标事件抖动
+                QVector3D velocity = (position - m_cameraState.position) / dt;
+                QVector3D angularVelocity = (direction - m_cameraState.viewDirection) / dt;
+                m_cameraState.velocity = m_cameraState.velocity * 0.5f + velocity * 0.5f;
+                m_cameraState.angularVelocity = m_cameraState.angularVelocity * 0.5f + angularVelocity * 0.5f;
+            }
+        } else {
+            m_cameraTimer.start();
+        }
+        
+        m_cameraState.position = position;
+        m_cameraState.viewDirection = direction;
+        m_cameraState.isValid = true;
     }
     
-    // 更新内存使用量
-    m_currentMemoryUsage -= chunk->memoryUsage;
+    if (m_prefetchEnabled) {
+        schedulePredictedPrefetch();
+    }
+}
+
+bool PointCloudMemoryManager::unloadChunk(size_t chunkIndex)
+{
+    QElapsedTimer timer;
+    timer.start();
     
-    // 标记为未加载
-    chunk->isLoaded = false;
+    size_t currentUsage = 0;
     
-    m_totalUnloadOperations++;
-    m_totalUnloadTime += timer.elapsed();
+    {
+        QMutexLocker locker(&m_stateMutex);
+        
+        if (chunkIndex >= m_chunks.size() || !m_chunks[chunkIndex] || !m_chunks[chunkIndex]->isLoaded) {
+            return false;
+        }
+        
+        // 渲染视图仍在引用的块不能释放
+        if (chunkIndex < m_cacheState.size() && m_cacheState[chunkIndex].renderPinned) {
+            return false;
+        }
+        
+        auto& chunk = m_chunks[chunkIndex];
+        
+        // 从加载队列中移除
+        auto it = std::find(m_loadedChunks.begin(), m_loadedChunks.end(), chunkIndex);
+        if (it != m_loadedChunks.end()) {
+            m_loadedChunks.erase(it);
+        }
+        
+        // 更新内存使用量
+        m_currentMemoryUsage -= chunk->memoryUsage;
+        
+        // 标记为未加载，只保留压缩数据
+        chunk->isLoaded = false;
+        releaseResidentData(*chunk);
+        onChunkEvicted(chunkIndex);
+        
+        m_totalUnloadOperations++;
+        m_totalUnloadTime += timer.elapsed();
+        currentUsage = m_currentMemoryUsage;
+    }
     
     emit chunkUnloaded(chunkIndex);
-    emit memoryUsageChanged(m_currentMemoryUsage, m_maxMemoryUsage);
+    emit memoryUsageChanged(currentUsage, m_maxMemoryUsage);
     
     return true;
 }
@@ -295,6 +697,8 @@ bool PointCloudMemoryManager::optimizeMemoryUsage()
     QElapsedTimer timer;
     timer.start();
     
+    QMutexLocker locker(&m_stateMutex);
+    
     size_t initialMemory = m_currentMemoryUsage;
     size_t targetMemory = m_maxMemoryUsage * 0.7; // 目标使用70%
     
@@ -311,11 +715,14 @@ bool PointCloudMemoryManager::optimizeMemoryUsage()
 
 size_t PointCloudMemoryManager::getCurrentMemoryUsage() const
 {
+    QMutexLocker locker(&m_stateMutex);
     return m_currentMemoryUsage;
 }
 
 QVariantMap PointCloudMemoryManager::getMemoryStatistics() const
 {
+    QMutexLocker locker(&m_stateMutex);
+    
     if (!m_statisticsValid) {
         const_cast<PointCloudMemoryManager*>(this)->updateMemoryStatistics();
     }
@@ -325,10 +732,22 @@ QVariantMap PointCloudMemoryManager::getMemoryStatistics() const
 
 void PointCloudMemoryManager::clearAllData()
 {
-    m_chunks.clear();
-    m_loadedChunks.clear();
-    m_currentMemoryUsage = 0;
-    m_statisticsValid = false;
+    // 先停止预取线程，再释放块数据
+    cancelPrefetch();
+    
+    {
+        QMutexLocker locker(&m_stateMutex);
+        m_chunks.clear();
+        m_loadedChunks.clear();
+        m_cacheState.clear();
+        m_currentMemoryUsage = 0;
+        m_statisticsValid = false;
+    }
+    
+    {
+        QMutexLocker locker(&m_prefetchMutex);
+        m_prefetchQueuedPriority.clear();
+    }
     
     emit statusMessage("All data cleared");
     emit memoryUsageChanged(0, m_maxMemoryUsage);
@@ -336,6 +755,7 @@ void PointCloudMemoryManager::clearAllData()
 
 void PointCloudMemoryManager::setChunkPriority(size_t chunkIndex, int priority)
 {
+    QMutexLocker locker(&m_stateMutex);
     if (chunkIndex < m_chunks.size() && m_chunks[chunkIndex]) {
         m_chunks[chunkIndex]->priority = priority;
     }
@@ -352,39 +772,270 @@ bool PointCloudMemoryManager::isAutoMemoryManagementEnabled() const
     return m_autoMemoryManagement;
 }
 
+void PointCloudMemoryManager::setChunkEncoding(ChunkEncoding encoding)
+{
+    m_chunkEncoding = encoding;
+}
+
+ChunkEncoding PointCloudMemoryManager::getChunkEncoding() const
+{
+    return m_chunkEncoding;
+}
+
+void PointCloudMemoryManager::setMaxQuantizationError(float maxError)
+{
+    m_maxQuantizationError = qMax(0.0f, maxError);
+}
+
+void PointCloudMemoryManager::setColdChunkCompressionEnabled(bool enabled)
+{
+    m_coldCompressionEnabled = enabled;
+}
+
+bool PointCloudMemoryManager::isColdChunkCompressionEnabled() const
+{
+    return m_coldCompressionEnabled;
+}
+
 // 私有方法实现
+std::vector<size_t> PointCloudMemoryManager::computeSpatialOrder(const std::vector<QVector3D>& points) const
+{
+    auto boundingBox = computeChunkBoundingBox(points);
+    QVector3D extent = boundingBox.second - boundingBox.first;
+
+    // 每轴量化到 2^21 个单元，退化轴使用单位缩放
+    const float cellCount = static_cast<float>((1u << kMortonBitsPerAxis) - 1);
+    QVector3D scale(extent.x() > 0.0f ? cellCount / extent.x() : 1.0f,
+                    extent.y() > 0.0f ? cellCount / extent.y() : 1.0f,
+                    extent.z() > 0.0f ? cellCount / extent.z() : 1.0f);
+
+    std::vector<std::pair<quint64, size_t>> keyedIndices;
+    keyedIndices.reserve(points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        keyedIndices.emplace_back(computeMortonCode(points[i], boundingBox.first, scale), i);
+    }
+
+    std::sort(keyedIndices.begin(), keyedIndices.end());
+
+    std::vector<size_t> order;
+    order.reserve(keyedIndices.size());
+    for (const auto& keyed : keyedIndices) {
+        order.push_back(keyed.second);
+    }
+
+    return order;
+}
+
 std::unique_ptr<PointCloudChunk> PointCloudMemoryManager::createChunk(const std::vector<QVector3D>& points,
+                                                                      const std::vector<size_t>& order,
                                                                       size_t startIndex,
                                                                       size_t endIndex)
 {
-    if (startIndex >= endIndex || endIndex > points.size()) {
+    if (startIndex >= endIndex || endIndex > order.size()) {
         return nullptr;
     }
 
     auto chunk = std::make_unique<PointCloudChunk>();
 
-    // 复制点数据
-    chunk->points.reserve(endIndex - startIndex);
+    // 按空间顺序收集点数据
+    std::vector<QVector3D> chunkPoints;
+    chunkPoints.reserve(endIndex - startIndex);
     for (size_t i = startIndex; i < endIndex; ++i) {
-        chunk->points.push_back(points[i]);
+        chunkPoints.push_back(points[order[i]]);
     }
 
     // 计算边界框
-    auto boundingBox = computeChunkBoundingBox(chunk->points);
+    auto boundingBox = computeChunkBoundingBox(chunkPoints);
     chunk->boundingBoxMin = boundingBox.first;
     chunk->boundingBoxMax = boundingBox.second;
 
-    // 计算内存使用量
-    chunk->memoryUsage = chunk->points.size() * sizeof(QVector3D);
+    // 编码驻留数据并计算内存使用量
+    encodeChunkPoints(*chunk, chunkPoints);
 
     // 设置默认属性
     chunk->priority = 0;
     chunk->isLoaded = false;
     chunk->lastAccessTime = 0;
+    chunk->accessCount = 0;
+    chunk->reloadCost = static_cast<float>(kReloadOverheadMs + chunk->memoryUsage / kRawReloadBytesPerMs);
+
+    // 冷块只保留压缩数据，加载时再解压
+    if (m_coldCompressionEnabled) {
+        chunk->compressedData = compressChunkData(*chunk);
+        releaseResidentData(*chunk);
+        chunk->reloadCost = static_cast<float>(kReloadOverheadMs +
+                                               chunk->compressedData.size() / kCompressedReloadBytesPerMs);
+    }
 
     return chunk;
 }
 
+void PointCloudMemoryManager::encodeChunkPoints(PointCloudChunk& chunk, const std::vector<QVector3D>& points) const
+{
+    chunk.pointCount = points.size();
+    chunk.points.clear();
+    chunk.quantizedPoints.clear();
+
+    QVector3D extent = chunk.boundingBoxMax - chunk.boundingBoxMin;
+    float maxExtent = qMax(extent.x(), qMax(extent.y(), extent.z()));
+
+    // 量化误差为半个网格步长，超出允许误差的块保持浮点存储
+    bool quantize = m_chunkEncoding == ChunkEncoding::Quantized16 &&
+                    maxExtent / kQuantizationLevels * 0.5f <= m_maxQuantizationError;
+
+    if (!quantize) {
+        chunk.encoding = ChunkEncoding::Raw;
+        chunk.points = points;
+        chunk.quantizationStep = QVector3D();
+        chunk.memoryUsage = points.size() * sizeof(QVector3D);
+        return;
+    }
+
+    chunk.encoding = ChunkEncoding::Quantized16;
+    chunk.quantizationStep = extent / kQuantizationLevels;
+
+    const float minValue[3] = {chunk.boundingBoxMin.x(), chunk.boundingBoxMin.y(), chunk.boundingBoxMin.z()};
+    float inverseStep[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        float step = chunk.quantizationStep[axis];
+        inverseStep[axis] = step > 0.0f ? 1.0f / step : 0.0f;
+    }
+
+    chunk.quantizedPoints.resize(points.size() * 3);
+    for (size_t i = 0; i < points.size(); ++i) {
+        for (int axis = 0; axis < 3; ++axis) {
+            float cell = (points[i][axis] - minValue[axis]) * inverseStep[axis];
+            chunk.quantizedPoints[i * 3 + axis] =
+                static_cast<quint16>(qBound(0.0f, cell + 0.5f, kQuantizationLevels));
+        }
+    }
+
+    chunk.memoryUsage = chunk.quantizedPoints.size() * sizeof(quint16);
+}
+
+std::vector<QVector3D> PointCloudMemoryManager::decodeChunkPoints(const PointCloudChunk& chunk) const
+{
+    if (chunk.encoding == ChunkEncoding::Raw) {
+        return chunk.points;
+    }
+
+    std::vector<QVector3D> points(chunk.pointCount);
+    if (chunk.quantizedPoints.size() < chunk.pointCount * 3) {
+        return {};
+    }
+
+    const quint16* input = chunk.quantizedPoints.data();
+    float* output = reinterpret_cast<float*>(points.data());
+    const size_t valueCount = chunk.pointCount * 3;
+
+    const float offset[3] = {chunk.boundingBoxMin.x(), chunk.boundingBoxMin.y(), chunk.boundingBoxMin.z()};
+    const float step[3] = {chunk.quantizationStep.x(), chunk.quantizationStep.y(), chunk.quantizationStep.z()};
+
+    size_t i = 0;
+
+#ifdef WALL_EXTRACTION_HAS_SSE2
+    // 每次解码4个点（12个分量），三组4通道的步长/偏移按xyz循环排列
+    const __m128 scale0 = _mm_setr_ps(step[0], step[1], step[2], step[0]);
+    const __m128 scale1 = _mm_setr_ps(step[1], step[2], step[0], step[1]);
+    const __m128 scale2 = _mm_setr_ps(step[2], step[0], step[1], step[2]);
+    const __m128 offset0 = _mm_setr_ps(offset[0], offset[1], offset[2], offset[0]);
+    const __m128 offset1 = _mm_setr_ps(offset[1], offset[2], offset[0], offset[1]);
+    const __m128 offset2 = _mm_setr_ps(offset[2], offset[0], offset[1], offset[2]);
+    const __m128i zero = _mm_setzero_si128();
+
+    for (; i + 12 <= valueCount; i += 12) {
+        __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+        __m128i high = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(input + i + 8));
+
+        __m128 v0 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(low, zero));
+        __m128 v1 = _mm_cvtepi32_ps(_mm_unpackhi_epi16(low, zero));
+        __m128 v2 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(high, zero));
+
+        _mm_storeu_ps(output + i, _mm_add_ps(_mm_mul_ps(v0, scale0), offset0));
+        _mm_storeu_ps(output + i + 4, _mm_add_ps(_mm_mul_ps(v1, scale1), offset1));
+        _mm_storeu_ps(output + i + 8, _mm_add_ps(_mm_mul_ps(v2, scale2), offset2));
+    }
+#endif
+
+    for (; i < valueCount; ++i) {
+        size_t axis = i % 3;
+        output[i] = offset[axis] + input[i] * step[axis];
+    }
+
+    return points;
+}
+
+QByteArray PointCloudMemoryManager::compressChunkData(const PointCloudChunk& chunk) const
+{
+    if (chunk.encoding == ChunkEncoding::Raw) {
+        QByteArray raw(reinterpret_cast<const char*>(chunk.points.data()),
+                       static_cast<int>(chunk.points.size() * sizeof(QVector3D)));
+        return qCompress(raw, kColdCompressionLevel);
+    }
+
+    // Morton顺序下相邻点坐标接近，分量差分后数值集中在0附近，便于LZ压缩
+    const auto& quantized = chunk.quantizedPoints;
+    std::vector<quint16> deltas(quantized.size());
+    for (size_t i = 0; i < quantized.size(); ++i) {
+        quint16 previous = i >= 3 ? quantized[i - 3] : 0;
+        deltas[i] = static_cast<quint16>(quantized[i] - previous);
+    }
+
+    QByteArray raw(reinterpret_cast<const char*>(deltas.data()),
+                   static_cast<int>(deltas.size() * sizeof(quint16)));
+    return qCompress(raw, kColdCompressionLevel);
+}
+
+bool PointCloudMemoryManager::decompressChunkData(PointCloudChunk& chunk) const
+{
+    bool hasResidentData = chunk.encoding == ChunkEncoding::Raw ?
+        chunk.points.size() == chunk.pointCount : chunk.quantizedPoints.size() == chunk.pointCount * 3;
+    if (hasResidentData) {
+        return true;
+    }
+
+    if (chunk.compressedData.isEmpty()) {
+        return false;
+    }
+
+    QByteArray raw = qUncompress(chunk.compressedData);
+
+    if (chunk.encoding == ChunkEncoding::Raw) {
+        if (static_cast<size_t>(raw.size()) != chunk.pointCount * sizeof(QVector3D)) {
+            return false;
+        }
+        chunk.points.resize(chunk.pointCount);
+        std::memcpy(chunk.points.data(), raw.constData(), raw.size());
+        return true;
+    }
+
+    if (static_cast<size_t>(raw.size()) != chunk.pointCount * 3 * sizeof(quint16)) {
+        return false;
+    }
+
+    auto& quantized = chunk.quantizedPoints;
+    quantized.resize(chunk.pointCount * 3);
+    std::memcpy(quantized.data(), raw.constData(), raw.size());
+
+    // 还原差分
+    for (size_t i = 3; i < quantized.size(); ++i) {
+        quantized[i] = static_cast<quint16>(quantized[i] + quantized[i - 3]);
+    }
+
+    return true;
+}
+
+void PointCloudMemoryManager::releaseResidentData(PointCloudChunk& chunk) const
+{
+    // 没有压缩副本的块必须保留驻留数据
+    if (chunk.compressedData.isEmpty()) {
+        return;
+    }
+
+    std::vector<QVector3D>().swap(chunk.points);
+    std::vector<quint16>().swap(chunk.quantizedPoints);
+}
+
 std::pair<QVector3D, QVector3D> PointCloudMemoryManager::computeChunkBoundingBox(const std::vector<QVector3D>& points) const
 {
     if (points.empty()) {
@@ -434,39 +1085,255 @@ bool PointCloudMemoryManager::isChunkVisible(const PointCloudChunk& chunk,
     return angle <= qDegreesToRadians(fov * 0.5f);
 }
 
+bool PointCloudMemoryManager::loadChunkLocked(size_t chunkIndex, bool allowEviction)
+{
+    if (chunkIndex >= m_chunks.size() || !m_chunks[chunkIndex] || m_chunks[chunkIndex]->isLoaded) {
+        return false;
+    }
+    
+    auto& chunk = m_chunks[chunkIndex];
+    
+    // 检查内存限制
+    if (m_currentMemoryUsage + chunk->memoryUsage > m_maxMemoryUsage) {
+        if (!allowEviction) {
+            return false;
+        }
+        performMemoryCleanup(m_maxMemoryUsage - qMin(chunk->memoryUsage, m_maxMemoryUsage));
+    }
+    
+    // 解压冷数据，实测耗时用于修正重载代价
+    QElapsedTimer decodeTimer;
+    decodeTimer.start();
+    if (!decompressChunkData(*chunk)) {
+        qWarning() << "Failed to decompress chunk" << chunkIndex;
+        return false;
+    }
+    if (!chunk->compressedData.isEmpty()) {
+        float measuredCost = static_cast<float>(kReloadOverheadMs + decodeTimer.nsecsElapsed() / 1.0e6);
+        chunk->reloadCost = chunk->reloadCost * 0.5f + measuredCost * 0.5f;
+    }
+    
+    // 加载块
+    chunk->isLoaded = true;
+    chunk->lastAccessTime = QDateTime::currentMSecsSinceEpoch();
+    m_loadedChunks.push_back(chunkIndex);
+    m_currentMemoryUsage += chunk->memoryUsage;
+    m_statisticsValid = false;
+    onChunkAdmitted(chunkIndex);
+    
+    return true;
+}
+
+void PointCloudMemoryManager::schedulePrefetch(size_t chunkIndex, float priority)
+{
+    QMutexLocker locker(&m_prefetchMutex);
+    
+    // 已以更高优先级排队的块不再重复入队
+    if (chunkIndex >= m_prefetchQueuedPriority.size() || m_prefetchQueuedPriority[chunkIndex] <= priority) {
+        return;
+    }
+    
+    m_prefetchQueuedPriority[chunkIndex] = priority;
+    m_prefetchQueue.push({priority, chunkIndex});
+    
+    if (m_activePrefetchWorkers < m_prefetchPool.maxThreadCount()) {
+        ++m_activePrefetchWorkers;
+        quint64 generation = m_prefetchGeneration;
+        m_prefetchPool.start([this, generation]() { runPrefetchWorker(generation); });
+    }
+}
+
+void PointCloudMemoryManager::schedulePredictedPrefetch()
+{
+    std::vector<std::pair<float, size_t>> candidates;
+    
+    {
+        QMutexLocker locker(&m_stateMutex);
+        
+        const CameraMotionState& camera = m_cameraState;
+        if (!camera.isValid) {
+            return;
+        }
+        
+        // 按当前速度外推前瞻时间后的相机位置和视线方向
+        QVector3D predictedPosition = camera.position + camera.velocity * m_prefetchLookahead;
+        QVector3D predictedDirection = (camera.viewDirection + camera.angularVelocity * m_prefetchLookahead).normalized();
+        if (predictedDirection.isNull()) {
+            predictedDirection = camera.viewDirection;
+        }
+        
+        // 运动越快，视锥体外需要预取的范围越大
+        float margin = camera.velocity.length() * m_prefetchLookahead;
+        
+        for (size_t i = 0; i < m_chunks.size(); ++i) {
+            if (!m_chunks[i] || m_chunks[i]->isLoaded) {
+                continue;
+            }
+            
+            float distance = qMin(distanceToViewFrustum(*m_chunks[i], camera.position, camera.viewDirection, camera),
+                                  distanceToViewFrustum(*m_chunks[i], predictedPosition, predictedDirection, camera));
+            if (distance > margin) {
+                continue;
+            }
+            
+            // 视锥体内的块按到相机的距离排序
+            QVector3D chunkCenter = (m_chunks[i]->boundingBoxMin + m_chunks[i]->boundingBoxMax) * 0.5f;
+            float priority = distance + 0.01f * (chunkCenter - camera.position).length();
+            candidates.emplace_back(priority, i);
+        }
+    }
+    
+    {
+        // 丢弃过期的预测请求，保留渲染急需的请求
+        QMutexLocker locker(&m_prefetchMutex);
+        std::vector<PrefetchRequest> urgent;
+        while (!m_prefetchQueue.empty()) {
+            if (m_prefetchQueue.top().priority < 0.0f) {
+                urgent.push_back(m_prefetchQueue.top());
+            } else {
+                m_prefetchQueuedPriority[m_prefetchQueue.top().chunkIndex] = std::numeric_limits<float>::infinity();
+            }
+            m_prefetchQueue.pop();
+        }
+        for (const auto& request : urgent) {
+            m_prefetchQueue.push(request);
+        }
+    }
+    
+    for (const auto& candidate : candidates) {
+        schedulePrefetch(candidate.second, candidate.first);
+    }
+}
+
+float PointCloudMemoryManager::distanceToViewFrustum(const PointCloudChunk& chunk,
+                                                    const QVector3D& position,
+                                                    const QVector3D& direction,
+                                                    const CameraMotionState& camera) const
+{
+    // 以包围球近似块，以圆锥近似视锥体
+    QVector3D chunkCenter = (chunk.boundingBoxMin + chunk.boundingBoxMax) * 0.5f;
+    float chunkRadius = (chunk.boundingBoxMax - chunk.boundingBoxMin).length() * 0.5f;
+    
+    QVector3D toChunk = chunkCenter - position;
+    float along = QVector3D::dotProduct(toChunk, direction);
+    float lateral = qSqrt(qMax(0.0f, toChunk.lengthSquared() - along * along));
+    
+    float outside = 0.0f;
+    
+    // 近平面之前或远平面之后的部分
+    if (along + chunkRadius < camera.nearPlane) {
+        outside += camera.nearPlane - (along + chunkRadius);
+    }
+    if (along - chunkRadius > camera.farPlane) {
+        outside += (along - chunkRadius) - camera.farPlane;
+    }
+    
+    // 视野圆锥之外的部分
+    float coneRadius = qMax(0.0f, along) * qTan(qDegreesToRadians(camera.fov * 0.5f));
+    outside += qMax(0.0f, lateral - coneRadius - chunkRadius);
+    
+    return outside;
+}
+
+void PointCloudMemoryManager::runPrefetchWorker(quint64 generation)
+{
+    forever {
+        PrefetchRequest request;
+        
+        {
+            QMutexLocker locker(&m_prefetchMutex);
+            if (m_prefetchQueue.empty() || generation != m_prefetchGeneration) {
+                --m_activePrefetchWorkers;
+                return;
+            }
+            
+            request = m_prefetchQueue.top();
+            m_prefetchQueue.pop();
+            if (request.chunkIndex < m_prefetchQueuedPriority.size()) {
+                m_prefetchQueuedPriority[request.chunkIndex] = std::numeric_limits<float>::infinity();
+            }
+        }
+        
+        bool loaded = false;
+        size_t currentUsage = 0;
+        
+        {
+            // 预测请求只在预算内加载；渲染急需的请求允许按策略卸载其他块
+            QMutexLocker locker(&m_stateMutex);
+            loaded = loadChunkLocked(request.chunkIndex, request.priority < 0.0f && m_autoMemoryManagement);
+            currentUsage = m_currentMemoryUsage;
+        }
+        
+        if (loaded) {
+            emit chunkLoaded(request.chunkIndex);
+            emit memoryUsageChanged(currentUsage, m_maxMemoryUsage);
+        }
+    }
+}
+
+void PointCloudMemoryManager::cancelPrefetch()
+{
+    {
+        QMutexLocker locker(&m_prefetchMutex);
+        ++m_prefetchGeneration;
+        while (!m_prefetchQueue.empty()) {
+            m_prefetchQueue.pop();
+        }
+        std::fill(m_prefetchQueuedPriority.begin(), m_prefetchQueuedPriority.end(),
+                  std::numeric_limits<float>::infinity());
+    }
+    
+    m_prefetchPool.waitForDone();
+}
+
 std::vector<size_t> PointCloudMemoryManager::selectChunksToUnload(size_t requiredMemory)
 {
     std::vector<size_t> chunksToUnload;
     size_t freedMemory = 0;
 
+    if (m_strategy == MemoryStrategy::ARC) {
+        std::vector<size_t> loaded(m_loadedChunks.begin(), m_loadedChunks.end());
+        return selectChunksToUnloadARC(loaded, requiredMemory);
+    }
+
     // 创建候选列表
-    std::vector<std::pair<size_t, qint64>> candidates; // (index, score)
+    std::vector<std::pair<size_t, std::pair<double, double>>> candidates; // (index, (score, tie-break))
 
+    size_t loadOrder = 0;
     for (size_t i : m_loadedChunks) {
-        if (i < m_chunks.size() && m_chunks[i] && m_chunks[i]->isLoaded) {
-            qint64 score = 0;
+        if (i < m_chunks.size() && m_chunks[i] && m_chunks[i]->isLoaded && !m_cacheState[i].renderPinned) {
+            const auto& chunk = m_chunks[i];
+            double recency = -static_cast<double>(chunk->lastAccessTime); // 越久未访问，分数越高
+            std::pair<double, double> score(0.0, 0.0);
 
             switch (m_strategy) {
                 case MemoryStrategy::LRU:
-                    score = -m_chunks[i]->lastAccessTime; // 越久未访问，分数越高
+                    score = {recency, 0.0};
                     break;
 
                 case MemoryStrategy::LFU:
-                    // 简化实现，使用访问时间作为频率指标
-                    score = -m_chunks[i]->lastAccessTime;
+                    score = {-static_cast<double>(chunk->accessCount), recency}; // 访问次数越少越先卸载
                     break;
 
                 case MemoryStrategy::FIFO:
-                    score = i; // 索引越小，越早创建
+                    score = {-static_cast<double>(loadOrder), 0.0}; // 越早加载，分数越高
                     break;
 
                 case MemoryStrategy::Priority:
-                    score = -m_chunks[i]->priority; // 优先级越低，越容易被卸载
+                    score = {-static_cast<double>(chunk->priority), recency}; // 优先级越低，越容易被卸载
+                    break;
+
+                case MemoryStrategy::CostAware:
+                    score = {-m_cacheState[i].retentionValue, recency}; // 保留价值越低越先卸载
+                    break;
+
+                case MemoryStrategy::ARC:
                     break;
             }
 
             candidates.emplace_back(i, score);
         }
+        loadOrder++;
     }
 
     // 按分数排序
@@ -489,11 +1356,166 @@ std::vector<size_t> PointCloudMemoryManager::selectChunksToUnload(size_t require
     return chunksToUnload;
 }
 
+std::vector<size_t> PointCloudMemoryManager::selectChunksToUnloadARC(const std::vector<size_t>& candidates,
+                                                                     size_t requiredMemory) const
+{
+    // T1、T2各自按最近访问时间排序（最久未访问在前）
+    std::vector<size_t> t1;
+    std::vector<size_t> t2;
+    double t1Bytes = 0.0;
+
+    for (size_t i : candidates) {
+        if (i >= m_chunks.size() || !m_chunks[i] || !m_chunks[i]->isLoaded || m_cacheState[i].renderPinned) {
+            continue;
+        }
+        if (i < m_cacheState.size() && m_cacheState[i].arcList == ArcList::T2) {
+            t2.push_back(i);
+        } else {
+            t1.push_back(i);
+            t1Bytes += m_chunks[i]->memoryUsage;
+        }
+    }
+
+    auto olderFirst = [this](size_t a, size_t b) {
+        return m_chunks[a]->lastAccessTime < m_chunks[b]->lastAccessTime;
+    };
+    std::sort(t1.begin(), t1.end(), olderFirst);
+    std::sort(t2.begin(), t2.end(), olderFirst);
+
+    std::vector<size_t> chunksToUnload;
+    size_t freedMemory = 0;
+    size_t t1Pos = 0;
+    size_t t2Pos = 0;
+
+    while (freedMemory < requiredMemory && (t1Pos < t1.size() || t2Pos < t2.size())) {
+        // T1超出目标大小时从T1淘汰，否则从T2淘汰
+        bool fromT1 = t1Pos < t1.size() && (t1Bytes > m_arcTargetT1 || t2Pos >= t2.size());
+        size_t chunkIndex = fromT1 ? t1[t1Pos++] : t2[t2Pos++];
+
+        if (fromT1) {
+            t1Bytes -= m_chunks[chunkIndex]->memoryUsage;
+        }
+        chunksToUnload.push_back(chunkIndex);
+        freedMemory += m_chunks[chunkIndex]->memoryUsage;
+    }
+
+    return chunksToUnload;
+}
+
 void PointCloudMemoryManager::updateChunkAccessTime(size_t chunkIndex)
 {
-    if (chunkIndex < m_chunks.size() && m_chunks[chunkIndex]) {
-        m_chunks[chunkIndex]->lastAccessTime = QDateTime::currentMSecsSinceEpoch();
+    QMutexLocker locker(&m_stateMutex);
+
+    if (chunkIndex >= m_chunks.size() || !m_chunks[chunkIndex]) {
+        return;
+    }
+
+    auto& chunk = m_chunks[chunkIndex];
+    chunk->lastAccessTime = QDateTime::currentMSecsSinceEpoch();
+
+    if (++chunk->accessCount >= kAccessCountAgingThreshold) {
+        for (auto& other : m_chunks) {
+            if (other) {
+                other->accessCount = (other->accessCount + 1) / 2;
+            }
+        }
+    }
+
+    PolicyCounters& counters = m_policyCounters[m_strategy];
+    if (chunk->isLoaded) {
+        counters.hits++;
+
+        if (chunkIndex < m_cacheState.size()) {
+            // 再次命中的块从最近列表晋升到频繁列表
+            auto& state = m_cacheState[chunkIndex];
+            if (state.arcList == ArcList::T1) {
+                state.arcList = ArcList::T2;
+            }
+            state.retentionValue = computeRetentionValue(chunkIndex);
+        }
+    } else {
+        counters.misses++;
     }
+
+    m_statisticsValid = false;
+}
+
+void PointCloudMemoryManager::onChunkAdmitted(size_t chunkIndex)
+{
+    if (chunkIndex >= m_cacheState.size()) {
+        return;
+    }
+
+    auto& state = m_cacheState[chunkIndex];
+    double chunkBytes = static_cast<double>(m_chunks[chunkIndex]->memoryUsage);
+
+    if (state.arcList == ArcList::B1 || state.arcList == ArcList::B2) {
+        double b1Count = std::count_if(m_cacheState.begin(), m_cacheState.end(),
+                                       [](const ChunkCacheState& s) { return s.arcList == ArcList::B1; });
+        double b2Count = std::count_if(m_cacheState.begin(), m_cacheState.end(),
+                                       [](const ChunkCacheState& s) { return s.arcList == ArcList::B2; });
+
+        if (state.arcList == ArcList::B1) {
+            // 最近列表淘汰过早：增大T1预算
+            m_arcTargetT1 = qMin(static_cast<double>(m_maxMemoryUsage),
+                                 m_arcTargetT1 + qMax(1.0, b2Count / b1Count) * chunkBytes);
+        } else {
+            // 频繁列表淘汰过早：减小T1预算
+            m_arcTargetT1 = qMax(0.0, m_arcTargetT1 - qMax(1.0, b1Count / b2Count) * chunkBytes);
+        }
+        state.arcList = ArcList::T2;
+    } else {
+        state.arcList = ArcList::T1;
+    }
+
+    state.ghostTime = 0;
+    state.retentionValue = computeRetentionValue(chunkIndex);
+}
+
+void PointCloudMemoryManager::onChunkEvicted(size_t chunkIndex)
+{
+    if (chunkIndex >= m_cacheState.size()) {
+        return;
+    }
+
+    auto& state = m_cacheState[chunkIndex];
+
+    // 被淘汰块的价值成为新的老化基准，使长期未访问的块价值相对下降
+    if (m_strategy == MemoryStrategy::CostAware) {
+        m_gdsfInflation = qMax(m_gdsfInflation, state.retentionValue);
+    }
+
+    state.arcList = (state.arcList == ArcList::T2) ? ArcList::B2 : ArcList::B1;
+    state.ghostTime = QDateTime::currentMSecsSinceEpoch();
+
+    // 幽灵列表长度不超过驻留块数，超出时丢弃最旧的记录
+    size_t ghostLimit = qMax(static_cast<size_t>(1), m_loadedChunks.size());
+    std::vector<size_t> ghosts;
+    for (size_t i = 0; i < m_cacheState.size(); ++i) {
+        if (m_cacheState[i].arcList == ArcList::B1 || m_cacheState[i].arcList == ArcList::B2) {
+            ghosts.push_back(i);
+        }
+    }
+
+    if (ghosts.size() > ghostLimit) {
+        size_t dropCount = ghosts.size() - ghostLimit;
+        std::partial_sort(ghosts.begin(), ghosts.begin() + dropCount, ghosts.end(),
+                          [this](size_t a, size_t b) { return m_cacheState[a].ghostTime < m_cacheState[b].ghostTime; });
+        for (size_t i = 0; i < dropCount; ++i) {
+            m_cacheState[ghosts[i]].arcList = ArcList::None;
+            m_cacheState[ghosts[i]].ghostTime = 0;
+        }
+    }
+}
+
+double PointCloudMemoryManager::computeRetentionValue(size_t chunkIndex) const
+{
+    const auto& chunk = m_chunks[chunkIndex];
+
+    // GreedyDual-Size-Frequency: H = L + 频率 x 重载代价 / 大小
+    double sizeMB = qMax(1e-3, chunk->memoryUsage / (1024.0 * 1024.0));
+    double frequency = qMax(1u, chunk->accessCount);
+    return m_gdsfInflation + frequency * chunk->reloadCost / sizeMB;
 }
 
 bool PointCloudMemoryManager::isMemoryLimitExceeded() const
@@ -511,9 +1533,13 @@ bool PointCloudMemoryManager::performMemoryCleanup(size_t targetMemory)
     auto chunksToUnload = selectChunksToUnload(requiredMemory);
 
     size_t unloadedCount = 0;
+    PolicyCounters& counters = m_policyCounters[m_strategy];
     for (size_t chunkIndex : chunksToUnload) {
+        size_t chunkMemory = m_chunks[chunkIndex]->memoryUsage;
         if (unloadChunk(chunkIndex)) {
             unloadedCount++;
+            counters.evictions++;
+            counters.evictedBytes += chunkMemory;
         }
     }
 
@@ -529,6 +1555,7 @@ void PointCloudMemoryManager::updateMemoryStatistics()
     m_memoryStatistics.clear();
 
     m_memoryStatistics["strategy"] = static_cast<int>(m_strategy);
+    m_memoryStatistics["strategy_name"] = memoryStrategyName(m_strategy);
     m_memoryStatistics["max_memory_mb"] = static_cast<qulonglong>(m_maxMemoryUsage / (1024 * 1024));
     m_memoryStatistics["current_memory_mb"] = static_cast<qulonglong>(m_currentMemoryUsage / (1024 * 1024));
     m_memoryStatistics["memory_usage_percent"] = static_cast<double>(m_currentMemoryUsage) / m_maxMemoryUsage * 100.0;
@@ -536,6 +1563,27 @@ void PointCloudMemoryManager::updateMemoryStatistics()
     m_memoryStatistics["total_chunks"] = static_cast<qulonglong>(m_chunks.size());
     m_memoryStatistics["loaded_chunks"] = static_cast<qulonglong>(m_loadedChunks.size());
     m_memoryStatistics["auto_management"] = m_autoMemoryManagement;
+    m_memoryStatistics["prefetch_enabled"] = m_prefetchEnabled.load();
+    m_memoryStatistics["pending_prefetch"] = static_cast<qulonglong>(getPendingPrefetchCount());
+
+    // 块存储编码统计
+    size_t totalPoints = 0;
+    size_t quantizedChunks = 0;
+    size_t coldStorageBytes = 0;
+    for (const auto& chunk : m_chunks) {
+        if (chunk) {
+            totalPoints += chunk->pointCount;
+            coldStorageBytes += chunk->compressedData.size();
+            if (chunk->encoding == ChunkEncoding::Quantized16) {
+                quantizedChunks++;
+            }
+        }
+    }
+    m_memoryStatistics["quantized_chunks"] = static_cast<qulonglong>(quantizedChunks);
+    m_memoryStatistics["cold_compression_enabled"] = m_coldCompressionEnabled;
+    m_memoryStatistics["cold_storage_mb"] = static_cast<double>(coldStorageBytes) / (1024.0 * 1024.0);
+    m_memoryStatistics["cold_compression_ratio"] = coldStorageBytes > 0 ?
+        static_cast<double>(totalPoints * sizeof(QVector3D)) / coldStorageBytes : 1.0;
 
     m_memoryStatistics["total_load_operations"] = static_cast<qulonglong>(m_totalLoadOperations);
     m_memoryStatistics["total_unload_operations"] = static_cast<qulonglong>(m_totalUnloadOperations);
@@ -544,6 +1592,35 @@ void PointCloudMemoryManager::updateMemoryStatistics()
     m_memoryStatistics["avg_unload_time_ms"] = m_totalUnloadOperations > 0 ?
         static_cast<double>(m_totalUnloadTime) / m_totalUnloadOperations : 0.0;
 
+    // 各策略的命中/未命中/淘汰统计，用于根据实际数据调整内存预算
+    QVariantMap policyStatistics;
+    for (const auto& entry : m_policyCounters) {
+        const PolicyCounters& counters = entry.second;
+        quint64 accesses = counters.hits + counters.misses;
+
+        QVariantMap policy;
+        policy["hits"] = counters.hits;
+        policy["misses"] = counters.misses;
+        policy["evictions"] = counters.evictions;
+        policy["evicted_mb"] = static_cast<double>(counters.evictedBytes) / (1024.0 * 1024.0);
+        policy["hit_rate"] = accesses > 0 ? static_cast<double>(counters.hits) / accesses : 0.0;
+        policyStatistics[memoryStrategyName(entry.first)] = policy;
+    }
+    m_memoryStatistics["policy_statistics"] = policyStatistics;
+
+    auto current = m_policyCounters.find(m_strategy);
+    PolicyCounters currentCounters = current != m_policyCounters.end() ? current->second : PolicyCounters();
+    quint64 currentAccesses = currentCounters.hits + currentCounters.misses;
+    m_memoryStatistics["cache_hits"] = currentCounters.hits;
+    m_memoryStatistics["cache_misses"] = currentCounters.misses;
+    m_memoryStatistics["evictions"] = currentCounters.evictions;
+    m_memoryStatistics["hit_rate"] = currentAccesses > 0 ?
+        static_cast<double>(currentCounters.hits) / currentAccesses : 0.0;
+
+    if (m_strategy == MemoryStrategy::ARC) {
+        m_memoryStatistics["arc_target_t1_mb"] = m_arcTargetT1 / (1024.0 * 1024.0);
+    }
+
     m_statisticsValid = true;
 }
 
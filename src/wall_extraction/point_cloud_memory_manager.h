@@ -3,25 +3,97 @@
 
 #include <QObject>
 #include <QVector3D>
+#include <QByteArray>
 #include <QVariantMap>
 #include <QDateTime>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QRecursiveMutex>
+#include <QThreadPool>
 #include <vector>
 #include <memory>
 #include <deque>
+#include <queue>
+#include <map>
+#include <atomic>
 
 namespace WallExtraction {
 
+// 块内点数据编码方式
+enum class ChunkEncoding {
+    Raw,            // 32位浮点坐标
+    Quantized16     // 相对块边界框的16位网格坐标
+};
+
 // 点云数据块
 struct PointCloudChunk {
-    std::vector<QVector3D> points;      // 点云数据
+    ChunkEncoding encoding;             // 驻留数据编码
+    size_t pointCount;                  // 点数
+    std::vector<QVector3D> points;      // 点云数据（Raw编码时使用）
+    std::vector<quint16> quantizedPoints; // 量化坐标，xyz交错（Quantized16编码时使用）
+    QVector3D quantizationStep;         // 各轴量化步长，原点为boundingBoxMin
+    QByteArray compressedData;          // 冷数据：差分+LZ压缩后的点数据，卸载时保留
     QVector3D boundingBoxMin;           // 边界框最小点
     QVector3D boundingBoxMax;           // 边界框最大点
     size_t memoryUsage;                 // 内存使用量
     int priority;                       // 优先级
     bool isLoaded;                      // 是否已加载
     qint64 lastAccessTime;              // 最后访问时间
+    quint32 accessCount;                // 访问次数（LFU/代价感知策略使用，定期衰减）
+    float reloadCost;                   // 重新加载代价估计（毫秒）
     
-    PointCloudChunk() : memoryUsage(0), priority(0), isLoaded(false), lastAccessTime(0) {}
+    PointCloudChunk()
+        : encoding(ChunkEncoding::Raw), pointCount(0), memoryUsage(0), priority(0), isLoaded(false), lastAccessTime(0), accessCount(0), reloadCost(0.0f) {}
+};
+
+// 点预算渲染视图：引用块驻留数据的抽样视图，不复制点
+//
+// 视图在下一次selectPointBudget()、releaseRenderViews()或clearAllData()之前有效，
+// 期间所引用的块不会被淘汰。量化块可直接以步长stride * 3个分量上传为顶点属性，
+// 在着色器中用origin + q * quantizationStep还原坐标。
+struct ChunkRenderView {
+    size_t chunkIndex;                  // 块索引
+    size_t stride;                      // 抽样步长（点）
+    size_t pointCount;                  // 视图中的点数
+    float screenCoverage;               // 估计的屏幕覆盖比例（0~1）
+    ChunkEncoding encoding;             // 数据编码
+    const QVector3D* points;            // Raw编码：块内浮点数据
+    const quint16* quantizedPoints;     // Quantized16编码：xyz交错量化数据
+    QVector3D origin;                   // 量化原点
+    QVector3D quantizationStep;         // 量化步长
+
+    ChunkRenderView()
+        : chunkIndex(0), stride(1), pointCount(0), screenCoverage(0.0f),
+          encoding(ChunkEncoding::Raw), points(nullptr), quantizedPoints(nullptr) {}
+
+    /**
+     * @brief 获取视图中第i个点
+     * @param i 视图内点序号（0 ~ pointCount-1）
+     * @return 点坐标
+     */
+    QVector3D point(size_t i) const {
+        size_t source = i * stride;
+        if (encoding == ChunkEncoding::Raw) {
+            return points[source];
+        }
+        const quint16* q = quantizedPoints + source * 3;
+        return origin + QVector3D(q[0], q[1], q[2]) * quantizationStep;
+    }
+};
+
+// 相机运动状态（用于预取预测）
+struct CameraMotionState {
+    QVector3D position;                 // 相机位置
+    QVector3D viewDirection;            // 视线方向（单位向量）
+    QVector3D velocity;                 // 平移速度（单位/秒）
+    QVector3D angularVelocity;          // 视线方向变化率（1/秒）
+    float fov;                          // 视野角度（度）
+    float nearPlane;                    // 近平面距离
+    float farPlane;                     // 远平面距离
+    bool isValid;                       // 是否已收到相机状态
+
+    CameraMotionState()
+        : viewDirection(0, 0, -1), fov(60.0f), nearPlane(0.1f), farPlane(1000.0f), isValid(false) {}
 };
 
 // 内存管理策略
@@ -29,7 +101,9 @@ enum class MemoryStrategy {
     LRU,            // 最近最少使用
     LFU,            // 最少使用频率
     FIFO,           // 先进先出
-    Priority        // 基于优先级
+    Priority,       // 基于优先级
+    ARC,            // 自适应替换缓存（在最近/频繁两个列表间自适应分配预算）
+    CostAware       // 代价感知（GreedyDual-Size-Frequency，权衡重载代价与块大小）
 };
 
 /**
@@ -64,6 +138,13 @@ public:
      */
     MemoryStrategy getMemoryStrategy() const;
 
+    /**
+     * @brief 获取策略名称（统计输出使用）
+     * @param strategy 内存管理策略
+     * @return 策略名称
+     */
+    static QString memoryStrategyName(MemoryStrategy strategy);
+
     /**
      * @brief 设置最大内存使用量
      * @param maxMemoryMB 最大内存使用量（MB）
@@ -78,6 +159,10 @@ public:
 
     /**
      * @brief 分块加载点云数据
+     *
+     * 点按Morton编码排序后再切分为固定大小的块，每个块在空间上紧凑，
+     * 使视锥体剔除和区域预加载能够有效跳过数据。
+     *
      * @param points 原始点云数据
      * @param chunkSize 每块的点数量
      * @return 加载是否成功
@@ -103,6 +188,13 @@ public:
      */
     std::vector<QVector3D> getChunkPoints(size_t chunkIndex) const;
 
+    /**
+     * @brief 获取指定块的边界框
+     * @param chunkIndex 块索引
+     * @return 边界框（最小点，最大点），索引无效时返回零向量
+     */
+    std::pair<QVector3D, QVector3D> getChunkBoundingBox(size_t chunkIndex) const;
+
     /**
      * @brief 获取用于渲染的点云数据
      * @param lodLevel LOD级别
@@ -125,16 +217,109 @@ public:
                                            float nearPlane,
                                            float farPlane) const;
 
+    /**
+     * @brief 按点预算选择渲染视图
+     *
+     * 视锥体内的块按屏幕覆盖从大到小排序，预算按覆盖比例分配，
+     * 每个块选择各自的抽样步长，使可见区域内的屏幕点密度均匀。
+     * 点数少于分配额的块全部保留，余量分给其他块。
+     *
+     * @param viewPosition 视点位置
+     * @param viewDirection 视线方向
+     * @param fov 视野角度（度）
+     * @param nearPlane 近平面
+     * @param farPlane 远平面
+     * @param pointBudget 目标点数上限
+     * @return 块视图列表（按屏幕覆盖降序）
+     */
+    std::vector<ChunkRenderView> selectPointBudget(const QVector3D& viewPosition,
+                                                   const QVector3D& viewDirection,
+                                                   float fov,
+                                                   float nearPlane,
+                                                   float farPlane,
+                                                   size_t pointBudget) const;
+
+    /**
+     * @brief 释放渲染视图对块的固定，使其可以被淘汰
+     */
+    void releaseRenderViews() const;
+
     /**
      * @brief 预加载指定区域的点云数据
+     *
+     * 启用异步预取时，区域内的块按距离排队由后台线程加载，调用立即返回；
+     * 否则在调用线程上同步加载。
+     *
      * @param center 区域中心
      * @param radius 区域半径
-     * @return 预加载是否成功
+     * @return 是否有块被加载或加入预取队列
      */
     bool preloadRegion(const QVector3D& center, float radius);
 
     /**
-     * @brief 卸载指定块的数据
+     * @brief 启用/禁用异步预取
+     *
+     * 启用后渲染路径（getVisiblePoints、getPointsForRendering）不再同步加载
+     * 未驻留的块，而是将其以最高优先级加入预取队列并跳过。
+     *
+     * @param enabled 是否启用
+     */
+    void setPrefetchEnabled(bool enabled);
+
+    /**
+     * @brief 检查异步预取是否启用
+     * @return 是否启用
+     */
+    bool isPrefetchEnabled() const;
+
+    /**
+     * @brief 设置预取线程数量
+     * @param threadCount 线程数量
+     */
+    void setPrefetchThreadCount(int threadCount);
+
+    /**
+     * @brief 设置相机运动预测的前瞻时间
+     * @param seconds 前瞻时间（秒）
+     */
+    void setPrefetchLookahead(float seconds);
+
+    /**
+     * @brief 设置用于预取的视锥体参数
+     * @param fov 视野角度（度）
+     * @param nearPlane 近平面距离
+     * @param farPlane 远平面距离
+     */
+    void setPrefetchFrustum(float fov, float nearPlane, float farPlane);
+
+    /**
+     * @brief 获取当前相机运动状态
+     * @return 相机运动状态
+     */
+    CameraMotionState getCameraMotionState() const;
+
+    /**
+     * @brief 检查块是否已驻留内存
+     * @param chunkIndex 块索引
+     * @return 是否已驻留
+     */
+    bool isChunkResident(size_t chunkIndex) const;
+
+    /**
+     * @brief 获取预取队列中等待的块数量
+     * @return 等待数量
+     */
+    size_t getPendingPrefetchCount() const;
+
+    /**
+     * @brief 等待预取队列处理完成
+     * @param msecs 超时时间（毫秒），-1表示无限等待
+     * @return 是否在超时前完成
+     */
+    bool waitForPrefetch(int msecs = -1);
+
+    /**
+     * @brief 卸载指定块的数据（被渲染视图引用的块不会被卸载）
      * @param chunkIndex 块索引
      * @return 卸载是否成功
      */
@@ -182,6 +367,50 @@ public:
      */
     bool isAutoMemoryManagementEnabled() const;
 
+    /**
+     * @brief 设置块驻留数据的编码方式（对之后加载的点云生效）
+     * @param encoding 编码方式
+     */
+    void setChunkEncoding(ChunkEncoding encoding);
+
+    /**
+     * @brief 获取块驻留数据的编码方式
+     * @return 编码方式
+     */
+    ChunkEncoding getChunkEncoding() const;
+
+    /**
+     * @brief 设置允许的最大量化误差，超出时该块回退为浮点存储
+     * @param maxError 最大误差（点云坐标单位）
+     */
+    void setMaxQuantizationError(float maxError);
+
+    /**
+     * @brief 启用/禁用冷块压缩（对之后加载的点云生效）
+     *
+     * 启用时卸载的块只保留压缩数据，重新加载时解压。
+     * @param enabled 是否启用
+     */
+    void setColdChunkCompressionEnabled(bool enabled);
+
+    /**
+     * @brief 检查冷块压缩是否启用
+     * @return 是否启用
+     */
+    bool isColdChunkCompressionEnabled() const;
+
+public slots:
+    /**
+     * @brief 更新相机状态并按预测的相机运动调度预取
+     *
+     * 由俯视图交互控制器在平移/缩放时调用，
+     * 速度由相邻两次调用的位置差估计。
+     *
+     * @param position 相机位置
+     * @param viewDirection 视线方向
+     */
+    void updateCameraState(const QVector3D& position, const QVector3D& viewDirection);
+
 signals:
     /**
      * @brief 内存使用量变化信号
@@ -221,17 +450,60 @@ signals:
     void errorOccurred(const QString& error);
 
 private:
+    /**
+     * @brief 计算点云的空间排序（Morton顺序）
+     * @param points 点云数据
+     * @return 按Morton编码排序后的点索引
+     */
+    std::vector<size_t> computeSpatialOrder(const std::vector<QVector3D>& points) const;
+
     /**
      * @brief 创建点云块
      * @param points 点云数据
-     * @param startIndex 起始索引
-     * @param endIndex 结束索引
+     * @param order 空间排序后的点索引
+     * @param startIndex 排序序列中的起始位置
+     * @param endIndex 排序序列中的结束位置
      * @return 点云块
      */
     std::unique_ptr<PointCloudChunk> createChunk(const std::vector<QVector3D>& points,
+                                                 const std::vector<size_t>& order,
                                                  size_t startIndex,
                                                  size_t endIndex);
 
+    /**
+     * @brief 按当前编码设置编码块的驻留数据并计算内存使用量
+     * @param chunk 点云块（边界框需已计算）
+     * @param points 块内点
+     */
+    void encodeChunkPoints(PointCloudChunk& chunk, const std::vector<QVector3D>& points) const;
+
+    /**
+     * @brief 将块的驻留数据解码为浮点坐标
+     * @param chunk 点云块
+     * @return 解码后的点
+     */
+    std::vector<QVector3D> decodeChunkPoints(const PointCloudChunk& chunk) const;
+
+    /**
+     * @brief 压缩块的驻留数据（量化坐标先按xyz分量做差分）
+     * @param chunk 点云块
+     * @return 压缩数据
+     */
+    QByteArray compressChunkData(const PointCloudChunk& chunk) const;
+
+    /**
+     * @brief 从压缩数据恢复块的驻留数据
+     * @param chunk 点云块
+     * @return 是否成功
+     */
+    bool decompressChunkData(PointCloudChunk& chunk) const;
+
+    /**
+     * @brief 释放块的驻留数据（仅在存在压缩副本时）
+     * @param chunk 点云块
+     */
+    void releaseResidentData(PointCloudChunk& chunk) const;
+
     /**
      * @brief 计算块的边界框
      * @param points 点云数据
@@ -256,6 +528,61 @@ private:
                        float nearPlane,
                        float farPlane) const;
 
+    /**
+     * @brief 加载块（调用者需持有状态锁）
+     * @param chunkIndex 块索引
+     * @param allowEviction 内存不足时是否允许卸载其他块
+     * @return 本次调用是否新加载了块
+     */
+    bool loadChunkLocked(size_t chunkIndex, bool allowEviction);
+
+    /**
+     * @brief 读取块的点（调用者需持有状态锁），驻留检查和加载在同一把锁内完成
+     * @param chunkIndex 块索引
+     * @param queueIfMissing 未驻留时只排队预取、不在当前线程加载
+     * @param points 输出点
+     * @param loadedNow 本次调用是否新加载了块
+     * @return 是否读到了点
+     */
+    bool readChunkLocked(size_t chunkIndex, bool queueIfMissing,
+                         std::vector<QVector3D>& points, bool& loadedNow) const;
+
+    /**
+     * @brief 将块加入预取队列
+     * @param chunkIndex 块索引
+     * @param priority 优先级（越小越先加载，负值表示渲染急需）
+     */
+    void schedulePrefetch(size_t chunkIndex, float priority);
+
+    /**
+     * @brief 根据当前与预测的相机状态重建预取队列
+     */
+    void schedulePredictedPrefetch();
+
+    /**
+     * @brief 计算块到视锥体的距离（在视锥体内时为0）
+     * @param chunk 点云块
+     * @param position 相机位置
+     * @param direction 视线方向
+     * @param camera 视锥体参数来源
+     * @return 距离
+     */
+    float distanceToViewFrustum(const PointCloudChunk& chunk,
+                                const QVector3D& position,
+                                const QVector3D& direction,
+                                const CameraMotionState& camera) const;
+
+    /**
+     * @brief 预取工作线程主循环
+     * @param generation 启动时的队列代数
+     */
+    void runPrefetchWorker(quint64 generation);
+
+    /**
+     * @brief 取消所有待处理的预取并等待工作线程结束
+     */
+    void cancelPrefetch();
+
     /**
      * @brief 根据策略选择要卸载的块
      * @param requiredMemory 需要的内存量
@@ -264,11 +591,38 @@ private:
     std::vector<size_t> selectChunksToUnload(size_t requiredMemory);
 
     /**
-     * @brief 更新块的访问时间
+     * @brief 记录一次块访问（访问时间、频率、命中统计及ARC列表迁移）
      * @param chunkIndex 块索引
      */
     void updateChunkAccessTime(size_t chunkIndex);
 
+    /**
+     * @brief 块进入内存时更新替换策略状态
+     * @param chunkIndex 块索引
+     */
+    void onChunkAdmitted(size_t chunkIndex);
+
+    /**
+     * @brief 块被淘汰时更新替换策略状态
+     * @param chunkIndex 块索引
+     */
+    void onChunkEvicted(size_t chunkIndex);
+
+    /**
+     * @brief 计算代价感知策略下块的保留价值
+     * @param chunkIndex 块索引
+     * @return GreedyDual-Size-Frequency优先级
+     */
+    double computeRetentionValue(size_t chunkIndex) const;
+
+    /**
+     * @brief ARC策略下选择要卸载的块
+     * @param candidates 已加载块索引
+     * @param requiredMemory 需要的内存量
+     * @return 要卸载的块索引列表
+     */
+    std::vector<size_t> selectChunksToUnloadARC(const std::vector<size_t>& candidates, size_t requiredMemory) const;
+
     /**
      * @brief 检查内存使用是否超限
      * @return 是否超限
@@ -312,6 +666,55 @@ private:
     size_t m_totalUnloadOperations;
     qint64 m_totalLoadTime;
     qint64 m_totalUnloadTime;
+
+    // 替换策略统计（按策略分别累计）
+    struct PolicyCounters {
+        quint64 hits = 0;
+        quint64 misses = 0;
+        quint64 evictions = 0;
+        quint64 evictedBytes = 0;
+    };
+    std::map<MemoryStrategy, PolicyCounters> m_policyCounters;
+
+    // ARC状态：T1最近访问一次，T2访问多次，B1/B2为对应的淘汰记录（幽灵列表）
+    enum class ArcList : quint8 { None, T1, T2, B1, B2 };
+    struct ChunkCacheState {
+        ArcList arcList = ArcList::None;
+        qint64 ghostTime = 0;           // 进入幽灵列表的时间
+        double retentionValue = 0.0;    // GreedyDual-Size-Frequency优先级
+        bool renderPinned = false;      // 被渲染视图引用，不可淘汰
+    };
+    std::vector<ChunkCacheState> m_cacheState;
+    double m_arcTargetT1;               // ARC中T1的目标字节数（自适应参数p）
+    double m_gdsfInflation;             // GreedyDual老化值L
+
+    // 块存储编码
+    ChunkEncoding m_chunkEncoding;
+    float m_maxQuantizationError;
+    bool m_coldCompressionEnabled;
+
+    // 块驻留状态锁（渲染线程与预取线程共享）
+    mutable QRecursiveMutex m_stateMutex;
+
+    // 异步预取
+    struct PrefetchRequest {
+        float priority;
+        size_t chunkIndex;
+        bool operator>(const PrefetchRequest& other) const { return priority > other.priority; }
+    };
+    std::priority_queue<PrefetchRequest, std::vector<PrefetchRequest>,
+                        std::greater<PrefetchRequest>> m_prefetchQueue;
+    std::vector<float> m_prefetchQueuedPriority;  // 块在队列中的最高优先级（未排队时为无穷大）
+    mutable QMutex m_prefetchMutex;
+    QThreadPool m_prefetchPool;
+    int m_activePrefetchWorkers;
+    quint64 m_prefetchGeneration;
+    std::atomic<bool> m_prefetchEnabled;    // 渲染线程和预取线程都会读取
+    float m_prefetchLookahead;              // 运动预测前瞻时间（秒）
+
+    // 相机运动预测
+    CameraMotionState m_cameraState;
+    QElapsedTimer m_cameraTimer;
 };
 
 } // namespace WallExtraction
@@ -319,5 +722,6 @@ private:
 // 注册元类型
 Q_DECLARE_METATYPE(WallExtraction::MemoryStrategy)
 Q_DECLARE_METATYPE(WallExtraction::PointCloudChunk)
+Q_DECLARE_METATYPE(WallExtraction::CameraMotionState)
 
 #endif // POINT_CLOUD_MEMORY_MANAGER_H
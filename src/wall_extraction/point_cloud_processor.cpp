@@ -1,4 +1,8 @@
 #include "point_cloud_processor.h"
+#include "spatial_index.h"
+#include "parallel_utils.h"
+#include "point_cloud_statistics.h"
+#include "symmetric_eigen_solver.h"
 #include "../../pcdreader.h"
 #include <QFile>
 #include <QFileInfo>
@@ -8,6 +12,10 @@
 #include <QRegularExpression>
 #include <QtMath>
 #include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
 #include <unordered_map>
 
 namespace WallExtraction {
@@ -29,6 +37,192 @@ QString PointCloudProcessorException::getDetailedMessage() const
     return m_detailedMessage;
 }
 
+// FilterStage 实现
+FilterStage FilterStage::heightRange(float minHeight, float maxHeight)
+{
+    FilterStage stage;
+    stage.type = FilterStageType::HeightRange;
+    stage.minPoint.setZ(minHeight);
+    stage.maxPoint.setZ(maxHeight);
+    return stage;
+}
+
+FilterStage FilterStage::bounds(const QVector3D& minPoint, const QVector3D& maxPoint)
+{
+    FilterStage stage;
+    stage.type = FilterStageType::Bounds;
+    stage.minPoint = minPoint;
+    stage.maxPoint = maxPoint;
+    return stage;
+}
+
+FilterStage FilterStage::voxelDownsample(float voxelSize)
+{
+    FilterStage stage;
+    stage.type = FilterStageType::VoxelDownsample;
+    stage.size = voxelSize;
+    return stage;
+}
+
+FilterStage FilterStage::statisticalOutlier(int neighborCount, float stdDevThreshold)
+{
+    FilterStage stage;
+    stage.type = FilterStageType::StatisticalOutlier;
+    stage.count = neighborCount;
+    stage.threshold = stdDevThreshold;
+    return stage;
+}
+
+FilterStage FilterStage::radiusOutlier(float radius, int minNeighbors)
+{
+    FilterStage stage;
+    stage.type = FilterStageType::RadiusOutlier;
+    stage.size = radius;
+    stage.count = minNeighbors;
+    return stage;
+}
+
+FilterStage FilterStage::voxelDensity(float voxelSize, int minPointsPerVoxel)
+{
+    FilterStage stage;
+    stage.type = FilterStageType::VoxelDensity;
+    stage.size = voxelSize;
+    stage.count = minPointsPerVoxel;
+    return stage;
+}
+
+FilterStage FilterStage::removeGround(float groundThreshold)
+{
+    FilterStage stage;
+    stage.type = FilterStageType::RemoveGround;
+    stage.size = groundThreshold;
+    return stage;
+}
+
+FilterStage FilterStage::keepGround(float groundThreshold)
+{
+    FilterStage stage;
+    stage.type = FilterStageType::KeepGround;
+    stage.size = groundThreshold;
+    return stage;
+}
+
+// FilterPipelineResult 实现
+std::vector<QVector3D> FilterPipelineResult::materialize(const std::vector<QVector3D>& points) const
+{
+    std::vector<QVector3D> selectedPoints(indices.size());
+    parallelFor(0, indices.size(), [&](size_t i) {
+        selectedPoints[i] = points[indices[i]];
+    });
+    return selectedPoints;
+}
+
+namespace {
+
+QString filterStageName(FilterStageType type)
+{
+    switch (type) {
+    case FilterStageType::HeightRange:        return "HeightRange";
+    case FilterStageType::Bounds:             return "Bounds";
+    case FilterStageType::VoxelDownsample:    return "VoxelDownsample";
+    case FilterStageType::StatisticalOutlier: return "StatisticalOutlier";
+    case FilterStageType::RadiusOutlier:      return "RadiusOutlier";
+    case FilterStageType::VoxelDensity:       return "VoxelDensity";
+    case FilterStageType::RemoveGround:       return "RemoveGround";
+    case FilterStageType::KeepGround:         return "KeepGround";
+    }
+    return "Unknown";
+}
+
+bool isPointwiseFilterStage(FilterStageType type)
+{
+    return type == FilterStageType::HeightRange || type == FilterStageType::Bounds;
+}
+
+bool isNeighborhoodFilterStage(FilterStageType type)
+{
+    return type == FilterStageType::StatisticalOutlier || type == FilterStageType::RadiusOutlier;
+}
+
+bool isFinitePoint(const QVector3D& point)
+{
+    return std::isfinite(point.x()) && std::isfinite(point.y()) && std::isfinite(point.z());
+}
+
+// KD树不包含非有限点，邻域滤波直接将其移除
+void removeNonFinitePoints(const PointSelection& selection, std::vector<char>& keepMask)
+{
+    parallelFor(0, selection.size(), [&](size_t i) {
+        if (!isFinitePoint(selection[i])) {
+            keepMask[i] = 0;
+        }
+    });
+}
+
+// 选中的有限点的边界，全选时直接使用SIMD归约
+PointCloudBounds computeSelectionBounds(const PointSelection& selection)
+{
+    if (!selection.indices) {
+        return computePointCloudBounds(*selection.points);
+    }
+
+    std::vector<PointCloudBounds> partials(parallelRangeCount(selection.size()));
+    parallelForRange(0, selection.size(), [&](size_t begin, size_t end, size_t range) {
+        PointCloudBounds& bounds = partials[range];
+        for (size_t i = begin; i < end; ++i) {
+            const QVector3D& point = selection[i];
+            if (!isFinitePoint(point)) {
+                continue;
+            }
+            if (bounds.validCount == 0) {
+                bounds.minPoint = point;
+                bounds.maxPoint = point;
+            } else {
+                bounds.minPoint = QVector3D(qMin(bounds.minPoint.x(), point.x()),
+                                            qMin(bounds.minPoint.y(), point.y()),
+                                            qMin(bounds.minPoint.z(), point.z()));
+                bounds.maxPoint = QVector3D(qMax(bounds.maxPoint.x(), point.x()),
+                                            qMax(bounds.maxPoint.y(), point.y()),
+                                            qMax(bounds.maxPoint.z(), point.z()));
+            }
+            ++bounds.validCount;
+        }
+    });
+
+    PointCloudBounds total;
+    for (const auto& partial : partials) {
+        if (partial.validCount == 0) {
+            continue;
+        }
+        if (total.validCount == 0) {
+            total = partial;
+            continue;
+        }
+        total.minPoint = QVector3D(qMin(total.minPoint.x(), partial.minPoint.x()),
+                                   qMin(total.minPoint.y(), partial.minPoint.y()),
+                                   qMin(total.minPoint.z(), partial.minPoint.z()));
+        total.maxPoint = QVector3D(qMax(total.maxPoint.x(), partial.maxPoint.x()),
+                                   qMax(total.maxPoint.y(), partial.maxPoint.y()),
+                                   qMax(total.maxPoint.z(), partial.maxPoint.z()));
+        total.validCount += partial.validCount;
+    }
+    return total;
+}
+
+// 全局体素坐标按每轴21位（偏移2^20）打包成64位键
+// 坐标须为有限值；先在浮点范围内截断再转换，极大的有限坐标也不会溢出
+quint64 voxelKeyForPoint(const QVector3D& point, float inverseVoxelSize)
+{
+    const float offset = static_cast<float>(1 << 20);
+    const float maxCoordinate = static_cast<float>((1 << 21) - 1);
+    auto axisKey = [&](float value) {
+        return static_cast<quint64>(qBound(0.0f, std::floor(value * inverseVoxelSize) + offset, maxCoordinate));
+    };
+    return (axisKey(point.x()) << 42) | (axisKey(point.y()) << 21) | axisKey(point.z());
+}
+
+} // namespace
+
 // PointCloudProcessor 实现
 PointCloudProcessor::PointCloudProcessor(QObject* parent)
     : QObject(parent)
@@ -41,6 +235,12 @@ PointCloudProcessor::PointCloudProcessor(QObject* parent)
     // 设置默认处理参数
     m_processingParameters["outlier_removal_neighbors"] = 20;
     m_processingParameters["outlier_removal_std_dev"] = 2.0;
+    m_processingParameters["radius_outlier_enabled"] = false;
+    m_processingParameters["radius_outlier_radius"] = 0.1;
+    m_processingParameters["radius_outlier_min_neighbors"] = 5;
+    m_processingParameters["density_filter_enabled"] = false;
+    m_processingParameters["density_filter_voxel_size"] = 0.2;
+    m_processingParameters["density_filter_min_points"] = 3;
     m_processingParameters["downsample_voxel_size"] = 0.1;
     m_processingParameters["ground_threshold"] = 0.1;
     
@@ -158,9 +358,20 @@ PointCloudMetadata PointCloudProcessor::getMetadata(const QString& filename) con
             metadata.pointCount = header.pointCount;
             metadata.coordinateSystem = header.coordinateSystem;
             
-            // 设置边界框
-            metadata.boundingBoxMin = QVector3D(header.xMin, header.yMin, header.zMin);
-            metadata.boundingBoxMax = QVector3D(header.xMax, header.yMax, header.zMax);
+            // 边界框经与点相同的解码变换转换到局部坐标系（轴取反时交换上下界）
+            metadata.origin = m_lasReader->getCoordinateOrigin(filename);
+            PointDecodeTransform transform = m_lasReader->getDecodeTransform();
+            transform.origin = metadata.origin;
+            transform.autoOrigin = false;
+            QVector3D first;
+            QVector3D second;
+            if (transform.apply(header.xMin, header.yMin, header.zMin, first) &&
+                transform.apply(header.xMax, header.yMax, header.zMax, second)) {
+                for (int axis = 0; axis < 3; ++axis) {
+                    metadata.boundingBoxMin[axis] = qMin(first[axis], second[axis]);
+                    metadata.boundingBoxMax[axis] = qMax(first[axis], second[axis]);
+                }
+            }
             
             // 设置属性信息
             QStringList attributes = m_lasReader->getAvailableAttributes(filename);
@@ -193,6 +404,20 @@ PointCloudMetadata PointCloudProcessor::getMetadata(const QString& filename) con
     return metadata;
 }
 
+CoordinateOrigin PointCloudProcessor::getCoordinateOrigin(const QString& filename) const
+{
+    PointCloudFormat format = detectFormat(filename);
+    if (format != PointCloudFormat::LAS && format != PointCloudFormat::LAZ) {
+        return CoordinateOrigin();
+    }
+
+    try {
+        return m_lasReader->getCoordinateOrigin(filename);
+    } catch (const std::exception& e) {
+        throw PointCloudProcessorException(QString("Failed to get coordinate origin: %1").arg(e.what()));
+    }
+}
+
 std::vector<QVector3D> PointCloudProcessor::readPointCloud(const QString& filename) const
 {
     QElapsedTimer timer;
@@ -273,15 +498,47 @@ std::vector<QVector3D> PointCloudProcessor::preprocessPointCloud(const std::vect
 {
     emitStatusMessage("Preprocessing point cloud...");
     
-    std::vector<QVector3D> processedPoints = points;
+    std::vector<QVector3D> processedPoints;
     
-    // 去除离群点
-    if (removeOutliers) {
-        emitStatusMessage("Removing outliers...");
-        int neighborCount = m_processingParameters["outlier_removal_neighbors"].toInt();
-        float stdDevThreshold = m_processingParameters["outlier_removal_std_dev"].toFloat();
-        processedPoints = this->removeOutliers(processedPoints, neighborCount, stdDevThreshold);
+    bool radiusFilterEnabled = m_processingParameters.value("radius_outlier_enabled", false).toBool();
+    bool densityFilterEnabled = m_processingParameters.value("density_filter_enabled", false).toBool();
+    
+    // 去除离群点：各滤波器在同一份点云上更新保留掩码，最后统一压缩
+    if (removeOutliers || radiusFilterEnabled || densityFilterEnabled) {
+        std::vector<char> keepMask(points.size(), 1);
+        
+        // 统计滤波和半径滤波共用一棵KD树
+        std::unique_ptr<PointKDTree> tree;
+        if (removeOutliers || radiusFilterEnabled) {
+            emitStatusMessage("Building spatial index...");
+            tree = std::make_unique<PointKDTree>(points);
+        }
+        
+        if (removeOutliers) {
+            emitStatusMessage("Removing outliers...");
+            int neighborCount = m_processingParameters["outlier_removal_neighbors"].toInt();
+            float stdDevThreshold = m_processingParameters["outlier_removal_std_dev"].toFloat();
+            applyStatisticalOutlierFilter(points, *tree, neighborCount, stdDevThreshold, keepMask);
+        }
+        
+        if (radiusFilterEnabled) {
+            emitStatusMessage("Removing radius outliers...");
+            float radius = m_processingParameters["radius_outlier_radius"].toFloat();
+            int minNeighbors = m_processingParameters["radius_outlier_min_neighbors"].toInt();
+            applyRadiusOutlierFilter(points, *tree, radius, minNeighbors, keepMask);
+        }
+        
+        if (densityFilterEnabled) {
+            emitStatusMessage("Removing sparse voxels...");
+            float densityVoxelSize = m_processingParameters["density_filter_voxel_size"].toFloat();
+            int minPoints = m_processingParameters["density_filter_min_points"].toInt();
+            applyVoxelDensityFilter(points, densityVoxelSize, minPoints, keepMask);
+        }
+        
+        processedPoints = compactByMask(points, keepMask);
         emitStatusMessage(QString("Removed %1 outliers").arg(points.size() - processedPoints.size()));
+    } else {
+        processedPoints = points;
     }
     
     // 下采样
@@ -297,24 +554,17 @@ std::vector<QVector3D> PointCloudProcessor::preprocessPointCloud(const std::vect
 
 std::pair<QVector3D, QVector3D> PointCloudProcessor::computeBoundingBox(const std::vector<QVector3D>& points) const
 {
-    if (points.empty()) {
+    PointCloudBounds bounds = computePointCloudBounds(points);
+    if (!bounds.isValid()) {
         return {QVector3D(), QVector3D()};
     }
-    
-    QVector3D minPoint = points[0];
-    QVector3D maxPoint = points[0];
-    
-    for (const auto& point : points) {
-        minPoint.setX(qMin(minPoint.x(), point.x()));
-        minPoint.setY(qMin(minPoint.y(), point.y()));
-        minPoint.setZ(qMin(minPoint.z(), point.z()));
-        
-        maxPoint.setX(qMax(maxPoint.x(), point.x()));
-        maxPoint.setY(qMax(maxPoint.y(), point.y()));
-        maxPoint.setZ(qMax(maxPoint.z(), point.z()));
-    }
-    
-    return {minPoint, maxPoint};
+
+    return {bounds.minPoint, bounds.maxPoint};
+}
+
+QVariantMap PointCloudProcessor::computeStatistics(const std::vector<QVector3D>& points) const
+{
+    return computePointCloudStatistics(points).toVariantMap();
 }
 
 // 私有方法实现
@@ -409,67 +659,406 @@ float PointCloudProcessor::calculateDistance(const QVector3D& p1, const QVector3
     return (p1 - p2).length();
 }
 
+std::vector<int> PointCloudProcessor::findKNearestNeighbors(const std::vector<QVector3D>& points,
+                                                           const QVector3D& queryPoint,
+                                                           int k) const
+{
+    if (k <= 0 || points.empty()) {
+        return {};
+    }
+
+    // 单次查询不值得建树：线性扫描 + 部分选择，O(n)
+    std::vector<std::pair<float, int>> distances(points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        distances[i] = {(points[i] - queryPoint).lengthSquared(), static_cast<int>(i)};
+    }
+
+    size_t count = qMin(static_cast<size_t>(k), distances.size());
+    std::nth_element(distances.begin(), distances.begin() + (count - 1), distances.end());
+    std::sort(distances.begin(), distances.begin() + count);
+
+    std::vector<int> neighbors;
+    neighbors.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        neighbors.push_back(distances[i].second);
+    }
+
+    return neighbors;
+}
+
 std::vector<QVector3D> PointCloudProcessor::removeOutliers(const std::vector<QVector3D>& points,
                                                           int neighborCount,
                                                           float stdDevThreshold) const
 {
-    if (points.size() < neighborCount) {
+    if (neighborCount <= 0 || points.size() <= static_cast<size_t>(neighborCount)) {
         return points; // 点数太少，无法进行离群点检测
     }
 
-    std::vector<QVector3D> filteredPoints;
-    filteredPoints.reserve(points.size());
+    QElapsedTimer timer;
+    timer.start();
+
+    emitStatusMessage("Building KD-tree for outlier removal...");
+    PointKDTree tree(points);
+    emitProcessingProgress(20);
+
+    std::vector<char> keepMask(points.size(), 1);
+    applyStatisticalOutlierFilter(points, tree, neighborCount, stdDevThreshold, keepMask);
+    std::vector<QVector3D> filteredPoints = compactByMask(points, keepMask);
+
+    emitProcessingProgress(100);
+    emitStatusMessage(QString("Outlier removal: kept %1 of %2 points in %3 ms")
+                      .arg(filteredPoints.size()).arg(points.size()).arg(timer.elapsed()));
+
+    return filteredPoints;
+}
+
+std::vector<QVector3D> PointCloudProcessor::removeRadiusOutliers(const std::vector<QVector3D>& points,
+                                                                float radius,
+                                                                int minNeighbors) const
+{
+    if (points.empty() || radius <= 0.0f || minNeighbors <= 0) {
+        return points;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    emitStatusMessage("Building KD-tree for radius outlier removal...");
+    PointKDTree tree(points);
+    emitProcessingProgress(20);
+
+    std::vector<char> keepMask(points.size(), 1);
+    applyRadiusOutlierFilter(points, tree, radius, minNeighbors, keepMask);
+    std::vector<QVector3D> filteredPoints = compactByMask(points, keepMask);
+
+    emitProcessingProgress(100);
+    emitStatusMessage(QString("Radius outlier removal: kept %1 of %2 points in %3 ms")
+                      .arg(filteredPoints.size()).arg(points.size()).arg(timer.elapsed()));
+
+    return filteredPoints;
+}
+
+std::vector<QVector3D> PointCloudProcessor::filterByVoxelDensity(const std::vector<QVector3D>& points,
+                                                                float voxelSize,
+                                                                int minPointsPerVoxel) const
+{
+    if (points.empty() || voxelSize <= 0.0f || minPointsPerVoxel <= 1) {
+        return points;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    std::vector<char> keepMask(points.size(), 1);
+    applyVoxelDensityFilter(points, voxelSize, minPointsPerVoxel, keepMask);
+    std::vector<QVector3D> filteredPoints = compactByMask(points, keepMask);
+
+    emitProcessingProgress(100);
+    emitStatusMessage(QString("Voxel density filter: kept %1 of %2 points in %3 ms")
+                      .arg(filteredPoints.size()).arg(points.size()).arg(timer.elapsed()));
+
+    return filteredPoints;
+}
+
+void PointCloudProcessor::applyStatisticalOutlierFilter(const PointSelection& selection,
+                                                        const PointKDTree& tree,
+                                                        int neighborCount,
+                                                        float stdDevThreshold,
+                                                        std::vector<char>& keepMask) const
+{
+    if (neighborCount <= 0 || selection.size() <= static_cast<size_t>(neighborCount)) {
+        return;
+    }
 
     emitStatusMessage("Computing neighbor distances...");
 
-    for (size_t i = 0; i < points.size(); ++i) {
-        // 计算到最近邻居的距离
-        std::vector<float> distances;
-        distances.reserve(neighborCount);
-
-        for (size_t j = 0; j < points.size(); ++j) {
-            if (i != j) {
-                float dist = calculateDistance(points[i], points[j]);
-                distances.push_back(dist);
+    // 每段独立累计均值和方差（Welford），最后合并
+    struct RunningStatistics {
+        double count = 0.0;
+        double mean = 0.0;
+        double m2 = 0.0;
+    };
+
+    const size_t k = static_cast<size_t>(neighborCount);
+    std::vector<float> meanDistances(selection.size(), 0.0f);
+    std::vector<RunningStatistics> partialStatistics(parallelRangeCount(tree.size(), 1024));
+
+    // 按树布局顺序查询，结果包含点自身（距离为0），因此取k+1个邻居
+    parallelForRange(0, tree.size(), [&](size_t begin, size_t end, size_t range) {
+        std::vector<quint32> indices;
+        std::vector<float> squaredDistances;
+        RunningStatistics& statistics = partialStatistics[range];
+
+        for (size_t position = begin; position < end; ++position) {
+            size_t found = tree.knnSearch(tree.layoutPoint(position), k + 1, indices, squaredDistances);
+
+            float distanceSum = 0.0f;
+            for (float squaredDistance : squaredDistances) {
+                distanceSum += qSqrt(squaredDistance);
             }
+            float meanDistance = found > 1 ? distanceSum / (found - 1) : 0.0f;
+            meanDistances[tree.layoutIndex(position)] = meanDistance;
+
+            statistics.count += 1.0;
+            double delta = meanDistance - statistics.mean;
+            statistics.mean += delta / statistics.count;
+            statistics.m2 += delta * (meanDistance - statistics.mean);
         }
+    }, 1024);
 
-        // 排序并取前k个最近邻居
-        std::sort(distances.begin(), distances.end());
-        if (distances.size() > neighborCount) {
-            distances.resize(neighborCount);
+    emitProcessingProgress(80);
+
+    // 合并各段的统计量（Chan并行方差公式）
+    RunningStatistics total;
+    for (const auto& partial : partialStatistics) {
+        if (partial.count == 0.0) {
+            continue;
         }
+        double count = total.count + partial.count;
+        double delta = partial.mean - total.mean;
+        total.mean += delta * partial.count / count;
+        total.m2 += partial.m2 + delta * delta * total.count * partial.count / count;
+        total.count = count;
+    }
+
+    double stdDev = total.count > 0.0 ? std::sqrt(total.m2 / total.count) : 0.0;
+    float distanceThreshold = static_cast<float>(total.mean + stdDevThreshold * stdDev);
 
-        // 计算平均距离
-        float meanDistance = 0.0f;
-        for (float dist : distances) {
-            meanDistance += dist;
+    // 平均邻域距离超过 全局均值 + 阈值 x 标准差 的点为离群点
+    parallelFor(0, selection.size(), [&](size_t i) {
+        if (meanDistances[i] > distanceThreshold) {
+            keepMask[i] = 0;
         }
-        meanDistance /= distances.size();
+    });
+    removeNonFinitePoints(selection, keepMask);
+}
+
+void PointCloudProcessor::applyRadiusOutlierFilter(const PointSelection& selection,
+                                                   const PointKDTree& tree,
+                                                   float radius,
+                                                   int minNeighbors,
+                                                   std::vector<char>& keepMask) const
+{
+    if (selection.empty() || radius <= 0.0f || minNeighbors <= 0) {
+        return;
+    }
+
+    emitStatusMessage("Counting radius neighbors...");
+
+    // 只统计之前各阶段保留的点；使用掩码快照，本阶段的移除不影响其他点的计数
+    const std::vector<char> selectedMask = keepMask;
 
-        // 计算标准差
-        float variance = 0.0f;
-        for (float dist : distances) {
-            variance += (dist - meanDistance) * (dist - meanDistance);
+    // 计数包含点自身，数到minNeighbors+1个即提前结束搜索
+    const size_t requiredCount = static_cast<size_t>(minNeighbors) + 1;
+    parallelFor(0, tree.size(), [&](size_t position) {
+        quint32 index = tree.layoutIndex(position);
+        if (!selectedMask[index]) {
+            return;
         }
-        float stdDev = qSqrt(variance / distances.size());
+        if (tree.radiusCount(tree.layoutPoint(position), radius, requiredCount, &selectedMask) < requiredCount) {
+            keepMask[index] = 0;
+        }
+    }, 1024);
+    removeNonFinitePoints(selection, keepMask);
+}
+
+void PointCloudProcessor::applyVoxelDensityFilter(const PointSelection& selection,
+                                                  float voxelSize,
+                                                  int minPointsPerVoxel,
+                                                  std::vector<char>& keepMask) const
+{
+    if (selection.empty() || voxelSize <= 0.0f || minPointsPerVoxel <= 1) {
+        return;
+    }
+
+    emitStatusMessage("Computing voxel occupancy...");
+
+    // 每轴21位体素坐标打包成64位键，超出范围的坐标被截断到边界体素
+    const qint64 maxCoordinate = (1 << 21) - 1;
+    auto packKey = [](qint64 x, qint64 y, qint64 z) -> quint64 {
+        return (static_cast<quint64>(x) << 42) | (static_cast<quint64>(y) << 21) | static_cast<quint64>(z);
+    };
+
+    // 非有限点没有所在体素，与邻域滤波一致直接移除；体素原点只由仍保留的有限点确定
+    removeNonFinitePoints(selection, keepMask);
+    const float maxValue = std::numeric_limits<float>::max();
+    std::vector<QVector3D> partialOrigins(parallelRangeCount(selection.size()), QVector3D(maxValue, maxValue, maxValue));
+    parallelForRange(0, selection.size(), [&](size_t begin, size_t end, size_t range) {
+        QVector3D& partialOrigin = partialOrigins[range];
+        for (size_t i = begin; i < end; ++i) {
+            if (keepMask[i]) {
+                const QVector3D& point = selection[i];
+                partialOrigin = QVector3D(qMin(partialOrigin.x(), point.x()),
+                                          qMin(partialOrigin.y(), point.y()),
+                                          qMin(partialOrigin.z(), point.z()));
+            }
+        }
+    });
+    QVector3D origin(maxValue, maxValue, maxValue);
+    for (const auto& partialOrigin : partialOrigins) {
+        origin = QVector3D(qMin(origin.x(), partialOrigin.x()),
+                           qMin(origin.y(), partialOrigin.y()),
+                           qMin(origin.z(), partialOrigin.z()));
+    }
+    if (origin.x() == maxValue) {
+        return;
+    }
+    const float inverseVoxelSize = 1.0f / voxelSize;
 
-        // 检查是否为离群点
-        if (meanDistance <= (stdDevThreshold * stdDev)) {
+    // 只为仍保留的点计算体素键，已被移除的点（包括非有限点）不做整数转换
+    std::vector<quint64> pointKeys(selection.size(), 0);
+    parallelFor(0, selection.size(), [&](size_t i) {
+        if (!keepMask[i]) {
+            return;
+        }
+        QVector3D local = (selection[i] - origin) * inverseVoxelSize;
+        // 先在浮点范围内截断再转换，极大的有限坐标也不会溢出
+        const float maxLocal = static_cast<float>(maxCoordinate);
+        qint64 x = static_cast<qint64>(qBound(0.0f, local.x(), maxLocal));
+        qint64 y = static_cast<qint64>(qBound(0.0f, local.y(), maxLocal));
+        qint64 z = static_cast<qint64>(qBound(0.0f, local.z(), maxLocal));
+        pointKeys[i] = packKey(x, y, z);
+    });
+
+    // 只统计仍保留的点，已被前序滤波移除的点不计入密度
+    std::unordered_map<quint64, quint32> voxelIds;
+    voxelIds.reserve(selection.size() / 4 + 1);
+    std::vector<quint32> voxelCounts;
+    std::vector<quint32> pointVoxels(selection.size(), 0);
+    for (size_t i = 0; i < selection.size(); ++i) {
+        if (!keepMask[i]) {
+            continue;
+        }
+        auto inserted = voxelIds.emplace(pointKeys[i], static_cast<quint32>(voxelCounts.size()));
+        if (inserted.second) {
+            voxelCounts.push_back(0);
+        }
+        quint32 voxelId = inserted.first->second;
+        ++voxelCounts[voxelId];
+        pointVoxels[i] = voxelId;
+    }
+
+    std::vector<quint64> voxelKeys(voxelCounts.size());
+    for (const auto& entry : voxelIds) {
+        voxelKeys[entry.second] = entry.first;
+    }
+
+    emitProcessingProgress(50);
+
+    // 每个被占据的体素只汇总一次26邻域，哈希表在此阶段只读，可并发查找
+    std::vector<quint32> neighborhoodCounts(voxelCounts.size(), 0);
+    parallelFor(0, voxelKeys.size(), [&](size_t voxel) {
+        const quint64 key = voxelKeys[voxel];
+        const qint64 vx = static_cast<qint64>(key >> 42);
+        const qint64 vy = static_cast<qint64>((key >> 21) & maxCoordinate);
+        const qint64 vz = static_cast<qint64>(key & maxCoordinate);
+
+        quint32 total = 0;
+        for (qint64 dx = -1; dx <= 1; ++dx) {
+            for (qint64 dy = -1; dy <= 1; ++dy) {
+                for (qint64 dz = -1; dz <= 1; ++dz) {
+                    qint64 x = vx + dx;
+                    qint64 y = vy + dy;
+                    qint64 z = vz + dz;
+                    if (x < 0 || y < 0 || z < 0 || x > maxCoordinate || y > maxCoordinate || z > maxCoordinate) {
+                        continue;
+                    }
+                    auto it = voxelIds.find(packKey(x, y, z));
+                    if (it != voxelIds.end()) {
+                        total += voxelCounts[it->second];
+                    }
+                }
+            }
+        }
+        neighborhoodCounts[voxel] = total;
+    }, 256);
+
+    const quint32 minCount = static_cast<quint32>(minPointsPerVoxel);
+    parallelFor(0, selection.size(), [&](size_t i) {
+        if (keepMask[i] && neighborhoodCounts[pointVoxels[i]] < minCount) {
+            keepMask[i] = 0;
+        }
+    });
+}
+
+std::vector<QVector3D> PointCloudProcessor::compactByMask(const std::vector<QVector3D>& points,
+                                                          const std::vector<char>& keepMask) const
+{
+    size_t keptCount = std::count(keepMask.begin(), keepMask.end(), 1);
+    std::vector<QVector3D> filteredPoints;
+    filteredPoints.reserve(keptCount);
+    for (size_t i = 0; i < points.size(); ++i) {
+        if (keepMask[i]) {
             filteredPoints.push_back(points[i]);
         }
+    }
+    return filteredPoints;
+}
 
-        // 更新进度
-        if (i % 1000 == 0) {
-            int progress = static_cast<int>((i * 100) / points.size());
-            emitProcessingProgress(progress);
+std::vector<QVector3D> PointCloudProcessor::estimateNormals(const std::vector<QVector3D>& points,
+                                                           int neighborCount,
+                                                           float radius,
+                                                           NormalOrientation orientation,
+                                                           const QVector3D& viewpoint,
+                                                           std::vector<float>* curvatures) const
+{
+    if (points.empty()) {
+        if (curvatures) {
+            curvatures->clear();
         }
+        return {};
     }
 
+    QElapsedTimer timer;
+    timer.start();
+
+    emitStatusMessage("Building KD-tree for normal estimation...");
+    PointKDTree tree(points);
+    emitProcessingProgress(20);
+
+    emitStatusMessage("Estimating normals...");
+    std::vector<QVector3D> normals = computePointNormals(points, tree, neighborCount, radius,
+                                                         orientation, viewpoint, curvatures);
+
     emitProcessingProgress(100);
-    return filteredPoints;
+    emitStatusMessage(QString("Normal estimation: %1 points in %2 ms")
+                      .arg(points.size()).arg(timer.elapsed()));
+
+    return normals;
 }
 
+DominantAxisAlignment PointCloudProcessor::estimateDominantAxisAlignment(const std::vector<QVector3D>& points,
+                                                                       size_t maxSamples,
+                                                                       int neighborCount) const
+{
+    PointCloudBounds bounds = computePointCloudBounds(points);
+    if (!bounds.isValid()) {
+        return DominantAxisAlignment();
+    }
+
+    // 均匀子采样，墙面在稀疏后仍保持平面结构
+    size_t stride = std::max<size_t>(1, (points.size() + std::max<size_t>(1, maxSamples) - 1) /
+                                            std::max<size_t>(1, maxSamples));
+    std::vector<QVector3D> samples;
+    samples.reserve(points.size() / stride + 1);
+    for (size_t i = 0; i < points.size(); i += stride) {
+        samples.push_back(points[i]);
+    }
+
+    std::vector<QVector3D> normals = estimateNormals(samples, neighborCount, 0.0f, NormalOrientation::None);
+    DominantAxisAlignment alignment = WallExtraction::estimateDominantAxisAlignment(normals, bounds.center());
+
+    if (alignment.valid) {
+        emitStatusMessage(QString("Dominant wall direction: %1 deg (confidence %2)")
+                          .arg(qRadiansToDegrees(alignment.angle), 0, 'f', 2)
+                          .arg(alignment.confidence, 0, 'f', 2));
+    } else {
+        emitStatusMessage("Dominant wall direction not found");
+    }
+    return alignment;
+}
+
+
 std::vector<QVector3D> PointCloudProcessor::downsamplePointCloud(const std::vector<QVector3D>& points,
                                                                  float voxelSize) const
 {
@@ -537,26 +1126,685 @@ PointCloudProcessor::separateGroundPoints(const std::vector<QVector3D>& points,
         return {groundPoints, nonGroundPoints};
     }
 
-    // 简化的地面分离算法：基于高度阈值
-    auto bbox = computeBoundingBox(points);
-    float groundLevel = bbox.first.z() + groundThreshold;
+    std::vector<char> groundMask = computeGroundMask(points, groundThreshold);
 
-    for (const auto& point : points) {
-        if (point.z() <= groundLevel) {
-            groundPoints.push_back(point);
+    size_t groundCount = std::count(groundMask.begin(), groundMask.end(), 1);
+    groundPoints.reserve(groundCount);
+    nonGroundPoints.reserve(points.size() - groundCount);
+    for (size_t i = 0; i < points.size(); ++i) {
+        if (groundMask[i]) {
+            groundPoints.push_back(points[i]);
         } else {
-            nonGroundPoints.push_back(point);
+            nonGroundPoints.push_back(points[i]);
         }
     }
 
     return {groundPoints, nonGroundPoints};
 }
 
+FilterPipelineResult PointCloudProcessor::runFilterPipeline(const std::vector<QVector3D>& points,
+                                                            const std::vector<FilterStage>& stages) const
+{
+    FilterPipelineResult result;
+    QElapsedTimer totalTimer;
+    totalTimer.start();
+
+    result.indices.resize(points.size());
+    std::iota(result.indices.begin(), result.indices.end(), 0u);
+
+    size_t stageIndex = 0;
+    while (stageIndex < stages.size() && !result.indices.empty()) {
+        QElapsedTimer stageTimer;
+        stageTimer.start();
+
+        FilterStageTiming timing;
+        timing.inputCount = result.indices.size();
+        QStringList stageNames;
+        const FilterStage& stage = stages[stageIndex];
+
+        if (isPointwiseFilterStage(stage.type) || stage.type == FilterStageType::VoxelDownsample) {
+            // 连续的逐点阶段加上紧随的体素下采样，一次遍历完成
+            std::vector<const FilterStage*> group;
+            while (stageIndex < stages.size() && isPointwiseFilterStage(stages[stageIndex].type)) {
+                group.push_back(&stages[stageIndex++]);
+            }
+            if (stageIndex < stages.size() && stages[stageIndex].type == FilterStageType::VoxelDownsample) {
+                group.push_back(&stages[stageIndex++]);
+            }
+            for (const FilterStage* fusedStage : group) {
+                stageNames << filterStageName(fusedStage->type);
+            }
+            runFusedPointStages(points, group, result.indices);
+        } else {
+            // 其余阶段直接在原始点云的当前选择上运行，掩码按选择位置存储，不物化中间结果
+            const PointSelection selection(points, result.indices);
+            std::vector<char> keepMask(selection.size(), 1);
+
+            if (isNeighborhoodFilterStage(stage.type)) {
+                PointKDTree tree(points, result.indices);
+                while (stageIndex < stages.size() && isNeighborhoodFilterStage(stages[stageIndex].type)) {
+                    const FilterStage& neighborhoodStage = stages[stageIndex++];
+                    if (neighborhoodStage.type == FilterStageType::StatisticalOutlier) {
+                        applyStatisticalOutlierFilter(selection, tree, neighborhoodStage.count,
+                                                      neighborhoodStage.threshold, keepMask);
+                    } else {
+                        applyRadiusOutlierFilter(selection, tree, neighborhoodStage.size,
+                                                 neighborhoodStage.count, keepMask);
+                    }
+                    stageNames << filterStageName(neighborhoodStage.type);
+                }
+            } else if (stage.type == FilterStageType::VoxelDensity) {
+                applyVoxelDensityFilter(selection, stage.size, stage.count, keepMask);
+                stageNames << filterStageName(stage.type);
+                ++stageIndex;
+            } else {
+                std::vector<char> groundMask = computeGroundMask(selection, stage.size);
+                const char keepGround = stage.type == FilterStageType::KeepGround ? 1 : 0;
+                parallelFor(0, selection.size(), [&](size_t i) {
+                    keepMask[i] = (groundMask[i] != 0) == (keepGround != 0);
+                });
+                stageNames << filterStageName(stage.type);
+                ++stageIndex;
+            }
+
+            size_t kept = 0;
+            for (size_t i = 0; i < result.indices.size(); ++i) {
+                if (keepMask[i]) {
+                    result.indices[kept++] = result.indices[i];
+                }
+            }
+            result.indices.resize(kept);
+        }
+
+        timing.name = stageNames.join("+");
+        timing.fused = stageNames.size() > 1;
+        timing.outputCount = result.indices.size();
+        timing.elapsedMs = stageTimer.nsecsElapsed() / 1.0e6;
+        result.stageTimings.push_back(timing);
+
+        emitStatusMessage(QString("Filter stage %1: %2 -> %3 points (%4 ms)")
+                          .arg(timing.name).arg(timing.inputCount).arg(timing.outputCount)
+                          .arg(timing.elapsedMs, 0, 'f', 2));
+    }
+
+    result.totalElapsedMs = totalTimer.nsecsElapsed() / 1.0e6;
+    return result;
+}
+
+std::vector<QVector3D> PointCloudProcessor::applyFilterPipeline(const std::vector<QVector3D>& points,
+                                                                const std::vector<FilterStage>& stages) const
+{
+    return runFilterPipeline(points, stages).materialize(points);
+}
+
+void PointCloudProcessor::runFusedPointStages(const std::vector<QVector3D>& points,
+                                              const std::vector<const FilterStage*>& stages,
+                                              std::vector<quint32>& indices) const
+{
+    const FilterStage* voxelStage = nullptr;
+    size_t predicateCount = stages.size();
+    if (!stages.empty() && stages.back()->type == FilterStageType::VoxelDownsample) {
+        voxelStage = stages.back();
+        --predicateCount;
+    }
+    const bool downsample = voxelStage && voxelStage->size > 0.0f;
+    const float inverseVoxelSize = downsample ? 1.0f / voxelStage->size : 0.0f;
+
+    // NaN与任何边界比较都为假，非有限点须先单独排除，否则会通过所有范围判断并进入体素键计算
+    auto accepts = [&](const QVector3D& point) {
+        if (!isFinitePoint(point)) {
+            return false;
+        }
+        for (size_t s = 0; s < predicateCount; ++s) {
+            const FilterStage& stage = *stages[s];
+            if (stage.type == FilterStageType::HeightRange) {
+                if (point.z() < stage.minPoint.z() || point.z() > stage.maxPoint.z()) {
+                    return false;
+                }
+            } else if (point.x() < stage.minPoint.x() || point.x() > stage.maxPoint.x() ||
+                       point.y() < stage.minPoint.y() || point.y() > stage.maxPoint.y() ||
+                       point.z() < stage.minPoint.z() || point.z() > stage.maxPoint.z()) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    std::vector<char> accepted(indices.size());
+    std::vector<quint64> voxelKeys(downsample ? indices.size() : 0);
+    parallelFor(0, indices.size(), [&](size_t i) {
+        const QVector3D& point = points[indices[i]];
+        accepted[i] = accepts(point);
+        if (downsample && accepted[i]) {
+            voxelKeys[i] = voxelKeyForPoint(point, inverseVoxelSize);
+        }
+    });
+
+    if (!downsample) {
+        size_t kept = 0;
+        for (size_t i = 0; i < indices.size(); ++i) {
+            if (accepted[i]) {
+                indices[kept++] = indices[i];
+            }
+        }
+        indices.resize(kept);
+        return;
+    }
+
+    // 每个体素保留最接近体素质心的原始点，结果仍是原始点云的子集
+    struct VoxelAccumulator {
+        double x = 0.0;
+        double y = 0.0;
+        double z = 0.0;
+        quint32 count = 0;
+        quint32 best = 0;
+        float bestDistance = std::numeric_limits<float>::max();
+    };
+
+    std::unordered_map<quint64, quint32> voxelIds;
+    voxelIds.reserve(indices.size() / 4 + 1);
+    std::vector<VoxelAccumulator> voxels;
+    std::vector<quint32> pointVoxels(indices.size(), 0);
+    for (size_t i = 0; i < indices.size(); ++i) {
+        if (!accepted[i]) {
+            continue;
+        }
+        auto inserted = voxelIds.emplace(voxelKeys[i], static_cast<quint32>(voxels.size()));
+        if (inserted.second) {
+            voxels.emplace_back();
+        }
+        VoxelAccumulator& voxel = voxels[inserted.first->second];
+        const QVector3D& point = points[indices[i]];
+        voxel.x += point.x();
+        voxel.y += point.y();
+        voxel.z += point.z();
+        ++voxel.count;
+        pointVoxels[i] = inserted.first->second;
+    }
+
+    for (size_t i = 0; i < indices.size(); ++i) {
+        if (!accepted[i]) {
+            continue;
+        }
+        VoxelAccumulator& voxel = voxels[pointVoxels[i]];
+        QVector3D centroid(static_cast<float>(voxel.x / voxel.count),
+                           static_cast<float>(voxel.y / voxel.count),
+                           static_cast<float>(voxel.z / voxel.count));
+        float distance = (points[indices[i]] - centroid).lengthSquared();
+        if (distance < voxel.bestDistance) {
+            voxel.bestDistance = distance;
+            voxel.best = indices[i];
+        }
+    }
+
+    indices.resize(voxels.size());
+    for (size_t v = 0; v < voxels.size(); ++v) {
+        indices[v] = voxels[v].best;
+    }
+    std::sort(indices.begin(), indices.end());
+}
+
+std::vector<char> PointCloudProcessor::computeGroundMask(const PointSelection& selection,
+                                                         float groundThreshold) const
+{
+    FloorCeilingResult result = detectFloorAndCeiling(selection, 0.05f, groundThreshold, 0.02f);
+    std::vector<char> groundMask = std::move(result.floorMask);
+
+    bool hasFloor = std::any_of(result.surfaces.begin(), result.surfaces.end(),
+                                [](const HorizontalSurface& surface) { return surface.isFloor; });
+    PointCloudBounds bounds = hasFloor ? PointCloudBounds() : computeSelectionBounds(selection);
+    if (bounds.isValid()) {
+        // 未检测到地板：退化为基于高度阈值的分离
+        float groundLevel = bounds.minPoint.z() + groundThreshold;
+        parallelFor(0, selection.size(), [&](size_t i) {
+            groundMask[i] = selection[i].z() <= groundLevel;
+        });
+    }
+
+    return groundMask;
+}
+
+FloorCeilingResult PointCloudProcessor::detectFloorAndCeiling(const std::vector<QVector3D>& points,
+                                                              float binSize,
+                                                              float distanceThreshold,
+                                                              float minPeakFraction) const
+{
+    return detectFloorAndCeiling(PointSelection(points), binSize, distanceThreshold, minPeakFraction);
+}
+
+FloorCeilingResult PointCloudProcessor::detectFloorAndCeiling(const PointSelection& selection,
+                                                              float binSize,
+                                                              float distanceThreshold,
+                                                              float minPeakFraction) const
+{
+    FloorCeilingResult result;
+    result.floorMask.assign(selection.size(), 0);
+    result.ceilingMask.assign(selection.size(), 0);
+
+    if (selection.size() < 3 || binSize <= 0.0f) {
+        return result;
+    }
+
+    PointCloudBounds bounds = computeSelectionBounds(selection);
+    if (!bounds.isValid()) {
+        return result;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    emitStatusMessage("Detecting floor and ceiling...");
+
+    const float minZ = bounds.minPoint.z();
+    const size_t binCount = static_cast<size_t>((bounds.maxPoint.z() - minZ) / binSize) + 1;
+    if (binCount > 1000000) {
+        emitStatusMessage("Height range too large for floor detection");
+        return result;
+    }
+
+    // 高度直方图：每段独立统计后合并
+    std::vector<std::vector<quint32>> partialHistograms(parallelRangeCount(selection.size()));
+    parallelForRange(0, selection.size(), [&](size_t begin, size_t end, size_t range) {
+        std::vector<quint32>& histogram = partialHistograms[range];
+        histogram.assign(binCount, 0);
+        for (size_t i = begin; i < end; ++i) {
+            const QVector3D& point = selection[i];
+            if (!isFinitePoint(point)) {
+                continue;
+            }
+            size_t bin = static_cast<size_t>((point.z() - minZ) / binSize);
+            ++histogram[qMin(bin, binCount - 1)];
+        }
+    });
+
+    std::vector<quint32> histogram(binCount, 0);
+    for (const auto& partial : partialHistograms) {
+        for (size_t bin = 0; bin < partial.size(); ++bin) {
+            histogram[bin] += partial[bin];
+        }
+    }
+
+    // 三格平滑后做非极大值抑制，抑制窗口约0.2米
+    std::vector<quint32> smoothed(binCount, 0);
+    for (size_t bin = 0; bin < binCount; ++bin) {
+        smoothed[bin] = histogram[bin]
+                      + (bin > 0 ? histogram[bin - 1] : 0)
+                      + (bin + 1 < binCount ? histogram[bin + 1] : 0);
+    }
+
+    const quint32 minPeakCount = static_cast<quint32>(qMax(3.0f, minPeakFraction * selection.size()));
+    const size_t suppression = qMax<size_t>(1, static_cast<size_t>(0.2f / binSize));
+    std::vector<size_t> peaks;
+    for (size_t bin = 0; bin < binCount; ++bin) {
+        if (smoothed[bin] < minPeakCount) {
+            continue;
+        }
+
+        // 峰值还需明显高于周围0.5米内的背景，均匀分布的点不会产生峰值
+        const size_t backgroundBins = qMax<size_t>(3, static_cast<size_t>(0.5f / binSize));
+        quint64 backgroundSum = 0;
+        size_t backgroundCount = 0;
+        for (size_t other = (bin > backgroundBins ? bin - backgroundBins : 0);
+             other <= qMin(binCount - 1, bin + backgroundBins); ++other) {
+            if (other + 2 < bin || other > bin + 2) {
+                backgroundSum += histogram[other];
+                ++backgroundCount;
+            }
+        }
+        if (backgroundCount > 0 && smoothed[bin] < 6.0 * backgroundSum / backgroundCount) {
+            continue;
+        }
+
+        bool isPeak = true;
+        size_t first = bin > suppression ? bin - suppression : 0;
+        size_t last = qMin(binCount - 1, bin + suppression);
+        for (size_t other = first; other <= last && isPeak; ++other) {
+            if (other < bin && smoothed[other] >= smoothed[bin]) {
+                isPeak = false;
+            } else if (other > bin && smoothed[other] > smoothed[bin]) {
+                isPeak = false;
+            }
+        }
+        if (isPeak) {
+            peaks.push_back(bin);
+        }
+    }
+
+    emitProcessingProgress(30);
+
+    // 地板上方紧邻有墙面等点而下方为空（楼板内部），天花板相反。
+    // 统计时跳过所有峰值附近的格子，避免薄楼板另一侧的峰值干扰判定
+    const size_t nearBins = 2;
+    const size_t farBins = qMax<size_t>(nearBins + 1, static_cast<size_t>(0.5f / binSize));
+    std::vector<char> nearPeak(binCount, 0);
+    for (size_t peak : peaks) {
+        for (size_t bin = (peak > nearBins ? peak - nearBins : 0); bin <= qMin(binCount - 1, peak + nearBins); ++bin) {
+            nearPeak[bin] = 1;
+        }
+    }
+    auto countRange = [&](size_t first, size_t last) {
+        quint64 count = 0;
+        for (size_t bin = first; bin <= last && bin < binCount; ++bin) {
+            if (!nearPeak[bin]) {
+                count += histogram[bin];
+            }
+        }
+        return count;
+    };
+
+    const float bandHalfWidth = qMax(2.0f * binSize, 3.0f * distanceThreshold);
+    for (size_t peakIndex = 0; peakIndex < peaks.size(); ++peakIndex) {
+        size_t bin = peaks[peakIndex];
+
+        bool isFloor;
+        if (peaks.size() > 1 && peakIndex == 0) {
+            isFloor = true;
+        } else if (peaks.size() > 1 && peakIndex + 1 == peaks.size()) {
+            isFloor = false;
+        } else {
+            quint64 above = countRange(bin + nearBins + 1, bin + farBins);
+            quint64 below = bin > nearBins ? countRange(bin > farBins ? bin - farBins : 0, bin - nearBins - 1) : 0;
+            isFloor = above >= below;
+        }
+
+        // 以峰值附近三格的加权平均作为峰值高度
+        double weightedSum = 0.0;
+        double weightTotal = 0.0;
+        for (size_t other = (bin > 0 ? bin - 1 : 0); other <= qMin(binCount - 1, bin + 1); ++other) {
+            weightedSum += histogram[other] * (minZ + (other + 0.5) * binSize);
+            weightTotal += histogram[other];
+        }
+        float peakHeight = static_cast<float>(weightTotal > 0.0 ? weightedSum / weightTotal
+                                                                : minZ + (bin + 0.5) * binSize);
+
+        HorizontalSurface surface;
+        surface.isFloor = isFloor;
+        surface.height = peakHeight;
+        std::vector<char>& mask = isFloor ? result.floorMask : result.ceilingMask;
+        if (fitHorizontalSurface(selection, peakHeight, bandHalfWidth, distanceThreshold, surface, mask)) {
+            result.surfaces.push_back(surface);
+        }
+
+        emitProcessingProgress(30 + static_cast<int>(70 * (peakIndex + 1) / peaks.size()));
+    }
+
+    int floorCount = std::count_if(result.surfaces.begin(), result.surfaces.end(),
+                                   [](const HorizontalSurface& surface) { return surface.isFloor; });
+    emitStatusMessage(QString("Detected %1 floor and %2 ceiling surfaces in %3 ms")
+                      .arg(floorCount).arg(result.surfaces.size() - floorCount).arg(timer.elapsed()));
+
+    return result;
+}
+
+bool PointCloudProcessor::fitHorizontalSurface(const PointSelection& selection,
+                                               float peakHeight,
+                                               float bandHalfWidth,
+                                               float distanceThreshold,
+                                               HorizontalSurface& surface,
+                                               std::vector<char>& mask) const
+{
+    // 收集高度带内的候选点
+    std::vector<std::vector<quint32>> partialCandidates(parallelRangeCount(selection.size()));
+    parallelForRange(0, selection.size(), [&](size_t begin, size_t end, size_t range) {
+        std::vector<quint32>& candidates = partialCandidates[range];
+        for (size_t i = begin; i < end; ++i) {
+            if (qAbs(selection[i].z() - peakHeight) <= bandHalfWidth && isFinitePoint(selection[i])) {
+                candidates.push_back(static_cast<quint32>(i));
+            }
+        }
+    });
+
+    std::vector<quint32> candidates;
+    for (const auto& partial : partialCandidates) {
+        candidates.insert(candidates.end(), partial.begin(), partial.end());
+    }
+    if (candidates.size() < 3) {
+        return false;
+    }
+
+    // 二维网格抽样：每格保留一个点，RANSAC代价与点密度无关
+    const float gridCellSize = 0.25f;
+    std::unordered_map<quint64, quint32> gridSamples;
+    gridSamples.reserve(candidates.size() / 8 + 1);
+    for (quint32 index : candidates) {
+        qint64 cx = static_cast<qint64>(std::floor(selection[index].x() / gridCellSize));
+        qint64 cy = static_cast<qint64>(std::floor(selection[index].y() / gridCellSize));
+        quint64 key = (static_cast<quint64>(cx) << 32) ^ static_cast<quint64>(static_cast<quint32>(cy));
+        gridSamples.emplace(key, index);
+    }
+
+    std::vector<QVector3D> samples;
+    samples.reserve(gridSamples.size());
+    for (const auto& entry : gridSamples) {
+        samples.push_back(selection[entry.second]);
+    }
+    if (samples.size() < 3) {
+        return false;
+    }
+
+    auto countSampleInliers = [&](const QVector3D& normal, float d) {
+        size_t count = 0;
+        for (const auto& sample : samples) {
+            if (qAbs(QVector3D::dotProduct(normal, sample) + d) <= distanceThreshold) {
+                ++count;
+            }
+        }
+        return count;
+    };
+
+    // 以水平面作为初始假设，只接受倾角小于15度的平面
+    const float minNormalZ = std::cos(qDegreesToRadians(15.0f));
+    QVector3D bestNormal(0, 0, 1);
+    float bestD = -peakHeight;
+    size_t bestScore = countSampleInliers(bestNormal, bestD);
+
+    std::mt19937 generator(static_cast<quint32>(samples.size()));
+    std::uniform_int_distribution<size_t> distribution(0, samples.size() - 1);
+    const int iterations = 200;
+    for (int iteration = 0; iteration < iterations; ++iteration) {
+        const QVector3D& p1 = samples[distribution(generator)];
+        const QVector3D& p2 = samples[distribution(generator)];
+        const QVector3D& p3 = samples[distribution(generator)];
+        QVector3D normal = QVector3D::crossProduct(p2 - p1, p3 - p1);
+        if (normal.lengthSquared() < 1e-12f) {
+            continue;
+        }
+        normal.normalize();
+        if (normal.z() < 0.0f) {
+            normal = -normal;
+        }
+        if (normal.z() < minNormalZ) {
+            continue;
+        }
+        float d = -QVector3D::dotProduct(normal, p1);
+        size_t score = countSampleInliers(normal, d);
+        if (score > bestScore) {
+            bestScore = score;
+            bestNormal = normal;
+            bestD = d;
+        }
+    }
+
+    // 用全部内点做PCA精化（候选为选择位置，协方差按原始索引计算）
+    std::vector<quint32> inliers;
+    inliers.reserve(candidates.size());
+    for (quint32 index : candidates) {
+        if (qAbs(QVector3D::dotProduct(bestNormal, selection[index]) + bestD) <= distanceThreshold) {
+            inliers.push_back(selection.index(index));
+        }
+    }
+    if (inliers.size() >= 3) {
+        QVector3D centroid;
+        SymmetricEigen3 eigen = computeSymmetricEigen3(computeCovariance(*selection.points, inliers, centroid));
+        QVector3D refinedNormal = eigen.eigenvectors[2];
+        if (refinedNormal.z() < 0.0f) {
+            refinedNormal = -refinedNormal;
+        }
+        if (refinedNormal.z() >= minNormalZ) {
+            bestNormal = refinedNormal;
+            bestD = -QVector3D::dotProduct(refinedNormal, centroid);
+        }
+    }
+
+    std::vector<char> inlierFlags(candidates.size(), 0);
+    parallelFor(0, candidates.size(), [&](size_t i) {
+        inlierFlags[i] = qAbs(QVector3D::dotProduct(bestNormal, selection[candidates[i]]) + bestD) <= distanceThreshold;
+    });
+
+    size_t inlierCount = 0;
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        if (inlierFlags[i]) {
+            mask[candidates[i]] = 1;
+            ++inlierCount;
+        }
+    }
+    if (inlierCount < 3) {
+        return false;
+    }
+
+    surface.normal = bestNormal;
+    surface.d = bestD;
+    surface.inlierCount = inlierCount;
+    return true;
+}
+
+std::vector<char> PointCloudProcessor::progressiveMorphologicalFilter(const std::vector<QVector3D>& points,
+                                                                      float cellSize,
+                                                                      float maxWindowSize,
+                                                                      float slope,
+                                                                      float initialDistance,
+                                                                      float maxDistance) const
+{
+    std::vector<char> groundMask(points.size(), 1);
+    if (points.empty() || cellSize <= 0.0f) {
+        return groundMask;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    emitStatusMessage("Running progressive morphological ground filter...");
+
+    auto bbox = computeBoundingBox(points);
+    const QVector3D origin = bbox.first;
+    const size_t columns = static_cast<size_t>((bbox.second.x() - origin.x()) / cellSize) + 1;
+    const size_t rows = static_cast<size_t>((bbox.second.y() - origin.y()) / cellSize) + 1;
+    if (columns * rows > 50000000) {
+        emitStatusMessage("Grid too large for morphological filter, increase cell size");
+        return groundMask;
+    }
+
+    // 非有限点不参与栅格化，也不视为地面点（单元标记为单元总数）
+    const quint32 invalidCell = static_cast<quint32>(rows * columns);
+    std::vector<quint32> pointCells(points.size());
+    parallelFor(0, points.size(), [&](size_t i) {
+        if (!isFinitePoint(points[i])) {
+            pointCells[i] = invalidCell;
+            groundMask[i] = 0;
+            return;
+        }
+        size_t column = qMin(columns - 1, static_cast<size_t>((points[i].x() - origin.x()) / cellSize));
+        size_t row = qMin(rows - 1, static_cast<size_t>((points[i].y() - origin.y()) / cellSize));
+        pointCells[i] = static_cast<quint32>(row * columns + column);
+    });
+
+    // 最低点栅格
+    const float emptyCell = std::numeric_limits<float>::max();
+    std::vector<float> surface(rows * columns, emptyCell);
+    for (size_t i = 0; i < points.size(); ++i) {
+        if (pointCells[i] == invalidCell) {
+            continue;
+        }
+        float& cell = surface[pointCells[i]];
+        cell = qMin(cell, points[i].z());
+    }
+
+    // 空栅格先按行、再按列用最近的非空栅格填充
+    auto fillLine = [&](size_t first, size_t count, size_t stride) {
+        size_t lastFilled = count;
+        for (size_t i = 0; i < count; ++i) {
+            float& cell = surface[first + i * stride];
+            if (cell != emptyCell) {
+                if (lastFilled == count) {
+                    for (size_t j = 0; j < i; ++j) {
+                        surface[first + j * stride] = cell;
+                    }
+                } else {
+                    size_t middle = (lastFilled + i) / 2;
+                    for (size_t j = lastFilled + 1; j < i; ++j) {
+                        surface[first + j * stride] = surface[first + (j <= middle ? lastFilled : i) * stride];
+                    }
+                }
+                lastFilled = i;
+            }
+        }
+        if (lastFilled != count) {
+            for (size_t j = lastFilled + 1; j < count; ++j) {
+                surface[first + j * stride] = surface[first + lastFilled * stride];
+            }
+        }
+    };
+    parallelFor(0, rows, [&](size_t row) { fillLine(row * columns, columns, 1); }, 64);
+    parallelFor(0, columns, [&](size_t column) { fillLine(column, rows, columns); }, 64);
+
+    // 可分离的最小/最大值滤波
+    std::vector<float> buffer(surface.size());
+    auto filterPass = [&](const std::vector<float>& input, std::vector<float>& output,
+                          size_t radius, bool horizontal, bool useMin) {
+        size_t lines = horizontal ? rows : columns;
+        size_t length = horizontal ? columns : rows;
+        size_t stride = horizontal ? 1 : columns;
+        parallelFor(0, lines, [&](size_t line) {
+            size_t first = horizontal ? line * columns : line;
+            for (size_t i = 0; i < length; ++i) {
+                size_t lo = i > radius ? i - radius : 0;
+                size_t hi = qMin(length - 1, i + radius);
+                float value = input[first + lo * stride];
+                for (size_t j = lo + 1; j <= hi; ++j) {
+                    float candidate = input[first + j * stride];
+                    value = useMin ? qMin(value, candidate) : qMax(value, candidate);
+                }
+                output[first + i * stride] = value;
+            }
+        }, 16);
+    };
+
+    // 窗口按2倍递增，至少执行一次
+    float previousWindow = 0.0f;
+    for (size_t halfWindow = 1, iteration = 0;
+         iteration == 0 || (2 * halfWindow + 1) * cellSize <= maxWindowSize;
+         halfWindow *= 2, ++iteration) {
+        float windowSize = (2 * halfWindow + 1) * cellSize;
+        float heightThreshold = iteration == 0
+            ? initialDistance
+            : qMin(maxDistance, slope * (windowSize - previousWindow) + initialDistance);
+        previousWindow = windowSize;
+
+        // 开运算 = 腐蚀（最小值）后膨胀（最大值）
+        filterPass(surface, buffer, halfWindow, true, true);
+        filterPass(buffer, surface, halfWindow, false, true);
+        filterPass(surface, buffer, halfWindow, true, false);
+        filterPass(buffer, surface, halfWindow, false, false);
+
+        parallelFor(0, points.size(), [&](size_t i) {
+            if (groundMask[i] && points[i].z() - surface[pointCells[i]] > heightThreshold) {
+                groundMask[i] = 0;
+            }
+        });
+    }
+
+    size_t groundCount = std::count(groundMask.begin(), groundMask.end(), 1);
+    emitStatusMessage(QString("Morphological filter: %1 of %2 points are ground (%3 ms)")
+                      .arg(groundCount).arg(points.size()).arg(timer.elapsed()));
+
+    return groundMask;
+}
+
 std::vector<QVector3D> PointCloudProcessor::transformCoordinates(const std::vector<QVector3D>& points,
                                                                 CoordinateSystem sourceSystem,
-                                                                CoordinateSystem targetSystem) const
+                                                                CoordinateSystem targetSystem,
+                                                                const CoordinateOrigin& sourceOrigin,
+                                                                CoordinateOrigin* targetOrigin) const
 {
-    return m_lasReader->transformCoordinates(points, sourceSystem, targetSystem);
+    return m_lasReader->transformCoordinates(points, sourceSystem, targetSystem, sourceOrigin, targetOrigin);
 }
 
 void PointCloudProcessor::setProcessingParameters(const QVariantMap& parameters)
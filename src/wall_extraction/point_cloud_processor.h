@@ -9,12 +9,16 @@
 #include <vector>
 #include <memory>
 #include "las_reader.h"
+#include "oriented_bounding_box.h"
+#include "normal_estimation.h"
 
 // 前向声明
 class PCDReader;
 
 namespace WallExtraction {
 
+class PointKDTree;
+
 // 点云格式枚举
 enum class PointCloudFormat {
     Unknown,
@@ -29,6 +33,92 @@ enum class PointCloudFormat {
     TXT
 };
 
+// 水平面（地板或天花板）
+struct HorizontalSurface {
+    QVector3D normal;           // 单位法向量（朝向+Z）
+    float d = 0.0f;             // 平面方程 normal·p + d = 0
+    float height = 0.0f;        // 高度直方图峰值位置
+    size_t inlierCount = 0;     // 内点数量
+    bool isFloor = true;        // true为地板，false为天花板
+};
+
+// 地板/天花板检测结果，掩码与输入点一一对应
+struct FloorCeilingResult {
+    std::vector<char> floorMask;
+    std::vector<char> ceilingMask;
+    std::vector<HorizontalSurface> surfaces;    // 按高度升序
+};
+
+// 滤波阶段类型
+enum class FilterStageType {
+    HeightRange,            // 高度范围（逐点判定）
+    Bounds,                 // 包围盒范围（逐点判定）
+    VoxelDownsample,        // 体素下采样，保留最接近体素质心的原始点
+    StatisticalOutlier,     // 统计离群点滤波（邻域）
+    RadiusOutlier,          // 半径离群点滤波（邻域）
+    VoxelDensity,           // 体素密度滤波
+    RemoveGround,           // 移除地面点
+    KeepGround              // 只保留地面点
+};
+
+// 滤波阶段描述
+struct FilterStage {
+    FilterStageType type = FilterStageType::HeightRange;
+    QVector3D minPoint;         // 范围下限（高度范围只使用z）
+    QVector3D maxPoint;         // 范围上限
+    float size = 0.0f;          // 体素大小 / 搜索半径 / 地面阈值
+    float threshold = 0.0f;     // 标准差倍数
+    int count = 0;              // 邻居数 / 最少点数
+
+    static FilterStage heightRange(float minHeight, float maxHeight);
+    static FilterStage bounds(const QVector3D& minPoint, const QVector3D& maxPoint);
+    static FilterStage voxelDownsample(float voxelSize);
+    static FilterStage statisticalOutlier(int neighborCount = 20, float stdDevThreshold = 2.0f);
+    static FilterStage radiusOutlier(float radius = 0.1f, int minNeighbors = 5);
+    static FilterStage voxelDensity(float voxelSize = 0.2f, int minPointsPerVoxel = 3);
+    static FilterStage removeGround(float groundThreshold = 0.1f);
+    static FilterStage keepGround(float groundThreshold = 0.1f);
+};
+
+// 单个（或融合后的一组）阶段的执行统计
+struct FilterStageTiming {
+    QString name;               // 阶段名，融合阶段以'+'连接
+    size_t inputCount = 0;      // 输入点数
+    size_t outputCount = 0;     // 输出点数
+    double elapsedMs = 0.0;     // 耗时（毫秒）
+    bool fused = false;         // 是否由多个阶段融合执行
+};
+
+// 点云选择的只读视图（引用原始点云和选择索引，不复制点数据）
+// indices为空指针时表示全部点；第i个选中点为points[indices[i]]，按选择位置的掩码长度为size()
+struct PointSelection {
+    const std::vector<QVector3D>* points;
+    const std::vector<quint32>* indices;
+
+    PointSelection(const std::vector<QVector3D>& points) : points(&points), indices(nullptr) {}
+    PointSelection(const std::vector<QVector3D>& points, const std::vector<quint32>& indices)
+        : points(&points), indices(&indices) {}
+
+    size_t size() const { return indices ? indices->size() : points->size(); }
+    bool empty() const { return size() == 0; }
+    quint32 index(size_t position) const { return indices ? (*indices)[position] : static_cast<quint32>(position); }
+    const QVector3D& operator[](size_t position) const { return (*points)[index(position)]; }
+};
+
+// 滤波流水线结果：只保存选择索引，最终结果按需物化
+struct FilterPipelineResult {
+    std::vector<quint32> indices;                   // 保留点在原始点云中的索引（升序）
+    std::vector<FilterStageTiming> stageTimings;    // 各阶段执行统计
+    double totalElapsedMs = 0.0;
+
+    /**
+     * @brief 按选择索引物化点云
+     * @param points 运行流水线时的原始点云
+     * @return 保留的点
+     */
+    std::vector<QVector3D> materialize(const std::vector<QVector3D>& points) const;
+};
+
 // 点云属性信息
 struct PointCloudAttributes {
     bool hasIntensity = false;
@@ -44,6 +134,7 @@ struct PointCloudMetadata {
     quint32 pointCount;
     PointCloudAttributes attributes;
     CoordinateSystemInfo coordinateSystem;
+    CoordinateOrigin origin;        // 读取得到的点坐标相对该原点，边界框与点坐标在同一坐标系
     QVector3D boundingBoxMin;
     QVector3D boundingBoxMax;
     QString originalFilename;
@@ -107,10 +198,22 @@ public:
      */
     PointCloudMetadata getMetadata(const QString& filename) const;
 
+    /**
+     * @brief 获取读取结果所在坐标系的原点
+     *
+     * LAS/LAZ读取结果为相对文件原点的局部坐标（大坐标重定中心），其他格式为绝对坐标，原点为0。
+     * 还原全局坐标时需加回该原点。
+     *
+     * @param filename 文件路径
+     * @return 坐标原点
+     * @throws PointCloudProcessorException
+     */
+    CoordinateOrigin getCoordinateOrigin(const QString& filename) const;
+
     /**
      * @brief 读取点云数据（仅坐标）
      * @param filename 文件路径
-     * @return 点云坐标数组
+     * @return 点云坐标数组（相对getCoordinateOrigin返回的原点）
      * @throws PointCloudProcessorException
      */
     std::vector<QVector3D> readPointCloud(const QString& filename) const;
@@ -118,7 +221,7 @@ public:
     /**
      * @brief 读取点云数据（包含属性）
      * @param filename 文件路径
-     * @return 带属性的点云数据
+     * @return 带属性的点云数据（坐标相对getCoordinateOrigin返回的原点）
      * @throws PointCloudProcessorException
      */
     std::vector<PointWithAttributes> readPointCloudWithAttributes(const QString& filename) const;
@@ -144,16 +247,111 @@ public:
     std::pair<QVector3D, QVector3D> computeBoundingBox(const std::vector<QVector3D>& points) const;
 
     /**
-     * @brief 点云去噪
+     * @brief 点云去噪（统计离群点滤波）
+     *
+     * 基于KD树并行计算每个点到k个近邻的平均距离，
+     * 平均距离超过全局均值加stdDevThreshold倍标准差的点视为离群点。
+     *
      * @param points 原始点云数据
-     * @param neighborCount 邻居点数量阈值
-     * @param stdDevThreshold 标准差阈值
+     * @param neighborCount 邻居点数量
+     * @param stdDevThreshold 标准差倍数阈值
      * @return 去噪后的点云数据
      */
     std::vector<QVector3D> removeOutliers(const std::vector<QVector3D>& points,
                                          int neighborCount = 20,
                                          float stdDevThreshold = 2.0f) const;
 
+    /**
+     * @brief 半径离群点滤波
+     *
+     * 半径r内邻居数少于minNeighbors的点视为离群点。计数达到minNeighbors即停止搜索。
+     *
+     * @param points 原始点云数据
+     * @param radius 搜索半径
+     * @param minNeighbors 最少邻居数（不含点自身）
+     * @return 滤波后的点云数据
+     */
+    std::vector<QVector3D> removeRadiusOutliers(const std::vector<QVector3D>& points,
+                                               float radius = 0.1f,
+                                               int minNeighbors = 5) const;
+
+    /**
+     * @brief 体素密度滤波
+     *
+     * 以点所在体素及其26邻域体素内的点数作为局部密度，
+     * 密度低于minPointsPerVoxel的点被移除，用于去除行人等运动物体留下的稀疏鬼影点。
+     *
+     * @param points 原始点云数据
+     * @param voxelSize 体素大小
+     * @param minPointsPerVoxel 邻域内最少点数
+     * @return 滤波后的点云数据
+     */
+    std::vector<QVector3D> filterByVoxelDensity(const std::vector<QVector3D>& points,
+                                               float voxelSize = 0.2f,
+                                               int minPointsPerVoxel = 3) const;
+
+    /**
+     * @brief PCA法向量估计
+     *
+     * 对每个点的邻域协方差做闭式特征分解，最小特征值方向为法向量。
+     * radius大于0时使用半径邻域，否则使用k近邻。
+     * 在进程内并行计算，替代 normal_estimation.py 的离线流程。
+     *
+     * @param points 点云数据
+     * @param neighborCount k近邻数量（含点自身）
+     * @param radius 邻域半径，0表示使用k近邻
+     * @param orientation 法向量定向方式
+     * @param viewpoint 视点（orientation为TowardViewpoint时使用）
+     * @param curvatures 可选输出，每个点的曲率 λ3/(λ1+λ2+λ3)
+     * @return 与points一一对应的单位法向量，邻域点不足3个的点法向量为零向量
+     */
+    std::vector<QVector3D> estimateNormals(const std::vector<QVector3D>& points,
+                                          int neighborCount = 20,
+                                          float radius = 0.0f,
+                                          NormalOrientation orientation = NormalOrientation::TowardViewpoint,
+                                          const QVector3D& viewpoint = QVector3D(0, 0, 0),
+                                          std::vector<float>* curvatures = nullptr) const;
+
+    /**
+     * @brief 估计主墙方向对齐变换
+     *
+     * 对均匀子采样点估计PCA法向量，再由水平法向量的角度直方图求主方向，
+     * 旋转中心为点云边界中心。
+     *
+     * @param points 点云数据
+     * @param maxSamples 参与法向量估计的最大点数
+     * @param neighborCount k近邻数量
+     * @return 对齐变换，无法确定主方向时valid为false
+     */
+    DominantAxisAlignment estimateDominantAxisAlignment(const std::vector<QVector3D>& points,
+                                                        size_t maxSamples = 50000,
+                                                        int neighborCount = 16) const;
+
+    /**
+     * @brief 运行滤波流水线
+     *
+     * 各阶段只在原始点云的选择索引上工作，最终结果按需物化：
+     * 相邻的逐点阶段（高度、包围盒）及紧随其后的体素下采样在一次并行遍历中融合执行，不复制点数据；
+     * 相邻的邻域阶段（统计、半径离群点）按选择索引共建一棵KD树；
+     * 体素密度和地面阶段经选择索引直接读取原始点云。
+     * 逐点阶段和体素下采样同时移除坐标非有限的点。
+     *
+     * @param points 原始点云数据
+     * @param stages 按顺序执行的滤波阶段
+     * @return 选择索引及各阶段耗时
+     */
+    FilterPipelineResult runFilterPipeline(const std::vector<QVector3D>& points,
+                                           const std::vector<FilterStage>& stages) const;
+
+    /**
+     * @brief 运行滤波流水线并物化结果
+     * @param points 原始点云数据
+     * @param stages 按顺序执行的滤波阶段
+     * @return 滤波后的点云数据
+     */
+    std::vector<QVector3D> applyFilterPipeline(const std::vector<QVector3D>& points,
+                                               const std::vector<FilterStage>& stages) const;
+
     /**
      * @brief 点云下采样
      * @param points 原始点云数据
@@ -176,25 +374,73 @@ public:
 
     /**
      * @brief 分离地面点
+     *
+     * 地面为detectFloorAndCeiling检测到的地板平面内点；未检测到地板时退化为最低点之上groundThreshold内的点。
+     *
      * @param points 原始点云数据
-     * @param groundThreshold 地面阈值
+     * @param groundThreshold 地面阈值（平面内点距离阈值）
      * @return 地面点和非地面点的分离结果
      */
     std::pair<std::vector<QVector3D>, std::vector<QVector3D>> 
     separateGroundPoints(const std::vector<QVector3D>& points,
                         float groundThreshold = 0.1f) const;
 
+    /**
+     * @brief 室内地板/天花板检测
+     *
+     * 先统计高度直方图并检测峰值，每个峰值按其上下方的点分布判定为地板或天花板，
+     * 再在峰值高度带内按二维网格抽样做平面RANSAC，支持多层建筑和轻微倾斜的楼面。
+     *
+     * @param points 点云数据
+     * @param binSize 直方图分辨率
+     * @param distanceThreshold 平面内点距离阈值
+     * @param minPeakFraction 峰值至少包含的点数比例
+     * @return 地板/天花板掩码及平面参数
+     */
+    FloorCeilingResult detectFloorAndCeiling(const std::vector<QVector3D>& points,
+                                             float binSize = 0.05f,
+                                             float distanceThreshold = 0.05f,
+                                             float minPeakFraction = 0.02f) const;
+
+    /**
+     * @brief 渐进形态学地面滤波（室外场景）
+     *
+     * 在最低点栅格上以逐渐增大的窗口做形态学开运算，
+     * 高出开运算表面超过对应高差阈值的点判为非地面点。
+     *
+     * @param points 点云数据
+     * @param cellSize 栅格大小
+     * @param maxWindowSize 最大窗口尺寸（米）
+     * @param slope 地形坡度
+     * @param initialDistance 初始高差阈值
+     * @param maxDistance 最大高差阈值
+     * @return 地面点掩码
+     */
+    std::vector<char> progressiveMorphologicalFilter(const std::vector<QVector3D>& points,
+                                                     float cellSize = 0.5f,
+                                                     float maxWindowSize = 16.0f,
+                                                     float slope = 0.3f,
+                                                     float initialDistance = 0.15f,
+                                                     float maxDistance = 2.5f) const;
+
     /**
      * @brief 坐标系统转换
+     *
+     * 读取时已平移到局部原点的点云须给出sourceOrigin，否则局部坐标会被当作绝对坐标投影。
+     *
      * @param points 原始点云数据
      * @param sourceSystem 源坐标系统
      * @param targetSystem 目标坐标系统
+     * @param sourceOrigin 输入点的坐标原点（例如getCoordinateOrigin的返回值）
+     * @param targetOrigin 输出点的坐标原点（可为空，为空时输出绝对坐标）
      * @return 转换后的点云数据
      * @throws PointCloudProcessorException
      */
     std::vector<QVector3D> transformCoordinates(const std::vector<QVector3D>& points,
                                                CoordinateSystem sourceSystem,
-                                               CoordinateSystem targetSystem) const;
+                                               CoordinateSystem targetSystem,
+                                               const CoordinateOrigin& sourceOrigin = CoordinateOrigin(),
+                                               CoordinateOrigin* targetOrigin = nullptr) const;
 
     /**
      * @brief 设置处理参数
@@ -275,6 +521,104 @@ private:
                                           const QVector3D& queryPoint,
                                           int k) const;
 
+    /**
+     * @brief 统计离群点滤波，清除掩码中离群点的标记
+     * @param selection 选中的点
+     * @param tree 基于selection构建的KD树（查询结果为选择位置）
+     * @param neighborCount 邻居点数量
+     * @param stdDevThreshold 标准差倍数阈值
+     * @param keepMask 按选择位置的保留掩码（统计量基于全部选中点计算）
+     */
+    void applyStatisticalOutlierFilter(const PointSelection& selection,
+                                       const PointKDTree& tree,
+                                       int neighborCount,
+                                       float stdDevThreshold,
+                                       std::vector<char>& keepMask) const;
+
+    /**
+     * @brief 半径离群点滤波，只检查掩码中仍保留的点
+     * @param selection 选中的点
+     * @param tree 基于selection构建的KD树（查询结果为选择位置）
+     * @param radius 搜索半径
+     * @param minNeighbors 最少邻居数（不含点自身）
+     * @param keepMask 按选择位置的保留掩码
+     */
+    void applyRadiusOutlierFilter(const PointSelection& selection,
+                                  const PointKDTree& tree,
+                                  float radius,
+                                  int minNeighbors,
+                                  std::vector<char>& keepMask) const;
+
+    /**
+     * @brief 体素密度滤波，只统计和检查掩码中仍保留的点
+     * @param selection 选中的点
+     * @param voxelSize 体素大小
+     * @param minPointsPerVoxel 邻域内最少点数
+     * @param keepMask 按选择位置的保留掩码
+     */
+    void applyVoxelDensityFilter(const PointSelection& selection,
+                                 float voxelSize,
+                                 int minPointsPerVoxel,
+                                 std::vector<char>& keepMask) const;
+
+    /**
+     * @brief 在高度带内拟合水平面并标记内点
+     * @param selection 选中的点
+     * @param peakHeight 直方图峰值高度
+     * @param bandHalfWidth 候选高度带半宽
+     * @param distanceThreshold 内点距离阈值
+     * @param surface 输出平面参数
+     * @param mask 按选择位置的内点掩码（只置位，不清除）
+     * @return 是否拟合成功
+     */
+    bool fitHorizontalSurface(const PointSelection& selection,
+                              float peakHeight,
+                              float bandHalfWidth,
+                              float distanceThreshold,
+                              HorizontalSurface& surface,
+                              std::vector<char>& mask) const;
+
+    /**
+     * @brief 在选中的点上检测地板/天花板，掩码按选择位置存储
+     * @param selection 选中的点
+     * @param binSize 直方图分辨率
+     * @param distanceThreshold 平面内点距离阈值
+     * @param minPeakFraction 峰值至少包含的点数比例
+     * @return 地板/天花板掩码及平面参数
+     */
+    FloorCeilingResult detectFloorAndCeiling(const PointSelection& selection,
+                                             float binSize,
+                                             float distanceThreshold,
+                                             float minPeakFraction) const;
+
+    /**
+     * @brief 计算地面点掩码（地板平面内点，未检测到地板时退化为高度阈值）
+     * @param selection 选中的点
+     * @param groundThreshold 地面阈值
+     * @return 按选择位置的地面点掩码
+     */
+    std::vector<char> computeGroundMask(const PointSelection& selection,
+                                        float groundThreshold) const;
+
+    /**
+     * @brief 融合执行逐点阶段和体素下采样，原地缩减选择索引
+     * @param points 原始点云数据
+     * @param stages 逐点阶段（可选最后一个为体素下采样）
+     * @param indices 选择索引
+     */
+    void runFusedPointStages(const std::vector<QVector3D>& points,
+                             const std::vector<const FilterStage*>& stages,
+                             std::vector<quint32>& indices) const;
+
+    /**
+     * @brief 按掩码压缩点云
+     * @param points 点云数据
+     * @param keepMask 保留掩码
+     * @return 保留的点
+     */
+    std::vector<QVector3D> compactByMask(const std::vector<QVector3D>& points,
+                                         const std::vector<char>& keepMask) const;
+
     /**
      * @brief 计算点云统计信息
      * @param points 点云数据
@@ -301,6 +645,8 @@ private:
 
 // 注册元类型
 Q_DECLARE_METATYPE(WallExtraction::PointCloudFormat)
+Q_DECLARE_METATYPE(WallExtraction::NormalOrientation)
+Q_DECLARE_METATYPE(WallExtraction::FilterStageType)
 Q_DECLARE_METATYPE(WallExtraction::PointCloudMetadata)
 
 #endif // POINT_CLOUD_PROCESSOR_H
@@ -0,0 +1,311 @@
+#include "point_cloud_statistics.h"
+#include "parallel_utils.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define WALL_EXTRACTION_HAS_SSE2 1
+#endif
+
+namespace WallExtraction {
+
+namespace {
+
+// 每段至少处理的点数，避免小点云的线程开销
+const size_t kMinPointsPerRange = 1 << 16;
+
+struct PartialBounds {
+    float minValue[3] = {std::numeric_limits<float>::max(),
+                         std::numeric_limits<float>::max(),
+                         std::numeric_limits<float>::max()};
+    float maxValue[3] = {std::numeric_limits<float>::lowest(),
+                         std::numeric_limits<float>::lowest(),
+                         std::numeric_limits<float>::lowest()};
+    size_t count = 0;
+
+    void add(const QVector3D& point)
+    {
+        for (int axis = 0; axis < 3; ++axis) {
+            minValue[axis] = std::min(minValue[axis], point[axis]);
+            maxValue[axis] = std::max(maxValue[axis], point[axis]);
+        }
+        ++count;
+    }
+
+    void merge(const PartialBounds& other)
+    {
+        if (other.count == 0) {
+            return;
+        }
+        for (int axis = 0; axis < 3; ++axis) {
+            minValue[axis] = std::min(minValue[axis], other.minValue[axis]);
+            maxValue[axis] = std::max(maxValue[axis], other.maxValue[axis]);
+        }
+        count += other.count;
+    }
+};
+
+// NaN与任何值比较均为false，因此同时排除了非有限值
+inline bool isValidPoint(const QVector3D& point, float maxAbsCoordinate)
+{
+    return std::fabs(point.x()) <= maxAbsCoordinate &&
+           std::fabs(point.y()) <= maxAbsCoordinate &&
+           std::fabs(point.z()) <= maxAbsCoordinate;
+}
+
+inline const QVector3D& pointAt(const char* base, size_t index, size_t strideBytes)
+{
+    return *reinterpret_cast<const QVector3D*>(base + index * strideBytes);
+}
+
+void accumulateBoundsScalar(const char* base, size_t begin, size_t end, size_t strideBytes,
+                            float maxAbsCoordinate, PartialBounds& bounds)
+{
+    for (size_t i = begin; i < end; ++i) {
+        const QVector3D& point = pointAt(base, i, strideBytes);
+        if (isValidPoint(point, maxAbsCoordinate)) {
+            bounds.add(point);
+        }
+    }
+}
+
+#ifdef WALL_EXTRACTION_HAS_SSE2
+/**
+ * 连续存储的点按4个一组处理：12个float正好是3个__m128，
+ * 每个寄存器的分量在各组之间对应相同的坐标轴，因此无需重排即可逐分量求极值，
+ * 最后再按分量所属的轴合并。含无效点的组退回标量处理。
+ */
+void accumulateBoundsContiguous(const QVector3D* points, size_t begin, size_t end,
+                                float maxAbsCoordinate, PartialBounds& bounds)
+{
+    const float* data = reinterpret_cast<const float*>(points);
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    const __m128 limit = _mm_set1_ps(maxAbsCoordinate);
+
+    __m128 min0 = _mm_set1_ps(std::numeric_limits<float>::max());
+    __m128 min1 = min0;
+    __m128 min2 = min0;
+    __m128 max0 = _mm_set1_ps(std::numeric_limits<float>::lowest());
+    __m128 max1 = max0;
+    __m128 max2 = max0;
+    size_t vectorCount = 0;
+
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        const float* block = data + i * 3;
+        __m128 v0 = _mm_loadu_ps(block);
+        __m128 v1 = _mm_loadu_ps(block + 4);
+        __m128 v2 = _mm_loadu_ps(block + 8);
+
+        __m128 valid = _mm_and_ps(_mm_and_ps(_mm_cmple_ps(_mm_and_ps(v0, absMask), limit),
+                                             _mm_cmple_ps(_mm_and_ps(v1, absMask), limit)),
+                                  _mm_cmple_ps(_mm_and_ps(v2, absMask), limit));
+        if (_mm_movemask_ps(valid) != 0xF) {
+            accumulateBoundsScalar(reinterpret_cast<const char*>(points), i, i + 4,
+                                   sizeof(QVector3D), maxAbsCoordinate, bounds);
+            continue;
+        }
+
+        min0 = _mm_min_ps(min0, v0);
+        min1 = _mm_min_ps(min1, v1);
+        min2 = _mm_min_ps(min2, v2);
+        max0 = _mm_max_ps(max0, v0);
+        max1 = _mm_max_ps(max1, v1);
+        max2 = _mm_max_ps(max2, v2);
+        vectorCount += 4;
+    }
+
+    if (vectorCount > 0) {
+        float mins[12];
+        float maxs[12];
+        _mm_storeu_ps(mins, min0);
+        _mm_storeu_ps(mins + 4, min1);
+        _mm_storeu_ps(mins + 8, min2);
+        _mm_storeu_ps(maxs, max0);
+        _mm_storeu_ps(maxs + 4, max1);
+        _mm_storeu_ps(maxs + 8, max2);
+
+        // 第k个float属于第 k % 3 个坐标轴
+        PartialBounds vectorBounds;
+        for (int k = 0; k < 12; ++k) {
+            int axis = k % 3;
+            vectorBounds.minValue[axis] = std::min(vectorBounds.minValue[axis], mins[k]);
+            vectorBounds.maxValue[axis] = std::max(vectorBounds.maxValue[axis], maxs[k]);
+        }
+        vectorBounds.count = vectorCount;
+        bounds.merge(vectorBounds);
+    }
+
+    accumulateBoundsScalar(reinterpret_cast<const char*>(points), i, end,
+                           sizeof(QVector3D), maxAbsCoordinate, bounds);
+}
+#endif
+
+} // namespace
+
+float PointCloudStatistics::zPercentile(double percentile) const
+{
+    if (zHistogram.empty()) {
+        return bounds.minPoint.z();
+    }
+
+    quint64 total = 0;
+    for (quint32 count : zHistogram) {
+        total += count;
+    }
+    if (total == 0) {
+        return bounds.minPoint.z();
+    }
+
+    double target = std::max(0.0, std::min(1.0, percentile)) * total;
+    quint64 cumulative = 0;
+    for (size_t bin = 0; bin < zHistogram.size(); ++bin) {
+        quint64 next = cumulative + zHistogram[bin];
+        if (next >= target && zHistogram[bin] > 0) {
+            double fraction = (target - cumulative) / zHistogram[bin];
+            return static_cast<float>(zHistogramMin + (bin + fraction) * zBinSize);
+        }
+        cumulative = next;
+    }
+    return bounds.maxPoint.z();
+}
+
+QVariantMap PointCloudStatistics::toVariantMap() const
+{
+    QVariantMap map;
+    map["point_count"] = static_cast<qulonglong>(bounds.validCount);
+    map["min_x"] = bounds.minPoint.x();
+    map["min_y"] = bounds.minPoint.y();
+    map["min_z"] = bounds.minPoint.z();
+    map["max_x"] = bounds.maxPoint.x();
+    map["max_y"] = bounds.maxPoint.y();
+    map["max_z"] = bounds.maxPoint.z();
+    map["mean_x"] = mean.x();
+    map["mean_y"] = mean.y();
+    map["mean_z"] = mean.z();
+    map["std_dev_x"] = std::sqrt(variance.x());
+    map["std_dev_y"] = std::sqrt(variance.y());
+    map["std_dev_z"] = std::sqrt(variance.z());
+    map["median_z"] = zPercentile(0.5);
+    map["z_percentile_05"] = zPercentile(0.05);
+    map["z_percentile_95"] = zPercentile(0.95);
+    return map;
+}
+
+PointCloudBounds computePointCloudBounds(const QVector3D* points,
+                                         size_t count,
+                                         size_t strideBytes,
+                                         float maxAbsCoordinate)
+{
+    PointCloudBounds result;
+    if (!points || count == 0) {
+        return result;
+    }
+
+    const char* base = reinterpret_cast<const char*>(points);
+    std::vector<PartialBounds> partials(parallelRangeCount(count, kMinPointsPerRange));
+    parallelForRange(0, count, [&](size_t begin, size_t end, size_t range) {
+#ifdef WALL_EXTRACTION_HAS_SSE2
+        if (strideBytes == sizeof(QVector3D) && sizeof(QVector3D) == 3 * sizeof(float)) {
+            accumulateBoundsContiguous(points, begin, end, maxAbsCoordinate, partials[range]);
+            return;
+        }
+#endif
+        accumulateBoundsScalar(base, begin, end, strideBytes, maxAbsCoordinate, partials[range]);
+    }, kMinPointsPerRange);
+
+    PartialBounds total;
+    for (const auto& partial : partials) {
+        total.merge(partial);
+    }
+    if (total.count == 0) {
+        return result;
+    }
+
+    result.minPoint = QVector3D(total.minValue[0], total.minValue[1], total.minValue[2]);
+    result.maxPoint = QVector3D(total.maxValue[0], total.maxValue[1], total.maxValue[2]);
+    result.validCount = total.count;
+    return result;
+}
+
+PointCloudBounds computePointCloudBounds(const std::vector<QVector3D>& points, float maxAbsCoordinate)
+{
+    return computePointCloudBounds(points.data(), points.size(), sizeof(QVector3D), maxAbsCoordinate);
+}
+
+PointCloudStatistics computePointCloudStatistics(const QVector3D* points,
+                                                 size_t count,
+                                                 size_t strideBytes,
+                                                 size_t histogramBins)
+{
+    PointCloudStatistics statistics;
+    statistics.bounds = computePointCloudBounds(points, count, strideBytes);
+    if (!statistics.bounds.isValid()) {
+        return statistics;
+    }
+
+    histogramBins = std::max<size_t>(1, histogramBins);
+    const float zRange = statistics.bounds.size().z();
+    statistics.zHistogramMin = statistics.bounds.minPoint.z();
+    statistics.zBinSize = zRange > 0.0f ? zRange / histogramBins : 1.0f;
+    const float inverseBinSize = 1.0f / statistics.zBinSize;
+
+    // 以边界中心为偏移累计矩，避免大坐标下的精度损失
+    struct PartialMoments {
+        double sum[3] = {0.0, 0.0, 0.0};
+        double sumSquares[3] = {0.0, 0.0, 0.0};
+        std::vector<quint32> histogram;
+    };
+
+    const QVector3D shift = statistics.bounds.center();
+    const char* base = reinterpret_cast<const char*>(points);
+    const float maxAbsCoordinate = std::numeric_limits<float>::max();
+    std::vector<PartialMoments> partials(parallelRangeCount(count, kMinPointsPerRange));
+    parallelForRange(0, count, [&](size_t begin, size_t end, size_t range) {
+        PartialMoments& moments = partials[range];
+        moments.histogram.assign(histogramBins, 0);
+        for (size_t i = begin; i < end; ++i) {
+            const QVector3D& point = pointAt(base, i, strideBytes);
+            if (!isValidPoint(point, maxAbsCoordinate)) {
+                continue;
+            }
+            for (int axis = 0; axis < 3; ++axis) {
+                double value = static_cast<double>(point[axis]) - shift[axis];
+                moments.sum[axis] += value;
+                moments.sumSquares[axis] += value * value;
+            }
+            size_t bin = static_cast<size_t>((point.z() - statistics.zHistogramMin) * inverseBinSize);
+            ++moments.histogram[std::min(bin, histogramBins - 1)];
+        }
+    }, kMinPointsPerRange);
+
+    double sum[3] = {0.0, 0.0, 0.0};
+    double sumSquares[3] = {0.0, 0.0, 0.0};
+    statistics.zHistogram.assign(histogramBins, 0);
+    for (const auto& partial : partials) {
+        for (int axis = 0; axis < 3; ++axis) {
+            sum[axis] += partial.sum[axis];
+            sumSquares[axis] += partial.sumSquares[axis];
+        }
+        for (size_t bin = 0; bin < partial.histogram.size(); ++bin) {
+            statistics.zHistogram[bin] += partial.histogram[bin];
+        }
+    }
+
+    const double n = static_cast<double>(statistics.bounds.validCount);
+    for (int axis = 0; axis < 3; ++axis) {
+        double mean = sum[axis] / n;
+        statistics.mean[axis] = static_cast<float>(static_cast<double>(shift[axis]) + mean);
+        statistics.variance[axis] = static_cast<float>(std::max(0.0, sumSquares[axis] / n - mean * mean));
+    }
+
+    return statistics;
+}
+
+PointCloudStatistics computePointCloudStatistics(const std::vector<QVector3D>& points, size_t histogramBins)
+{
+    return computePointCloudStatistics(points.data(), points.size(), sizeof(QVector3D), histogramBins);
+}
+
+} // namespace WallExtraction
@@ -0,0 +1,100 @@
+#ifndef POINT_CLOUD_STATISTICS_H
+#define POINT_CLOUD_STATISTICS_H
+
+#include <QVector3D>
+#include <QVariantMap>
+#include <vector>
+#include <limits>
+
+namespace WallExtraction {
+
+// 点云轴对齐边界
+struct PointCloudBounds {
+    QVector3D minPoint;
+    QVector3D maxPoint;
+    size_t validCount = 0;      // 参与统计的有效点数
+
+    bool isValid() const { return validCount > 0; }
+    QVector3D size() const { return maxPoint - minPoint; }
+    QVector3D center() const { return (minPoint + maxPoint) * 0.5f; }
+};
+
+// 点云统计信息
+struct PointCloudStatistics {
+    PointCloudBounds bounds;
+    QVector3D mean;                     // 均值
+    QVector3D variance;                 // 方差（总体方差）
+    std::vector<quint32> zHistogram;    // 高度直方图
+    float zHistogramMin = 0.0f;         // 直方图起始高度
+    float zBinSize = 0.0f;              // 直方图分辨率
+
+    bool isValid() const { return bounds.isValid(); }
+
+    /**
+     * @brief 由高度直方图估计高度分位数（格内线性插值）
+     * @param percentile 分位数 [0,1]
+     * @return 估计的高度值
+     */
+    float zPercentile(double percentile) const;
+
+    /**
+     * @brief 转换为QVariantMap
+     * @return 统计信息
+     */
+    QVariantMap toVariantMap() const;
+};
+
+/**
+ * @brief 计算点云边界（SIMD + 多线程归约）
+ *
+ * 任一坐标非有限或绝对值超过maxAbsCoordinate的点视为无效点，不参与统计。
+ * 支持带步长的点数组，例如 PointWithAttributes::position。
+ *
+ * @param points 第一个点的坐标
+ * @param count 点数
+ * @param strideBytes 相邻两点坐标之间的字节数
+ * @param maxAbsCoordinate 坐标绝对值上限
+ * @return 边界，无有效点时validCount为0
+ */
+PointCloudBounds computePointCloudBounds(const QVector3D* points,
+                                         size_t count,
+                                         size_t strideBytes = sizeof(QVector3D),
+                                         float maxAbsCoordinate = std::numeric_limits<float>::max());
+
+/**
+ * @brief 计算点云边界
+ * @param points 点云数据
+ * @param maxAbsCoordinate 坐标绝对值上限
+ * @return 边界
+ */
+PointCloudBounds computePointCloudBounds(const std::vector<QVector3D>& points,
+                                         float maxAbsCoordinate = std::numeric_limits<float>::max());
+
+/**
+ * @brief 计算点云统计信息（边界、均值、方差、高度直方图）
+ *
+ * 先归约边界，再以边界中心为偏移并行累计一阶、二阶矩和高度直方图，共两次遍历。
+ *
+ * @param points 第一个点的坐标
+ * @param count 点数
+ * @param strideBytes 相邻两点坐标之间的字节数
+ * @param histogramBins 高度直方图格数
+ * @return 统计信息
+ */
+PointCloudStatistics computePointCloudStatistics(const QVector3D* points,
+                                                 size_t count,
+                                                 size_t strideBytes = sizeof(QVector3D),
+                                                 size_t histogramBins = 256);
+
+/**
+ * @brief 计算点云统计信息
+ * @param points 点云数据
+ * @param histogramBins 高度直方图格数
+ * @return 统计信息
+ */
+PointCloudStatistics computePointCloudStatistics(const std::vector<QVector3D>& points,
+                                                 size_t histogramBins = 256);
+
+} // namespace WallExtraction
+
+#endif // POINT_CLOUD_STATISTICS_H
@@ -0,0 +1,342 @@
+#include "region_growing.h"
+#include "parallel_utils.h"
+#include "spatial_index.h"
+#include "symmetric_eigen_solver.h"
+#include <QElapsedTimer>
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace WallExtraction {
+
+namespace {
+
+// 默认邻居数
+const int kDefaultNeighborCount = 12;
+
+// 默认相邻点法向最大夹角（度）
+const float kDefaultMaxNormalAngle = 10.0f;
+
+// 默认种子曲率阈值（平面点的曲率接近0，棱角处接近1/3）
+const float kDefaultMaxSeedCurvature = 0.05f;
+
+// 无效邻居/无效区域标记
+const quint32 kInvalidIndex = std::numeric_limits<quint32>::max();
+
+// 每个分块至少包含的点数
+const size_t kMinPointsPerTile = 1 << 14;
+
+/**
+ * @brief 并查集查找（路径减半），只能由拥有该子树的线程调用
+ */
+inline quint32 findRoot(std::vector<quint32>& parent, quint32 i)
+{
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+/**
+ * @brief 并查集查找（不修改），合并完成后可并发调用
+ */
+inline quint32 findRootConst(const std::vector<quint32>& parent, quint32 i)
+{
+    while (parent[i] != i) {
+        i = parent[i];
+    }
+    return i;
+}
+
+/**
+ * @brief 合并两个集合，较小的根作为新根，使结果与合并顺序无关
+ */
+inline void unite(std::vector<quint32>& parent, quint32 a, quint32 b)
+{
+    a = findRoot(parent, a);
+    b = findRoot(parent, b);
+    if (a < b) {
+        parent[b] = a;
+    } else if (b < a) {
+        parent[a] = b;
+    }
+}
+
+} // namespace
+
+RegionGrowingSegmenter::RegionGrowingSegmenter(const RANSACParameters& parameters)
+    : m_parameters(parameters)
+    , m_neighborCount(kDefaultNeighborCount)
+    , m_maxNormalAngle(kDefaultMaxNormalAngle)
+    , m_maxSeedCurvature(kDefaultMaxSeedCurvature)
+{
+}
+
+void RegionGrowingSegmenter::setParameters(const RANSACParameters& parameters)
+{
+    m_parameters = parameters;
+}
+
+RANSACParameters RegionGrowingSegmenter::getParameters() const
+{
+    return m_parameters;
+}
+
+void RegionGrowingSegmenter::setNeighborCount(int neighborCount)
+{
+    m_neighborCount = std::max(3, neighborCount);
+}
+
+int RegionGrowingSegmenter::getNeighborCount() const
+{
+    return m_neighborCount;
+}
+
+void RegionGrowingSegmenter::setMaxNormalAngle(float degrees)
+{
+    m_maxNormalAngle = std::clamp(degrees, 0.0f, 90.0f);
+}
+
+float RegionGrowingSegmenter::getMaxNormalAngle() const
+{
+    return m_maxNormalAngle;
+}
+
+void RegionGrowingSegmenter::setMaxSeedCurvature(float curvature)
+{
+    m_maxSeedCurvature = std::clamp(curvature, 1e-6f, 1.0f / 3.0f);
+}
+
+float RegionGrowingSegmenter::getMaxSeedCurvature() const
+{
+    return m_maxSeedCurvature;
+}
+
+void RegionGrowingSegmenter::setProgressCallback(std::function<void(int)> callback)
+{
+    m_progressCallback = callback;
+}
+
+void RegionGrowingSegmenter::setCancellationCallback(std::function<bool()> callback)
+{
+    m_cancellationCallback = callback;
+}
+
+QVariantMap RegionGrowingSegmenter::getStatistics() const
+{
+    return m_statistics;
+}
+
+std::vector<Plane3D> RegionGrowingSegmenter::segment(const std::vector<QVector3D>& points)
+{
+    std::vector<Plane3D> planes;
+    m_statistics.clear();
+
+    QElapsedTimer timer;
+    timer.start();
+
+    const size_t pointCount = points.size();
+    const size_t minPoints = static_cast<size_t>(std::max(3, m_parameters.minPoints));
+    if (pointCount < minPoints || pointCount >= kInvalidIndex) {
+        return planes;
+    }
+
+    // 1. K近邻邻接、法向量和曲率（按KD树布局分块，分块即后续的并查集分块）
+    //    非有限点不在树中，保持曲率1且没有邻居，不参与生长
+    const size_t k = static_cast<size_t>(m_neighborCount);
+    PointKDTree tree(points);
+    std::vector<quint32> neighbors(pointCount * k, kInvalidIndex);
+    std::vector<QVector3D> normals(pointCount);
+    std::vector<float> curvature(pointCount, 1.0f);
+    std::vector<quint32> tileOf(pointCount, 0);
+
+    parallelForRange(0, tree.size(), [&](size_t begin, size_t end, size_t tile) {
+        std::vector<quint32> indices;
+        std::vector<float> squaredDistances;
+        for (size_t position = begin; position < end; ++position) {
+            const quint32 index = tree.layoutIndex(position);
+            tileOf[index] = static_cast<quint32>(tile);
+            const QVector3D& p = tree.layoutPoint(position);
+            // 结果包含查询点自身，多取一个
+            if (tree.knnSearch(p, k + 1, indices, squaredDistances) < 3) {
+                continue;
+            }
+            QVector3D centroid;
+            SymmetricEigen3 eigen = computeSymmetricEigen3(computeCovariance(points, indices, centroid));
+            const double sum = eigen.eigenvalues[0] + eigen.eigenvalues[1] + eigen.eigenvalues[2];
+            normals[index] = eigen.eigenvectors[2];
+            curvature[index] = sum > 0.0 ? static_cast<float>(eigen.eigenvalues[2] / sum) : 0.0f;
+
+            size_t slot = 0;
+            for (quint32 neighbor : indices) {
+                if (neighbor != index && slot < k) {
+                    neighbors[index * k + slot++] = neighbor;
+                }
+            }
+        }
+    }, kMinPointsPerTile);
+
+    const qint64 neighborhoodTime = timer.elapsed();
+    if (m_cancellationCallback && m_cancellationCallback()) {
+        return planes;
+    }
+    if (m_progressCallback) {
+        m_progressCallback(50);
+    }
+
+    const float epsilon = m_parameters.epsilon;
+    const float normalThreshold = std::cos(qDegreesToRadians(m_maxNormalAngle));
+    auto isSeed = [&](quint32 i) {
+        return curvature[i] <= m_maxSeedCurvature;
+    };
+    auto isCompatible = [&](quint32 i, quint32 j) {
+        if (std::fabs(QVector3D::dotProduct(normals[i], normals[j])) < normalThreshold) {
+            return false;
+        }
+        QVector3D offset = points[j] - points[i];
+        return std::fabs(QVector3D::dotProduct(normals[i], offset)) <= epsilon &&
+               std::fabs(QVector3D::dotProduct(normals[j], offset)) <= epsilon;
+    };
+
+    // 2. 种子之间的连接：块内直接合并，跨块的连接先收集
+    std::vector<quint32> parent(pointCount);
+    std::iota(parent.begin(), parent.end(), 0u);
+    std::vector<std::vector<std::pair<quint32, quint32>>> crossEdges(
+        parallelRangeCount(tree.size(), kMinPointsPerTile));
+
+    parallelForRange(0, tree.size(), [&](size_t begin, size_t end, size_t tile) {
+        for (size_t position = begin; position < end; ++position) {
+            const quint32 i = tree.layoutIndex(position);
+            if (!isSeed(i)) {
+                continue;
+            }
+            for (size_t slot = 0; slot < k; ++slot) {
+                const quint32 j = neighbors[i * k + slot];
+                if (j == kInvalidIndex || !isSeed(j) || !isCompatible(i, j)) {
+                    continue;
+                }
+                if (tileOf[j] == tile) {
+                    unite(parent, i, j);
+                } else if (i < j) {
+                    crossEdges[tile].emplace_back(i, j);
+                } else {
+                    crossEdges[tile].emplace_back(j, i);
+                }
+            }
+        }
+    }, kMinPointsPerTile);
+
+    for (const auto& edges : crossEdges) {
+        for (const auto& edge : edges) {
+            unite(parent, edge.first, edge.second);
+        }
+    }
+
+    // 3. 区域标签：种子取其根，非种子点归属曲率最低的兼容种子
+    std::vector<quint32> label(pointCount, kInvalidIndex);
+    parallelFor(0, pointCount, [&](size_t index) {
+        const quint32 i = static_cast<quint32>(index);
+        if (isSeed(i)) {
+            label[i] = findRootConst(parent, i);
+            return;
+        }
+        if (curvature[i] > 1.0f / 3.0f) {
+            return;     // 法向量无效
+        }
+        quint32 bestSeed = kInvalidIndex;
+        for (size_t slot = 0; slot < k; ++slot) {
+            const quint32 j = neighbors[i * k + slot];
+            if (j != kInvalidIndex && isSeed(j) && isCompatible(i, j) &&
+                (bestSeed == kInvalidIndex || curvature[j] < curvature[bestSeed])) {
+                bestSeed = j;
+            }
+        }
+        if (bestSeed != kInvalidIndex) {
+            label[i] = findRootConst(parent, bestSeed);
+        }
+    }, kMinPointsPerTile);
+
+    const size_t seedCount = static_cast<size_t>(std::count_if(curvature.begin(), curvature.end(),
+                                                               [this](float c) { return c <= m_maxSeedCurvature; }));
+    std::vector<quint32>().swap(neighbors);
+    std::vector<quint32>().swap(parent);
+
+    // 4. 按标签分组（计数排序），保留点数不少于minPoints的区域
+    std::vector<quint32> regionSize(pointCount, 0);
+    for (quint32 root : label) {
+        if (root != kInvalidIndex) {
+            ++regionSize[root];
+        }
+    }
+    std::vector<quint32> roots;
+    for (size_t i = 0; i < pointCount; ++i) {
+        if (regionSize[i] >= minPoints) {
+            roots.push_back(static_cast<quint32>(i));
+        }
+    }
+    std::sort(roots.begin(), roots.end(), [&regionSize](quint32 a, quint32 b) {
+        return regionSize[a] > regionSize[b] || (regionSize[a] == regionSize[b] && a < b);
+    });
+
+    std::vector<quint32> regionOf(pointCount, kInvalidIndex);
+    std::vector<std::vector<quint32>> regions(roots.size());
+    for (size_t r = 0; r < roots.size(); ++r) {
+        regionOf[roots[r]] = static_cast<quint32>(r);
+        regions[r].reserve(regionSize[roots[r]]);
+    }
+    for (size_t i = 0; i < pointCount; ++i) {
+        if (label[i] != kInvalidIndex && regionOf[label[i]] != kInvalidIndex) {
+            regions[regionOf[label[i]]].push_back(static_cast<quint32>(i));
+        }
+    }
+
+    if (m_cancellationCallback && m_cancellationCallback()) {
+        return planes;
+    }
+    if (m_progressCallback) {
+        m_progressCallback(80);
+    }
+
+    // 5. 各区域PCA拟合平面，距平面超过epsilon的点不计入内点
+    std::vector<Plane3D> fitted(regions.size());
+    parallelFor(0, regions.size(), [&](size_t r) {
+        QVector3D centroid;
+        SymmetricEigen3 eigen = computeSymmetricEigen3(computeCovariance(points, regions[r], centroid));
+        Plane3D& plane = fitted[r];
+        plane.point = centroid;
+        plane.normal = eigen.eigenvectors[2];
+        plane.distance = QVector3D::dotProduct(plane.normal, centroid);
+        plane.inlierIndices.reserve(regions[r].size());
+        for (quint32 index : regions[r]) {
+            if (std::fabs(QVector3D::dotProduct(plane.normal, points[index]) - plane.distance) <= epsilon) {
+                plane.inlierIndices.push_back(static_cast<int>(index));
+            }
+        }
+        plane.confidence = static_cast<float>(plane.inlierIndices.size()) / pointCount;
+    }, 1);
+
+    size_t segmentedPoints = 0;
+    for (Plane3D& plane : fitted) {
+        if (plane.inlierIndices.size() >= minPoints) {
+            segmentedPoints += plane.inlierIndices.size();
+            planes.push_back(std::move(plane));
+        }
+    }
+
+    if (m_progressCallback) {
+        m_progressCallback(100);
+    }
+
+    m_statistics["seed_points"] = static_cast<qulonglong>(seedCount);
+    m_statistics["regions_detected"] = static_cast<int>(planes.size());
+    m_statistics["segmented_points"] = static_cast<qulonglong>(segmentedPoints);
+    m_statistics["unassigned_points"] = static_cast<qulonglong>(pointCount - segmentedPoints);
+    m_statistics["neighborhood_ms"] = neighborhoodTime;
+    m_statistics["segmentation_ms"] = timer.elapsed() - neighborhoodTime;
+    return planes;
+}
+
+} // namespace WallExtraction
@@ -0,0 +1,93 @@
+#ifndef REGION_GROWING_H
+#define REGION_GROWING_H
+
+#include <QVector3D>
+#include <QVariantMap>
+#include <functional>
+#include <vector>
+#include "wall_fitting_algorithm.h"
+
+namespace WallExtraction {
+
+/**
+ * @brief 基于法向量的区域生长平面分割
+ *
+ * - 邻接关系：KD树K近邻，同时估计每个点的法向量和曲率（最小特征值占比）；
+ * - 生长条件：相邻点法向夹角不超过maxNormalAngle，且互相到对方切平面的距离不超过epsilon；
+ * - 种子：曲率低于maxSeedCurvature的点可以继续向外生长，其余点只能被相邻种子吸收，
+ *   并归属曲率最低的兼容种子所在区域；
+ * - 并行合并：点按KD树布局划分为空间分块，块内的种子连接在各线程的并查集上完成，
+ *   跨块的连接最后串行合并。种子之间的连通关系与生长顺序无关，结果与按曲率升序逐个种子生长一致。
+ *
+ * 点数不少于minPoints的区域按PCA拟合平面，距平面超过epsilon的点不计入内点。
+ */
+class RegionGrowingSegmenter
+{
+public:
+    explicit RegionGrowingSegmenter(const RANSACParameters& parameters = RANSACParameters());
+
+    void setParameters(const RANSACParameters& parameters);
+    RANSACParameters getParameters() const;
+
+    /**
+     * @brief 设置邻居数量
+     * @param neighborCount K近邻数量（至少为3）
+     */
+    void setNeighborCount(int neighborCount);
+    int getNeighborCount() const;
+
+    /**
+     * @brief 设置相邻点法向量的最大夹角
+     *
+     * 夹角逐点累积，过大时区域会沿平滑过渡（如噪声点链）跨到相交的平面上，
+     * 因此比RANSAC的normalThreshold严格。
+     * @param degrees 最大夹角（度）
+     */
+    void setMaxNormalAngle(float degrees);
+    float getMaxNormalAngle() const;
+
+    /**
+     * @brief 设置种子点的最大曲率
+     * @param curvature 曲率阈值，取值范围(0, 1/3]
+     */
+    void setMaxSeedCurvature(float curvature);
+    float getMaxSeedCurvature() const;
+
+    /**
+     * @brief 设置进度回调
+     * @param callback 回调 callback(百分比)
+     */
+    void setProgressCallback(std::function<void(int)> callback);
+
+    /**
+     * @brief 设置取消检查，返回true时在下一阶段之前停止并返回空结果
+     * @param callback 取消检查回调
+     */
+    void setCancellationCallback(std::function<bool()> callback);
+
+    /**
+     * @brief 分割平面
+     * @param points 点云数据
+     * @return 检测到的平面，按内点数降序排列，内点互不重叠
+     */
+    std::vector<Plane3D> segment(const std::vector<QVector3D>& points);
+
+    /**
+     * @brief 获取上一次分割的统计信息
+     * @return 统计信息（seed_points、regions_detected等）
+     */
+    QVariantMap getStatistics() const;
+
+private:
+    RANSACParameters m_parameters;
+    int m_neighborCount;
+    float m_maxNormalAngle;
+    float m_maxSeedCurvature;
+    std::function<void(int)> m_progressCallback;
+    std::function<bool()> m_cancellationCallback;
+    QVariantMap m_statistics;
+};
+
+} // namespace WallExtraction
+
+#endif // REGION_GROWING_H
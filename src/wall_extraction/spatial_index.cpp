@@ -1,12 +1,27 @@
 #include "spatial_index.h"
+#include "parallel_utils.h"
+#include "point_cloud_statistics.h"
 #include <QDebug>
 #include <QElapsedTimer>
 #include <QtMath>
 #include <algorithm>
+#include <cmath>
+#include <numeric>
 #include <queue>
+#include <thread>
 
 namespace WallExtraction {
 
+namespace {
+
+// 自动确定栅格边长时每个单元的平均点数
+const double kGridPointsPerCell = 32.0;
+
+// 栅格单元总数上限
+const double kMaxGridCells = 1 << 22;
+
+} // namespace
+
 SpatialIndex::SpatialIndex(QObject* parent)
     : QObject(parent)
     , m_indexType(SpatialIndexType::Octree)
@@ -331,24 +346,12 @@ bool SpatialIndex::isPointInBoundingBox(const QVector3D& point, const QVector3D&
 
 std::pair<QVector3D, QVector3D> SpatialIndex::computeBoundingBox(const std::vector<QVector3D>& points) const
 {
-    if (points.empty()) {
+    PointCloudBounds bounds = computePointCloudBounds(points);
+    if (!bounds.isValid()) {
         return {QVector3D(), QVector3D()};
     }
-    
-    QVector3D minPoint = points[0];
-    QVector3D maxPoint = points[0];
-    
-    for (const auto& point : points) {
-        minPoint.setX(qMin(minPoint.x(), point.x()));
-        minPoint.setY(qMin(minPoint.y(), point.y()));
-        minPoint.setZ(qMin(minPoint.z(), point.z()));
-        
-        maxPoint.setX(qMax(maxPoint.x(), point.x()));
-        maxPoint.setY(qMax(maxPoint.y(), point.y()));
-        maxPoint.setZ(qMax(maxPoint.z(), point.z()));
-    }
-    
-    return {minPoint, maxPoint};
+
+    return {bounds.minPoint, bounds.maxPoint};
 }
 
 void SpatialIndex::updateStatistics()
@@ -741,4 +744,444 @@ void SpatialIndex::emitErrorOccurred(const QString& error)
     emit errorOccurred(error);
 }
 
+// PointKDTree 实现
+PointKDTree::PointKDTree()
+    : m_leafSize(32)
+{
+}
+
+PointKDTree::PointKDTree(const std::vector<QVector3D>& points, size_t leafSize)
+    : m_leafSize(32)
+{
+    build(points, leafSize);
+}
+
+PointKDTree::PointKDTree(const std::vector<QVector3D>& points, const std::vector<quint32>& indices, size_t leafSize)
+    : m_leafSize(32)
+{
+    build(points, indices, leafSize);
+}
+
+void PointKDTree::build(const std::vector<QVector3D>& points, size_t leafSize)
+{
+    clear();
+    m_leafSize = qMax(static_cast<size_t>(1), leafSize);
+
+    // 非有限点不参与构建：NaN无法比较，nth_element的行为未定义
+    m_indices.reserve(points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        const QVector3D& point = points[i];
+        if (std::isfinite(point.x()) && std::isfinite(point.y()) && std::isfinite(point.z())) {
+            m_indices.push_back(static_cast<quint32>(i));
+        }
+    }
+    buildLayout(points, nullptr);
+}
+
+void PointKDTree::build(const std::vector<QVector3D>& points, const std::vector<quint32>& indices, size_t leafSize)
+{
+    clear();
+    m_leafSize = qMax(static_cast<size_t>(1), leafSize);
+
+    // m_indices保存选择位置，构建时经indices间接访问原始点
+    m_indices.reserve(indices.size());
+    for (size_t i = 0; i < indices.size(); ++i) {
+        const QVector3D& point = points[indices[i]];
+        if (std::isfinite(point.x()) && std::isfinite(point.y()) && std::isfinite(point.z())) {
+            m_indices.push_back(static_cast<quint32>(i));
+        }
+    }
+    buildLayout(points, indices.data());
+}
+
+void PointKDTree::clear()
+{
+    m_points.clear();
+    m_indices.clear();
+    m_splitAxis.clear();
+}
+
+void PointKDTree::buildLayout(const std::vector<QVector3D>& source, const quint32* sourceIndices)
+{
+    if (m_indices.empty()) {
+        return;
+    }
+    m_splitAxis.assign(m_indices.size(), 0);
+
+    // 顶层若干级子树在独立线程中构建，各线程只写不相交的区间
+    int parallelDepth = 0;
+    while ((static_cast<size_t>(1) << parallelDepth) < parallelThreadCount() && parallelDepth < 4) {
+        ++parallelDepth;
+    }
+    if (m_indices.size() < 65536) {
+        parallelDepth = 0;
+    }
+
+    buildRange(source, sourceIndices, 0, m_indices.size(), parallelDepth);
+
+    // 按树布局重排点，查询时顺序访问
+    m_points.resize(m_indices.size());
+    for (size_t i = 0; i < m_indices.size(); ++i) {
+        m_points[i] = source[sourceIndices ? sourceIndices[m_indices[i]] : m_indices[i]];
+    }
+}
+
+void PointKDTree::buildRange(const std::vector<QVector3D>& source, const quint32* sourceIndices,
+                             size_t begin, size_t end, int parallelDepth)
+{
+    if (end - begin <= m_leafSize) {
+        return;
+    }
+
+    auto pointAt = [&source, sourceIndices](quint32 index) -> const QVector3D& {
+        return source[sourceIndices ? sourceIndices[index] : index];
+    };
+
+    // 沿包围盒最长轴分割
+    QVector3D minPoint = pointAt(m_indices[begin]);
+    QVector3D maxPoint = minPoint;
+    for (size_t i = begin + 1; i < end; ++i) {
+        const QVector3D& point = pointAt(m_indices[i]);
+        minPoint.setX(qMin(minPoint.x(), point.x()));
+        minPoint.setY(qMin(minPoint.y(), point.y()));
+        minPoint.setZ(qMin(minPoint.z(), point.z()));
+        maxPoint.setX(qMax(maxPoint.x(), point.x()));
+        maxPoint.setY(qMax(maxPoint.y(), point.y()));
+        maxPoint.setZ(qMax(maxPoint.z(), point.z()));
+    }
+
+    QVector3D extent = maxPoint - minPoint;
+    int axis = 0;
+    if (extent.y() > extent[axis]) axis = 1;
+    if (extent.z() > extent[axis]) axis = 2;
+
+    size_t mid = begin + (end - begin) / 2;
+    std::nth_element(m_indices.begin() + begin, m_indices.begin() + mid, m_indices.begin() + end,
+                     [&pointAt, axis](quint32 a, quint32 b) { return pointAt(a)[axis] < pointAt(b)[axis]; });
+    m_splitAxis[mid] = static_cast<quint8>(axis);
+
+    if (parallelDepth > 0) {
+        std::thread leftThread([this, &source, sourceIndices, begin, mid, parallelDepth]() {
+            buildRange(source, sourceIndices, begin, mid, parallelDepth - 1);
+        });
+        buildRange(source, sourceIndices, mid + 1, end, parallelDepth - 1);
+        leftThread.join();
+    } else {
+        buildRange(source, sourceIndices, begin, mid, 0);
+        buildRange(source, sourceIndices, mid + 1, end, 0);
+    }
+}
+
+size_t PointKDTree::knnSearch(const QVector3D& queryPoint, size_t k,
+                              std::vector<quint32>& indices, std::vector<float>& squaredDistances) const
+{
+    indices.clear();
+    squaredDistances.clear();
+
+    if (k == 0 || m_points.empty()) {
+        return 0;
+    }
+
+    // 每个线程复用自己的候选数组，避免批量查询时反复分配
+    thread_local std::vector<Neighbor> best;
+    best.clear();
+    best.reserve(k);
+
+    float cellOffsets[3] = {0.0f, 0.0f, 0.0f};
+    searchKnn(0, m_points.size(), queryPoint, k, best, cellOffsets, 0.0f);
+
+    indices.reserve(best.size());
+    squaredDistances.reserve(best.size());
+    for (const auto& neighbor : best) {
+        indices.push_back(m_indices[neighbor.second]);
+        squaredDistances.push_back(neighbor.first);
+    }
+
+    return best.size();
+}
+
+void PointKDTree::searchKnn(size_t begin, size_t end, const QVector3D& queryPoint, size_t k,
+                            std::vector<Neighbor>& best, float* cellOffsets, float cellDistanceSquared) const
+{
+    // 候选按距离升序保存，k较小时插入排序比堆更快
+    auto consider = [&](size_t position) {
+        float distanceSquared = (m_points[position] - queryPoint).lengthSquared();
+        if (best.size() < k) {
+            best.emplace_back(distanceSquared, static_cast<quint32>(position));
+        } else if (distanceSquared < best.back().first) {
+            best.back() = Neighbor(distanceSquared, static_cast<quint32>(position));
+        } else {
+            return;
+        }
+        for (size_t j = best.size() - 1; j > 0 && best[j - 1].first > best[j].first; --j) {
+            std::swap(best[j - 1], best[j]);
+        }
+    };
+
+    if (end - begin <= m_leafSize) {
+        for (size_t i = begin; i < end; ++i) {
+            consider(i);
+        }
+        return;
+    }
+
+    size_t mid = begin + (end - begin) / 2;
+    int axis = m_splitAxis[mid];
+    float diff = queryPoint[axis] - m_points[mid][axis];
+
+    consider(mid);
+
+    size_t nearBegin = diff < 0.0f ? begin : mid + 1;
+    size_t nearEnd = diff < 0.0f ? mid : end;
+    size_t farBegin = diff < 0.0f ? mid + 1 : begin;
+    size_t farEnd = diff < 0.0f ? end : mid;
+
+    // 先搜索查询点所在一侧
+    searchKnn(nearBegin, nearEnd, queryPoint, k, best, cellOffsets, cellDistanceSquared);
+
+    // 另一侧的下界为查询点到该单元格的累计距离，仅在可能更近时搜索
+    float previousOffset = cellOffsets[axis];
+    float farDistanceSquared = cellDistanceSquared - previousOffset * previousOffset + diff * diff;
+    if (best.size() < k || farDistanceSquared < best.back().first) {
+        cellOffsets[axis] = diff;
+        searchKnn(farBegin, farEnd, queryPoint, k, best, cellOffsets, farDistanceSquared);
+        cellOffsets[axis] = previousOffset;
+    }
+}
+
+size_t PointKDTree::radiusSearch(const QVector3D& queryPoint, float radius, std::vector<quint32>& indices) const
+{
+    indices.clear();
+    if (m_points.empty() || radius < 0.0f) {
+        return 0;
+    }
+
+    searchRadius(0, m_points.size(), queryPoint, radius * radius, indices);
+    return indices.size();
+}
+
+void PointKDTree::searchRadius(size_t begin, size_t end, const QVector3D& queryPoint, float radiusSquared,
+                               std::vector<quint32>& indices) const
+{
+    if (end - begin <= m_leafSize) {
+        for (size_t i = begin; i < end; ++i) {
+            if ((m_points[i] - queryPoint).lengthSquared() <= radiusSquared) {
+                indices.push_back(m_indices[i]);
+            }
+        }
+        return;
+    }
+
+    size_t mid = begin + (end - begin) / 2;
+    int axis = m_splitAxis[mid];
+    float diff = queryPoint[axis] - m_points[mid][axis];
+
+    if ((m_points[mid] - queryPoint).lengthSquared() <= radiusSquared) {
+        indices.push_back(m_indices[mid]);
+    }
+
+    if (diff <= 0.0f || diff * diff <= radiusSquared) {
+        searchRadius(begin, mid, queryPoint, radiusSquared, indices);
+    }
+    if (diff >= 0.0f || diff * diff <= radiusSquared) {
+        searchRadius(mid + 1, end, queryPoint, radiusSquared, indices);
+    }
+}
+
+size_t PointKDTree::radiusCount(const QVector3D& queryPoint, float radius, size_t maxCount,
+                                const std::vector<char>* selectedMask) const
+{
+    size_t count = 0;
+    if (m_points.empty() || radius < 0.0f || maxCount == 0) {
+        return 0;
+    }
+
+    countRadius(0, m_points.size(), queryPoint, radius * radius, maxCount, selectedMask, count);
+    return qMin(count, maxCount);
+}
+
+void PointKDTree::countRadius(size_t begin, size_t end, const QVector3D& queryPoint, float radiusSquared,
+                              size_t maxCount, const std::vector<char>* selectedMask, size_t& count) const
+{
+    if (count >= maxCount) {
+        return;
+    }
+
+    auto isCounted = [&](size_t position) {
+        return (m_points[position] - queryPoint).lengthSquared() <= radiusSquared &&
+               (!selectedMask || (*selectedMask)[m_indices[position]]);
+    };
+
+    if (end - begin <= m_leafSize) {
+        for (size_t i = begin; i < end && count < maxCount; ++i) {
+            if (isCounted(i)) {
+                ++count;
+            }
+        }
+        return;
+    }
+
+    size_t mid = begin + (end - begin) / 2;
+    int axis = m_splitAxis[mid];
+    float diff = queryPoint[axis] - m_points[mid][axis];
+
+    if (isCounted(mid)) {
+        ++count;
+    }
+
+    if (diff <= 0.0f || diff * diff <= radiusSquared) {
+        countRadius(begin, mid, queryPoint, radiusSquared, maxCount, selectedMask, count);
+    }
+    if (diff >= 0.0f || diff * diff <= radiusSquared) {
+        countRadius(mid + 1, end, queryPoint, radiusSquared, maxCount, selectedMask, count);
+    }
+}
+
+// PointGrid2D 实现
+PointGrid2D::PointGrid2D()
+    : m_cellSize(0.0f)
+    , m_columns(0)
+    , m_rows(0)
+{
+}
+
+PointGrid2D::PointGrid2D(const std::vector<QVector3D>& points, float cellSize)
+    : m_cellSize(0.0f)
+    , m_columns(0)
+    , m_rows(0)
+{
+    build(points, cellSize);
+}
+
+void PointGrid2D::build(const std::vector<QVector3D>& points, float cellSize)
+{
+    clear();
+
+    PointCloudBounds bounds = computePointCloudBounds(points);
+    if (!bounds.isValid() || points.size() >= std::numeric_limits<quint32>::max()) {
+        return;
+    }
+
+    const double width = qMax(static_cast<double>(bounds.maxPoint.x() - bounds.minPoint.x()), 1e-3);
+    const double height = qMax(static_cast<double>(bounds.maxPoint.y() - bounds.minPoint.y()), 1e-3);
+    double size = cellSize > 0.0f ? cellSize : std::sqrt(width * height * kGridPointsPerCell / bounds.validCount);
+    size = qMax(size, std::sqrt(width * height / kMaxGridCells));
+    size = qMax(size, 1e-3);
+
+    m_cellSize = static_cast<float>(size);
+    m_origin = QVector2D(bounds.minPoint.x(), bounds.minPoint.y());
+    m_columns = static_cast<int>(width / size) + 1;
+    m_rows = static_cast<int>(height / size) + 1;
+
+    // 每个点所在的单元（无效点标记为单元总数）
+    const quint32 cellCount = static_cast<quint32>(m_columns) * static_cast<quint32>(m_rows);
+    std::vector<quint32> cellOf(points.size(), cellCount);
+    parallelFor(0, points.size(), [&](size_t i) {
+        const QVector3D& point = points[i];
+        if (!std::isfinite(point.x()) || !std::isfinite(point.y()) || !std::isfinite(point.z())) {
+            return;
+        }
+        int column = qBound(0, static_cast<int>((point.x() - m_origin.x()) / m_cellSize), m_columns - 1);
+        int row = qBound(0, static_cast<int>((point.y() - m_origin.y()) / m_cellSize), m_rows - 1);
+        cellOf[i] = static_cast<quint32>(row) * static_cast<quint32>(m_columns) + static_cast<quint32>(column);
+    });
+
+    // 计数排序
+    m_cellStart.assign(static_cast<size_t>(cellCount) + 1, 0);
+    for (quint32 cell : cellOf) {
+        if (cell < cellCount) {
+            ++m_cellStart[cell + 1];
+        }
+    }
+    for (size_t c = 0; c < cellCount; ++c) {
+        m_cellStart[c + 1] += m_cellStart[c];
+    }
+
+    m_positions.resize(m_cellStart[cellCount]);
+    m_indices.resize(m_cellStart[cellCount]);
+    std::vector<quint32> cursor(m_cellStart.begin(), m_cellStart.end() - 1);
+    for (size_t i = 0; i < points.size(); ++i) {
+        if (cellOf[i] < cellCount) {
+            quint32 position = cursor[cellOf[i]]++;
+            m_positions[position] = QVector2D(points[i].x(), points[i].y());
+            m_indices[position] = static_cast<quint32>(i);
+        }
+    }
+}
+
+void PointGrid2D::clear()
+{
+    m_positions.clear();
+    m_indices.clear();
+    m_cellStart.clear();
+    m_origin = QVector2D();
+    m_cellSize = 0.0f;
+    m_columns = 0;
+    m_rows = 0;
+}
+
+size_t PointGrid2D::corridorSearch(const QVector2D& start, const QVector2D& end, float halfWidth, float extension,
+                                   std::vector<quint32>& indices) const
+{
+    indices.clear();
+    if (isEmpty() || halfWidth < 0.0f) {
+        return 0;
+    }
+
+    const QVector2D axis = end - start;
+    const float length = axis.length();
+    const QVector2D direction = length > 1e-6f ? axis / length : QVector2D(1.0f, 0.0f);
+    const QVector2D lateral(-direction.y(), direction.x());
+    const float alongMin = -extension;
+    const float alongMax = length + extension;
+
+    // 矩形四角的包围盒确定候选单元范围
+    float minX = std::numeric_limits<float>::max();
+    float minY = std::numeric_limits<float>::max();
+    float maxX = std::numeric_limits<float>::lowest();
+    float maxY = std::numeric_limits<float>::lowest();
+    for (float along : {alongMin, alongMax}) {
+        for (float across : {-halfWidth, halfWidth}) {
+            QVector2D corner = start + direction * along + lateral * across;
+            minX = qMin(minX, corner.x());
+            minY = qMin(minY, corner.y());
+            maxX = qMax(maxX, corner.x());
+            maxY = qMax(maxY, corner.y());
+        }
+    }
+    if (maxX < m_origin.x() || maxY < m_origin.y() ||
+        minX > m_origin.x() + m_columns * m_cellSize || minY > m_origin.y() + m_rows * m_cellSize) {
+        return 0;
+    }
+    const int columnBegin = qBound(0, static_cast<int>(std::floor((minX - m_origin.x()) / m_cellSize)), m_columns - 1);
+    const int columnEnd = qBound(0, static_cast<int>(std::floor((maxX - m_origin.x()) / m_cellSize)), m_columns - 1);
+    const int rowBegin = qBound(0, static_cast<int>(std::floor((minY - m_origin.y()) / m_cellSize)), m_rows - 1);
+    const int rowEnd = qBound(0, static_cast<int>(std::floor((maxY - m_origin.y()) / m_cellSize)), m_rows - 1);
+
+    // 斜向走廊的包围盒中有大量单元与矩形不相交，按单元中心到矩形的距离整体跳过
+    const float cellReach = m_cellSize * std::sqrt(0.5f);
+    for (int row = rowBegin; row <= rowEnd; ++row) {
+        for (int column = columnBegin; column <= columnEnd; ++column) {
+            QVector2D center = m_origin + QVector2D((column + 0.5f) * m_cellSize, (row + 0.5f) * m_cellSize) - start;
+            float centerAlong = QVector2D::dotProduct(center, direction);
+            float centerAcross = QVector2D::dotProduct(center, lateral);
+            if (std::fabs(centerAcross) > halfWidth + cellReach ||
+                centerAlong < alongMin - cellReach || centerAlong > alongMax + cellReach) {
+                continue;
+            }
+
+            const size_t cell = static_cast<size_t>(row) * m_columns + column;
+            for (quint32 position = m_cellStart[cell]; position < m_cellStart[cell + 1]; ++position) {
+                QVector2D offset = m_positions[position] - start;
+                float along = QVector2D::dotProduct(offset, direction);
+                if (along >= alongMin && along <= alongMax &&
+                    std::fabs(QVector2D::dotProduct(offset, lateral)) <= halfWidth) {
+                    indices.push_back(m_indices[position]);
+                }
+            }
+        }
+    }
+    return indices.size();
+}
+
 } // namespace WallExtraction
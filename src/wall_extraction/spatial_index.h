@@ -3,9 +3,12 @@
 
 #include <QObject>
 #include <QVector3D>
+#include <QVector2D>
 #include <QVariantMap>
 #include <vector>
 #include <memory>
+#include <array>
+#include <limits>
 
 namespace WallExtraction {
 
@@ -47,6 +50,193 @@ struct QueryResult {
     QueryResult(size_t idx, float dist) : pointIndex(idx), distance(dist) {}
 };
 
+/**
+ * @brief 扁平KD树
+ *
+ * 面向批量邻域查询的轻量KD树：点按树布局重排存储在连续数组中，
+ * 内部节点的分割轴按中位位置存储，不使用节点指针。
+ * 构建完成后所有查询均为只读，可在多个线程中并发调用。
+ * 查询结果中的索引为构建时输入数组中的原始索引（按选择索引构建时为选择中的位置）。
+ * 坐标非有限（NaN/Inf）的点不进入树，size()可能小于输入点数。
+ */
+class PointKDTree
+{
+public:
+    PointKDTree();
+    explicit PointKDTree(const std::vector<QVector3D>& points, size_t leafSize = 32);
+    PointKDTree(const std::vector<QVector3D>& points, const std::vector<quint32>& indices, size_t leafSize = 32);
+
+    /**
+     * @brief 构建KD树（顶层子树并行构建，跳过非有限点）
+     * @param points 点云数据
+     * @param leafSize 叶节点最大点数
+     */
+    void build(const std::vector<QVector3D>& points, size_t leafSize = 32);
+
+    /**
+     * @brief 只对选中的点构建KD树（不复制输入点云）
+     *
+     * 查询结果中的索引为点在indices中的位置，而不是原始索引，
+     * 便于调用方直接按选择位置维护掩码。
+     * @param points 原始点云数据
+     * @param indices 选中点在points中的索引
+     * @param leafSize 叶节点最大点数
+     */
+    void build(const std::vector<QVector3D>& points, const std::vector<quint32>& indices, size_t leafSize = 32);
+
+    /**
+     * @brief 清空KD树
+     */
+    void clear();
+
+    /**
+     * @brief 检查KD树是否为空
+     * @return 是否为空
+     */
+    bool isEmpty() const { return m_points.empty(); }
+
+    /**
+     * @brief 获取树内点数
+     * @return 点数（不含非有限点）
+     */
+    size_t size() const { return m_points.size(); }
+
+    /**
+     * @brief 获取树布局中第position个点
+     *
+     * 对树内所有点做批量查询时按布局顺序遍历，相邻查询访问相近的节点，缓存命中率更高。
+     * @param position 布局位置
+     * @return 点坐标
+     */
+    const QVector3D& layoutPoint(size_t position) const { return m_points[position]; }
+
+    /**
+     * @brief 获取树布局中第position个点的原始索引
+     * @param position 布局位置
+     * @return 原始索引
+     */
+    quint32 layoutIndex(size_t position) const { return m_indices[position]; }
+
+    /**
+     * @brief K近邻查询（结果包含与查询点重合的点）
+     * @param queryPoint 查询点
+     * @param k 邻居数量
+     * @param indices 输出：邻居原始索引（按距离升序）
+     * @param squaredDistances 输出：对应的平方距离
+     * @return 找到的邻居数量
+     */
+    size_t knnSearch(const QVector3D& queryPoint, size_t k,
+                     std::vector<quint32>& indices, std::vector<float>& squaredDistances) const;
+
+    /**
+     * @brief 半径查询
+     * @param queryPoint 查询点
+     * @param radius 查询半径
+     * @param indices 输出：半径内点的原始索引（无序）
+     * @return 找到的点数
+     */
+    size_t radiusSearch(const QVector3D& queryPoint, float radius, std::vector<quint32>& indices) const;
+
+    /**
+     * @brief 半径内点计数，达到maxCount时提前结束
+     * @param queryPoint 查询点
+     * @param radius 查询半径
+     * @param maxCount 计数上限
+     * @param selectedMask 可选：按原始索引的选择掩码，非空时只统计掩码非零的点
+     * @return 半径内的点数（不超过maxCount）
+     */
+    size_t radiusCount(const QVector3D& queryPoint, float radius,
+                       size_t maxCount = std::numeric_limits<size_t>::max(),
+                       const std::vector<char>* selectedMask = nullptr) const;
+
+private:
+    using Neighbor = std::pair<float, quint32>;    // (平方距离, 重排后位置)
+
+    void buildLayout(const std::vector<QVector3D>& source, const quint32* sourceIndices);
+    void buildRange(const std::vector<QVector3D>& source, const quint32* sourceIndices,
+                    size_t begin, size_t end, int parallelDepth);
+    void searchKnn(size_t begin, size_t end, const QVector3D& queryPoint, size_t k,
+                   std::vector<Neighbor>& best, float* cellOffsets, float cellDistanceSquared) const;
+    void searchRadius(size_t begin, size_t end, const QVector3D& queryPoint, float radiusSquared,
+                      std::vector<quint32>& indices) const;
+    void countRadius(size_t begin, size_t end, const QVector3D& queryPoint, float radiusSquared,
+                     size_t maxCount, const std::vector<char>* selectedMask, size_t& count) const;
+
+private:
+    std::vector<QVector3D> m_points;    // 按树布局重排的点
+    std::vector<quint32> m_indices;     // 重排后位置 -> 原始索引
+    std::vector<quint8> m_splitAxis;    // 内部节点的分割轴（按中位位置存储）
+    size_t m_leafSize;
+};
+
+/**
+ * @brief XY平面上的均匀栅格索引
+ *
+ * 点按所在栅格单元做计数排序，同一单元的点在数组中连续（CSR存储），只保存XY坐标。
+ * 竖直方向不分层，适合俯视图上的走廊、矩形查询（例如沿用户绘制的墙线收集墙面点）。
+ * 构建完成后所有查询均为只读，可在多个线程中并发调用。
+ * 坐标非有限的点不进入索引；查询结果中的索引为构建时输入数组中的原始索引。
+ */
+class PointGrid2D
+{
+public:
+    PointGrid2D();
+    explicit PointGrid2D(const std::vector<QVector3D>& points, float cellSize = 0.0f);
+
+    /**
+     * @brief 构建栅格索引
+     * @param points 点云数据
+     * @param cellSize 栅格边长，不大于0时按平均每个单元约32个点自动确定
+     */
+    void build(const std::vector<QVector3D>& points, float cellSize = 0.0f);
+
+    /**
+     * @brief 清空索引
+     */
+    void clear();
+
+    /**
+     * @brief 检查索引是否为空
+     * @return 是否为空
+     */
+    bool isEmpty() const { return m_positions.empty(); }
+
+    /**
+     * @brief 获取索引中的点数
+     * @return 点数
+     */
+    size_t size() const { return m_positions.size(); }
+
+    /**
+     * @brief 获取栅格边长
+     * @return 栅格边长
+     */
+    float cellSize() const { return m_cellSize; }
+
+    /**
+     * @brief 有向矩形（走廊）查询
+     *
+     * 矩形以线段的XY投影为中轴，两侧各宽halfWidth，两端各延伸extension。
+     * @param start 线段起点（XY）
+     * @param end 线段终点（XY）
+     * @param halfWidth 半宽
+     * @param extension 两端延伸长度
+     * @param indices 输出：矩形内点的原始索引（按栅格单元顺序）
+     * @return 找到的点数
+     */
+    size_t corridorSearch(const QVector2D& start, const QVector2D& end, float halfWidth, float extension,
+                          std::vector<quint32>& indices) const;
+
+private:
+    std::vector<QVector2D> m_positions;  // 按栅格单元排序的XY坐标
+    std::vector<quint32> m_indices;      // 排序后位置 -> 原始索引
+    std::vector<quint32> m_cellStart;    // 单元c的点位于[m_cellStart[c], m_cellStart[c + 1])
+    QVector2D m_origin;                  // 栅格左下角
+    float m_cellSize;
+    int m_columns;
+    int m_rows;
+};
+
 /**
  * @brief 空间索引类
  * 
@@ -2,6 +2,7 @@
 #include "wall_extraction_manager.h"
 #include "top_down_view_renderer.h"
 #include "view_projection_manager.h"
+#include "top_down_interaction_controller.h"
 #include "color_mapping_manager.h"
 #include "point_cloud_lod_manager.h"
 #include "point_cloud_memory_manager.h"
@@ -2508,6 +2509,8 @@ void Stage1DemoWidget::loadPointCloudFile()
             WallExtraction::LASReader reader;
             if (reader.canReadFile(fileName)) {
                 m_currentPointCloud = reader.readPointCloudWithAttributes(fileName);
+                invalidatePointCloudStatistics();
+                setCoordinateOrigin(reader.getCoordinateOrigin(fileName));
                 m_currentSimpleCloud.clear();
                 for (const auto& point : m_currentPointCloud) {
                     m_currentSimpleCloud.push_back(point.position);
@@ -2519,13 +2522,16 @@ void Stage1DemoWidget::loadPointCloudFile()
         } else if (ext == "pcd") {
             // PCD文件处理
             qDebug() << "Loading PCD file:" << fileName;
-            std::vector<QVector3D> simplePoints = PCDReader::ReadVec3PointCloudPCD(fileName);
+            WallExtraction::CoordinateOrigin origin;
+            std::vector<QVector3D> simplePoints = PCDReader::ReadVec3PointCloudPCD(fileName, &origin);
             if (simplePoints.empty()) {
                 throw std::runtime_error("Failed to read PCD file or file is empty");
             }
+            setCoordinateOrigin(origin);
 
             // 转换为带属性的点云格式，并进行数据验证
             m_currentPointCloud.clear();
+            invalidatePointCloudStatistics();
             m_currentSimpleCloud.clear();
             m_currentPointCloud.reserve(simplePoints.size());
             m_currentSimpleCloud.reserve(simplePoints.size());
@@ -2545,11 +2551,7 @@ void Stage1DemoWidget::loadPointCloudFile()
                     isValid = false;
                 }
 
-                // 检查是否在合理范围内（假设点云在±1000米范围内）
-                const float MAX_COORD = 1000.0f;
-                if (qAbs(pos.x()) > MAX_COORD || qAbs(pos.y()) > MAX_COORD || qAbs(pos.z()) > MAX_COORD) {
-                    isValid = false;
-                }
+                // 坐标已相对原点解码，地理参考的大坐标不再按±1000米范围剔除
 
                 if (isValid) {
                     WallExtraction::PointWithAttributes point;
@@ -2607,8 +2609,19 @@ void Stage1DemoWidget::loadPointCloudFile()
                 throw std::runtime_error("Failed to read PLY file or file is empty");
             }
 
+            // PLY读取器输出float绝对坐标，按包围盒中心选取原点并在校验循环中平移
+            WallExtraction::PointCloudBounds plyBounds = WallExtraction::computePointCloudBounds(simplePoints);
+            WallExtraction::CoordinateOrigin origin;
+            if (plyBounds.isValid()) {
+                origin = WallExtraction::CoordinateOrigin::forBounds(
+                    plyBounds.minPoint.x(), plyBounds.minPoint.y(), plyBounds.minPoint.z(),
+                    plyBounds.maxPoint.x(), plyBounds.maxPoint.y(), plyBounds.maxPoint.z());
+            }
+            setCoordinateOrigin(origin);
+
             // 转换为带属性的点云格式，并进行数据验证
             m_currentPointCloud.clear();
+            invalidatePointCloudStatistics();
             m_currentSimpleCloud.clear();
             m_currentPointCloud.reserve(simplePoints.size());
             m_currentSimpleCloud.reserve(simplePoints.size());
@@ -2618,7 +2631,7 @@ void Stage1DemoWidget::loadPointCloudFile()
             int invalidPoints = 0;
 
             for (size_t i = 0; i < simplePoints.size(); ++i) {
-                const QVector3D& pos = simplePoints[i];
+                const QVector3D pos = origin.toLocal(simplePoints[i].x(), simplePoints[i].y(), simplePoints[i].z());
 
                 // 数据有效性检查
                 bool isValid = true;
@@ -2628,12 +2641,6 @@ void Stage1DemoWidget::loadPointCloudFile()
                     isValid = false;
                 }
 
-                // 检查是否在合理范围内
-                const float MAX_COORD = 1000.0f;
-                if (qAbs(pos.x()) > MAX_COORD || qAbs(pos.y()) > MAX_COORD || qAbs(pos.z()) > MAX_COORD) {
-                    isValid = false;
-                }
-
                 if (isValid) {
                     WallExtraction::PointWithAttributes point;
                     point.position = pos;
@@ -2672,9 +2679,11 @@ void Stage1DemoWidget::loadPointCloudFile()
             if (simplePoints.empty()) {
                 throw std::runtime_error("Failed to read XYZ/TXT file or file is empty");
             }
+            setCoordinateOrigin(WallExtraction::CoordinateOrigin());
 
             // 转换为带属性的点云格式
             m_currentPointCloud.clear();
+            invalidatePointCloudStatistics();
             m_currentSimpleCloud = simplePoints;
             m_currentPointCloud.reserve(simplePoints.size());
 
@@ -2746,8 +2755,11 @@ void Stage1DemoWidget::clearPointCloud()
 
     // 清除点云数据
     m_currentPointCloud.clear();
+    invalidatePointCloudStatistics();
     m_currentSimpleCloud.clear();
     m_currentFileName.clear();
+    setCoordinateOrigin(WallExtraction::CoordinateOrigin());
+    updateFrameAlignment();
     qDebug() << "Point cloud data cleared";
 
     // 完全清除UI显示
@@ -3418,19 +3430,16 @@ QRectF Stage1DemoWidget::getActualPointCloudBounds() const
         return QRectF();
     }
 
-    // 计算点云的实际边界
-    float minX = std::numeric_limits<float>::max();
-    float maxX = std::numeric_limits<float>::lowest();
-    float minY = std::numeric_limits<float>::max();
-    float maxY = std::numeric_limits<float>::lowest();
-
-    // 遍历所有点以获得精确边界（对于线段标注精度很重要）
-    for (const auto& point : m_currentPointCloud) {
-        minX = std::min(minX, point.position.x());
-        maxX = std::max(maxX, point.position.x());
-        minY = std::min(minY, point.position.y());
-        maxY = std::max(maxY, point.position.y());
+    // 精确边界（对于线段标注精度很重要），取自加载后缓存的统计结果
+    const WallExtraction::PointCloudBounds& cloudBounds = currentPointCloudStatistics().bounds;
+    if (!cloudBounds.isValid()) {
+        qDebug() << "Point cloud has no valid points, returning empty bounds";
+        return QRectF();
     }
+    float minX = cloudBounds.minPoint.x();
+    float maxX = cloudBounds.maxPoint.x();
+    float minY = cloudBounds.minPoint.y();
+    float maxY = cloudBounds.maxPoint.y();
 
     // 不添加边距，使用精确边界以确保线段标注准确
     QRectF bounds(minX, minY, maxX - minX, maxY - minY);
@@ -3547,6 +3556,9 @@ void Stage1DemoWidget::processLoadedPointCloud()
     // 详细分析点云数据
     analyzePointCloudData();
 
+    // 墙面拟合在主墙方向对齐的坐标中进行
+    updateFrameAlignment();
+
     m_stats.pointCount = m_currentPointCloud.size();
 
     // 自动计算颜色映射范围
@@ -3593,6 +3605,8 @@ void Stage1DemoWidget::generateSampleData(int pointCount)
     qDebug() << "Requested point count:" << pointCount;
 
     m_currentPointCloud.clear();
+    invalidatePointCloudStatistics();
+    setCoordinateOrigin(WallExtraction::CoordinateOrigin());
     m_currentSimpleCloud.clear();
 
     m_currentPointCloud.reserve(pointCount);
@@ -3663,18 +3677,15 @@ QRectF Stage1DemoWidget::calculatePointCloudBounds() const
         return QRectF(-100, -100, 200, 200); // 默认边界
     }
 
-    // 计算点云的实际边界
-    float minX = std::numeric_limits<float>::max();
-    float maxX = std::numeric_limits<float>::lowest();
-    float minY = std::numeric_limits<float>::max();
-    float maxY = std::numeric_limits<float>::lowest();
-
-    for (const auto& point : m_currentPointCloud) {
-        minX = qMin(minX, point.position.x());
-        maxX = qMax(maxX, point.position.x());
-        minY = qMin(minY, point.position.y());
-        maxY = qMax(maxY, point.position.y());
+    // 点云的实际边界（使用缓存的统计结果）
+    const WallExtraction::PointCloudBounds& cloudBounds = currentPointCloudStatistics().bounds;
+    if (!cloudBounds.isValid()) {
+        return QRectF(-100, -100, 200, 200); // 默认边界
     }
+    float minX = cloudBounds.minPoint.x();
+    float maxX = cloudBounds.maxPoint.x();
+    float minY = cloudBounds.minPoint.y();
+    float maxY = cloudBounds.maxPoint.y();
 
     // 添加边距（10%）
     float rangeX = maxX - minX;
@@ -3692,6 +3703,57 @@ QRectF Stage1DemoWidget::calculatePointCloudBounds() const
     return bounds;
 }
 
+const WallExtraction::PointCloudStatistics& Stage1DemoWidget::currentPointCloudStatistics() const
+{
+    if (!m_pointCloudStatisticsValid) {
+        if (m_currentPointCloud.empty()) {
+            m_pointCloudStatistics = WallExtraction::PointCloudStatistics();
+        } else {
+            // 直接按步长读取PointWithAttributes::position，无需复制坐标
+            m_pointCloudStatistics = WallExtraction::computePointCloudStatistics(
+                &m_currentPointCloud[0].position, m_currentPointCloud.size(),
+                sizeof(WallExtraction::PointWithAttributes));
+        }
+        m_pointCloudStatisticsValid = true;
+    }
+    return m_pointCloudStatistics;
+}
+
+void Stage1DemoWidget::invalidatePointCloudStatistics()
+{
+    m_pointCloudStatisticsValid = false;
+}
+
+void Stage1DemoWidget::setCoordinateOrigin(const WallExtraction::CoordinateOrigin& origin)
+{
+    m_coordinateOrigin = origin;
+    if (m_wallManager) {
+        m_wallManager->setCoordinateOrigin(origin);
+    }
+}
+
+void Stage1DemoWidget::updateFrameAlignment()
+{
+    WallExtraction::DominantAxisAlignment alignment;
+    if (!m_currentPointCloud.empty()) {
+        // 均匀抽样后估计，避免为大点云复制完整坐标
+        const size_t maxSamples = 50000;
+        const size_t stride = (m_currentPointCloud.size() + maxSamples - 1) / maxSamples;
+        std::vector<QVector3D> samples;
+        samples.reserve(m_currentPointCloud.size() / stride + 1);
+        for (size_t i = 0; i < m_currentPointCloud.size(); i += stride) {
+            samples.push_back(m_currentPointCloud[i].position);
+        }
+
+        WallExtraction::PointCloudProcessor processor;
+        alignment = processor.estimateDominantAxisAlignment(samples, maxSamples);
+    }
+
+    if (m_wallManager) {
+        m_wallManager->setFrameAlignment(alignment);
+    }
+}
+
 void Stage1DemoWidget::optimizeColorMappingForTopDown()
 {
     if (!m_colorMapper || m_currentPointCloud.empty()) {
@@ -3728,27 +3790,19 @@ void Stage1DemoWidget::analyzePointCloudData()
 
     qDebug() << "=== Point Cloud Data Analysis ===";
 
-    // 统计坐标范围
-    float minX = std::numeric_limits<float>::max();
-    float maxX = std::numeric_limits<float>::lowest();
-    float minY = std::numeric_limits<float>::max();
-    float maxY = std::numeric_limits<float>::lowest();
-    float minZ = std::numeric_limits<float>::max();
-    float maxZ = std::numeric_limits<float>::lowest();
+    // 坐标范围、均值和方差来自缓存的统计结果
+    const WallExtraction::PointCloudStatistics& statistics = currentPointCloudStatistics();
+    const QVector3D& minPoint = statistics.bounds.minPoint;
+    const QVector3D& maxPoint = statistics.bounds.maxPoint;
+    float minX = minPoint.x(), maxX = maxPoint.x();
+    float minY = minPoint.y(), maxY = maxPoint.y();
+    float minZ = minPoint.z(), maxZ = maxPoint.z();
 
     // 统计属性
     QSet<QString> availableAttributes;
     QMap<QString, QPair<float, float>> attributeRanges;
 
     for (const auto& point : m_currentPointCloud) {
-        // 坐标范围
-        minX = qMin(minX, point.position.x());
-        maxX = qMax(maxX, point.position.x());
-        minY = qMin(minY, point.position.y());
-        maxY = qMax(maxY, point.position.y());
-        minZ = qMin(minZ, point.position.z());
-        maxZ = qMax(maxZ, point.position.z());
-
         // 属性统计
         for (auto it = point.attributes.begin(); it != point.attributes.end(); ++it) {
             QString attrName = it.key();
@@ -3771,6 +3825,8 @@ void Stage1DemoWidget::analyzePointCloudData()
     qDebug() << "X range:" << minX << "to" << maxX << "(" << (maxX - minX) << ")";
     qDebug() << "Y range:" << minY << "to" << maxY << "(" << (maxY - minY) << ")";
     qDebug() << "Z range:" << minZ << "to" << maxZ << "(" << (maxZ - minZ) << ")";
+    qDebug() << "Mean:" << statistics.mean << "Variance:" << statistics.variance;
+    qDebug() << "Z median:" << statistics.zPercentile(0.5);
 
     qDebug() << "Available attributes:" << availableAttributes.values();
     for (auto it = attributeRanges.begin(); it != attributeRanges.end(); ++it) {
@@ -3900,6 +3956,8 @@ void Stage1DemoWidget::generateValidTestData(int pointCount)
     qDebug() << "Generating" << pointCount << "test points";
 
     m_currentPointCloud.clear();
+    invalidatePointCloudStatistics();
+    setCoordinateOrigin(WallExtraction::CoordinateOrigin());
     m_currentSimpleCloud.clear();
     m_currentPointCloud.reserve(pointCount);
     m_currentSimpleCloud.reserve(pointCount);
@@ -4069,6 +4127,12 @@ void Stage1DemoWidget::connectSignals()
                 this, &Stage1DemoWidget::onPointSizeChanged);
     }
 
+    // 相机移动驱动点云块预取
+    if (m_renderer && m_renderer->getInteractionController() && m_memoryManager) {
+        connect(m_renderer->getInteractionController(), &WallExtraction::TopDownInteractionController::cameraMoved,
+                m_memoryManager.get(), &WallExtraction::PointCloudMemoryManager::updateCameraState);
+    }
+
     // 线段绘制控制连接
     if (m_lineDrawingToolbar) {
         connect(m_lineDrawingToolbar, &WallExtraction::LineDrawingToolbar::drawingModeChangeRequested,
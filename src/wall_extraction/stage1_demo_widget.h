@@ -26,6 +26,8 @@
 #include <QPen>
 #include <QBrush>
 #include <memory>
+#include "point_cloud_statistics.h"
+#include "coordinate_transform.h"
 
 // 前向声明
 namespace WallExtraction {
@@ -193,6 +195,16 @@ private:
     QVector3D accurateScreenToWorld(const QVector2D& screenPoint, const QRectF& bounds) const;
     QRectF getActualPointCloudBounds() const;
 
+    // 点云统计缓存（每次加载只计算一次）
+    const WallExtraction::PointCloudStatistics& currentPointCloudStatistics() const;
+    void invalidatePointCloudStatistics();
+
+    // 当前点云的双精度坐标原点（点坐标为相对原点的局部坐标，导出和墙面结果加回原点）
+    void setCoordinateOrigin(const WallExtraction::CoordinateOrigin& origin);
+
+    // 估计当前点云的主墙方向并同步到墙面拟合（点云为空时取消对齐）
+    void updateFrameAlignment();
+
     // 新的视口坐标转换方法（解决复杂场景偏移问题）
     QVector3D viewportToWorld(const QVector2D& viewportPoint, const QRectF& bounds) const;
     QPointF worldToViewport(const QVector3D& worldPoint, const QRectF& bounds) const;
@@ -298,7 +310,10 @@ private:
     
     // 数据存储
     std::vector<WallExtraction::PointWithAttributes> m_currentPointCloud;
+    mutable WallExtraction::PointCloudStatistics m_pointCloudStatistics;  // m_currentPointCloud的统计缓存
+    mutable bool m_pointCloudStatisticsValid = false;
     std::vector<QVector3D> m_currentSimpleCloud;
+    WallExtraction::CoordinateOrigin m_coordinateOrigin;  // 当前点云的坐标原点
     QString m_currentFileName;
     
     // 定时器
@@ -0,0 +1,380 @@
+#ifndef SYMMETRIC_EIGEN_SOLVER_H
+#define SYMMETRIC_EIGEN_SOLVER_H
+
+#include <QVector3D>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace WallExtraction {
+
+/**
+ * @brief 3x3对称矩阵（只存上三角）
+ *
+ * 按 xx, xy, xz, yy, yz, zz 顺序存储，通常为点集的协方差矩阵。
+ */
+struct SymmetricMatrix3 {
+    double xx = 0.0;
+    double xy = 0.0;
+    double xz = 0.0;
+    double yy = 0.0;
+    double yz = 0.0;
+    double zz = 0.0;
+};
+
+/**
+ * @brief 3x3对称矩阵的特征分解结果
+ *
+ * 特征值按从大到小排列，eigenvectors[i]为eigenvalues[i]对应的单位特征向量。
+ * 对于协方差矩阵，eigenvectors[2]即为最小方差方向（平面法向量）。
+ */
+struct SymmetricEigen3 {
+    double eigenvalues[3] = {0.0, 0.0, 0.0};
+    QVector3D eigenvectors[3] = {QVector3D(1, 0, 0), QVector3D(0, 1, 0), QVector3D(0, 0, 1)};
+};
+
+namespace EigenSolverDetail {
+
+inline void cross(const double a[3], const double b[3], double out[3])
+{
+    out[0] = a[1] * b[2] - a[2] * b[1];
+    out[1] = a[2] * b[0] - a[0] * b[2];
+    out[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+inline double dot(const double a[3], const double b[3])
+{
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+/**
+ * @brief 求特征值对应的特征向量
+ *
+ * (A - λI)的行向量张成特征向量的正交补，取两两叉积中模最大者；
+ * 特征值重复导致秩不足时，返回与非零行正交的任一方向。
+ */
+inline QVector3D eigenvectorFor(const SymmetricMatrix3& m, double eigenvalue, double scale)
+{
+    double rows[3][3] = {
+        {m.xx - eigenvalue, m.xy, m.xz},
+        {m.xy, m.yy - eigenvalue, m.yz},
+        {m.xz, m.yz, m.zz - eigenvalue}
+    };
+
+    double candidates[3][3];
+    cross(rows[0], rows[1], candidates[0]);
+    cross(rows[0], rows[2], candidates[1]);
+    cross(rows[1], rows[2], candidates[2]);
+
+    int best = 0;
+    double bestNorm = dot(candidates[0], candidates[0]);
+    for (int i = 1; i < 3; ++i) {
+        double norm = dot(candidates[i], candidates[i]);
+        if (norm > bestNorm) {
+            bestNorm = norm;
+            best = i;
+        }
+    }
+
+    const double epsilon = 1e-24 * scale * scale * scale * scale;
+    if (bestNorm > epsilon) {
+        double inverse = 1.0 / std::sqrt(bestNorm);
+        return QVector3D(static_cast<float>(candidates[best][0] * inverse),
+                         static_cast<float>(candidates[best][1] * inverse),
+                         static_cast<float>(candidates[best][2] * inverse));
+    }
+
+    // 秩不超过1：取模最大的行，构造与之正交的方向
+    int row = 0;
+    double rowNorm = dot(rows[0], rows[0]);
+    for (int i = 1; i < 3; ++i) {
+        double norm = dot(rows[i], rows[i]);
+        if (norm > rowNorm) {
+            rowNorm = norm;
+            row = i;
+        }
+    }
+    if (rowNorm <= 1e-24 * scale * scale) {
+        return QVector3D(); // 各向同性，由调用方补全
+    }
+
+    const double* r = rows[row];
+    double axis[3] = {0.0, 0.0, 0.0};
+    int smallest = 0;
+    for (int i = 1; i < 3; ++i) {
+        if (std::fabs(r[i]) < std::fabs(r[smallest])) {
+            smallest = i;
+        }
+    }
+    axis[smallest] = 1.0;
+    double orthogonal[3];
+    cross(r, axis, orthogonal);
+    double inverse = 1.0 / std::sqrt(dot(orthogonal, orthogonal));
+    return QVector3D(static_cast<float>(orthogonal[0] * inverse),
+                     static_cast<float>(orthogonal[1] * inverse),
+                     static_cast<float>(orthogonal[2] * inverse));
+}
+
+} // namespace EigenSolverDetail
+
+/**
+ * @brief 3x3对称矩阵闭式特征分解
+ *
+ * 特征值由特征多项式的三角解法直接求得，特征向量由(A - λI)的行叉积求得，
+ * 不需要迭代，适合对每个点的邻域协方差逐一求解。
+ *
+ * @param matrix 对称矩阵
+ * @return 特征分解结果（特征值从大到小）
+ */
+inline SymmetricEigen3 computeSymmetricEigen3(const SymmetricMatrix3& matrix)
+{
+    SymmetricEigen3 result;
+
+    const double offDiagonal = matrix.xy * matrix.xy + matrix.xz * matrix.xz + matrix.yz * matrix.yz;
+    const double scale = std::max({std::fabs(matrix.xx), std::fabs(matrix.yy), std::fabs(matrix.zz),
+                                   std::fabs(matrix.xy), std::fabs(matrix.xz), std::fabs(matrix.yz)});
+    if (scale == 0.0) {
+        return result;
+    }
+
+    if (offDiagonal <= 1e-30 * scale * scale) {
+        // 已是对角矩阵
+        struct Entry { double value; QVector3D axis; };
+        Entry entries[3] = {{matrix.xx, QVector3D(1, 0, 0)},
+                            {matrix.yy, QVector3D(0, 1, 0)},
+                            {matrix.zz, QVector3D(0, 0, 1)}};
+        std::sort(entries, entries + 3, [](const Entry& a, const Entry& b) { return a.value > b.value; });
+        for (int i = 0; i < 3; ++i) {
+            result.eigenvalues[i] = entries[i].value;
+            result.eigenvectors[i] = entries[i].axis;
+        }
+        return result;
+    }
+
+    const double q = (matrix.xx + matrix.yy + matrix.zz) / 3.0;
+    const double dxx = matrix.xx - q;
+    const double dyy = matrix.yy - q;
+    const double dzz = matrix.zz - q;
+    const double p = std::sqrt((dxx * dxx + dyy * dyy + dzz * dzz + 2.0 * offDiagonal) / 6.0);
+
+    // B = (A - qI) / p，r = det(B) / 2
+    const double inverseP = 1.0 / p;
+    const double bxx = dxx * inverseP;
+    const double byy = dyy * inverseP;
+    const double bzz = dzz * inverseP;
+    const double bxy = matrix.xy * inverseP;
+    const double bxz = matrix.xz * inverseP;
+    const double byz = matrix.yz * inverseP;
+    double r = 0.5 * (bxx * (byy * bzz - byz * byz)
+                      - bxy * (bxy * bzz - byz * bxz)
+                      + bxz * (bxy * byz - byy * bxz));
+    r = std::max(-1.0, std::min(1.0, r));
+
+    const double phi = std::acos(r) / 3.0;
+    const double twoThirdsPi = 2.0943951023931954923;
+    result.eigenvalues[0] = q + 2.0 * p * std::cos(phi);
+    result.eigenvalues[2] = q + 2.0 * p * std::cos(phi + twoThirdsPi);
+    result.eigenvalues[1] = 3.0 * q - result.eigenvalues[0] - result.eigenvalues[2];
+
+    // 最大和最小特征值分离得最好，先求这两个方向，中间方向由叉积补全
+    QVector3D largest = EigenSolverDetail::eigenvectorFor(matrix, result.eigenvalues[0], scale);
+    QVector3D smallest = EigenSolverDetail::eigenvectorFor(matrix, result.eigenvalues[2], scale);
+
+    if (smallest.isNull() && largest.isNull()) {
+        return result;
+    }
+    if (smallest.isNull()) {
+        QVector3D helper = std::fabs(largest.x()) < 0.9f ? QVector3D(1, 0, 0) : QVector3D(0, 1, 0);
+        smallest = QVector3D::crossProduct(largest, helper).normalized();
+    } else if (largest.isNull()) {
+        QVector3D helper = std::fabs(smallest.x()) < 0.9f ? QVector3D(1, 0, 0) : QVector3D(0, 1, 0);
+        largest = QVector3D::crossProduct(smallest, helper).normalized();
+    } else {
+        // 重新正交化，抵消舍入误差
+        largest = (largest - QVector3D::dotProduct(largest, smallest) * smallest).normalized();
+    }
+
+    result.eigenvectors[0] = largest;
+    result.eigenvectors[2] = smallest;
+    result.eigenvectors[1] = QVector3D::crossProduct(smallest, largest).normalized();
+    return result;
+}
+
+/**
+ * @brief 计算点子集的协方差矩阵（以质心为中心）
+ * @param points 点云数据
+ * @param indices 参与计算的点索引
+ * @param centroid 输出质心
+ * @return 协方差矩阵（除以点数）
+ */
+template <typename Index>
+SymmetricMatrix3 computeCovariance(const std::vector<QVector3D>& points,
+                                   const std::vector<Index>& indices,
+                                   QVector3D& centroid)
+{
+    SymmetricMatrix3 covariance;
+    if (indices.empty()) {
+        centroid = QVector3D();
+        return covariance;
+    }
+
+    double cx = 0.0, cy = 0.0, cz = 0.0;
+    for (Index index : indices) {
+        const QVector3D& p = points[index];
+        cx += p.x();
+        cy += p.y();
+        cz += p.z();
+    }
+    const double inverseCount = 1.0 / static_cast<double>(indices.size());
+    cx *= inverseCount;
+    cy *= inverseCount;
+    cz *= inverseCount;
+
+    for (Index index : indices) {
+        const QVector3D& p = points[index];
+        double dx = p.x() - cx;
+        double dy = p.y() - cy;
+        double dz = p.z() - cz;
+        covariance.xx += dx * dx;
+        covariance.xy += dx * dy;
+        covariance.xz += dx * dz;
+        covariance.yy += dy * dy;
+        covariance.yz += dy * dz;
+        covariance.zz += dz * dz;
+    }
+    covariance.xx *= inverseCount;
+    covariance.xy *= inverseCount;
+    covariance.xz *= inverseCount;
+    covariance.yy *= inverseCount;
+    covariance.yz *= inverseCount;
+    covariance.zz *= inverseCount;
+
+    centroid = QVector3D(static_cast<float>(cx), static_cast<float>(cy), static_cast<float>(cz));
+    return covariance;
+}
+
+/**
+ * @brief 流式加权协方差累加器（Welford/West算法）
+ *
+ * 逐点更新均值和离差积和，不需要预先求质心，也没有"平方和减均值平方"的相消误差；
+ * 均值增量用Kahan补偿求和，千万级点数下均值仍保持双精度。
+ * 各线程的局部累加器可用merge合并（Chan等的两两合并公式）。
+ */
+class CovarianceAccumulator
+{
+public:
+    /**
+     * @brief 加入一个点
+     * @param point 点坐标
+     * @param weight 权重（不大于0时忽略）
+     */
+    void add(const QVector3D& point, double weight = 1.0)
+    {
+        if (!(weight > 0.0)) {
+            return;
+        }
+        const double newWeight = m_weight + weight;
+        const double delta[3] = {point.x() - mean(0), point.y() - mean(1), point.z() - mean(2)};
+        const double ratio = weight / newWeight;
+        for (int axis = 0; axis < 3; ++axis) {
+            compensatedAdd(axis, delta[axis] * ratio);
+        }
+        // C += w·W/(W+w)·δδᵀ，等价于 w·δ(x - μ_new)ᵀ 但保持严格对称
+        addOuter(delta, weight * m_weight / newWeight);
+        m_weight = newWeight;
+        ++m_count;
+    }
+
+    /**
+     * @brief 合并另一个累加器
+     * @param other 另一个累加器
+     */
+    void merge(const CovarianceAccumulator& other)
+    {
+        if (other.m_weight <= 0.0) {
+            return;
+        }
+        if (m_weight <= 0.0) {
+            *this = other;
+            return;
+        }
+        const double newWeight = m_weight + other.m_weight;
+        const double delta[3] = {other.mean(0) - mean(0), other.mean(1) - mean(1), other.mean(2) - mean(2)};
+        const double ratio = other.m_weight / newWeight;
+        for (int axis = 0; axis < 3; ++axis) {
+            compensatedAdd(axis, delta[axis] * ratio);
+        }
+        m_comoment.xx += other.m_comoment.xx;
+        m_comoment.xy += other.m_comoment.xy;
+        m_comoment.xz += other.m_comoment.xz;
+        m_comoment.yy += other.m_comoment.yy;
+        m_comoment.yz += other.m_comoment.yz;
+        m_comoment.zz += other.m_comoment.zz;
+        addOuter(delta, m_weight * other.m_weight / newWeight);
+        m_weight = newWeight;
+        m_count += other.m_count;
+    }
+
+    size_t count() const { return m_count; }
+    double totalWeight() const { return m_weight; }
+
+    /**
+     * @brief 加权均值
+     * @return 均值（无点时为原点）
+     */
+    QVector3D mean() const
+    {
+        return QVector3D(static_cast<float>(mean(0)), static_cast<float>(mean(1)), static_cast<float>(mean(2)));
+    }
+
+    /**
+     * @brief 加权协方差矩阵（除以总权重）
+     * @return 协方差矩阵
+     */
+    SymmetricMatrix3 covariance() const
+    {
+        SymmetricMatrix3 result;
+        if (m_weight <= 0.0) {
+            return result;
+        }
+        const double inverseWeight = 1.0 / m_weight;
+        result.xx = m_comoment.xx * inverseWeight;
+        result.xy = m_comoment.xy * inverseWeight;
+        result.xz = m_comoment.xz * inverseWeight;
+        result.yy = m_comoment.yy * inverseWeight;
+        result.yz = m_comoment.yz * inverseWeight;
+        result.zz = m_comoment.zz * inverseWeight;
+        return result;
+    }
+
+private:
+    double mean(int axis) const { return m_mean[axis] - m_compensation[axis]; }
+
+    void compensatedAdd(int axis, double increment)
+    {
+        const double y = increment - m_compensation[axis];
+        const double t = m_mean[axis] + y;
+        m_compensation[axis] = (t - m_mean[axis]) - y;
+        m_mean[axis] = t;
+    }
+
+    void addOuter(const double delta[3], double factor)
+    {
+        m_comoment.xx += factor * delta[0] * delta[0];
+        m_comoment.xy += factor * delta[0] * delta[1];
+        m_comoment.xz += factor * delta[0] * delta[2];
+        m_comoment.yy += factor * delta[1] * delta[1];
+        m_comoment.yz += factor * delta[1] * delta[2];
+        m_comoment.zz += factor * delta[2] * delta[2];
+    }
+
+    double m_mean[3] = {0.0, 0.0, 0.0};
+    double m_compensation[3] = {0.0, 0.0, 0.0};   // Kahan补偿项
+    SymmetricMatrix3 m_comoment;                    // 离差积和
+    double m_weight = 0.0;
+    size_t m_count = 0;
+};
+
+} // namespace WallExtraction
+
+#endif // SYMMETRIC_EIGEN_SOLVER_H
@@ -272,7 +272,7 @@ void TopDownInteractionController::pan(const QPointF& delta)
     params.bounds.translate(worldDeltaX, worldDeltaY);
     
     m_projectionManager->setViewParameters(params);
-    emit viewChanged();
+    notifyViewChanged();
 }
 
 QPointF TopDownInteractionController::getViewCenter() const
@@ -295,7 +295,7 @@ void TopDownInteractionController::setViewCenter(const QPointF& center)
     params.bounds.translate(delta.x(), delta.y());
     
     m_projectionManager->setViewParameters(params);
-    emit viewChanged();
+    notifyViewChanged();
 }
 
 // 缩放控制实现
@@ -317,7 +317,7 @@ void TopDownInteractionController::zoom(float factor, const QPointF& center)
     }
     
     m_projectionManager->setViewParameters(params);
-    emit viewChanged();
+    notifyViewChanged();
 }
 
 void TopDownInteractionController::wheelZoom(const QPointF& center, int delta)
@@ -342,7 +342,7 @@ void TopDownInteractionController::setZoomLevel(float zoom)
     params.zoom = clampZoom(zoom);
     
     m_projectionManager->setViewParameters(params);
-    emit viewChanged();
+    notifyViewChanged();
 }
 
 void TopDownInteractionController::zoomToFit(float margin)
@@ -356,7 +356,7 @@ void TopDownInteractionController::zoomToFit(float margin)
     params.center = QVector3D(0, 0, 0);
     
     m_projectionManager->setViewParameters(params);
-    emit viewChanged();
+    notifyViewChanged();
 }
 
 // 选择控制实现
@@ -564,6 +564,21 @@ void TopDownInteractionController::setInertialScrollingEnabled(bool enabled)
 }
 
 // 私有辅助方法
+void TopDownInteractionController::notifyViewChanged()
+{
+    emit viewChanged();
+    
+    if (!m_projectionManager) return;
+    
+    // 俯视相机：位于视图中心上方，高度取可见范围的一半
+    ViewParameters params = m_projectionManager->getViewParameters();
+    QRectF bounds = m_projectionManager->getViewBounds();
+    float height = qMax(bounds.width(), bounds.height()) * 0.5f;
+    
+    emit cameraMoved(QVector3D(params.center.x(), params.center.y(), params.center.z() + height),
+                     QVector3D(0.0f, 0.0f, -1.0f));
+}
+
 void TopDownInteractionController::updateInteractionState()
 {
     // 更新交互状态的内部逻辑
@@ -353,6 +353,13 @@ signals:
      */
     void viewChanged();
 
+    /**
+     * @brief 相机移动信号（用于点云块预取）
+     * @param position 等效相机位置（视图中心上方）
+     * @param viewDirection 视线方向（俯视为-Z）
+     */
+    void cameraMoved(const QVector3D& position, const QVector3D& viewDirection);
+
     /**
      * @brief 选择改变信号
      * @param selection 新的选择结果
@@ -383,6 +390,11 @@ private:
      */
     void updateInteractionState();
 
+    /**
+     * @brief 发出视图改变和相机移动信号
+     */
+    void notifyViewChanged();
+
     /**
      * @brief 检查点是否在矩形内
      * @param point 点坐标
@@ -101,6 +101,17 @@ QRectF TopDownViewRenderer::getViewBounds() const
     return m_viewBounds;
 }
 
+void TopDownViewRenderer::setFrameAlignment(const DominantAxisAlignment& alignment)
+{
+    m_frameAlignment = alignment;
+    emit viewParametersChanged();
+}
+
+DominantAxisAlignment TopDownViewRenderer::getFrameAlignment() const
+{
+    return m_frameAlignment;
+}
+
 void TopDownViewRenderer::setRenderMode(TopDownRenderMode mode)
 {
     if (m_renderMode != mode) {
@@ -628,6 +639,9 @@ std::vector<ColoredPoint> TopDownViewRenderer::preprocessPoints(const std::vecto
     for (const auto& point : points) {
         positions.push_back(point.position);
     }
+    if (m_frameAlignment.valid) {
+        positions = alignPoints(positions, m_frameAlignment);
+    }
 
     auto projectionResults = m_projectionManager->projectToTopDown(positions);
 
@@ -649,8 +663,10 @@ std::vector<ColoredPoint> TopDownViewRenderer::preprocessPoints(const std::vecto
     auto coloredPoints = m_colorMapper->applyColorMapping(points);
     qDebug() << "After color mapping:" << coloredPoints.size() << "colored points";
 
-    // 应用投影变换
-    auto projectionResults = m_projectionManager->projectToTopDown(points);
+    // 应用投影变换（设置了主方向对齐时先旋转到对齐坐标）
+    auto projectionResults = m_frameAlignment.valid
+        ? m_projectionManager->projectToTopDown(alignPoints(points, m_frameAlignment))
+        : m_projectionManager->projectToTopDown(points);
     qDebug() << "After projection:" << projectionResults.size() << "projection results";
 
     // 合并结果
@@ -12,6 +12,7 @@
 #include <vector>
 #include <memory>
 #include "las_reader.h"
+#include "oriented_bounding_box.h"
 
 namespace WallExtraction {
 
@@ -104,6 +105,23 @@ public:
      */
     QRectF getViewBounds() const;
 
+    /**
+     * @brief 设置主方向对齐变换
+     *
+     * 设置后点云先旋转到对齐坐标再投影，视图边界按对齐坐标解释，
+     * 主墙与栅格平行，同样分辨率下空白区域更少。
+     * 投影管理器本身不含对齐，线段叠加和拾取的坐标换算需由调用方按同一变换处理。
+     *
+     * @param alignment 对齐变换，valid为false时取消对齐
+     */
+    void setFrameAlignment(const DominantAxisAlignment& alignment);
+
+    /**
+     * @brief 获取主方向对齐变换
+     * @return 对齐变换
+     */
+    DominantAxisAlignment getFrameAlignment() const;
+
     /**
      * @brief 设置渲染模式
      * @param mode 渲染模式
@@ -331,6 +349,7 @@ private:
     bool m_initialized;
     QSize m_viewportSize;
     QRectF m_viewBounds;
+    DominantAxisAlignment m_frameAlignment;
     TopDownRenderMode m_renderMode;
     float m_pointSize;
     bool m_antiAliasingEnabled;
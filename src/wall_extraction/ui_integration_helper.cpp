@@ -268,6 +268,31 @@ void UIIntegrationHelper::setupConnections()
     connect(m_wallExtractionManager, &WallExtractionManager::wallFittingProgress,
             this, &UIIntegrationHelper::onWallFittingProgress);
     
+    connect(m_wallExtractionManager, &WallExtractionManager::wallFittingCancelled,
+            this, &UIIntegrationHelper::onWallFittingCancelled);
+    
+    // 拟合在后台执行，检测到的平面即时写入进度日志
+    connect(m_wallExtractionManager, &WallExtractionManager::wallFittingPlaneFound,
+            this, [this](const Plane3D& plane) {
+                if (m_progressDialog) {
+                    m_progressDialog->addLogMessage(QString("检测到平面：%1 个内点")
+                                                    .arg(plane.inlierIndices.size()));
+                }
+            });
+    
+    // 取消请求转发给管理器
+    connect(this, &UIIntegrationHelper::wallFittingCancelled,
+            m_wallExtractionManager, &WallExtractionManager::cancelWallFitting);
+    
+    // 线段编辑后的墙面预览：视图目前不绘制墙面几何（完整拟合结果同样只显示数量和结果表），
+    // 这里只更新状态栏的墙面数量
+    connect(m_wallExtractionManager, &WallExtractionManager::wallPreviewUpdated,
+            this, [this](const std::vector<WallSegment>& walls) {
+                if (m_wallCountLabel) {
+                    m_wallCountLabel->setText(QString("墙面: %1").arg(walls.size()));
+                }
+            });
+    
     qDebug() << "Connections established";
 }
 
@@ -424,6 +449,25 @@ void UIIntegrationHelper::onWallFittingFailed(const QString& error)
     QMessageBox::critical(m_mainWindow, "墙面拟合失败", error);
 }
 
+void UIIntegrationHelper::onWallFittingCancelled()
+{
+    m_processingActive = false;
+    updateActionStates();
+    
+    m_statusUpdateTimer->stop();
+    
+    if (m_progressDialog) {
+        m_progressDialog->cancelProgress();
+    }
+    
+    updateStatus("墙面拟合已取消");
+    
+    // 隐藏进度条
+    if (m_statusProgressBar) {
+        m_statusProgressBar->setVisible(false);
+    }
+}
+
 void UIIntegrationHelper::onWallFittingProgress(int percentage, const QString& status)
 {
     updateProgress(percentage, status);
@@ -103,6 +103,7 @@ private slots:
     void onWallFittingStarted();
     void onWallFittingCompleted(const WallFittingResult& result);
     void onWallFittingFailed(const QString& error);
+    void onWallFittingCancelled();
     void onWallFittingProgress(int percentage, const QString& status);
     
     // 进度对话框信号处理
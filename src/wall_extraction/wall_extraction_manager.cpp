@@ -2,7 +2,13 @@
 #include "line_drawing_tool.h"
 #include "wall_fitting_algorithm.h"
 #include "wireframe_generator.h"
+#include "incremental_wall_fitter.h"
+#include "wall_fitting_job.h"
 #include <QDebug>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QMetaType>
 #include <QVector3D>
 
@@ -33,6 +39,9 @@ WallExtractionManager::WallExtractionManager(QWidget* parent)
     , m_currentMode(InteractionMode::PointCloudView)
     , m_parentWidget(parent)
     , m_isProcessing(false)
+    , m_activeJobId(-1)
+    , m_activeJobLineBased(false)
+    , m_wallFittingTimeout(0)
 {
     // 注册元类型以支持信号槽
     qRegisterMetaType<InteractionMode>("InteractionMode");
@@ -212,6 +221,11 @@ WireframeGenerator* WallExtractionManager::getWireframeGenerator() const
     return m_wireframeGenerator.get();
 }
 
+IncrementalWallFitter* WallExtractionManager::getIncrementalWallFitter() const
+{
+    return m_incrementalWallFitter.get();
+}
+
 void WallExtractionManager::processInvalidOperation()
 {
     throw WallExtractionException("Invalid operation requested");
@@ -234,49 +248,31 @@ bool WallExtractionManager::performLineBasedWallFitting(const std::vector<QVecto
         return false;
     }
 
-    try {
-        m_isProcessing = true;
-        m_currentPointCloud = pointCloud;
-
-        emit wallFittingStarted();
-        setStatusMessage("开始基于线段的墙面拟合");
-
-        // 获取用户绘制的线段
-        const auto& userLines = m_lineDrawingTool->getLineSegments();
-        if (userLines.empty()) {
-            m_isProcessing = false;
-            QString error = "没有可用的用户绘制线段";
-            emit wallFittingFailed(error);
-            return false;
-        }
-
-        qDebug() << "Starting line-based wall fitting with" << userLines.size()
-                 << "user lines and" << pointCloud.size() << "points";
-
-        // 执行基于线段的墙面拟合
-        m_lastWallFittingResult = m_wallFittingAlgorithm->fitWallsFromLines(pointCloud, userLines);
-
-        m_isProcessing = false;
-
-        if (m_lastWallFittingResult.success) {
-            emit wallFittingCompleted(m_lastWallFittingResult);
-            setStatusMessage(QString("墙面拟合完成：提取到 %1 个墙面")
-                           .arg(m_lastWallFittingResult.walls.size()));
-            qDebug() << "Line-based wall fitting completed successfully";
-            return true;
-        } else {
-            emit wallFittingFailed(m_lastWallFittingResult.errorMessage);
-            setStatusMessage("墙面拟合失败");
-            return false;
-        }
-
-    } catch (const std::exception& e) {
-        m_isProcessing = false;
-        QString error = QString("墙面拟合过程中发生异常: %1").arg(e.what());
-        qCritical() << error;
+    // 获取用户绘制的线段
+    const auto& userLines = m_lineDrawingTool->getLineSegments();
+    if (userLines.empty()) {
+        QString error = "没有可用的用户绘制线段";
         emit wallFittingFailed(error);
         return false;
     }
+
+    qDebug() << "Starting line-based wall fitting with" << userLines.size()
+             << "user lines and" << pointCloud.size() << "points";
+
+    // 在后台执行基于线段的墙面拟合，结果通过jobCompleted返回
+    m_isProcessing = true;
+    m_currentPointCloud = std::make_shared<const std::vector<QVector3D>>(pointCloud);
+    const WallFittingJobSettings settings =
+        WallFittingJobSettings::fromAlgorithm(*m_wallFittingAlgorithm, m_wallFittingTimeout);
+    m_activeJobId = m_jobRunner->submitLineJob(m_currentPointCloud, userLines, settings);
+    m_activeJobLineBased = true;
+    m_activeJobLines = userLines;
+    m_activeJobParameters = settings.parameters;
+    m_activeJobRegularization = settings.regularization;
+
+    emit wallFittingStarted();
+    setStatusMessage("开始基于线段的墙面拟合");
+    return true;
 }
 
 bool WallExtractionManager::performAutoWallFitting(const std::vector<QVector3D>& pointCloud)
@@ -296,39 +292,43 @@ bool WallExtractionManager::performAutoWallFitting(const std::vector<QVector3D>&
         return false;
     }
 
-    try {
-        m_isProcessing = true;
-        m_currentPointCloud = pointCloud;
+    qDebug() << "Starting automatic wall fitting with" << pointCloud.size() << "points";
 
-        emit wallFittingStarted();
-        setStatusMessage("开始自动墙面拟合");
+    // 在后台执行自动墙面拟合，界面线程只接收进度、逐个检测到的平面和最终结果
+    m_isProcessing = true;
+    m_currentPointCloud = std::make_shared<const std::vector<QVector3D>>(pointCloud);
+    m_activeJobId = m_jobRunner->submitPointCloudJob(
+        m_currentPointCloud, WallFittingJobSettings::fromAlgorithm(*m_wallFittingAlgorithm, m_wallFittingTimeout));
+    m_activeJobLineBased = false;
 
-        qDebug() << "Starting automatic wall fitting with" << pointCloud.size() << "points";
+    emit wallFittingStarted();
+    setStatusMessage("开始自动墙面拟合");
+    return true;
+}
 
-        // 执行自动墙面拟合
-        m_lastWallFittingResult = m_wallFittingAlgorithm->fitWallsFromPointCloud(pointCloud);
+bool WallExtractionManager::cancelWallFitting()
+{
+    if (!m_isProcessing || !m_jobRunner) {
+        return false;
+    }
 
-        m_isProcessing = false;
+    setStatusMessage("正在取消墙面拟合");
+    return m_jobRunner->cancel(m_activeJobId);
+}
 
-        if (m_lastWallFittingResult.success) {
-            emit wallFittingCompleted(m_lastWallFittingResult);
-            setStatusMessage(QString("自动墙面拟合完成：提取到 %1 个墙面")
-                           .arg(m_lastWallFittingResult.walls.size()));
-            qDebug() << "Automatic wall fitting completed successfully";
-            return true;
-        } else {
-            emit wallFittingFailed(m_lastWallFittingResult.errorMessage);
-            setStatusMessage("自动墙面拟合失败");
-            return false;
-        }
+bool WallExtractionManager::isWallFittingRunning() const
+{
+    return m_isProcessing;
+}
 
-    } catch (const std::exception& e) {
-        m_isProcessing = false;
-        QString error = QString("自动墙面拟合过程中发生异常: %1").arg(e.what());
-        qCritical() << error;
-        emit wallFittingFailed(error);
-        return false;
-    }
+void WallExtractionManager::setWallFittingTimeout(int msecs)
+{
+    m_wallFittingTimeout = qMax(0, msecs);
+}
+
+int WallExtractionManager::getWallFittingTimeout() const
+{
+    return m_wallFittingTimeout;
 }
 
 WallFittingResult WallExtractionManager::getLastWallFittingResult() const
@@ -336,6 +336,11 @@ WallFittingResult WallExtractionManager::getLastWallFittingResult() const
     return m_lastWallFittingResult;
 }
 
+std::vector<WallSegment> WallExtractionManager::getWallPreview() const
+{
+    return m_incrementalWallFitter ? m_incrementalWallFitter->getWalls() : std::vector<WallSegment>();
+}
+
 void WallExtractionManager::clearAllData()
 {
     if (m_isProcessing) {
@@ -354,8 +359,14 @@ void WallExtractionManager::clearAllData()
             m_wallFittingAlgorithm->reset();
         }
 
+        // 清除线段和墙面缓存（clearAll不发射线段删除信号）
+        if (m_incrementalWallFitter) {
+            m_incrementalWallFitter->clear();
+        }
+
         // 清除缓存数据
-        m_currentPointCloud.clear();
+        m_currentPointCloud.reset();
+        m_activeJobLines.clear();
         m_lastWallFittingResult = WallFittingResult();
 
         setStatusMessage("所有数据已清除");
@@ -367,6 +378,34 @@ void WallExtractionManager::clearAllData()
     }
 }
 
+void WallExtractionManager::setCoordinateOrigin(const CoordinateOrigin& origin)
+{
+    m_coordinateOrigin = origin;
+    if (m_lineDrawingTool) {
+        m_lineDrawingTool->setCoordinateOrigin(origin);
+    }
+    if (m_wallFittingAlgorithm) {
+        m_wallFittingAlgorithm->setCoordinateOrigin(origin);
+    }
+}
+
+CoordinateOrigin WallExtractionManager::getCoordinateOrigin() const
+{
+    return m_coordinateOrigin;
+}
+
+void WallExtractionManager::setFrameAlignment(const DominantAxisAlignment& alignment)
+{
+    if (m_wallFittingAlgorithm) {
+        m_wallFittingAlgorithm->setFrameAlignment(alignment);
+    }
+}
+
+DominantAxisAlignment WallExtractionManager::getFrameAlignment() const
+{
+    return m_wallFittingAlgorithm ? m_wallFittingAlgorithm->getFrameAlignment() : DominantAxisAlignment();
+}
+
 bool WallExtractionManager::exportWallData(const QString& filename) const
 {
     if (!m_initialized) {
@@ -381,10 +420,39 @@ bool WallExtractionManager::exportWallData(const QString& filename) const
             return false;
         }
 
-        // 导出墙面数据（如果有的话）
+        // 导出墙面数据（如果有的话），端点加回坐标原点
         if (m_lastWallFittingResult.success && !m_lastWallFittingResult.walls.empty()) {
-            // 这里可以添加墙面数据的导出逻辑
-            qDebug() << "Wall data export not yet implemented";
+            const CoordinateOrigin& origin = m_lastWallFittingResult.coordinateOrigin;
+
+            QJsonArray wallsArray;
+            for (const WallSegment& wall : m_lastWallFittingResult.walls) {
+                double startX, startY, startZ;
+                double endX, endY, endZ;
+                origin.toGlobal(wall.startPoint, startX, startY, startZ);
+                origin.toGlobal(wall.endPoint, endX, endY, endZ);
+
+                QJsonObject wallObject;
+                wallObject["id"] = wall.id;
+                wallObject["startPoint"] = QJsonArray{startX, startY, startZ};
+                wallObject["endPoint"] = QJsonArray{endX, endY, endZ};
+                wallObject["normal"] = QJsonArray{wall.normal.x(), wall.normal.y(), wall.normal.z()};
+                wallObject["height"] = wall.height;
+                wallObject["thickness"] = wall.thickness;
+                wallObject["confidence"] = wall.confidence;
+                wallsArray.append(wallObject);
+            }
+
+            QJsonObject root;
+            root["version"] = "1.0";
+            root["coordinateOrigin"] = QJsonArray{origin.x, origin.y, origin.z};
+            root["walls"] = wallsArray;
+
+            QFile file(filename + "_walls.json");
+            if (!file.open(QIODevice::WriteOnly)) {
+                qWarning() << "Failed to export wall data";
+                return false;
+            }
+            file.write(QJsonDocument(root).toJson());
         }
 
         qDebug() << "Data exported to" << filename;
@@ -415,6 +483,11 @@ bool WallExtractionManager::importWallData(const QString& filename)
             return false;
         }
 
+        // 导入不逐条发射线段信号，整体同步到增量拟合器
+        if (m_incrementalWallFitter) {
+            m_incrementalWallFitter->setLines(m_lineDrawingTool->getLineSegments());
+        }
+
         setStatusMessage("数据导入完成");
         qDebug() << "Data imported from" << filename;
         return true;
@@ -426,6 +499,30 @@ bool WallExtractionManager::importWallData(const QString& filename)
     }
 }
 
+void WallExtractionManager::handleJobCompleted(int jobId, const WallFittingResult& result)
+{
+    if (jobId != m_activeJobId) {
+        return;
+    }
+
+    m_isProcessing = false;
+    m_lastWallFittingResult = result;
+
+    // 之后的线段编辑由增量拟合器在后台只更新受影响的墙面：缓存直接取自本次结果，
+    // 再同步拟合期间的编辑，只有这些线段需要重新拟合
+    if (m_activeJobLineBased) {
+        m_incrementalWallFitter->setRegularizationOptions(m_activeJobRegularization);
+        m_incrementalWallFitter->seedWalls(m_currentPointCloud, m_activeJobParameters,
+                                           m_activeJobLines, result.walls);
+        m_incrementalWallFitter->setLines(m_lineDrawingTool->getLineSegments());
+        m_activeJobLines.clear();
+    }
+
+    setStatusMessage(QString("墙面拟合完成：提取到 %1 个墙面").arg(result.walls.size()));
+    qDebug() << "Wall fitting job completed:" << jobId << result.walls.size() << "walls";
+    emit wallFittingCompleted(result);
+}
+
 void WallExtractionManager::handleComponentError(const QString& error)
 {
     QString fullError = QString("Component error: %1").arg(error);
@@ -457,6 +554,12 @@ bool WallExtractionManager::initializeComponents()
             return false;
         }
 
+        // 创建增量墙面拟合器
+        m_incrementalWallFitter = std::make_unique<IncrementalWallFitter>();
+
+        // 创建后台拟合任务执行器
+        m_jobRunner = std::make_unique<WallFittingJobRunner>();
+
         qDebug() << "All components initialized successfully";
         return true;
 
@@ -479,6 +582,67 @@ void WallExtractionManager::setupConnections()
                 });
     }
 
+    // 后台拟合任务的进度和结果（只处理当前任务）
+    if (m_jobRunner) {
+        connect(m_jobRunner.get(), &WallFittingJobRunner::jobProgress,
+                this, [this](int jobId, int percentage, const QString& status) {
+                    if (jobId == m_activeJobId) {
+                        emit wallFittingProgress(percentage, status);
+                    }
+                });
+
+        connect(m_jobRunner.get(), &WallFittingJobRunner::jobPlaneFound,
+                this, [this](int jobId, const Plane3D& plane) {
+                    if (jobId == m_activeJobId) {
+                        emit wallFittingPlaneFound(plane);
+                    }
+                });
+
+        connect(m_jobRunner.get(), &WallFittingJobRunner::jobCompleted,
+                this, &WallExtractionManager::handleJobCompleted);
+
+        connect(m_jobRunner.get(), &WallFittingJobRunner::jobFailed,
+                this, [this](int jobId, const QString& error) {
+                    if (jobId != m_activeJobId) {
+                        return;
+                    }
+                    m_isProcessing = false;
+                    setStatusMessage("墙面拟合失败");
+                    emit wallFittingFailed(error);
+                });
+
+        connect(m_jobRunner.get(), &WallFittingJobRunner::jobCancelled,
+                this, [this](int jobId, bool timedOut) {
+                    if (jobId != m_activeJobId) {
+                        return;
+                    }
+                    m_isProcessing = false;
+                    if (timedOut) {
+                        QString error = QString("墙面拟合超时（%1 秒）").arg(m_wallFittingTimeout / 1000.0, 0, 'f', 1);
+                        setStatusMessage(error);
+                        emit wallFittingFailed(error);
+                    } else {
+                        setStatusMessage("墙面拟合已取消");
+                        emit wallFittingCancelled();
+                    }
+                });
+    }
+
+    // 线段编辑驱动增量墙面拟合
+    if (m_lineDrawingTool && m_incrementalWallFitter) {
+        connect(m_lineDrawingTool.get(), &LineDrawingTool::lineSegmentAdded,
+                m_incrementalWallFitter.get(), &IncrementalWallFitter::onLineSegmentAdded);
+
+        connect(m_lineDrawingTool.get(), &LineDrawingTool::lineSegmentRemoved,
+                m_incrementalWallFitter.get(), &IncrementalWallFitter::onLineSegmentRemoved);
+
+        connect(m_lineDrawingTool.get(), &LineDrawingTool::lineSegmentUpdated,
+                m_incrementalWallFitter.get(), &IncrementalWallFitter::onLineSegmentUpdated);
+
+        connect(m_incrementalWallFitter.get(), &IncrementalWallFitter::wallsUpdated,
+                this, &WallExtractionManager::wallPreviewUpdated);
+    }
+
     // 连接墙面拟合算法的信号
     if (m_wallFittingAlgorithm) {
         connect(m_wallFittingAlgorithm.get(), &WallFittingAlgorithm::errorOccurred,
@@ -509,7 +673,9 @@ void WallExtractionManager::cleanup()
         deactivateModule();
     }
 
-    // 智能指针会自动清理资源
+    // 智能指针会自动清理资源（后台任务先取消，增量拟合器先等待后台更新结束）
+    m_jobRunner.reset();
+    m_incrementalWallFitter.reset();
     m_wireframeGenerator.reset();
     m_wallFittingAlgorithm.reset();
     m_lineDrawingTool.reset();
@@ -42,6 +42,8 @@ private:
 class LineDrawingTool;
 class WallFittingAlgorithm;
 class WireframeGenerator;
+class IncrementalWallFitter;
+class WallFittingJobRunner;
 
 /**
  * @brief 墙面提取模块的主管理器类
@@ -132,6 +134,12 @@ public:
      */
     WireframeGenerator* getWireframeGenerator() const;
 
+    /**
+     * @brief 获取增量墙面拟合器
+     * @return 增量墙面拟合器指针
+     */
+    IncrementalWallFitter* getIncrementalWallFitter() const;
+
     /**
      * @brief 处理无效操作（用于测试异常处理）
      * @throws WallExtractionException
@@ -140,29 +148,96 @@ public:
 
     /**
      * @brief 基于用户绘制线段进行墙面拟合
+     *
+     * 拟合在后台线程执行，结果通过wallFittingCompleted、wallFittingFailed
+     * 或wallFittingCancelled返回。
+     *
      * @param pointCloud 点云数据
-     * @return 拟合是否成功
+     * @return 任务是否已提交
      */
     bool performLineBasedWallFitting(const std::vector<QVector3D>& pointCloud);
 
     /**
      * @brief 自动墙面拟合（仅基于点云）
+     *
+     * 拟合在后台线程执行，检测到的平面通过wallFittingPlaneFound逐个发布。
+     *
      * @param pointCloud 点云数据
-     * @return 拟合是否成功
+     * @return 任务是否已提交
      */
     bool performAutoWallFitting(const std::vector<QVector3D>& pointCloud);
 
+    /**
+     * @brief 请求取消当前的墙面拟合（协作式，在算法的下一个检查点生效）
+     * @return 是否有正在执行的拟合
+     */
+    bool cancelWallFitting();
+
+    /**
+     * @brief 是否有正在执行的墙面拟合
+     * @return 执行状态
+     */
+    bool isWallFittingRunning() const;
+
+    /**
+     * @brief 设置墙面拟合超时，超时后任务按取消处理并发射wallFittingFailed
+     * @param msecs 超时时间（毫秒），0表示不限制
+     */
+    void setWallFittingTimeout(int msecs);
+    int getWallFittingTimeout() const;
+
     /**
      * @brief 获取最近的墙面拟合结果
      * @return 墙面拟合结果
      */
     WallFittingResult getLastWallFittingResult() const;
 
+    /**
+     * @brief 获取当前的墙面预览
+     *
+     * 基于线段的墙面拟合之后，线段的每次编辑只在后台重新拟合受影响的墙面。
+     *
+     * @return 墙面预览
+     */
+    std::vector<WallSegment> getWallPreview() const;
+
     /**
      * @brief 清除所有线段和墙面数据
      */
     void clearAllData();
 
+    /**
+     * @brief 设置点云坐标原点
+     *
+     * 点云、线段和墙面均以相对原点的局部坐标保存，原点同步到线段绘制工具和墙面拟合算法，
+     * 导出时加回原点得到全局坐标。
+     *
+     * @param origin 坐标原点
+     */
+    void setCoordinateOrigin(const CoordinateOrigin& origin);
+
+    /**
+     * @brief 获取点云坐标原点
+     * @return 坐标原点
+     */
+    CoordinateOrigin getCoordinateOrigin() const;
+
+    /**
+     * @brief 设置主方向对齐变换
+     *
+     * 同步到墙面拟合算法：拟合在对齐坐标中进行，结果变换回点云坐标，
+     * 异步拟合任务随设置一起复制。
+     *
+     * @param alignment 对齐变换，valid为false时取消对齐
+     */
+    void setFrameAlignment(const DominantAxisAlignment& alignment);
+
+    /**
+     * @brief 获取主方向对齐变换
+     * @return 对齐变换
+     */
+    DominantAxisAlignment getFrameAlignment() const;
+
     /**
      * @brief 导出墙面数据
      * @param filename 文件名
@@ -226,6 +301,23 @@ signals:
      */
     void wallFittingProgress(int percentage, const QString& status);
 
+    /**
+     * @brief 墙面拟合过程中检测到平面（部分结果）
+     * @param plane 平面（世界坐标）
+     */
+    void wallFittingPlaneFound(const Plane3D& plane);
+
+    /**
+     * @brief 墙面拟合已被用户取消
+     */
+    void wallFittingCancelled();
+
+    /**
+     * @brief 墙面预览更新信号（线段编辑后增量拟合完成时发射）
+     * @param walls 全部墙面
+     */
+    void wallPreviewUpdated(const std::vector<WallSegment>& walls);
+
 private slots:
     /**
      * @brief 处理子组件错误
@@ -233,6 +325,13 @@ private slots:
      */
     void handleComponentError(const QString& error);
 
+    /**
+     * @brief 处理后台拟合任务完成
+     * @param jobId 任务ID
+     * @param result 拟合结果
+     */
+    void handleJobCompleted(int jobId, const WallFittingResult& result);
+
 private:
     /**
      * @brief 初始化子组件
@@ -270,13 +369,22 @@ private:
     std::unique_ptr<LineDrawingTool> m_lineDrawingTool;
     std::unique_ptr<WallFittingAlgorithm> m_wallFittingAlgorithm;
     std::unique_ptr<WireframeGenerator> m_wireframeGenerator;
+    std::unique_ptr<IncrementalWallFitter> m_incrementalWallFitter;
+    std::unique_ptr<WallFittingJobRunner> m_jobRunner;
 
     // 数据缓存
-    std::vector<QVector3D> m_currentPointCloud;
+    std::shared_ptr<const std::vector<QVector3D>> m_currentPointCloud;  // 与拟合任务和增量拟合器共享，不复制
     WallFittingResult m_lastWallFittingResult;
+    CoordinateOrigin m_coordinateOrigin;
 
     // 处理状态
     bool m_isProcessing;
+    int m_activeJobId;              // 当前后台拟合任务ID
+    bool m_activeJobLineBased;      // 当前任务是否基于线段
+    std::vector<LineSegment> m_activeJobLines;          // 当前线段任务使用的线段
+    RANSACParameters m_activeJobParameters;             // 当前任务使用的参数
+    WallRegularizationOptions m_activeJobRegularization;    // 当前任务使用的规则化选项
+    int m_wallFittingTimeout;       // 拟合超时（毫秒），0表示不限制
 };
 
 } // namespace WallExtraction
@@ -1,14 +1,293 @@
 #include "wall_fitting_algorithm.h"
 #include "line_drawing_tool.h"
+#include "efficient_ransac.h"
+#include "region_growing.h"
+#include "spatial_index.h"
+#include "parallel_utils.h"
+#include "plane_fitting.h"
+#include "wall_thickness.h"
 #include <QDebug>
 #include <QElapsedTimer>
+#include <QStringList>
 #include <QtMath>
 #include <algorithm>
+#include <numeric>
 #include <random>
+#include <limits>
+#include <map>
+#include <unordered_map>
 #include <cmath>
 
 namespace WallExtraction {
 
+namespace {
+
+// 预检验子集大小：足以区分明显的劣假设，又远小于全量点数
+const size_t kRansacPreTestSize = 512;
+
+// 每批假设数 = 线程数 × 该值，批越大自适应迭代次数更新越迟
+const size_t kRansacHypothesesPerThread = 4;
+
+// 并行评估时每段的最少点测试次数
+const size_t kRansacMinPointTestsPerRange = 1 << 15;
+
+// 用户线段两侧（及两端）收集墙面点的范围（米）
+const float kLineSearchRadius = 2.0f;
+
+// 线段端点重合的判定距离（米）
+const float kJunctionTolerance = 0.01f;
+
+// 两墙面方向夹角的正弦低于该值时视为平行，不求交
+const float kMinJoinSine = 0.1f;
+
+// 平面聚类：法向夹角（度）和偏移差（米）阈值，只合并同一表面的碎片，
+// 墙体两侧的表面由pairWallFaces按最大墙厚配对
+const float kPlaneClusterAngle = 5.0f;
+const float kPlaneClusterDistance = 0.1f;
+
+// 墙体两侧表面配对时沿墙方向的最小重叠比例（相对较短的表面）
+const float kMinFaceOverlap = 0.5f;
+
+// 平行墙面合并：起点距离阈值（米）
+const float kWallMergeDistance = 1.0f;
+
+// 朝向栅格的角度单元取为角度阈值的倍数：倾斜法向的水平投影角差可能大于三维夹角
+const float kOrientationCellScale = 2.0f;
+
+// 朝向栅格中元素的坐标：水平法向角θ∈[0, π)和两个位置坐标（平面为(d, 0)，墙面为起点XY）
+struct OrientedKey {
+    float theta;
+    float u;
+    float v;
+};
+
+/**
+ * @brief 规范化法向：水平投影角落在[0, π)内，互为反向的法向得到相同的θ
+ * @param normal 法向量
+ * @param canonical 规范法向（与normal同向或反向）
+ * @return 水平法向角θ
+ */
+float canonicalOrientation(const QVector3D& normal, QVector3D& canonical)
+{
+    canonical = normal;
+    if (std::hypot(normal.x(), normal.y()) < 1e-6f) {
+        return 0.0f;    // 水平面没有水平朝向，统一放在θ=0，由精确判定决定是否合并
+    }
+    float theta = std::atan2(normal.y(), normal.x());
+    if (theta < 0.0f) {
+        theta += static_cast<float>(M_PI);
+        canonical = -normal;
+    }
+    if (theta >= static_cast<float>(M_PI)) {
+        theta = 0.0f;
+        canonical = -canonical;
+    }
+    return theta;
+}
+
+inline quint32 findClusterRoot(std::vector<quint32>& parent, quint32 i)
+{
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+/**
+ * @brief 枚举(θ, u, v)哈希栅格中位于相邻单元的元素对
+ *
+ * 每个元素只与所在单元及相邻单元中的元素配对，各维度上的差不超过单元大小的元素对不会漏掉。
+ * θ按π循环；mirrorOnWrap为true时u、v沿规范法向度量，跨越0/π时随法向取反。
+ * θ单元少于3个时同一对可能被访问两次，visit需可重复调用。
+ *
+ * @param keys 元素的坐标
+ * @param angleCell θ方向单元大小（弧度），调整为π的整数分之一
+ * @param uCell u方向单元大小
+ * @param vCell v方向单元大小，不大于0时不按v分桶
+ * @param mirrorOnWrap 跨越0/π时是否对u、v取反
+ * @param visit 对每个元素对调用 visit(i, j)，i < j
+ */
+template <typename Visit>
+void forEachOrientedNeighbor(const std::vector<OrientedKey>& keys, float angleCell,
+                             float uCell, float vCell, bool mirrorOnWrap, const Visit& visit)
+{
+    const int thetaCells = qBound(1, static_cast<int>(std::floor(M_PI / angleCell)), 1023);
+    const double thetaCell = M_PI / thetaCells;
+    const bool useV = vCell > 0.0f;
+
+    // 各维度的单元坐标打包为64位键：θ占10位，u和v各占27位（带偏置）
+    const qint64 bias = qint64(1) << 26;
+    auto cellOf = [&](int t, double u, double v) -> quint64 {
+        const qint64 cu = qBound<qint64>(-bias, static_cast<qint64>(std::floor(u / uCell)), bias - 1) + bias;
+        const qint64 cv = useV
+            ? qBound<qint64>(-bias, static_cast<qint64>(std::floor(v / vCell)), bias - 1) + bias
+            : 0;
+        return (static_cast<quint64>(t) << 54) | (static_cast<quint64>(cu) << 27) | static_cast<quint64>(cv);
+    };
+    auto thetaIndex = [&](float theta) {
+        return qBound(0, static_cast<int>(theta / thetaCell), thetaCells - 1);
+    };
+
+    std::unordered_map<quint64, std::vector<quint32>> buckets;
+    buckets.reserve(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        buckets[cellOf(thetaIndex(keys[i].theta), keys[i].u, keys[i].v)].push_back(static_cast<quint32>(i));
+    }
+
+    const int vRange = useV ? 1 : 0;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        const OrientedKey& key = keys[i];
+        const int t0 = thetaIndex(key.theta);
+        for (int dt = -1; dt <= 1; ++dt) {
+            int t = t0 + dt;
+            double sign = 1.0;
+            if (t < 0 || t >= thetaCells) {
+                t = (t + thetaCells) % thetaCells;
+                sign = mirrorOnWrap ? -1.0 : 1.0;
+            }
+            if (dt != 0 && t == t0) {
+                continue;       // 只有一个θ单元时避免重复访问
+            }
+            for (int du = -1; du <= 1; ++du) {
+                for (int dv = -vRange; dv <= vRange; ++dv) {
+                    auto bucket = buckets.find(cellOf(t, sign * (key.u + du * uCell),
+                                                      sign * (key.v + dv * vCell)));
+                    if (bucket == buckets.end()) {
+                        continue;
+                    }
+                    for (quint32 j : bucket->second) {
+                        if (j > i) {
+                            visit(i, static_cast<size_t>(j));
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief 在(θ, u, v)哈希栅格中对相容的元素做并查集合并
+ *
+ * 只对相邻单元中的元素对做精确判定（见forEachOrientedNeighbor），相容元素在各维度上的差
+ * 不超过单元大小时结果与两两比较相同。
+ *
+ * @param compatible 精确判定 compatible(i, j)
+ * @return 每个元素所在簇的根
+ */
+template <typename Compatible>
+std::vector<quint32> clusterOrientedKeys(const std::vector<OrientedKey>& keys, float angleCell,
+                                         float uCell, float vCell, bool mirrorOnWrap,
+                                         const Compatible& compatible)
+{
+    std::vector<quint32> parent(keys.size());
+    std::iota(parent.begin(), parent.end(), 0u);
+
+    forEachOrientedNeighbor(keys, angleCell, uCell, vCell, mirrorOnWrap, [&](size_t i, size_t j) {
+        const quint32 ri = findClusterRoot(parent, static_cast<quint32>(i));
+        const quint32 rj = findClusterRoot(parent, static_cast<quint32>(j));
+        if (ri != rj && compatible(i, j)) {
+            parent[qMax(ri, rj)] = qMin(ri, rj);
+        }
+    });
+
+    for (size_t i = 0; i < keys.size(); ++i) {
+        parent[i] = findClusterRoot(parent, static_cast<quint32>(i));
+    }
+    return parent;
+}
+
+/**
+ * @brief 按并查集结果合并元素
+ *
+ * 每个簇保留支撑点最多的元素，其余成员的支撑数据追加到它后面（代表元素的数据原地保留，
+ * 其余成员的数据只追加一次），结果按簇内最小下标排序。多于一个成员的簇合并支撑数据后
+ * 调用refit(代表元素, items, 簇成员)，按合并后的支撑数据和成员几何更新代表元素的参数。
+ *
+ * @param items 待合并的元素（移入）
+ * @param roots 每个元素所在簇的根（簇内最小下标）
+ * @param support 返回元素支撑数据的引用
+ * @param refit 更新合并后元素的参数
+ * @return 合并后的元素
+ */
+template <typename Item, typename Support, typename Refit>
+std::vector<Item> mergeClusters(std::vector<Item> items, const std::vector<quint32>& roots,
+                                const Support& support, const Refit& refit)
+{
+    // 根是簇内最小下标，按下标顺序遍历即得到簇的输出顺序
+    std::vector<std::vector<quint32>> members(items.size());
+    for (size_t i = 0; i < items.size(); ++i) {
+        members[roots[i]].push_back(static_cast<quint32>(i));
+    }
+
+    std::vector<Item> merged;
+    for (size_t root = 0; root < items.size(); ++root) {
+        const std::vector<quint32>& cluster = members[root];
+        if (cluster.empty()) {
+            continue;
+        }
+
+        quint32 representative = cluster.front();
+        size_t totalSize = 0;
+        for (quint32 member : cluster) {
+            const size_t size = support(items[member]).size();
+            totalSize += size;
+            if (size > support(items[representative]).size()) {
+                representative = member;
+            }
+        }
+
+        auto& target = support(items[representative]);
+        target.reserve(totalSize);
+        for (quint32 member : cluster) {
+            if (member != representative) {
+                auto& source = support(items[member]);
+                target.insert(target.end(), source.begin(), source.end());
+                std::remove_reference_t<decltype(source)>().swap(source);
+            }
+        }
+        if (cluster.size() > 1) {
+            refit(items[representative], items, cluster);
+        }
+        merged.push_back(std::move(items[representative]));
+    }
+    return merged;
+}
+
+/**
+ * @brief 按合并后的内点重新拟合平面
+ *
+ * 法向保持与原平面同侧；拟合失败或法向偏离原平面超过angleThreshold（度）时保留原参数。
+ *
+ * @param plane 合并后的平面（inlierIndices为簇内全部内点）
+ * @param points 点云数据
+ * @param options 拟合选项
+ * @param angleThreshold 允许的法向偏离（度）
+ */
+void refitMergedPlane(Plane3D& plane, const std::vector<QVector3D>& points,
+                      const PlaneFitOptions& options, float angleThreshold)
+{
+    const PlaneFitResult fit = fitPlaneLeastSquares(points, plane.inlierIndices, options);
+    if (!fit.valid) {
+        return;
+    }
+
+    QVector3D normal = fit.normal;
+    if (QVector3D::dotProduct(normal, plane.normal) < 0.0f) {
+        normal = -normal;
+    }
+    if (QVector3D::dotProduct(normal, plane.normal) < qCos(qDegreesToRadians(angleThreshold))) {
+        return;
+    }
+
+    plane.point = fit.centroid;
+    plane.normal = normal;
+    plane.distance = QVector3D::dotProduct(normal, fit.centroid);
+}
+
+} // namespace
+
 // Plane3D 方法实现
 float Plane3D::distanceToPoint(const QVector3D& point) const
 {
@@ -35,6 +314,8 @@ float WallSegment::area() const
 WallFittingAlgorithm::WallFittingAlgorithm(QObject* parent)
     : QObject(parent)
     , m_initialized(false)
+    , m_planeDetectionMethod(PlaneDetectionMethod::EfficientRANSAC)
+    , m_detectingInAlignedFrame(false)
     , m_isProcessing(false)
     , m_totalIterations(0)
     , m_successfulFits(0)
@@ -110,15 +391,78 @@ RANSACParameters WallFittingAlgorithm::getRANSACParameters() const
     return m_parameters;
 }
 
+void WallFittingAlgorithm::setPlaneDetectionMethod(PlaneDetectionMethod method)
+{
+    m_planeDetectionMethod = method;
+}
+
+PlaneDetectionMethod WallFittingAlgorithm::getPlaneDetectionMethod() const
+{
+    return m_planeDetectionMethod;
+}
+
 void WallFittingAlgorithm::setProgressCallback(std::function<void(int, const QString&)> callback)
 {
     m_progressCallback = callback;
 }
 
+void WallFittingAlgorithm::setPlaneCallback(std::function<void(const Plane3D&)> callback)
+{
+    m_planeCallback = callback;
+}
+
+void WallFittingAlgorithm::setCancellationCallback(std::function<bool()> callback)
+{
+    m_cancellationCallback = callback;
+}
+
+bool WallFittingAlgorithm::isCancellationRequested() const
+{
+    return m_cancellationCallback && m_cancellationCallback();
+}
+
+void WallFittingAlgorithm::setFrameAlignment(const DominantAxisAlignment& alignment)
+{
+    m_frameAlignment = alignment;
+    qDebug() << "Frame alignment" << (alignment.valid ? "enabled" : "disabled")
+             << "angle:" << qRadiansToDegrees(alignment.angle);
+}
+
+DominantAxisAlignment WallFittingAlgorithm::getFrameAlignment() const
+{
+    return m_frameAlignment;
+}
+
+void WallFittingAlgorithm::setCoordinateOrigin(const CoordinateOrigin& origin)
+{
+    m_coordinateOrigin = origin;
+}
+
+CoordinateOrigin WallFittingAlgorithm::getCoordinateOrigin() const
+{
+    return m_coordinateOrigin;
+}
+
+void WallFittingAlgorithm::setRegularizationOptions(const WallRegularizationOptions& options)
+{
+    m_regularizationOptions = options;
+}
+
+WallRegularizationOptions WallFittingAlgorithm::getRegularizationOptions() const
+{
+    return m_regularizationOptions;
+}
+
+WallRegularizationResult WallFittingAlgorithm::getLastRegularization() const
+{
+    return m_lastRegularization;
+}
+
 // 主要算法接口
 WallFittingResult WallFittingAlgorithm::fitWallsFromPointCloud(const std::vector<QVector3D>& points)
 {
     WallFittingResult result;
+    result.coordinateOrigin = m_coordinateOrigin;
 
     if (!m_initialized) {
         result.errorMessage = "算法未初始化";
@@ -142,10 +486,26 @@ WallFittingResult WallFittingAlgorithm::fitWallsFromPointCloud(const std::vector
     try {
         reportProgress(0, "开始处理点云数据");
 
+        // 设置了主方向对齐时在对齐坐标中拟合，主墙与坐标轴平行
+        const bool useAlignment = m_frameAlignment.valid;
+        std::vector<QVector3D> alignedPoints;
+        if (useAlignment) {
+            alignedPoints = alignPoints(points, m_frameAlignment);
+        }
+        const std::vector<QVector3D>& workingPoints = useAlignment ? alignedPoints : points;
+
         // 步骤1：检测平面
         reportProgress(10, "检测垂直平面");
-        std::vector<Plane3D> planes = detectPlanes(points);
+        m_detectingInAlignedFrame = useAlignment;
+        std::vector<Plane3D> planes = detectPlanes(workingPoints);
+        m_detectingInAlignedFrame = false;
+        if (finishIfCancelled(result)) {
+            return result;
+        }
         result.planes = planes;
+        if (useAlignment) {
+            transformPlanesToWorld(result.planes);
+        }
 
         if (planes.empty()) {
             result.errorMessage = "未检测到垂直平面";
@@ -153,12 +513,15 @@ WallFittingResult WallFittingAlgorithm::fitWallsFromPointCloud(const std::vector
             return result;
         }
 
-        emit planesDetected(planes);
+        emit planesDetected(result.planes);
         reportProgress(50, QString("检测到 %1 个平面").arg(planes.size()));
 
         // 步骤2：从平面提取墙面
         reportProgress(60, "提取墙面段");
-        std::vector<WallSegment> walls = extractWallsFromPlanes(planes, points);
+        std::vector<WallSegment> walls = extractWallsFromPlanes(planes, workingPoints);
+        if (finishIfCancelled(result)) {
+            return result;
+        }
         result.walls = walls;
 
         if (walls.empty()) {
@@ -170,6 +533,9 @@ WallFittingResult WallFittingAlgorithm::fitWallsFromPointCloud(const std::vector
         // 步骤3：几何优化
         reportProgress(80, "优化墙面几何");
         optimizeWallGeometry(result.walls);
+        if (useAlignment) {
+            transformWallsToWorld(result.walls);
+        }
 
         // 完成处理
         result.totalPoints = static_cast<int>(points.size());
@@ -200,6 +566,7 @@ WallFittingResult WallFittingAlgorithm::fitWallsFromLines(const std::vector<QVec
                                                          const std::vector<LineSegment>& userLines)
 {
     WallFittingResult result;
+    result.coordinateOrigin = m_coordinateOrigin;
 
     if (!m_initialized) {
         result.errorMessage = "算法未初始化";
@@ -224,16 +591,20 @@ WallFittingResult WallFittingAlgorithm::fitWallsFromLines(const std::vector<QVec
 
         // 基于用户线段拟合墙面
         std::vector<WallSegment> walls = fitWallsAlongLines(points, userLines);
-        result.walls = walls;
-
+        if (finishIfCancelled(result)) {
+            return result;
+        }
         if (walls.empty()) {
             result.errorMessage = "未能基于用户线段提取到墙面";
             emit processingFailed(result.errorMessage);
             return result;
         }
 
+        // 用户线段已给出墙面位置和连接关系：在线段交汇处求交，默认不做规则化
         reportProgress(80, "优化墙面几何");
-        optimizeWallGeometry(result.walls);
+        joinWallsAtLineJunctions(walls, userLines);
+        result.walls = walls;
+        optimizeWallGeometry(result.walls, m_regularizationOptions.applyToLineFits);
 
         // 完成处理
         result.totalPoints = static_cast<int>(points.size());
@@ -270,117 +641,251 @@ std::vector<Plane3D> WallFittingAlgorithm::detectPlanes(const std::vector<QVecto
         return planes;
     }
 
-    std::vector<bool> used(points.size(), false);
-    std::random_device rd;
-    std::mt19937 gen(rd());
-
     reportProgress(15, "执行RANSAC平面检测");
 
-    // 多次RANSAC检测
-    for (int planeCount = 0; planeCount < 10; ++planeCount) {
-        // 收集未使用的点
-        std::vector<int> availableIndices;
-        for (size_t i = 0; i < points.size(); ++i) {
-            if (!used[i]) {
-                availableIndices.push_back(static_cast<int>(i));
+    if (m_planeDetectionMethod == PlaneDetectionMethod::EfficientRANSAC) {
+        // 一次检测全部平面（内点互不重叠），只保留垂直平面
+        EfficientRANSAC detector(m_parameters);
+        detector.setProgressCallback([this](int assignedPercentage) {
+            reportProgress(15 + assignedPercentage * 35 / 100, "高效RANSAC平面检测");
+        });
+        detector.setPlaneCallback([this](const Plane3D& plane) {
+            if (isVerticalPlane(plane)) {
+                reportPlane(plane);
+            }
+        });
+        detector.setCancellationCallback(m_cancellationCallback);
+        std::vector<Plane3D> detected = detector.detect(points);
+        for (Plane3D& plane : detected) {
+            if (isVerticalPlane(plane)) {
+                qDebug() << "检测到垂直平面，内点数:" << plane.inlierIndices.size();
+                planes.push_back(std::move(plane));
             }
         }
-
-        if (availableIndices.size() < m_parameters.minPoints) {
-            break;
+        QVariantMap statistics = detector.getStatistics();
+        qDebug() << "高效RANSAC：候选数" << statistics.value("candidates_generated").toULongLong()
+                 << "平面数" << statistics.value("planes_detected").toInt()
+                 << "未分配点数" << statistics.value("remaining_points").toULongLong();
+    } else if (m_planeDetectionMethod == PlaneDetectionMethod::RegionGrowing) {
+        RegionGrowingSegmenter segmenter(m_parameters);
+        segmenter.setProgressCallback([this](int percentage) {
+            reportProgress(15 + percentage * 35 / 100, "区域生长平面分割");
+        });
+        segmenter.setCancellationCallback(m_cancellationCallback);
+        std::vector<Plane3D> segmented = segmenter.segment(points);
+        for (Plane3D& plane : segmented) {
+            if (isVerticalPlane(plane)) {
+                qDebug() << "检测到垂直平面，内点数:" << plane.inlierIndices.size();
+                reportPlane(plane);
+                planes.push_back(std::move(plane));
+            }
         }
+        QVariantMap statistics = segmenter.getStatistics();
+        qDebug() << "区域生长：种子点数" << statistics.value("seed_points").toULongLong()
+                 << "区域数" << statistics.value("regions_detected").toInt()
+                 << "未分配点数" << statistics.value("unassigned_points").toULongLong();
+    } else {
+        // 逐个平面检测：已检测平面（含非垂直平面）的内点从剩余点中移除，直到找不到足够大的平面
+        std::vector<bool> used(points.size(), false);
+        std::vector<int> availableIndices(points.size());
+        std::iota(availableIndices.begin(), availableIndices.end(), 0);
 
-        // 执行RANSAC
-        Plane3D plane = fitPlaneRANSAC(points, availableIndices);
+        while (availableIndices.size() >= static_cast<size_t>(m_parameters.minPoints) &&
+               !isCancellationRequested()) {
+            Plane3D plane = fitPlaneRANSAC(points, availableIndices);
 
-        if (plane.inlierIndices.size() < m_parameters.minPoints) {
-            break;
-        }
-
-        // 检查是否为垂直平面
-        if (isVerticalPlane(plane)) {
-            planes.push_back(plane);
+            if (plane.inlierIndices.size() < static_cast<size_t>(m_parameters.minPoints)) {
+                break;
+            }
 
-            // 标记已使用的点
             for (int idx : plane.inlierIndices) {
                 used[idx] = true;
             }
+            availableIndices.erase(std::remove_if(availableIndices.begin(), availableIndices.end(),
+                                                  [&used](int idx) { return used[idx]; }),
+                                   availableIndices.end());
+
+            if (isVerticalPlane(plane)) {
+                qDebug() << "检测到垂直平面，内点数:" << plane.inlierIndices.size();
+                reportPlane(plane);
+                planes.push_back(std::move(plane));
+            }
 
-            qDebug() << "检测到垂直平面，内点数:" << plane.inlierIndices.size();
+            int assigned = static_cast<int>(points.size() - availableIndices.size());
+            reportProgress(15 + static_cast<int>(35LL * assigned / static_cast<qint64>(points.size())),
+                           "平面检测");
         }
-
-        updateProgress(planeCount + 1, 10, "平面检测");
     }
 
     // 过滤和聚类平面
     filterVerticalPlanes(planes);
-    clusterPlanes(planes);
+    clusterPlanes(planes, points);
+    pairWallFaces(planes, points);
 
     qDebug() << "平面检测完成，共检测到" << planes.size() << "个垂直平面";
     return planes;
 }
 
 // RANSAC平面拟合核心算法
+//
+// 假设按批生成后并行评估，每个假设只计数不收集内点：
+// 1. 预检验：先在固定随机子集上计数，子集计数的置信上界不足以超过当前最优时直接淘汰；
+// 2. 全量计数：只扫描indices，剩余点全部计入也无法超过当前最优时提前终止；
+// 3. 每批结束后按当前内点率和probability更新所需迭代次数；
+// 4. 只为最终胜出的平面收集内点。
 Plane3D WallFittingAlgorithm::fitPlaneRANSAC(const std::vector<QVector3D>& points,
                                              const std::vector<int>& indices)
 {
     Plane3D bestPlane;
-    int bestInlierCount = 0;
+    const size_t indexCount = indices.size();
+    if (indexCount < 3) {
+        return bestPlane;
+    }
+
+    struct Hypothesis {
+        QVector3D normal;
+        float distance;
+        size_t inlierCount;
+    };
+
+    const float threshold = m_parameters.epsilon;
+    auto countInliers = [&points, &indices, threshold](const Hypothesis& h, size_t begin, size_t end,
+                                                        size_t mustReach) {
+        // mustReach > 0 时，剩余点全部计入也达不到mustReach就提前返回
+        size_t count = 0;
+        for (size_t i = begin; i < end; ++i) {
+            const QVector3D& p = points[indices[i]];
+            if (std::fabs(QVector3D::dotProduct(h.normal, p) - h.distance) <= threshold) {
+                ++count;
+            } else if (mustReach > 0 && count + (end - i - 1) < mustReach) {
+                return count;
+            }
+        }
+        return count;
+    };
 
     std::random_device rd;
     std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(0, static_cast<int>(indices.size()) - 1);
-
-    for (int iter = 0; iter < m_parameters.maxIterations; ++iter) {
-        // 随机选择3个点
-        if (indices.size() < 3) break;
-
-        int idx1 = indices[dis(gen)];
-        int idx2 = indices[dis(gen)];
-        int idx3 = indices[dis(gen)];
-
-        if (idx1 == idx2 || idx1 == idx3 || idx2 == idx3) {
-            continue;
+    std::uniform_int_distribution<size_t> dis(0, indexCount - 1);
+
+    // 预检验子集：随机抽取后排序去重，按内存顺序访问，不复制点
+    const size_t preTestSize = std::min(indexCount, kRansacPreTestSize);
+    std::vector<int> preTestIndices;
+    if (preTestSize < indexCount) {
+        preTestIndices.reserve(preTestSize);
+        std::vector<size_t> picked;
+        picked.reserve(preTestSize);
+        for (size_t i = 0; i < preTestSize; ++i) {
+            picked.push_back(dis(gen));
         }
+        std::sort(picked.begin(), picked.end());
+        picked.erase(std::unique(picked.begin(), picked.end()), picked.end());
+        for (size_t i : picked) {
+            preTestIndices.push_back(indices[i]);
+        }
+    }
 
-        QVector3D p1 = points[idx1];
-        QVector3D p2 = points[idx2];
-        QVector3D p3 = points[idx3];
-
-        // 计算平面法向量
-        QVector3D v1 = p2 - p1;
-        QVector3D v2 = p3 - p1;
-        QVector3D normal = QVector3D::crossProduct(v1, v2).normalized();
+    const int maxIterations = std::max(1, m_parameters.maxIterations);
+    const double logFailure = std::log(1.0 - std::clamp(static_cast<double>(m_parameters.probability), 0.5, 0.999999));
+    const size_t batchSize = parallelThreadCount() * kRansacHypothesesPerThread;
+    // 每段至少处理约kRansacMinPointTestsPerRange次点测试，避免小点集时线程开销占主导
+    const size_t minHypothesesPerRange = std::max<size_t>(1, kRansacMinPointTestsPerRange / indexCount);
+
+    Hypothesis best{QVector3D(), 0.0f, 0};
+    int requiredIterations = maxIterations;
+    int iterations = 0;
+    int attempts = 0;
+    std::vector<Hypothesis> batch;
+    batch.reserve(batchSize);
+
+    while (iterations < requiredIterations && attempts < maxIterations * 4 && !isCancellationRequested()) {
+        // 生成一批非退化假设（随机数在调用线程中顺序生成）
+        batch.clear();
+        while (batch.size() < batchSize && iterations + static_cast<int>(batch.size()) < requiredIterations &&
+               attempts < maxIterations * 4) {
+            ++attempts;
+            size_t i1 = dis(gen);
+            size_t i2 = dis(gen);
+            size_t i3 = dis(gen);
+            if (i1 == i2 || i1 == i3 || i2 == i3) {
+                continue;
+            }
 
-        if (normal.length() < 0.1f) {
-            continue; // 三点共线
+            const QVector3D& p1 = points[indices[i1]];
+            QVector3D normal = QVector3D::crossProduct(points[indices[i2]] - p1, points[indices[i3]] - p1);
+            if (normal.length() < 1e-6f) {
+                continue; // 三点共线
+            }
+            normal.normalize();
+            batch.push_back({normal, QVector3D::dotProduct(normal, p1), 0});
+        }
+        if (batch.empty()) {
+            break;
         }
 
-        // 创建候选平面
-        Plane3D candidatePlane;
-        candidatePlane.point = p1;
-        candidatePlane.normal = normal;
-        candidatePlane.distance = QVector3D::dotProduct(normal, p1);
+        // 并行评估：批内共享批开始时的最优计数作为淘汰门槛
+        const size_t bestCount = best.inlierCount;
+        const size_t preTestThreshold = preTestIndices.empty() ? 0 :
+            static_cast<size_t>(static_cast<double>(bestCount) * preTestIndices.size() / indexCount);
+        parallelForRange(0, batch.size(), [&](size_t begin, size_t end, size_t) {
+            for (size_t h = begin; h < end; ++h) {
+                Hypothesis& hypothesis = batch[h];
+                if (!preTestIndices.empty() && bestCount > 0) {
+                    size_t subsetCount = 0;
+                    for (int idx : preTestIndices) {
+                        const QVector3D& p = points[idx];
+                        if (std::fabs(QVector3D::dotProduct(hypothesis.normal, p) - hypothesis.distance) <= threshold) {
+                            ++subsetCount;
+                        }
+                    }
+                    // 子集计数加3倍标准差仍不及最优的期望子集计数，判定为劣假设
+                    double upperBound = subsetCount + 3.0 * std::sqrt(static_cast<double>(subsetCount)) + 1.0;
+                    if (upperBound < static_cast<double>(preTestThreshold)) {
+                        hypothesis.inlierCount = 0;
+                        continue;
+                    }
+                }
+                hypothesis.inlierCount = countInliers(hypothesis, 0, indexCount, bestCount + 1);
+            }
+        }, minHypothesesPerRange);
 
-        // 查找内点
-        std::vector<int> inliers = findPlaneInliers(points, candidatePlane, m_parameters.epsilon);
+        iterations += static_cast<int>(batch.size());
+        for (const Hypothesis& hypothesis : batch) {
+            if (hypothesis.inlierCount > best.inlierCount) {
+                best = hypothesis;
+            }
+        }
 
-        if (inliers.size() > bestInlierCount) {
-            bestInlierCount = static_cast<int>(inliers.size());
-            bestPlane = candidatePlane;
-            bestPlane.inlierIndices = inliers;
+        // 自适应迭代次数：k = log(1-p) / log(1-w^3)
+        if (best.inlierCount > 0) {
+            double inlierRatio = static_cast<double>(best.inlierCount) / indexCount;
+            double sampleSuccess = inlierRatio * inlierRatio * inlierRatio;
+            if (sampleSuccess >= 1.0 - 1e-12) {
+                requiredIterations = iterations;
+            } else if (sampleSuccess > 0.0) {
+                double needed = logFailure / std::log(1.0 - sampleSuccess);
+                requiredIterations = static_cast<int>(std::min<double>(maxIterations, std::ceil(needed)));
+            }
         }
 
         // 早期终止条件
-        if (bestInlierCount > points.size() * 0.8) {
+        if (best.inlierCount > indexCount * 0.8) {
             break;
         }
     }
 
-    // 精化最佳平面
-    if (bestInlierCount >= m_parameters.minPoints) {
-        bestPlane = refinePlane(points, bestPlane.inlierIndices);
-        bestPlane.confidence = static_cast<float>(bestInlierCount) / points.size();
+    m_totalIterations += iterations;
+
+    // 仅为最优平面收集内点并精化
+    if (best.inlierCount >= static_cast<size_t>(m_parameters.minPoints)) {
+        Plane3D winner;
+        winner.point = best.normal * best.distance;
+        winner.normal = best.normal;
+        winner.distance = best.distance;
+
+        std::vector<int> inliers = findPlaneInliers(points, indices, winner, threshold);
+        bestPlane = refinePlane(points, inliers);
+        bestPlane.confidence = static_cast<float>(inliers.size()) / indexCount;
     }
 
     return bestPlane;
@@ -401,28 +906,49 @@ std::vector<int> WallFittingAlgorithm::findPlaneInliers(const std::vector<QVecto
     return inliers;
 }
 
+// 在索引子集中查找平面内点（分段并行，结果保持indices顺序）
+std::vector<int> WallFittingAlgorithm::findPlaneInliers(const std::vector<QVector3D>& points,
+                                                       const std::vector<int>& indices,
+                                                       const Plane3D& plane, float threshold)
+{
+    std::vector<std::vector<int>> rangeInliers(parallelRangeCount(indices.size()));
+    parallelForRange(0, indices.size(), [&](size_t begin, size_t end, size_t range) {
+        std::vector<int>& local = rangeInliers[range];
+        for (size_t i = begin; i < end; ++i) {
+            if (plane.containsPoint(points[indices[i]], threshold)) {
+                local.push_back(indices[i]);
+            }
+        }
+    });
+
+    size_t total = 0;
+    for (const auto& local : rangeInliers) {
+        total += local.size();
+    }
+    std::vector<int> inliers;
+    inliers.reserve(total);
+    for (const auto& local : rangeInliers) {
+        inliers.insert(inliers.end(), local.begin(), local.end());
+    }
+    return inliers;
+}
+
 // 精化平面参数
 Plane3D WallFittingAlgorithm::refinePlane(const std::vector<QVector3D>& points,
                                           const std::vector<int>& inliers)
 {
-    if (inliers.size() < 3) {
+    // 协方差最小二乘拟合（可选鲁棒重加权），与内点顺序无关
+    PlaneFitOptions options;
+    options.robust = m_parameters.robustRefinement;
+    PlaneFitResult fit = fitPlaneLeastSquares(points, inliers, options);
+    if (!fit.valid) {
         return Plane3D();
     }
 
-    // 计算质心
-    QVector3D centroid = QVector3D(0, 0, 0);
-    for (int idx : inliers) {
-        centroid += points[idx];
-    }
-    centroid /= static_cast<float>(inliers.size());
-
-    // 计算协方差矩阵的特征向量（简化实现）
-    QVector3D normal = calculateNormal(points);
-
     Plane3D refinedPlane;
-    refinedPlane.point = centroid;
-    refinedPlane.normal = normal.normalized();
-    refinedPlane.distance = QVector3D::dotProduct(refinedPlane.normal, centroid);
+    refinedPlane.point = fit.centroid;
+    refinedPlane.normal = fit.normal;
+    refinedPlane.distance = QVector3D::dotProduct(refinedPlane.normal, fit.centroid);
     refinedPlane.inlierIndices = inliers;
 
     return refinedPlane;
@@ -436,66 +962,70 @@ std::vector<WallSegment> WallFittingAlgorithm::extractWallsFromPlanes(const std:
 
     reportProgress(65, "从平面构建墙面");
 
-    for (size_t i = 0; i < planes.size(); ++i) {
-        const Plane3D& plane = planes[i];
-
-        WallSegment wall = buildWallFromPlane(plane, points);
-
-        if (wall.length() >= m_parameters.minWallLength) {
-            wall.id = static_cast<int>(walls.size());
-            walls.push_back(wall);
+    // 各平面相互独立，并行构建墙面和估计墙厚（工作线程中不发射信号）
+    std::vector<WallSegment> planeWalls(planes.size());
+    parallelFor(0, planes.size(), [&](size_t i) {
+        if (!isCancellationRequested()) {
+            planeWalls[i] = buildWallFromPlane(planes[i], points);
         }
+    }, 1);
 
-        updateProgress(static_cast<int>(i + 1), static_cast<int>(planes.size()), "构建墙面");
+    for (size_t i = 0; i < planeWalls.size(); ++i) {
+        if (planeWalls[i].length() >= m_parameters.minWallLength) {
+            planeWalls[i].id = static_cast<int>(walls.size());
+            walls.push_back(std::move(planeWalls[i]));
+        }
     }
+    updateProgress(static_cast<int>(planes.size()), static_cast<int>(planes.size()), "构建墙面");
 
     return walls;
 }
 
 // 从平面构建墙面
 WallSegment WallFittingAlgorithm::buildWallFromPlane(const Plane3D& plane,
-                                                    const std::vector<QVector3D>& points)
+                                                    const std::vector<QVector3D>& points,
+                                                    IndexSpan thicknessIndices)
 {
     WallSegment wall;
 
-    // 收集平面上的点
-    std::vector<QVector3D> planePoints;
-    for (int idx : plane.inlierIndices) {
-        planePoints.push_back(points[idx]);
-        wall.supportingPoints.push_back(points[idx]);
-    }
-
-    if (planePoints.empty()) {
+    if (plane.inlierIndices.empty()) {
         return wall;
     }
 
+    // 只记录支撑点索引，边界直接按索引读取点云
+    wall.inlierIndices = plane.inlierIndices;
+
     // 计算墙面边界
-    calculateWallBoundaries(wall, planePoints);
+    calculateWallBoundaries(wall, points, IndexSpan(wall.inlierIndices));
 
     // 设置墙面属性
     wall.normal = plane.normal;
     wall.confidence = plane.confidence;
 
-    // 估算墙面厚度
-    estimateWallThickness(wall, points);
+    // 估算墙面厚度（直接按索引读取点云，默认使用平面内点）
+    estimateWallThickness(wall, plane, points,
+                          thicknessIndices.empty() ? IndexSpan(plane.inlierIndices) : thicknessIndices);
 
     return wall;
 }
 
 // 计算墙面边界
 void WallFittingAlgorithm::calculateWallBoundaries(WallSegment& wall,
-                                                  const std::vector<QVector3D>& points)
+                                                  const std::vector<QVector3D>& points,
+                                                  IndexSpan indices)
 {
-    if (points.empty()) {
+    if (indices.empty()) {
         return;
     }
 
     // 简化实现：找到X-Y平面上的边界点
-    float minX = points[0].x(), maxX = points[0].x();
-    float minY = points[0].y(), maxY = points[0].y();
-    float minZ = points[0].z(), maxZ = points[0].z();
+    const QVector3D& first = points[indices.data[0]];
+    float minX = first.x(), maxX = first.x();
+    float minY = first.y(), maxY = first.y();
+    float minZ = first.z(), maxZ = first.z();
 
-    for (const QVector3D& point : points) {
+    for (int idx : indices) {
+        const QVector3D& point = points[idx];
         minX = qMin(minX, point.x());
         maxX = qMax(maxX, point.x());
         minY = qMin(minY, point.y());
@@ -523,13 +1053,34 @@ void WallFittingAlgorithm::calculateWallBoundaries(WallSegment& wall,
 
 // 估算墙面厚度
 void WallFittingAlgorithm::estimateWallThickness(WallSegment& wall,
-                                                const std::vector<QVector3D>& points)
+                                                const Plane3D& plane,
+                                                const std::vector<QVector3D>& points,
+                                                IndexSpan indices)
 {
-    // 简化实现：使用固定厚度
-    wall.thickness = 0.2f; // 20cm
+    WallThicknessOptions options;
+    options.maxThickness = m_parameters.maxWallThickness;
+    options.minFaceSeparation = m_parameters.epsilon;
 
-    // 在实际应用中，可以通过分析点云密度和分布来估算厚度
-    Q_UNUSED(points)
+    QVector3D normal(plane.normal.x(), plane.normal.y(), 0.0f);
+    if (normal.length() < 1e-6f) {
+        wall.thickness = options.defaultThickness;
+        return;
+    }
+    normal.normalize();
+
+    const WallThicknessEstimate estimate =
+        WallExtraction::estimateWallThickness(points, indices, plane.point, normal, options);
+    wall.thickness = estimate.thickness;
+
+    // 检测到两个表面时，墙面中线移到两个表面中间
+    if (estimate.doubleSided) {
+        auto moveToCenter = [&](QVector3D& point) {
+            const float offset = QVector3D::dotProduct(normal, point - plane.point);
+            point += normal * (estimate.centerOffset - offset);
+        };
+        moveToCenter(wall.startPoint);
+        moveToCenter(wall.endPoint);
+    }
 }
 
 // 基于用户线段的墙面拟合
@@ -540,73 +1091,158 @@ std::vector<WallSegment> WallFittingAlgorithm::fitWallsAlongLines(const std::vec
 
     reportProgress(20, "基于用户线段拟合墙面");
 
-    for (size_t i = 0; i < userLines.size(); ++i) {
-        const LineSegment& line = userLines[i];
-
-        // 查找线段附近的点
-        std::vector<QVector3D> nearbyPoints = findPointsNearLine(points, line, 2.0f);
+    // XY栅格索引只建一次，每条线段的走廊查询只访问附近的单元
+    PointGrid2D grid(points);
 
-        if (nearbyPoints.size() < m_parameters.minPoints) {
-            continue;
+    // 各线段相互独立，并行拟合（工作线程中不发射信号）
+    std::vector<WallSegment> lineWalls(userLines.size());
+    std::vector<char> fitted(userLines.size(), 0);
+    parallelFor(0, userLines.size(), [&](size_t i) {
+        if (isCancellationRequested()) {
+            return;
         }
+        const LineSegment& line = userLines[i];
+        fitted[i] = fitWallAlongLine(points, line, findLineCorridor(grid, line), lineWalls[i]) ? 1 : 0;
+    }, 1);
 
-        // 拟合平面
-        Plane3D plane = fitPlaneToLineAndPoints(line, nearbyPoints);
-
-        if (plane.inlierIndices.size() >= m_parameters.minPoints && isVerticalPlane(plane)) {
-            WallSegment wall = buildWallFromPlane(plane, points);
-            wall.sourceLineIds.push_back(line.id);
-            wall.id = static_cast<int>(walls.size());
-            walls.push_back(wall);
+    for (size_t i = 0; i < userLines.size(); ++i) {
+        if (fitted[i]) {
+            lineWalls[i].id = static_cast<int>(walls.size());
+            walls.push_back(std::move(lineWalls[i]));
         }
-
-        updateProgress(static_cast<int>(i + 1), static_cast<int>(userLines.size()), "线段拟合");
     }
 
+    updateProgress(static_cast<int>(userLines.size()), static_cast<int>(userLines.size()), "线段拟合");
     return walls;
 }
 
-// 查找线段附近的点
-std::vector<QVector3D> WallFittingAlgorithm::findPointsNearLine(const std::vector<QVector3D>& points,
-                                                               const LineSegment& line,
-                                                               float searchRadius)
+// 线段走廊内的点索引
+std::vector<int> WallFittingAlgorithm::findLineCorridor(const PointGrid2D& grid, const LineSegment& line)
+{
+    return findPointsNearLine(grid, line, kLineSearchRadius);
+}
+
+// 单条线段的墙面拟合：走廊内点数不足、内点不足或平面不垂直时返回false
+bool WallFittingAlgorithm::fitWallAlongLine(const std::vector<QVector3D>& points,
+                                            const LineSegment& line,
+                                            const std::vector<int>& corridorIndices,
+                                            WallSegment& wall)
 {
-    std::vector<QVector3D> nearbyPoints;
+    const size_t minPoints = static_cast<size_t>(qMax(3, m_parameters.minPoints));
+    if (corridorIndices.size() < minPoints) {
+        return false;
+    }
 
-    QVector3D lineStart = line.startPoint;
-    QVector3D lineEnd = line.endPoint;
-    QVector3D lineDir = (lineEnd - lineStart).normalized();
+    // 拟合平面
+    Plane3D plane = fitPlaneToLineAndPoints(points, line, corridorIndices);
+    if (plane.inlierIndices.size() < minPoints || !isVerticalPlane(plane)) {
+        return false;
+    }
 
-    for (const QVector3D& point : points) {
-        // 计算点到线段的距离
-        QVector3D toPoint = point - lineStart;
-        float projection = QVector3D::dotProduct(toPoint, lineDir);
+    // 走廊覆盖线段两侧，墙厚由走廊内的点估计
+    wall = buildWallFromPlane(plane, points, corridorIndices);
+    wall.sourceLineIds.push_back(line.id);
+    return true;
+}
 
-        QVector3D closestPoint;
-        if (projection < 0) {
-            closestPoint = lineStart;
-        } else if (projection > lineStart.distanceToPoint(lineEnd)) {
-            closestPoint = lineEnd;
-        } else {
-            closestPoint = lineStart + lineDir * projection;
+// 线段交汇处的墙面求交
+void WallFittingAlgorithm::joinWallsAtLineJunctions(std::vector<WallSegment>& walls,
+                                                    const std::vector<LineSegment>& lines)
+{
+    // 每面墙来自一条线段，按线段ID顺序与邻居求交，和增量拟合的结果一致
+    std::map<int, size_t> wallByLine;
+    for (size_t i = 0; i < walls.size(); ++i) {
+        if (walls[i].sourceLineIds.size() == 1) {
+            wallByLine[walls[i].sourceLineIds.front()] = i;
         }
+    }
+    std::unordered_map<int, const LineSegment*> lineById;
+    for (const LineSegment& line : lines) {
+        lineById[line.id] = &line;
+    }
 
-        float distance = point.distanceToPoint(closestPoint);
-        if (distance <= searchRadius) {
-            nearbyPoints.push_back(point);
+    // 线段通常只有数百条，两两检查即可
+    const std::vector<WallSegment> rawWalls = walls;
+    QVector2D junction;
+    for (const auto& item : wallByLine) {
+        const auto line = lineById.find(item.first);
+        if (line == lineById.end()) {
+            continue;
+        }
+        for (const auto& neighbor : wallByLine) {
+            const auto neighborLine = lineById.find(neighbor.first);
+            if (neighbor.first != item.first && neighborLine != lineById.end() &&
+                findLineJunction(*line->second, *neighborLine->second, junction)) {
+                joinWallEnd(walls[item.second], rawWalls[neighbor.second], junction);
+            }
         }
     }
+}
+
+// 两条线段的公共端点（XY投影）
+bool WallFittingAlgorithm::findLineJunction(const LineSegment& a, const LineSegment& b, QVector2D& junction)
+{
+    const QVector2D aEnds[2] = {QVector2D(a.startPoint.x(), a.startPoint.y()),
+                                QVector2D(a.endPoint.x(), a.endPoint.y())};
+    const QVector2D bEnds[2] = {QVector2D(b.startPoint.x(), b.startPoint.y()),
+                                QVector2D(b.endPoint.x(), b.endPoint.y())};
+    for (const QVector2D& p : aEnds) {
+        for (const QVector2D& q : bEnds) {
+            if ((p - q).length() <= kJunctionTolerance) {
+                junction = (p + q) * 0.5f;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// 把墙面靠近交汇点的一端移到两墙面中线（XY投影）的交点，高度不变；
+// 近似平行或交点离交汇点超过走廊半径时不动
+void WallFittingAlgorithm::joinWallEnd(WallSegment& wall, const WallSegment& other, const QVector2D& junction)
+{
+    const QVector2D p(wall.startPoint.x(), wall.startPoint.y());
+    const QVector2D d = QVector2D(wall.endPoint.x(), wall.endPoint.y()) - p;
+    const QVector2D q(other.startPoint.x(), other.startPoint.y());
+    const QVector2D e = QVector2D(other.endPoint.x(), other.endPoint.y()) - q;
+    const float cross = d.x() * e.y() - d.y() * e.x();
+    if (std::fabs(cross) <= kMinJoinSine * d.length() * e.length()) {
+        return;
+    }
+
+    const QVector2D w = q - p;
+    const QVector2D intersection = p + d * ((w.x() * e.y() - w.y() * e.x()) / cross);
+    if ((intersection - junction).length() > kLineSearchRadius) {
+        return;
+    }
 
-    return nearbyPoints;
+    QVector3D& end = (p - junction).lengthSquared() <=
+                             (QVector2D(wall.endPoint.x(), wall.endPoint.y()) - junction).lengthSquared()
+                         ? wall.startPoint : wall.endPoint;
+    end.setX(intersection.x());
+    end.setY(intersection.y());
+}
+
+// 查找线段附近的点：XY投影落在线段两侧searchRadius以内、两端各延伸searchRadius的矩形中
+std::vector<int> WallFittingAlgorithm::findPointsNearLine(const PointGrid2D& grid,
+                                                         const LineSegment& line,
+                                                         float searchRadius)
+{
+    std::vector<quint32> found;
+    grid.corridorSearch(QVector2D(line.startPoint.x(), line.startPoint.y()),
+                        QVector2D(line.endPoint.x(), line.endPoint.y()),
+                        searchRadius, searchRadius, found);
+    return std::vector<int>(found.begin(), found.end());
 }
 
 // 基于线段和点拟合平面
-Plane3D WallFittingAlgorithm::fitPlaneToLineAndPoints(const LineSegment& line,
-                                                     const std::vector<QVector3D>& nearbyPoints)
+Plane3D WallFittingAlgorithm::fitPlaneToLineAndPoints(const std::vector<QVector3D>& points,
+                                                     const LineSegment& line,
+                                                     const std::vector<int>& nearbyIndices)
 {
     Plane3D plane;
 
-    if (nearbyPoints.size() < 3) {
+    if (nearbyIndices.size() < 3) {
         return plane;
     }
 
@@ -619,16 +1255,36 @@ Plane3D WallFittingAlgorithm::fitPlaneToLineAndPoints(const LineSegment& line,
     plane.normal = normal;
     plane.distance = QVector3D::dotProduct(normal, line.startPoint);
 
-    // 查找内点
-    plane.inlierIndices = findPlaneInliers(nearbyPoints, plane, m_parameters.epsilon);
-    plane.confidence = static_cast<float>(plane.inlierIndices.size()) / nearbyPoints.size();
+    // 查找内点（调用方已按线段并行，这里串行筛选）
+    auto collectInliers = [&](Plane3D& target) {
+        target.inlierIndices.clear();
+        for (int idx : nearbyIndices) {
+            if (target.containsPoint(points[idx], m_parameters.epsilon)) {
+                target.inlierIndices.push_back(idx);
+            }
+        }
+    };
+    collectInliers(plane);
+
+    // 用内点最小二乘精化平面，法向朝向与线段平面一致，再按精化后的平面重新收集内点
+    PlaneFitOptions options;
+    options.robust = m_parameters.robustRefinement;
+    PlaneFitResult fit = fitPlaneLeastSquares(points, plane.inlierIndices, options);
+    if (fit.valid) {
+        plane.point = fit.centroid;
+        plane.normal = QVector3D::dotProduct(fit.normal, normal) < 0.0f ? -fit.normal : fit.normal;
+        plane.distance = QVector3D::dotProduct(plane.normal, plane.point);
+        collectInliers(plane);
+    }
+    plane.confidence = static_cast<float>(plane.inlierIndices.size()) / nearbyIndices.size();
 
     return plane;
 }
 
 // 几何优化
-void WallFittingAlgorithm::optimizeWallGeometry(std::vector<WallSegment>& walls)
+void WallFittingAlgorithm::optimizeWallGeometry(std::vector<WallSegment>& walls, bool regularize)
 {
+    m_lastRegularization = WallRegularizationResult();
     if (walls.empty()) {
         return;
     }
@@ -638,60 +1294,94 @@ void WallFittingAlgorithm::optimizeWallGeometry(std::vector<WallSegment>& walls)
     // 合并平行墙面
     mergeParallelWalls(walls);
 
-    // 规则化墙面交点
-    regularizeWallIntersections(walls);
+    // 主方向规则化和墙面交点
+    if (regularize) {
+        regularizeWallIntersections(walls);
+    }
 
     qDebug() << "墙面几何优化完成";
 }
 
 void WallFittingAlgorithm::mergeParallelWalls(std::vector<WallSegment>& walls, float angleThreshold)
 {
-    // 简化实现：标记需要合并的墙面
-    std::vector<bool> toRemove(walls.size(), false);
+    if (walls.size() < 2) {
+        return;
+    }
 
+    // 按(θ, 起点XY)分桶，只比较相邻单元中的墙面
+    std::vector<OrientedKey> keys(walls.size());
     for (size_t i = 0; i < walls.size(); ++i) {
-        if (toRemove[i]) continue;
-
-        for (size_t j = i + 1; j < walls.size(); ++j) {
-            if (toRemove[j]) continue;
-
-            // 检查是否平行
-            float angle = qRadiansToDegrees(qAcos(qAbs(QVector3D::dotProduct(
-                walls[i].normal, walls[j].normal))));
-
-            if (angle < angleThreshold) {
-                // 检查距离是否足够近
-                float distance = walls[i].startPoint.distanceToPoint(walls[j].startPoint);
-                if (distance < 1.0f) {
-                    // 合并墙面（简化：保留第一个，标记第二个删除）
-                    walls[i].supportingPoints.insert(walls[i].supportingPoints.end(),
-                                                    walls[j].supportingPoints.begin(),
-                                                    walls[j].supportingPoints.end());
-                    toRemove[j] = true;
-                }
+        QVector3D canonical;
+        keys[i].theta = canonicalOrientation(walls[i].normal, canonical);
+        keys[i].u = walls[i].startPoint.x();
+        keys[i].v = walls[i].startPoint.y();
+    }
+
+    const float cosThreshold = qCos(qDegreesToRadians(angleThreshold));
+    const std::vector<quint32> roots = clusterOrientedKeys(
+        keys, qDegreesToRadians(angleThreshold) * kOrientationCellScale,
+        kWallMergeDistance, kWallMergeDistance, false,
+        [&walls, cosThreshold](size_t i, size_t j) {
+            return qAbs(QVector3D::dotProduct(walls[i].normal, walls[j].normal)) > cosThreshold &&
+                   walls[i].startPoint.distanceToPoint(walls[j].startPoint) < kWallMergeDistance;
+        });
+
+    // 合并后的墙面保留簇内全部来源线段（mergeClusters按根的下标顺序输出）
+    std::map<quint32, std::vector<int>> sourceLines;
+    for (size_t i = 0; i < walls.size(); ++i) {
+        std::vector<int>& ids = sourceLines[roots[i]];
+        ids.insert(ids.end(), walls[i].sourceLineIds.begin(), walls[i].sourceLineIds.end());
+    }
+
+    // 合并后的墙面沿代表墙面的方向覆盖簇内全部墙面的端点，高度取最大值
+    walls = mergeClusters(std::move(walls), roots, [](WallSegment& wall) -> std::vector<int>& {
+        return wall.inlierIndices;
+    }, [](WallSegment& wall, const std::vector<WallSegment>& items, const std::vector<quint32>& cluster) {
+        const QVector3D origin = wall.startPoint;
+        const QVector3D direction = QVector3D(wall.endPoint.x() - origin.x(),
+                                              wall.endPoint.y() - origin.y(), 0.0f).normalized();
+        if (direction.isNull()) {
+            return;
+        }
+
+        float low = 0.0f;
+        float high = QVector3D::dotProduct(direction, wall.endPoint - origin);
+        for (quint32 member : cluster) {
+            for (const QVector3D& endpoint : {items[member].startPoint, items[member].endPoint}) {
+                const float along = QVector3D::dotProduct(direction, endpoint - origin);
+                low = qMin(low, along);
+                high = qMax(high, along);
             }
+            wall.height = qMax(wall.height, items[member].height);
         }
+        wall.startPoint = origin + direction * low;
+        wall.endPoint = origin + direction * high;
+    });
+
+    auto ids = sourceLines.begin();
+    for (WallSegment& wall : walls) {
+        std::sort(ids->second.begin(), ids->second.end());
+        wall.sourceLineIds = std::move(ids->second);
+        ++ids;
     }
-
-    // 移除标记的墙面
-    walls.erase(std::remove_if(walls.begin(), walls.end(),
-                              [&toRemove, &walls](const WallSegment& wall) {
-                                  size_t index = &wall - &walls[0];
-                                  return index < toRemove.size() && toRemove[index];
-                              }), walls.end());
 }
 
 void WallFittingAlgorithm::regularizeWallIntersections(std::vector<WallSegment>& walls)
 {
-    // 简化实现：调整墙面端点以形成更好的交点
-    for (size_t i = 0; i < walls.size(); ++i) {
-        for (size_t j = i + 1; j < walls.size(); ++j) {
-            // 检查墙面是否相交
-            // 这里可以实现更复杂的交点计算和调整逻辑
-            Q_UNUSED(walls[i])
-            Q_UNUSED(walls[j])
-        }
+    QElapsedTimer timer;
+    timer.start();
+
+    m_lastRegularization = regularizeWalls(walls, m_regularizationOptions);
+
+    QStringList angles;
+    for (float angle : m_lastRegularization.dominantAngles) {
+        angles << QString::number(qRadiansToDegrees(angle), 'f', 2);
     }
+    qDebug() << "Wall regularization:" << "dominant angles" << angles.join(", ")
+             << "snapped" << m_lastRegularization.snappedWalls
+             << "coplanar groups" << m_lastRegularization.coplanarGroups
+             << "junctions" << m_lastRegularization.junctions
+             << "time" << timer.elapsed() << "ms";
 }
 
 // 静态工具方法
@@ -737,10 +1427,27 @@ QVector3D WallFittingAlgorithm::calculateNormal(const std::vector<QVector3D>& po
         return QVector3D(0, 0, 1);
     }
 
-    // 简化实现：使用前三个点计算法向量
-    QVector3D v1 = points[1] - points[0];
-    QVector3D v2 = points[2] - points[0];
-    return QVector3D::crossProduct(v1, v2).normalized();
+    // 协方差最小特征值方向，退化点集返回Z轴
+    PlaneFitResult fit = fitPlaneLeastSquares(points);
+    return fit.valid ? fit.normal : QVector3D(0, 0, 1);
+}
+
+void WallFittingAlgorithm::transformPlanesToWorld(std::vector<Plane3D>& planes) const
+{
+    for (Plane3D& plane : planes) {
+        plane.point = m_frameAlignment.toWorld(plane.point);
+        plane.normal = m_frameAlignment.directionToWorld(plane.normal);
+        plane.distance = QVector3D::dotProduct(plane.normal, plane.point);
+    }
+}
+
+void WallFittingAlgorithm::transformWallsToWorld(std::vector<WallSegment>& walls) const
+{
+    for (WallSegment& wall : walls) {
+        wall.startPoint = m_frameAlignment.toWorld(wall.startPoint);
+        wall.endPoint = m_frameAlignment.toWorld(wall.endPoint);
+        wall.normal = m_frameAlignment.directionToWorld(wall.normal);
+    }
 }
 
 // 数据验证方法
@@ -815,6 +1522,32 @@ bool WallFittingAlgorithm::validateResult(const WallFittingResult& result)
 }
 
 // 进度报告方法
+bool WallFittingAlgorithm::finishIfCancelled(WallFittingResult& result)
+{
+    if (!isCancellationRequested()) {
+        return false;
+    }
+    result.cancelled = true;
+    result.errorMessage = "墙面拟合已取消";
+    m_isProcessing = false;
+    qDebug() << "Wall fitting cancelled";
+    return true;
+}
+
+void WallFittingAlgorithm::reportPlane(const Plane3D& plane)
+{
+    std::vector<Plane3D> reported(1, plane);
+    if (m_detectingInAlignedFrame) {
+        transformPlanesToWorld(reported);
+    }
+
+    emit planeDetected(reported.front());
+
+    if (m_planeCallback) {
+        m_planeCallback(reported.front());
+    }
+}
+
 void WallFittingAlgorithm::reportProgress(int percentage, const QString& status)
 {
     emit progressChanged(percentage, status);
@@ -840,35 +1573,129 @@ void WallFittingAlgorithm::filterVerticalPlanes(std::vector<Plane3D>& planes)
                                }), planes.end());
 }
 
-void WallFittingAlgorithm::clusterPlanes(std::vector<Plane3D>& planes)
+void WallFittingAlgorithm::clusterPlanes(std::vector<Plane3D>& planes, const std::vector<QVector3D>& points)
 {
-    // 简化实现：按距离聚类相似平面
-    std::vector<bool> processed(planes.size(), false);
+    if (planes.size() < 2) {
+        return;
+    }
 
+    // 按(θ, d)分桶：d为平面沿规范法向的偏移，只比较相邻单元中的平面
+    std::vector<OrientedKey> keys(planes.size());
+    std::vector<QVector3D> canonicalNormals(planes.size());
     for (size_t i = 0; i < planes.size(); ++i) {
-        if (processed[i]) continue;
+        keys[i].theta = canonicalOrientation(planes[i].normal, canonicalNormals[i]);
+        keys[i].u = QVector3D::dotProduct(canonicalNormals[i], planes[i].point);
+        keys[i].v = 0.0f;
+    }
 
-        for (size_t j = i + 1; j < planes.size(); ++j) {
-            if (processed[j]) continue;
+    const std::vector<quint32> roots = clusterOrientedKeys(
+        keys, qDegreesToRadians(kPlaneClusterAngle) * kOrientationCellScale,
+        kPlaneClusterDistance, 0.0f, true,
+        [&planes, &keys, &canonicalNormals](size_t i, size_t j) {
+            if (!arePlanesParallel(planes[i], planes[j], kPlaneClusterAngle)) {
+                return false;
+            }
+            // 规范法向相反（θ跨越0/π）时偏移符号相反
+            const bool sameSide = QVector3D::dotProduct(canonicalNormals[i], canonicalNormals[j]) >= 0.0f;
+            const float gap = sameSide ? keys[i].u - keys[j].u : keys[i].u + keys[j].u;
+            return qAbs(gap) < kPlaneClusterDistance;
+        });
+
+    // 同一表面的碎片按合并后的内点重新拟合
+    PlaneFitOptions options;
+    options.robust = m_parameters.robustRefinement;
+    planes = mergeClusters(std::move(planes), roots, [](Plane3D& plane) -> std::vector<int>& {
+        return plane.inlierIndices;
+    }, [&points, &options](Plane3D& plane, const std::vector<Plane3D>&, const std::vector<quint32>&) {
+        refitMergedPlane(plane, points, options, kPlaneClusterAngle);
+    });
+}
 
-            if (arePlanesParallel(planes[i], planes[j], 5.0f) &&
-                calculatePlaneDistance(planes[i], planes[j]) < 0.5f) {
+void WallFittingAlgorithm::pairWallFaces(std::vector<Plane3D>& planes, const std::vector<QVector3D>& points)
+{
+    const float maxThickness = m_parameters.maxWallThickness;
+    if (planes.size() < 2 || maxThickness <= 0.0f) {
+        return;
+    }
 
-                // 合并平面
-                planes[i].inlierIndices.insert(planes[i].inlierIndices.end(),
-                                              planes[j].inlierIndices.begin(),
-                                              planes[j].inlierIndices.end());
-                processed[j] = true;
-            }
+    // 规范法向下的偏移，以及内点沿墙方向的投影范围
+    std::vector<OrientedKey> keys(planes.size());
+    std::vector<QVector3D> canonicalNormals(planes.size());
+    std::vector<std::pair<float, float>> extents(planes.size());
+    parallelFor(0, planes.size(), [&](size_t i) {
+        keys[i].theta = canonicalOrientation(planes[i].normal, canonicalNormals[i]);
+        keys[i].u = QVector3D::dotProduct(canonicalNormals[i], planes[i].point);
+        keys[i].v = 0.0f;
+
+        const QVector3D direction = QVector3D(-canonicalNormals[i].y(), canonicalNormals[i].x(), 0.0f).normalized();
+        float low = std::numeric_limits<float>::max();
+        float high = std::numeric_limits<float>::lowest();
+        for (int idx : planes[i].inlierIndices) {
+            const float along = QVector3D::dotProduct(direction, points[idx]);
+            low = qMin(low, along);
+            high = qMax(high, along);
+        }
+        extents[i] = std::make_pair(low, high);
+    }, 1);
+
+    // 平行、间距不超过最大墙厚且沿墙方向重叠的平面互为候选
+    struct FacePair {
+        float gap;
+        size_t first;
+        size_t second;
+    };
+    std::vector<FacePair> candidates;
+    forEachOrientedNeighbor(keys, qDegreesToRadians(kPlaneClusterAngle) * kOrientationCellScale,
+                            maxThickness, 0.0f, true, [&](size_t i, size_t j) {
+        if (!arePlanesParallel(planes[i], planes[j], kPlaneClusterAngle)) {
+            return;
+        }
+        // 规范法向相反（θ跨越0/π）时偏移和沿墙坐标的符号相反
+        const bool sameSide = QVector3D::dotProduct(canonicalNormals[i], canonicalNormals[j]) >= 0.0f;
+        const float gap = qAbs(sameSide ? keys[i].u - keys[j].u : keys[i].u + keys[j].u);
+        if (gap > maxThickness) {
+            return;
+        }
+        const float low = sameSide ? extents[j].first : -extents[j].second;
+        const float high = sameSide ? extents[j].second : -extents[j].first;
+        const float overlap = qMin(extents[i].second, high) - qMax(extents[i].first, low);
+        const float shorter = qMin(extents[i].second - extents[i].first, high - low);
+        if (shorter > 0.0f && overlap >= kMinFaceOverlap * shorter) {
+            candidates.push_back({gap, i, j});
         }
+    });
+
+    // 间距最小的候选优先，每个平面只配对一次
+    std::sort(candidates.begin(), candidates.end(), [](const FacePair& a, const FacePair& b) {
+        if (a.gap != b.gap) {
+            return a.gap < b.gap;
+        }
+        return a.first != b.first ? a.first < b.first : a.second < b.second;
+    });
+
+    std::vector<quint32> roots(planes.size());
+    std::iota(roots.begin(), roots.end(), 0u);
+    std::vector<char> paired(planes.size(), 0);
+    int pairCount = 0;
+    for (const FacePair& candidate : candidates) {
+        if (paired[candidate.first] || paired[candidate.second]) {
+            continue;
+        }
+        paired[candidate.first] = paired[candidate.second] = 1;
+        roots[candidate.second] = static_cast<quint32>(candidate.first);
+        ++pairCount;
+    }
+    if (pairCount == 0) {
+        return;
     }
 
-    // 移除已处理的平面
-    planes.erase(std::remove_if(planes.begin(), planes.end(),
-                               [&processed, &planes](const Plane3D& plane) {
-                                   size_t index = &plane - &planes[0];
-                                   return index < processed.size() && processed[index];
-                               }), planes.end());
+    // 两个表面的内点一起拟合得到墙体中面（不做鲁棒重加权，否则会收敛到其中一个表面）
+    planes = mergeClusters(std::move(planes), roots, [](Plane3D& plane) -> std::vector<int>& {
+        return plane.inlierIndices;
+    }, [&points](Plane3D& plane, const std::vector<Plane3D>&, const std::vector<quint32>&) {
+        refitMergedPlane(plane, points, PlaneFitOptions(), kPlaneClusterAngle);
+    });
+    qDebug() << "墙体两侧表面配对:" << pairCount << "对";
 }
 
 float WallFittingAlgorithm::calculateVariance(const std::vector<QVector3D>& points, const Plane3D& plane)
@@ -8,11 +8,16 @@
 #include <vector>
 #include <memory>
 #include <functional>
+#include "oriented_bounding_box.h"
+#include "coordinate_transform.h"
+#include "wall_regularization.h"
+#include "wall_thickness.h"
 
 namespace WallExtraction {
 
 // 前向声明
 struct LineSegment;
+class PointGrid2D;
 
 // 平面数据结构
 struct Plane3D {
@@ -39,7 +44,7 @@ struct WallSegment {
     QVector3D normal;                   // 墙面法向量
     float thickness;                    // 墙面厚度
     float height;                       // 墙面高度
-    std::vector<QVector3D> supportingPoints;  // 支撑点云
+    std::vector<int> inlierIndices;     // 支撑点在拟合点云中的索引
     std::vector<int> sourceLineIds;     // 来源线段ID
     float confidence;                   // 置信度
     QDateTime createdTime;              // 创建时间
@@ -66,6 +71,7 @@ struct RANSACParameters {
     int maxIterations;        // 最大迭代次数 (1000)
     float minWallLength;      // 最小墙面长度 (1.0m)
     float maxWallThickness;   // 最大墙面厚度 (0.5m)
+    bool robustRefinement;    // 平面精化时做IRLS/Tukey重加权 (true)
 
     RANSACParameters()
         : probability(0.99f)
@@ -77,9 +83,17 @@ struct RANSACParameters {
         , maxIterations(1000)
         , minWallLength(1.0f)
         , maxWallThickness(0.5f)
+        , robustRefinement(true)
     {}
 };
 
+// 平面检测方法
+enum class PlaneDetectionMethod {
+    SequentialRANSAC,   // 逐个平面重复RANSAC，每次在剩余点上重新拟合
+    EfficientRANSAC,    // 高效RANSAC：八叉树局部采样、法向一致性和连通性过滤，一次检测全部平面
+    RegionGrowing       // 区域生长：K近邻法向一致的点连通成区域，适合密集的室内扫描
+};
+
 // 墙面拟合结果
 struct WallFittingResult {
     std::vector<WallSegment> walls;     // 提取的墙面
@@ -89,7 +103,9 @@ struct WallFittingResult {
     int unassignedPoints;               // 未分配的点数
     float processingTime;               // 处理时间（秒）
     bool success;                       // 是否成功
+    bool cancelled;                     // 是否被取消（含超时）
     QString errorMessage;               // 错误信息
+    CoordinateOrigin coordinateOrigin;  // 坐标原点（墙面和平面坐标相对该原点，导出时加回）
 
     WallFittingResult()
         : totalPoints(0)
@@ -97,6 +113,7 @@ struct WallFittingResult {
         , unassignedPoints(0)
         , processingTime(0.0f)
         , success(false)
+        , cancelled(false)
     {}
 };
 
@@ -126,9 +143,34 @@ public:
     void setRANSACParameters(const RANSACParameters& params);
     RANSACParameters getRANSACParameters() const;
 
+    // 平面检测方法（默认高效RANSAC）
+    void setPlaneDetectionMethod(PlaneDetectionMethod method);
+    PlaneDetectionMethod getPlaneDetectionMethod() const;
+
     // 进度回调设置
     void setProgressCallback(std::function<void(int, const QString&)> callback);
 
+    // 平面回调：检测过程中每找到一个垂直平面调用一次（在执行拟合的线程中）
+    void setPlaneCallback(std::function<void(const Plane3D&)> callback);
+
+    // 协作式取消：回调返回true时在下一个检查点停止，结果标记为已取消（回调可能被多个线程同时调用）
+    void setCancellationCallback(std::function<bool()> callback);
+    bool isCancellationRequested() const;
+
+    // 主方向对齐：设置后在对齐坐标中拟合，结果变换回世界坐标
+    void setFrameAlignment(const DominantAxisAlignment& alignment);
+    DominantAxisAlignment getFrameAlignment() const;
+
+    // 坐标原点：输入点为相对原点的局部坐标，原点随结果返回供导出使用
+    void setCoordinateOrigin(const CoordinateOrigin& origin);
+    CoordinateOrigin getCoordinateOrigin() const;
+
+    // 墙面规则化：几何优化阶段把墙面吸附到主方向、对齐共面墙面并连接交点
+    // （基于用户线段的拟合仅在applyToLineFits开启时执行）
+    void setRegularizationOptions(const WallRegularizationOptions& options);
+    WallRegularizationOptions getRegularizationOptions() const;
+    WallRegularizationResult getLastRegularization() const;
+
     // 主要算法接口
     WallFittingResult fitWallsFromPointCloud(const std::vector<QVector3D>& points);
     WallFittingResult fitWallsFromLines(const std::vector<QVector3D>& points,
@@ -145,8 +187,22 @@ public:
     std::vector<WallSegment> fitWallsAlongLines(const std::vector<QVector3D>& points,
                                                const std::vector<LineSegment>& userLines);
 
+    // 单条线段的走廊查询和墙面拟合（不发射信号，可在工作线程调用，供增量拟合复用）
+    std::vector<int> findLineCorridor(const PointGrid2D& grid, const LineSegment& line);
+    bool fitWallAlongLine(const std::vector<QVector3D>& points,
+                          const LineSegment& line,
+                          const std::vector<int>& corridorIndices,
+                          WallSegment& wall);
+
+    // 线段交汇处的墙面求交：端点重合的线段，其墙面靠近交汇点的一端移到两墙面中线的交点
+    // （每面墙只与相邻墙面单独拟合的结果求交，与求交顺序无关，增量拟合按线段复用）
+    void joinWallsAtLineJunctions(std::vector<WallSegment>& walls,
+                                  const std::vector<LineSegment>& lines);
+    static bool findLineJunction(const LineSegment& a, const LineSegment& b, QVector2D& junction);
+    static void joinWallEnd(WallSegment& wall, const WallSegment& other, const QVector2D& junction);
+
     // 几何优化
-    void optimizeWallGeometry(std::vector<WallSegment>& walls);
+    void optimizeWallGeometry(std::vector<WallSegment>& walls, bool regularize = true);
     void mergeParallelWalls(std::vector<WallSegment>& walls, float angleThreshold = 5.0f);
     void regularizeWallIntersections(std::vector<WallSegment>& walls);
 
@@ -163,6 +219,7 @@ signals:
     // 结果信号
     void wallsDetected(const std::vector<WallSegment>& walls);
     void planesDetected(const std::vector<Plane3D>& planes);
+    void planeDetected(const Plane3D& plane);
 
     // 状态信号
     void processingStarted();
@@ -186,27 +243,40 @@ private:
                            const std::vector<int>& indices);
     std::vector<int> findPlaneInliers(const std::vector<QVector3D>& points,
                                      const Plane3D& plane, float threshold);
+    std::vector<int> findPlaneInliers(const std::vector<QVector3D>& points,
+                                     const std::vector<int>& indices,
+                                     const Plane3D& plane, float threshold);
 
     // 平面处理
     Plane3D refinePlane(const std::vector<QVector3D>& points,
                        const std::vector<int>& inliers);
     void filterVerticalPlanes(std::vector<Plane3D>& planes);
-    void clusterPlanes(std::vector<Plane3D>& planes);
+    void clusterPlanes(std::vector<Plane3D>& planes, const std::vector<QVector3D>& points);
+    void pairWallFaces(std::vector<Plane3D>& planes, const std::vector<QVector3D>& points);
 
     // 墙面构建
     WallSegment buildWallFromPlane(const Plane3D& plane,
-                                  const std::vector<QVector3D>& points);
+                                  const std::vector<QVector3D>& points,
+                                  IndexSpan thicknessIndices = IndexSpan());
     void calculateWallBoundaries(WallSegment& wall,
-                                const std::vector<QVector3D>& points);
+                                const std::vector<QVector3D>& points,
+                                IndexSpan indices);
     void estimateWallThickness(WallSegment& wall,
-                              const std::vector<QVector3D>& points);
-
-    // 基于线段的拟合
-    std::vector<QVector3D> findPointsNearLine(const std::vector<QVector3D>& points,
-                                             const LineSegment& line,
-                                             float searchRadius);
-    Plane3D fitPlaneToLineAndPoints(const LineSegment& line,
-                                   const std::vector<QVector3D>& nearbyPoints);
+                              const Plane3D& plane,
+                              const std::vector<QVector3D>& points,
+                              IndexSpan indices);
+
+    // 基于线段的拟合（走廊查询走XY栅格索引，返回点索引）
+    std::vector<int> findPointsNearLine(const PointGrid2D& grid,
+                                        const LineSegment& line,
+                                        float searchRadius);
+    Plane3D fitPlaneToLineAndPoints(const std::vector<QVector3D>& points,
+                                   const LineSegment& line,
+                                   const std::vector<int>& nearbyIndices);
+
+    // 对齐坐标到世界坐标的变换
+    void transformPlanesToWorld(std::vector<Plane3D>& planes) const;
+    void transformWallsToWorld(std::vector<WallSegment>& walls) const;
 
     // 几何计算辅助方法
     QVector3D calculateCentroid(const std::vector<QVector3D>& points);
@@ -218,7 +288,11 @@ private:
     bool validateUserLines(const std::vector<LineSegment>& lines);
     bool validateResult(const WallFittingResult& result);
 
+    // 取消检查：已请求取消时标记结果并结束处理
+    bool finishIfCancelled(WallFittingResult& result);
+
     // 进度报告
+    void reportPlane(const Plane3D& plane);
     void reportProgress(int percentage, const QString& status);
     void updateProgress(int currentStep, int totalSteps, const QString& operation);
 
@@ -228,9 +302,23 @@ private:
 
     // 算法参数
     RANSACParameters m_parameters;
+    PlaneDetectionMethod m_planeDetectionMethod;
 
     // 回调函数
     std::function<void(int, const QString&)> m_progressCallback;
+    std::function<void(const Plane3D&)> m_planeCallback;
+    std::function<bool()> m_cancellationCallback;
+
+    // 主方向对齐变换
+    DominantAxisAlignment m_frameAlignment;
+    bool m_detectingInAlignedFrame;     // 平面检测在对齐坐标中进行，逐个报告的平面需变换回世界坐标
+
+    // 点云坐标原点
+    CoordinateOrigin m_coordinateOrigin;
+
+    // 墙面规则化
+    WallRegularizationOptions m_regularizationOptions;
+    WallRegularizationResult m_lastRegularization;
 
     // 处理状态
     bool m_isProcessing;
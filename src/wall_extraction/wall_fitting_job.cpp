@@ -0,0 +1,214 @@
+#include "wall_fitting_job.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QMutexLocker>
+
+namespace WallExtraction {
+
+WallFittingJobSettings WallFittingJobSettings::fromAlgorithm(const WallFittingAlgorithm& algorithm, int timeoutMs)
+{
+    WallFittingJobSettings settings;
+    settings.parameters = algorithm.getRANSACParameters();
+    settings.planeDetectionMethod = algorithm.getPlaneDetectionMethod();
+    settings.frameAlignment = algorithm.getFrameAlignment();
+    settings.coordinateOrigin = algorithm.getCoordinateOrigin();
+    settings.regularization = algorithm.getRegularizationOptions();
+    settings.timeoutMs = timeoutMs;
+    return settings;
+}
+
+WallFittingJobRunner::WallFittingJobRunner(QObject* parent)
+    : QObject(parent)
+    , m_nextJobId(1)
+{
+    // 拟合内部已按点和线段并行，默认一次只执行一个任务
+    m_pool.setMaxThreadCount(1);
+}
+
+WallFittingJobRunner::~WallFittingJobRunner()
+{
+    cancelAll();
+    m_pool.waitForDone();
+}
+
+void WallFittingJobRunner::setMaxConcurrentJobs(int count)
+{
+    m_pool.setMaxThreadCount(qMax(1, count));
+}
+
+int WallFittingJobRunner::getMaxConcurrentJobs() const
+{
+    return m_pool.maxThreadCount();
+}
+
+int WallFittingJobRunner::submitPointCloudJob(std::shared_ptr<const std::vector<QVector3D>> points,
+                                              const WallFittingJobSettings& settings)
+{
+    auto job = std::make_shared<Job>();
+    job->points = std::move(points);
+    job->settings = settings;
+    return submit(job);
+}
+
+int WallFittingJobRunner::submitPointCloudJob(const std::vector<QVector3D>& points,
+                                              const WallFittingJobSettings& settings)
+{
+    return submitPointCloudJob(std::make_shared<const std::vector<QVector3D>>(points), settings);
+}
+
+int WallFittingJobRunner::submitLineJob(std::shared_ptr<const std::vector<QVector3D>> points,
+                                        const std::vector<LineSegment>& lines,
+                                        const WallFittingJobSettings& settings)
+{
+    auto job = std::make_shared<Job>();
+    job->lineBased = true;
+    job->points = std::move(points);
+    job->lines = lines;
+    job->settings = settings;
+    return submit(job);
+}
+
+int WallFittingJobRunner::submitLineJob(const std::vector<QVector3D>& points,
+                                        const std::vector<LineSegment>& lines,
+                                        const WallFittingJobSettings& settings)
+{
+    return submitLineJob(std::make_shared<const std::vector<QVector3D>>(points), lines, settings);
+}
+
+int WallFittingJobRunner::submit(const std::shared_ptr<Job>& job)
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        job->id = m_nextJobId++;
+        m_jobs[job->id] = job;
+    }
+    m_pool.start([this, job]() { runJob(job); });
+    qDebug() << "Wall fitting job submitted:" << job->id << (job->lineBased ? "line-based" : "point cloud");
+    return job->id;
+}
+
+bool WallFittingJobRunner::cancel(int jobId)
+{
+    QMutexLocker locker(&m_mutex);
+    auto it = m_jobs.find(jobId);
+    if (it == m_jobs.end()) {
+        return false;
+    }
+    it->second->cancelRequested = true;
+    return true;
+}
+
+void WallFittingJobRunner::cancelAll()
+{
+    QMutexLocker locker(&m_mutex);
+    for (auto& item : m_jobs) {
+        item.second->cancelRequested = true;
+    }
+}
+
+bool WallFittingJobRunner::isActive(int jobId) const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_jobs.count(jobId) > 0;
+}
+
+int WallFittingJobRunner::activeJobCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return static_cast<int>(m_jobs.size());
+}
+
+bool WallFittingJobRunner::waitForDone(int msecs)
+{
+    return m_pool.waitForDone(msecs);
+}
+
+void WallFittingJobRunner::runJob(const std::shared_ptr<Job>& job)
+{
+    const int jobId = job->id;
+
+    // 排队期间已取消的任务不再执行
+    if (job->cancelRequested) {
+        WallFittingResult result;
+        result.cancelled = true;
+        result.errorMessage = "墙面拟合已取消";
+        QMetaObject::invokeMethod(this, [this, jobId, result]() {
+            finishJob(jobId, false, result);
+        }, Qt::QueuedConnection);
+        return;
+    }
+
+    QMetaObject::invokeMethod(this, [this, jobId]() { emit jobStarted(jobId); }, Qt::QueuedConnection);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    WallFittingAlgorithm algorithm;
+    algorithm.initialize();
+    algorithm.setRANSACParameters(job->settings.parameters);
+    algorithm.setPlaneDetectionMethod(job->settings.planeDetectionMethod);
+    algorithm.setFrameAlignment(job->settings.frameAlignment);
+    algorithm.setCoordinateOrigin(job->settings.coordinateOrigin);
+    algorithm.setRegularizationOptions(job->settings.regularization);
+
+    const qint64 timeoutMs = job->settings.timeoutMs;
+    algorithm.setCancellationCallback([job, &timer, timeoutMs]() {
+        if (job->cancelRequested) {
+            return true;
+        }
+        if (timeoutMs > 0 && timer.elapsed() > timeoutMs) {
+            job->timedOut = true;
+            return true;
+        }
+        return false;
+    });
+
+    int lastPercentage = -1;
+    algorithm.setProgressCallback([this, jobId, &lastPercentage](int percentage, const QString& status) {
+        if (percentage == lastPercentage) {
+            return;
+        }
+        lastPercentage = percentage;
+        QMetaObject::invokeMethod(this, [this, jobId, percentage, status]() {
+            emit jobProgress(jobId, percentage, status);
+        }, Qt::QueuedConnection);
+    });
+
+    algorithm.setPlaneCallback([this, jobId](const Plane3D& plane) {
+        QMetaObject::invokeMethod(this, [this, jobId, plane]() {
+            emit jobPlaneFound(jobId, plane);
+        }, Qt::QueuedConnection);
+    });
+
+    // 空指针按空点云处理，由算法报告输入无效
+    const std::vector<QVector3D> noPoints;
+    const std::vector<QVector3D>& points = job->points ? *job->points : noPoints;
+    WallFittingResult result = job->lineBased
+        ? algorithm.fitWallsFromLines(points, job->lines)
+        : algorithm.fitWallsFromPointCloud(points);
+    job->points.reset();
+
+    const bool timedOut = job->timedOut;
+    QMetaObject::invokeMethod(this, [this, jobId, timedOut, result]() {
+        finishJob(jobId, timedOut, result);
+    }, Qt::QueuedConnection);
+}
+
+void WallFittingJobRunner::finishJob(int jobId, bool timedOut, const WallFittingResult& result)
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_jobs.erase(jobId);
+    }
+
+    if (result.cancelled) {
+        qDebug() << "Wall fitting job cancelled:" << jobId << (timedOut ? "(timeout)" : "");
+        emit jobCancelled(jobId, timedOut);
+    } else if (result.success) {
+        emit jobCompleted(jobId, result);
+    } else {
+        emit jobFailed(jobId, result.errorMessage);
+    }
+}
+
+} // namespace WallExtraction
@@ -0,0 +1,165 @@
+#ifndef WALL_FITTING_JOB_H
+#define WALL_FITTING_JOB_H
+
+#include <QObject>
+#include <QMutex>
+#include <QThreadPool>
+#include <QVector3D>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <vector>
+#include "line_drawing_tool.h"
+#include "wall_fitting_algorithm.h"
+
+namespace WallExtraction {
+
+// 墙面拟合任务配置（提交时复制，工作线程中使用独立的算法实例）
+struct WallFittingJobSettings {
+    RANSACParameters parameters;
+    PlaneDetectionMethod planeDetectionMethod;
+    DominantAxisAlignment frameAlignment;
+    CoordinateOrigin coordinateOrigin;
+    WallRegularizationOptions regularization;
+    int timeoutMs;                      // 超时时间（毫秒），0表示不限制
+
+    WallFittingJobSettings()
+        : planeDetectionMethod(PlaneDetectionMethod::EfficientRANSAC)
+        , timeoutMs(0)
+    {}
+
+    /**
+     * @brief 复制算法对象的当前配置
+     * @param algorithm 墙面拟合算法
+     * @param timeoutMs 超时时间（毫秒），0表示不限制
+     * @return 任务配置
+     */
+    static WallFittingJobSettings fromAlgorithm(const WallFittingAlgorithm& algorithm, int timeoutMs = 0);
+};
+
+/**
+ * @brief 后台墙面拟合任务
+ *
+ * 拟合在线程池中执行，每个任务使用独立的WallFittingAlgorithm实例：
+ * - 进度（同一百分比只发布一次）和逐个检测到的平面通过排队调用发布到本对象所在线程；
+ * - 取消是协作式的：cancel()设置任务的取消标志，算法在下一个检查点（候选批次、
+ *   平面、线段、处理阶段之间）停止；超时同样在下一个检查点生效；
+ * - 任务结束时发射jobCompleted、jobFailed或jobCancelled之一。
+ */
+class WallFittingJobRunner : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit WallFittingJobRunner(QObject* parent = nullptr);
+
+    /**
+     * @brief 析构时取消所有任务并等待工作线程结束
+     */
+    ~WallFittingJobRunner();
+
+    /**
+     * @brief 设置同时执行的最大任务数
+     * @param count 任务数（至少为1）
+     */
+    void setMaxConcurrentJobs(int count);
+    int getMaxConcurrentJobs() const;
+
+    /**
+     * @brief 提交自动墙面拟合任务
+     * @param points 共享的点云数据（任务期间只读，不复制）
+     * @param settings 任务配置
+     * @return 任务ID
+     */
+    int submitPointCloudJob(std::shared_ptr<const std::vector<QVector3D>> points,
+                            const WallFittingJobSettings& settings);
+    int submitPointCloudJob(const std::vector<QVector3D>& points, const WallFittingJobSettings& settings);
+
+    /**
+     * @brief 提交基于线段的墙面拟合任务
+     * @param points 共享的点云数据（任务期间只读，不复制）
+     * @param lines 用户线段（复制）
+     * @param settings 任务配置
+     * @return 任务ID
+     */
+    int submitLineJob(std::shared_ptr<const std::vector<QVector3D>> points,
+                      const std::vector<LineSegment>& lines,
+                      const WallFittingJobSettings& settings);
+    int submitLineJob(const std::vector<QVector3D>& points,
+                      const std::vector<LineSegment>& lines,
+                      const WallFittingJobSettings& settings);
+
+    /**
+     * @brief 请求取消任务
+     * @param jobId 任务ID
+     * @return 任务是否存在且尚未结束
+     */
+    bool cancel(int jobId);
+
+    /**
+     * @brief 请求取消所有任务
+     */
+    void cancelAll();
+
+    /**
+     * @brief 任务是否尚未结束（排队或执行中）
+     */
+    bool isActive(int jobId) const;
+    int activeJobCount() const;
+
+    /**
+     * @brief 等待所有任务执行完毕（结束信号以排队方式发布，需要事件循环才能收到）
+     * @param msecs 超时时间（毫秒），-1表示一直等待
+     * @return 是否在超时前完成
+     */
+    bool waitForDone(int msecs = -1);
+
+signals:
+    void jobStarted(int jobId);
+    void jobProgress(int jobId, int percentage, const QString& status);
+    void jobPlaneFound(int jobId, const Plane3D& plane);
+    void jobCompleted(int jobId, const WallFittingResult& result);
+    void jobFailed(int jobId, const QString& error);
+
+    /**
+     * @brief 任务已取消
+     * @param jobId 任务ID
+     * @param timedOut 是否因超时取消
+     */
+    void jobCancelled(int jobId, bool timedOut);
+
+private:
+    struct Job {
+        int id;
+        bool lineBased;
+        std::shared_ptr<const std::vector<QVector3D>> points;
+        std::vector<LineSegment> lines;
+        WallFittingJobSettings settings;
+        std::atomic<bool> cancelRequested;
+        std::atomic<bool> timedOut;
+
+        Job() : id(-1), lineBased(false), cancelRequested(false), timedOut(false) {}
+    };
+
+    int submit(const std::shared_ptr<Job>& job);
+
+    /**
+     * @brief 在工作线程中执行任务
+     */
+    void runJob(const std::shared_ptr<Job>& job);
+
+    /**
+     * @brief 在本对象所在线程中结束任务并发射结束信号
+     */
+    void finishJob(int jobId, bool timedOut, const WallFittingResult& result);
+
+private:
+    mutable QMutex m_mutex;
+    QThreadPool m_pool;
+    std::map<int, std::shared_ptr<Job>> m_jobs;
+    int m_nextJobId;
+};
+
+} // namespace WallExtraction
+
+#endif // WALL_FITTING_JOB_H
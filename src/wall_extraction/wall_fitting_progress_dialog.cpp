@@ -161,6 +161,8 @@ void WallFittingProgressDialog::startProgress(const QString& title)
     m_startTime = QDateTime::currentMSecsSinceEpoch();
     m_lastUpdateTime = m_startTime;
     
+    m_cancelButton->setText("取消");
+    m_cancelButton->setEnabled(true);
     m_cancelButton->setVisible(true);
     m_closeButton->setVisible(false);
     
@@ -203,6 +205,22 @@ void WallFittingProgressDialog::failProgress(const QString& error)
     qDebug() << "Progress failed:" << error;
 }
 
+void WallFittingProgressDialog::cancelProgress(const QString& message)
+{
+    m_completed = true;
+    m_currentStatus = message;
+    
+    m_updateTimer->stop();
+    
+    m_cancelButton->setVisible(false);
+    m_closeButton->setVisible(true);
+    
+    updateProgressText();
+    addLogMessage(message);
+    
+    qDebug() << "Progress cancelled:" << message;
+}
+
 void WallFittingProgressDialog::addLogMessage(const QString& message)
 {
     QString timestamp = QDateTime::currentDateTime().toString("hh:mm:ss");
@@ -261,6 +279,11 @@ QString WallFittingProgressDialog::getElapsedTimeString() const
 void WallFittingProgressDialog::onCancelClicked()
 {
     m_cancelled = true;
+    
+    // 拟合在后台线程中协作式取消，等待任务在下一个检查点停止
+    m_cancelButton->setEnabled(false);
+    m_cancelButton->setText("正在取消...");
+    
     emit cancelled();
     addLogMessage("用户取消操作");
     qDebug() << "Progress cancelled by user";
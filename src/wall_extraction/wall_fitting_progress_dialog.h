@@ -40,6 +40,7 @@ public:
     void startProgress(const QString& title = "墙面拟合进行中");
     void completeProgress(const QString& message = "墙面拟合完成");
     void failProgress(const QString& error = "墙面拟合失败");
+    void cancelProgress(const QString& message = "墙面拟合已取消");
     void resetProgress();
     
     // 日志管理
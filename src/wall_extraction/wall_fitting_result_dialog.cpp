@@ -247,8 +247,8 @@ void WallFittingResultDialog::populateWallsTable()
         const WallSegment& wall = m_result.walls[i];
         
         m_wallsTable->setItem(i, 0, new QTableWidgetItem(QString::number(wall.id)));
-        m_wallsTable->setItem(i, 1, new QTableWidgetItem(formatVector3D(wall.startPoint)));
-        m_wallsTable->setItem(i, 2, new QTableWidgetItem(formatVector3D(wall.endPoint)));
+        m_wallsTable->setItem(i, 1, new QTableWidgetItem(formatGlobalPoint(m_result.coordinateOrigin, wall.startPoint)));
+        m_wallsTable->setItem(i, 2, new QTableWidgetItem(formatGlobalPoint(m_result.coordinateOrigin, wall.endPoint)));
         m_wallsTable->setItem(i, 3, new QTableWidgetItem(formatFloat(wall.length())));
         m_wallsTable->setItem(i, 4, new QTableWidgetItem(formatFloat(wall.height)));
         m_wallsTable->setItem(i, 5, new QTableWidgetItem(formatFloat(wall.thickness)));
@@ -0,0 +1,470 @@
+#include "wall_regularization.h"
+#include "wall_fitting_algorithm.h"
+#include <QVector2D>
+#include <QtMath>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace WallExtraction {
+
+namespace {
+
+const double kHalfPi = M_PI / 2.0;
+
+// 长度低于该值（米）的墙面没有可靠方向，不参与规则化
+const float kMinAxisLength = 1e-3f;
+
+// 主方向加权最小二乘精化的迭代次数（吸附范围随方向角移动，成员可能变化）
+const int kOrientationRefineIterations = 3;
+
+// 两墙面方向夹角的正弦低于该值时视为平行，不求交
+const float kMinJoinSine = 0.1f;
+
+// 墙面在XY平面内的中线
+struct WallAxis {
+    QVector2D mid;
+    double angle;       // 起点指向终点的方向角（弧度）
+    float halfLength;
+    float weight;       // 长度权重，0表示不参与规则化
+    int group;          // 主方向组，-1表示未吸附
+    int family;         // 0：组方向，1：组方向的垂直方向
+};
+
+inline QVector2D toXY(const QVector3D& point)
+{
+    return QVector2D(point.x(), point.y());
+}
+
+inline float cross2D(const QVector2D& a, const QVector2D& b)
+{
+    return a.x() * b.y() - a.y() * b.x();
+}
+
+/**
+ * @brief 角度回绕到[-π/4, π/4)
+ */
+inline double wrapQuarter(double angle)
+{
+    angle = std::fmod(angle + kHalfPi / 2.0, kHalfPi);
+    if (angle < 0.0) {
+        angle += kHalfPi;
+    }
+    return angle - kHalfPi / 2.0;
+}
+
+/**
+ * @brief 角度折叠到[0, π/2)
+ */
+inline double foldQuarter(double angle)
+{
+    angle = std::fmod(angle, kHalfPi);
+    return angle < 0.0 ? angle + kHalfPi : angle;
+}
+
+/**
+ * @brief 在尚未吸附的墙面中检测一组主方向
+ *
+ * 直方图按吸附范围循环平滑后取峰值，再对吸附范围内的墙面求加权最小二乘：
+ * 最小化 Σw·wrap(φ - θ)²，闭式解为残差的加权平均。
+ *
+ * @param axes 墙面中线
+ * @param binCount 直方图格数（覆盖90°）
+ * @param snapAngle 吸附范围（弧度）
+ * @param minWeight 峰值窗口内的最小长度
+ * @return 方向角（[0, π/2)），没有合格峰值时返回负值
+ */
+double detectOrientation(const std::vector<WallAxis>& axes, int binCount, double snapAngle, double minWeight)
+{
+    const double binWidth = kHalfPi / binCount;
+    std::vector<double> histogram(binCount, 0.0);
+    for (const WallAxis& axis : axes) {
+        if (axis.weight > 0.0f && axis.group < 0) {
+            const int bin = std::min(binCount - 1, static_cast<int>(foldQuarter(axis.angle) / binWidth));
+            histogram[bin] += axis.weight;
+        }
+    }
+
+    const int window = std::min(binCount / 2, static_cast<int>(std::round(snapAngle / binWidth)));
+    int peakBin = -1;
+    double peakWeight = 0.0;
+    for (int bin = 0; bin < binCount; ++bin) {
+        double weight = 0.0;
+        for (int k = -window; k <= window; ++k) {
+            weight += histogram[(bin + k + binCount) % binCount];
+        }
+        if (weight > peakWeight) {
+            peakWeight = weight;
+            peakBin = bin;
+        }
+    }
+    if (peakBin < 0 || peakWeight < minWeight) {
+        return -1.0;
+    }
+
+    double angle = (peakBin + 0.5) * binWidth;
+    for (int iteration = 0; iteration < kOrientationRefineIterations; ++iteration) {
+        double weightSum = 0.0;
+        double residualSum = 0.0;
+        for (const WallAxis& axis : axes) {
+            if (axis.weight <= 0.0f || axis.group >= 0) {
+                continue;
+            }
+            const double residual = wrapQuarter(axis.angle - angle);
+            if (std::fabs(residual) <= snapAngle) {
+                weightSum += axis.weight;
+                residualSum += axis.weight * residual;
+            }
+        }
+        if (weightSum <= 0.0) {
+            break;
+        }
+        angle = foldQuarter(angle + residualSum / weightSum);
+    }
+    return angle;
+}
+
+/**
+ * @brief 一组主方向内墙面方向角和共面偏移的联合最小二乘
+ *
+ * 平行和垂直由组内墙面共享方向角θ保证。两个方向族内按初始方向下的中线偏移排序分段
+ * （每段跨度不超过coplanarDistance），每段为一个共面簇，共享偏移o_c。墙面i（中点m、
+ * 长度L、方向残差r）到所在直线的距离沿墙长积分，目标为
+ *   E(θ, o) = Σ L·(n(θ)·m - o_c)² + Σ L³/12·(r - δ)²，δ = θ - θ0。
+ * 在θ0处线性化 n(θ)·m ≈ n0·m - δ·(d0·m) 后，o_c为簇内长度加权平均，消去o_c得到δ的
+ * 闭式解：共线但沿墙方向分开的墙面通过偏移项约束方向角。高斯-牛顿迭代后墙面绕中点
+ * 旋转到精化后的方向，多于一面墙的簇沿法向平移到共同偏移。
+ *
+ * @param axes 墙面中线（组内墙面的angle为原始方向角）
+ * @param members 组内墙面
+ * @param groupAngle 检测到的组方向角（弧度）
+ * @param coplanarDistance 共面簇的最大偏移跨度（米）
+ * @param coplanarGroups 累加调整为共面的墙面组数
+ * @return 精化后的组方向角（弧度）
+ */
+double solveGroupAxes(std::vector<WallAxis>& axes, const std::vector<int>& members, double groupAngle,
+                      float coplanarDistance, int& coplanarGroups)
+{
+    // 共面簇（单面墙也是一个簇，只参与方向角精化）
+    std::vector<std::vector<int>> clusters;
+    for (int family = 0; family < 2; ++family) {
+        const double familyAngle = groupAngle + family * kHalfPi;
+        const QVector2D normal(static_cast<float>(-std::sin(familyAngle)), static_cast<float>(std::cos(familyAngle)));
+
+        std::vector<std::pair<float, int>> offsets;
+        for (int index : members) {
+            if (axes[index].family == family) {
+                offsets.emplace_back(QVector2D::dotProduct(normal, axes[index].mid), index);
+            }
+        }
+        std::sort(offsets.begin(), offsets.end());
+
+        size_t begin = 0;
+        while (begin < offsets.size()) {
+            size_t end = begin + 1;
+            while (end < offsets.size() && offsets[end].first - offsets[begin].first <= coplanarDistance) {
+                ++end;
+            }
+            std::vector<int> cluster;
+            for (size_t k = begin; k < end; ++k) {
+                cluster.push_back(offsets[k].second);
+            }
+            clusters.push_back(std::move(cluster));
+            begin = end;
+        }
+    }
+
+    // 高斯-牛顿：a = n·m（偏移），b = d·m（沿墙坐标，偏移对θ的导数取负）
+    double angle = groupAngle;
+    for (int iteration = 0; iteration < kOrientationRefineIterations; ++iteration) {
+        double numerator = 0.0;
+        double denominator = 0.0;
+        for (const std::vector<int>& cluster : clusters) {
+            const double familyAngle = angle + axes[cluster.front()].family * kHalfPi;
+            const double cosAngle = std::cos(familyAngle);
+            const double sinAngle = std::sin(familyAngle);
+
+            double weightSum = 0.0;
+            double offsetMean = 0.0;
+            double alongMean = 0.0;
+            for (int index : cluster) {
+                const WallAxis& axis = axes[index];
+                weightSum += axis.weight;
+                offsetMean += axis.weight * (cosAngle * axis.mid.y() - sinAngle * axis.mid.x());
+                alongMean += axis.weight * (cosAngle * axis.mid.x() + sinAngle * axis.mid.y());
+            }
+            offsetMean /= weightSum;
+            alongMean /= weightSum;
+
+            for (int index : cluster) {
+                const WallAxis& axis = axes[index];
+                const double offset = cosAngle * axis.mid.y() - sinAngle * axis.mid.x() - offsetMean;
+                const double along = cosAngle * axis.mid.x() + sinAngle * axis.mid.y() - alongMean;
+                const double rotation = static_cast<double>(axis.weight) * axis.weight * axis.weight / 12.0;
+                numerator += axis.weight * offset * along + rotation * wrapQuarter(axis.angle - familyAngle);
+                denominator += axis.weight * along * along + rotation;
+            }
+        }
+        if (denominator <= 0.0) {
+            break;
+        }
+        angle += numerator / denominator;
+    }
+
+    // 写回：方向吸附到精化后的方向角，共面簇平移到加权平均偏移
+    for (const std::vector<int>& cluster : clusters) {
+        const double familyAngle = angle + axes[cluster.front()].family * kHalfPi;
+        const QVector2D normal(static_cast<float>(-std::sin(familyAngle)), static_cast<float>(std::cos(familyAngle)));
+
+        double weightSum = 0.0;
+        double offsetSum = 0.0;
+        for (int index : cluster) {
+            WallAxis& axis = axes[index];
+            axis.angle -= wrapQuarter(axis.angle - familyAngle);
+            weightSum += axis.weight;
+            offsetSum += axis.weight * QVector2D::dotProduct(normal, axis.mid);
+        }
+        if (cluster.size() < 2) {
+            continue;
+        }
+        const float target = static_cast<float>(offsetSum / weightSum);
+        for (int index : cluster) {
+            WallAxis& axis = axes[index];
+            axis.mid += normal * (target - QVector2D::dotProduct(normal, axis.mid));
+        }
+        ++coplanarGroups;
+    }
+    return angle;
+}
+
+// 墙面端点的候选交点
+struct EndCandidate {
+    float distance;
+    QVector2D point;
+
+    EndCandidate() : distance(std::numeric_limits<float>::max()) {}
+};
+
+/**
+ * @brief 对一对墙面求中线交点，记录可移到交点的端点
+ *
+ * 端点到交点的距离不超过junctionDistance，且交点落在另一面墙（两端各延长junctionDistance）
+ * 的范围内时，该端点成为候选；同一端点保留距离最近的候选。
+ */
+void proposeJunction(const std::vector<WallSegment>& walls, int a, int b, float junctionDistance,
+                     std::vector<std::array<EndCandidate, 2>>& candidates)
+{
+    const QVector2D p = toXY(walls[a].startPoint);
+    const QVector2D d = toXY(walls[a].endPoint) - p;
+    const QVector2D q = toXY(walls[b].startPoint);
+    const QVector2D e = toXY(walls[b].endPoint) - q;
+    const float lengthA = d.length();
+    const float lengthB = e.length();
+    const float cross = cross2D(d, e);
+    if (std::fabs(cross) <= kMinJoinSine * lengthA * lengthB) {
+        return;
+    }
+
+    const QVector2D w = q - p;
+    const float ta = cross2D(w, e) / cross;
+    const float tb = cross2D(w, d) / cross;
+    const QVector2D intersection = p + d * ta;
+
+    auto propose = [&](int wall, float t, float length, float otherT, float otherLength) {
+        const float slack = junctionDistance / otherLength;
+        if (otherT < -slack || otherT > 1.0f + slack) {
+            return;
+        }
+        const int end = t < 0.5f ? 0 : 1;
+        const float distance = std::fabs(t - end) * length;
+        EndCandidate& candidate = candidates[wall][end];
+        if (distance <= junctionDistance && distance < candidate.distance) {
+            candidate.distance = distance;
+            candidate.point = intersection;
+        }
+    };
+    propose(a, ta, lengthA, tb, lengthB);
+    propose(b, tb, lengthB, ta, lengthA);
+}
+
+/**
+ * @brief 扫描线求墙面交点，并把端点移到交点
+ * @return 移动的端点数
+ */
+int joinWallEnds(std::vector<WallSegment>& walls, const std::vector<WallAxis>& axes, float junctionDistance)
+{
+    // 外包矩形（扩大junctionDistance）
+    struct Box {
+        float minX, maxX, minY, maxY;
+    };
+    std::vector<Box> boxes(walls.size());
+    std::vector<int> order;
+    order.reserve(walls.size());
+    for (size_t i = 0; i < walls.size(); ++i) {
+        if (axes[i].weight <= 0.0f) {
+            continue;
+        }
+        const QVector2D p = toXY(walls[i].startPoint);
+        const QVector2D q = toXY(walls[i].endPoint);
+        boxes[i] = {std::min(p.x(), q.x()) - junctionDistance, std::max(p.x(), q.x()) + junctionDistance,
+                    std::min(p.y(), q.y()) - junctionDistance, std::max(p.y(), q.y()) + junctionDistance};
+        order.push_back(static_cast<int>(i));
+    }
+    std::sort(order.begin(), order.end(), [&boxes](int a, int b) {
+        return boxes[a].minX < boxes[b].minX;
+    });
+
+    // 按minX扫描，活动集合中只保留X区间仍与扫描位置重叠的墙面
+    std::vector<std::array<EndCandidate, 2>> candidates(walls.size());
+    std::vector<int> active;
+    for (int i : order) {
+        const Box& box = boxes[i];
+        for (size_t k = 0; k < active.size();) {
+            if (boxes[active[k]].maxX < box.minX) {
+                active[k] = active.back();
+                active.pop_back();
+                continue;
+            }
+            const Box& other = boxes[active[k]];
+            if (other.minY <= box.maxY && box.minY <= other.maxY) {
+                proposeJunction(walls, active[k], i, junctionDistance, candidates);
+            }
+            ++k;
+        }
+        active.push_back(i);
+    }
+
+    int moved = 0;
+    for (size_t i = 0; i < walls.size(); ++i) {
+        const std::array<EndCandidate, 2>& ends = candidates[i];
+        const bool moveStart = ends[0].distance <= junctionDistance;
+        const bool moveEnd = ends[1].distance <= junctionDistance;
+        if (!moveStart && !moveEnd) {
+            continue;
+        }
+
+        // 两端都移动时不允许墙面方向翻转
+        const QVector2D start = moveStart ? ends[0].point : toXY(walls[i].startPoint);
+        const QVector2D end = moveEnd ? ends[1].point : toXY(walls[i].endPoint);
+        if (QVector2D::dotProduct(end - start, toXY(walls[i].endPoint) - toXY(walls[i].startPoint)) <= 0.0f) {
+            continue;
+        }
+
+        if (moveStart) {
+            walls[i].startPoint.setX(start.x());
+            walls[i].startPoint.setY(start.y());
+            ++moved;
+        }
+        if (moveEnd) {
+            walls[i].endPoint.setX(end.x());
+            walls[i].endPoint.setY(end.y());
+            ++moved;
+        }
+    }
+    return moved;
+}
+
+} // namespace
+
+WallRegularizationResult regularizeWalls(std::vector<WallSegment>& walls, const WallRegularizationOptions& options)
+{
+    WallRegularizationResult result;
+    if (!options.enabled || walls.empty()) {
+        return result;
+    }
+
+    const double snapAngle = qDegreesToRadians(static_cast<double>(options.snapAngle));
+    const int binCount = std::max(4, options.histogramBins);
+
+    std::vector<WallAxis> axes(walls.size());
+    double totalWeight = 0.0;
+    for (size_t i = 0; i < walls.size(); ++i) {
+        const QVector2D p = toXY(walls[i].startPoint);
+        const QVector2D q = toXY(walls[i].endPoint);
+        const float length = (q - p).length();
+
+        WallAxis& axis = axes[i];
+        axis.mid = (p + q) * 0.5f;
+        axis.angle = std::atan2(q.y() - p.y(), q.x() - p.x());
+        axis.halfLength = length * 0.5f;
+        axis.weight = length >= kMinAxisLength ? length : 0.0f;
+        axis.group = -1;
+        axis.family = 0;
+        totalWeight += axis.weight;
+    }
+
+    // 主方向检测与吸附：同一组内的墙面只相差90°的整数倍
+    for (int group = 0; group < options.maxOrientations; ++group) {
+        const double minWeight = group == 0 ? 0.0 : options.minOrientationWeight * totalWeight;
+        const double angle = detectOrientation(axes, binCount, snapAngle, minWeight);
+        if (angle < 0.0) {
+            break;
+        }
+
+        int members = 0;
+        for (WallAxis& axis : axes) {
+            if (axis.weight <= 0.0f || axis.group >= 0) {
+                continue;
+            }
+            const double residual = wrapQuarter(axis.angle - angle);
+            if (std::fabs(residual) > snapAngle) {
+                continue;
+            }
+            // 方向角在联合求解后吸附，这里只记录所属组和方向族
+            axis.group = group;
+            const long quarterTurns = std::lround((axis.angle - residual - angle) / kHalfPi);
+            axis.family = static_cast<int>(((quarterTurns % 2) + 2) % 2);
+            ++members;
+        }
+        if (members == 0) {
+            break;
+        }
+        result.dominantAngles.push_back(static_cast<float>(angle));
+        result.snappedWalls += members;
+    }
+
+    // 各组方向角和共面偏移联合求解
+    for (size_t group = 0; group < result.dominantAngles.size(); ++group) {
+        std::vector<int> members;
+        for (size_t i = 0; i < axes.size(); ++i) {
+            if (axes[i].group == static_cast<int>(group)) {
+                members.push_back(static_cast<int>(i));
+            }
+        }
+        const double angle = solveGroupAxes(axes, members, result.dominantAngles[group],
+                                            options.coplanarDistance, result.coplanarGroups);
+        result.dominantAngles[group] = static_cast<float>(foldQuarter(angle));
+    }
+
+    // 写回吸附后的中线，法向量改为水平并保持原朝向
+    for (size_t i = 0; i < walls.size(); ++i) {
+        const WallAxis& axis = axes[i];
+        if (axis.group < 0) {
+            continue;
+        }
+        WallSegment& wall = walls[i];
+        const QVector2D direction(static_cast<float>(std::cos(axis.angle)), static_cast<float>(std::sin(axis.angle)));
+        const QVector2D start = axis.mid - direction * axis.halfLength;
+        const QVector2D end = axis.mid + direction * axis.halfLength;
+        wall.startPoint.setX(start.x());
+        wall.startPoint.setY(start.y());
+        wall.endPoint.setX(end.x());
+        wall.endPoint.setY(end.y());
+
+        QVector2D normal(-direction.y(), direction.x());
+        if (QVector2D::dotProduct(normal, toXY(wall.normal)) < 0.0f) {
+            normal = -normal;
+        }
+        wall.normal = QVector3D(normal.x(), normal.y(), 0.0f);
+    }
+
+    // 交点
+    if (options.junctionDistance > 0.0f) {
+        result.junctions = joinWallEnds(walls, axes, options.junctionDistance);
+    }
+
+    return result;
+}
+
+} // namespace WallExtraction
@@ -0,0 +1,68 @@
+#ifndef WALL_REGULARIZATION_H
+#define WALL_REGULARIZATION_H
+
+#include <vector>
+
+namespace WallExtraction {
+
+struct WallSegment;
+
+// 墙面规则化选项
+struct WallRegularizationOptions {
+    bool enabled;               // 是否执行规则化 (true)
+    float snapAngle;            // 墙面方向与主方向的最大吸附夹角（度）(5)
+    int histogramBins;          // 方向直方图格数，覆盖90° (90)
+    int maxOrientations;        // 主方向组（一对互相垂直的方向）的最大数目 (2)
+    float minOrientationWeight; // 第二组及以后的主方向组至少占墙面总长度的比例 (0.1)
+    float coplanarDistance;     // 同向墙面中线偏移差小于该值时调整为共面（米）(0.1)
+    float junctionDistance;     // 墙面端点移到交点的最大距离（米）(0.5)
+    bool applyToLineFits;       // 基于用户线段的拟合是否也规则化 (false)
+                                // 默认保留用户放置的位置和方向，不吸附、不对齐、不改连接
+
+    WallRegularizationOptions()
+        : enabled(true)
+        , snapAngle(5.0f)
+        , histogramBins(90)
+        , maxOrientations(2)
+        , minOrientationWeight(0.1f)
+        , coplanarDistance(0.1f)
+        , junctionDistance(0.5f)
+        , applyToLineFits(false)
+    {}
+};
+
+// 墙面规则化结果
+struct WallRegularizationResult {
+    std::vector<float> dominantAngles;  // 各主方向组的方向角（弧度，[0, π/2)，按检测顺序）
+    int snappedWalls;                   // 吸附到主方向的墙面数
+    int coplanarGroups;                 // 调整为共面的墙面组数（每组至少两面墙）
+    int junctions;                      // 移到交点的墙面端点数
+
+    WallRegularizationResult() : snappedWalls(0), coplanarGroups(0), junctions(0) {}
+};
+
+/**
+ * @brief 曼哈顿世界墙面规则化
+ *
+ * 在XY平面内依次执行：
+ * - 主方向检测：墙面方向角按90°折叠后以长度加权统计直方图，取平滑后的峰值，
+ *   再以吸附范围内墙面的加权最小二乘（残差按90°回绕）精化方向角；
+ *   一组方向同时约束平行和垂直的墙面，剩余墙面中继续检测下一组；
+ * - 联合求解：组内同向墙面按中线偏移相近分为共面簇，组方向角和各簇偏移一起求
+ *   墙面到所在直线距离的长度加权最小二乘（平行和垂直由共享方向角保证，共线墙面的
+ *   位置同时约束方向角）；
+ * - 吸附：组内墙面绕中点旋转到精化后的主方向或其垂直方向并平移到所在簇的偏移，
+ *   法向量改为水平；
+ * - 交点：扫描线（按X区间排序，维护活动集合）找出外包矩形相交的墙面对，
+ *   靠近中线交点的端点移到交点，形成L形和T形连接。
+ *
+ * @param walls 墙面（原地修改）
+ * @param options 规则化选项
+ * @return 规则化结果
+ */
+WallRegularizationResult regularizeWalls(std::vector<WallSegment>& walls,
+                                         const WallRegularizationOptions& options = WallRegularizationOptions());
+
+} // namespace WallExtraction
+
+#endif // WALL_REGULARIZATION_H
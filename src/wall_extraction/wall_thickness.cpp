@@ -0,0 +1,133 @@
+#include "wall_thickness.h"
+#include <algorithm>
+#include <cmath>
+
+namespace WallExtraction {
+
+namespace {
+
+// 峰值质心的半宽（格）
+const int kPeakHalfWidth = 2;
+
+// 两个表面之间的谷值不超过较低峰值的该比例，否则视为同一表面的宽峰
+const float kMaxValleyRatio = 0.5f;
+
+/**
+ * @brief 峰值附近各格的加权质心
+ * @return 质心所在的格坐标（格中心为整数+0.5）
+ */
+float peakCentroid(const std::vector<int>& histogram, int peak)
+{
+    double weightSum = 0.0;
+    double positionSum = 0.0;
+    const int first = std::max(0, peak - kPeakHalfWidth);
+    const int last = std::min(static_cast<int>(histogram.size()) - 1, peak + kPeakHalfWidth);
+    for (int bin = first; bin <= last; ++bin) {
+        weightSum += histogram[bin];
+        positionSum += histogram[bin] * (bin + 0.5);
+    }
+    return weightSum > 0.0 ? static_cast<float>(positionSum / weightSum) : peak + 0.5f;
+}
+
+int peakCount(const std::vector<int>& histogram, int peak)
+{
+    int count = 0;
+    const int first = std::max(0, peak - kPeakHalfWidth);
+    const int last = std::min(static_cast<int>(histogram.size()) - 1, peak + kPeakHalfWidth);
+    for (int bin = first; bin <= last; ++bin) {
+        count += histogram[bin];
+    }
+    return count;
+}
+
+} // namespace
+
+WallThicknessEstimate estimateWallThickness(const std::vector<QVector3D>& points,
+                                            IndexSpan indices,
+                                            const QVector3D& origin,
+                                            const QVector3D& normal,
+                                            const WallThicknessOptions& options)
+{
+    WallThicknessEstimate estimate;
+    estimate.thickness = options.defaultThickness;
+
+    const float binSize = std::max(options.binSize, 1e-4f);
+    const float range = std::max(options.maxThickness, binSize);
+    const int binCount = static_cast<int>(std::ceil(2.0f * range / binSize));
+
+    std::vector<int> histogram(binCount, 0);
+    const double originOffset = QVector3D::dotProduct(normal, origin);
+    int binned = 0;
+    for (int index : indices) {
+        // NaN与范围比较都为假，须先排除，否则会以未定义的整数转换进入直方图
+        const double offset = QVector3D::dotProduct(normal, points[index]) - originOffset;
+        if (!std::isfinite(offset) || offset < -range || offset >= range) {
+            continue;
+        }
+        const int bin = std::min(binCount - 1, static_cast<int>((offset + range) / binSize));
+        ++histogram[bin];
+        ++binned;
+    }
+    if (binned == 0) {
+        return estimate;
+    }
+
+    // [1, 2, 1]平滑后找峰值
+    std::vector<int> smoothed(binCount, 0);
+    for (int bin = 0; bin < binCount; ++bin) {
+        smoothed[bin] = 2 * histogram[bin]
+                        + (bin > 0 ? histogram[bin - 1] : 0)
+                        + (bin + 1 < binCount ? histogram[bin + 1] : 0);
+    }
+    const int firstPeak = static_cast<int>(std::max_element(smoothed.begin(), smoothed.end()) - smoothed.begin());
+
+    const int minSeparation = std::max(1, static_cast<int>(std::ceil(options.minFaceSeparation / binSize)));
+    const int maxSeparation = static_cast<int>(options.maxThickness / binSize);
+    int secondPeak = -1;
+    for (int bin = std::max(0, firstPeak - maxSeparation);
+         bin <= std::min(binCount - 1, firstPeak + maxSeparation); ++bin) {
+        if (std::abs(bin - firstPeak) < minSeparation) {
+            continue;
+        }
+        const bool localMaximum = (bin == 0 || smoothed[bin] >= smoothed[bin - 1]) &&
+                                  (bin + 1 == binCount || smoothed[bin] >= smoothed[bin + 1]);
+        if (!localMaximum || smoothed[bin] < options.minPeakRatio * smoothed[firstPeak]) {
+            continue;
+        }
+        if (secondPeak >= 0 && smoothed[bin] <= smoothed[secondPeak]) {
+            continue;
+        }
+
+        // 两个峰值之间必须有谷值
+        const int low = std::min(bin, firstPeak);
+        const int high = std::max(bin, firstPeak);
+        const int valley = *std::min_element(smoothed.begin() + low, smoothed.begin() + high + 1);
+        if (valley <= kMaxValleyRatio * smoothed[bin]) {
+            secondPeak = bin;
+        }
+    }
+
+    const float firstOffset = peakCentroid(histogram, firstPeak) * binSize - range;
+    estimate.faceOffsets[0] = estimate.faceOffsets[1] = firstOffset;
+    estimate.facePoints[0] = estimate.facePoints[1] = peakCount(histogram, firstPeak);
+    estimate.centerOffset = firstOffset;
+    if (secondPeak < 0) {
+        return estimate;
+    }
+
+    const float secondOffset = peakCentroid(histogram, secondPeak) * binSize - range;
+    const int secondPoints = peakCount(histogram, secondPeak);
+    if (secondOffset < firstOffset) {
+        estimate.faceOffsets[0] = secondOffset;
+        estimate.facePoints[0] = secondPoints;
+    } else {
+        estimate.faceOffsets[1] = secondOffset;
+        estimate.facePoints[1] = secondPoints;
+    }
+    estimate.doubleSided = true;
+    estimate.thickness = estimate.faceOffsets[1] - estimate.faceOffsets[0];
+    estimate.centerOffset = 0.5f * (estimate.faceOffsets[0] + estimate.faceOffsets[1]);
+    return estimate;
+}
+
+} // namespace WallExtraction
@@ -0,0 +1,77 @@
+#ifndef WALL_THICKNESS_H
+#define WALL_THICKNESS_H
+
+#include <QVector3D>
+#include <cstddef>
+#include <vector>
+
+namespace WallExtraction {
+
+// 点索引的只读视图（引用调用方的索引数组，不复制）
+struct IndexSpan {
+    const int* data;
+    size_t size;
+
+    IndexSpan() : data(nullptr), size(0) {}
+    IndexSpan(const int* data, size_t size) : data(data), size(size) {}
+    IndexSpan(const std::vector<int>& indices) : data(indices.data()), size(indices.size()) {}
+
+    bool empty() const { return size == 0; }
+    const int* begin() const { return data; }
+    const int* end() const { return data + size; }
+};
+
+// 墙厚估计选项
+struct WallThicknessOptions {
+    float maxThickness;         // 最大墙厚（米），两个表面峰值的间距不超过该值 (0.5)
+    float binSize;              // 直方图格宽（米）(0.01)
+    float minFaceSeparation;    // 两个表面峰值的最小间距（米），更近时视为同一表面 (0.05)
+    float minPeakRatio;         // 第二个表面峰值至少为第一个峰值的比例 (0.2)
+    float defaultThickness;     // 只检测到一个表面时使用的墙厚（米）(0.2)
+
+    WallThicknessOptions()
+        : maxThickness(0.5f)
+        , binSize(0.01f)
+        , minFaceSeparation(0.05f)
+        , minPeakRatio(0.2f)
+        , defaultThickness(0.2f)
+    {}
+};
+
+// 墙厚估计结果（偏移均沿给定法向，相对参考点）
+struct WallThicknessEstimate {
+    bool doubleSided;           // 是否检测到两个表面
+    float thickness;            // 墙厚（单面时为defaultThickness）
+    float centerOffset;         // 墙体中面的偏移（单面时为表面偏移）
+    float faceOffsets[2];       // 两个表面的偏移（从小到大，单面时相同）
+    int facePoints[2];          // 两个表面峰值附近的点数
+
+    WallThicknessEstimate()
+        : doubleSided(false), thickness(0.0f), centerOffset(0.0f)
+        , faceOffsets{0.0f, 0.0f}, facePoints{0, 0}
+    {}
+};
+
+/**
+ * @brief 由点沿墙面法向的分布估计墙厚
+ *
+ * 参考平面两侧maxThickness范围内的点按法向偏移统计一维直方图，平滑后取最高峰为第一个表面，
+ * 在maxThickness范围内寻找与之有明显谷值分隔、高度不低于minPeakRatio的局部峰值作为第二个表面。
+ * 峰值位置取峰值附近各格的加权质心。
+ *
+ * @param points 点云数据
+ * @param indices 参与估计的点索引
+ * @param origin 参考平面上的一点
+ * @param normal 参考平面的单位法向（水平）
+ * @param options 估计选项
+ * @return 估计结果，范围内没有点时facePoints为0且thickness为defaultThickness
+ */
+WallThicknessEstimate estimateWallThickness(const std::vector<QVector3D>& points,
+                                            IndexSpan indices,
+                                            const QVector3D& origin,
+                                            const QVector3D& normal,
+                                            const WallThicknessOptions& options = WallThicknessOptions());
+
+} // namespace WallExtraction
+
+#endif // WALL_THICKNESS_H
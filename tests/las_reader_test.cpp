@@ -2,6 +2,7 @@
 #include <QObject>
 #include <QTemporaryFile>
 #include <QVector3D>
+#include <cstring>
 #include <memory>
 #include "las_reader.h"
 
@@ -32,6 +33,8 @@ private slots:
     void testWKTCoordinateSystem();
     void testUTMCoordinateSystem();
     void testCoordinateTransformation();
+    void testBatchCoordinateTransformation();
+    void testCoordinateOriginRebasing();
     
     // 属性信息测试
     void testClassificationParsing();
@@ -207,6 +210,139 @@ void LASReaderTest::testCoordinateTransformation()
     QVERIFY(transformed.y() != sourcePoint.y());
 }
 
+void LASReaderTest::testBatchCoordinateTransformation()
+{
+    using namespace WallExtraction;
+
+    // UTM 31N中央经线上45°N：东坐标为假东偏，北坐标为子午线弧长×0.9996
+    TransverseMercator utm31 = TransverseMercator::utm(31, true);
+    double easting = 0.0;
+    double northing = 0.0;
+    utm31.forward(3.0, 45.0, easting, northing);
+    QVERIFY(qAbs(easting - 500000.0) < 1e-6);
+    QVERIFY(qAbs(northing - 4982950.400) < 0.01);
+
+    // 正反算往返
+    double longitude = 0.0;
+    double latitude = 0.0;
+    utm31.forward(5.0, 50.0, easting, northing);
+    utm31.inverse(easting, northing, longitude, latitude);
+    QVERIFY(qAbs(longitude - 5.0) < 1e-9);
+    QVERIFY(qAbs(latitude - 50.0) < 1e-9);
+
+    // 带原点的批量转换：UTM 33N → WGS84 → UTM 33N 往返保持毫米级精度
+    CoordinateOrigin origin{400000.0, 5500000.0, 0.0};
+    std::vector<QVector3D> localPoints;
+    for (int i = 0; i < 1000; ++i) {
+        localPoints.emplace_back(i * 0.37f, i * 0.11f, i * 0.01f);
+    }
+
+    CoordinateOrigin geographicOrigin;
+    auto geographic = m_reader->transformCoordinates(localPoints, CoordinateSystem::UTM_Zone33N,
+                                                     CoordinateSystem::WGS84, origin, &geographicOrigin);
+    QVERIFY(qAbs(geographicOrigin.x - 13.6) < 0.1);
+    QVERIFY(qAbs(geographicOrigin.y - 49.6) < 0.1);
+
+    CoordinateOrigin roundTripOrigin;
+    auto roundTrip = m_reader->transformCoordinates(geographic, CoordinateSystem::WGS84,
+                                                    CoordinateSystem::UTM_Zone33N, geographicOrigin, &roundTripOrigin);
+    QCOMPARE(roundTrip.size(), localPoints.size());
+    for (size_t i = 0; i < localPoints.size(); ++i) {
+        double x, y, z;
+        roundTripOrigin.toGlobal(roundTrip[i], x, y, z);
+        QVERIFY(qAbs(x - (origin.x + localPoints[i].x())) < 0.01);
+        QVERIFY(qAbs(y - (origin.y + localPoints[i].y())) < 0.01);
+    }
+
+    // 仿射与逆仿射抵消
+    AffineTransform grid = AffineTransform::similarity2D(12.5, 1.0002, 350.0, -120.0, 4.0);
+    CoordinateTransformer affine;
+    affine.addAffine(grid).addAffine(grid.inverse());
+    double x = 1234.5, y = 678.9, z = 10.0;
+    affine.transform(x, y, z);
+    QVERIFY(qAbs(x - 1234.5) < 1e-9);
+    QVERIFY(qAbs(y - 678.9) < 1e-9);
+    QCOMPARE(affine.stepCount(), size_t(1));
+
+    // 未知坐标系统抛出异常
+    QVERIFY_EXCEPTION_THROWN(m_reader->transformCoordinates(localPoints, CoordinateSystem::Unknown,
+                                                            CoordinateSystem::WGS84),
+                             LASReaderException);
+}
+
+void LASReaderTest::testCoordinateOriginRebasing()
+{
+    // UTM量级坐标：解码后应为相对原点的局部坐标，加回原点后保持毫米精度
+    QString testFile = m_testDataDir + "/utm_origin_test.las";
+    const int pointCount = 100;
+    const double scale = 0.001;
+    const double offsetX = 512000.0;
+    const double offsetY = 5403000.0;
+    const double offsetZ = 250.0;
+
+    QFile file(testFile);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    QByteArray header(227, 0);
+    header[0] = 'L'; header[1] = 'A'; header[2] = 'S'; header[3] = 'F';
+    header[24] = 1; header[25] = 2;
+    *reinterpret_cast<quint32*>(header.data() + 96) = 227;
+    header[104] = 0;
+    *reinterpret_cast<quint16*>(header.data() + 105) = 20;
+    *reinterpret_cast<quint32*>(header.data() + 107) = pointCount;
+    const double scales[3] = {scale, scale, scale};
+    const double offsets[3] = {offsetX, offsetY, offsetZ};
+    const double bounds[6] = {offsetX + 123.457, offsetX, offsetY + 12.346, offsetY, offsetZ + 1.0, offsetZ};
+    memcpy(header.data() + 131, scales, sizeof(scales));
+    memcpy(header.data() + 155, offsets, sizeof(offsets));
+    memcpy(header.data() + 179, bounds, sizeof(bounds));
+    file.write(header);
+    for (int i = 0; i < pointCount; ++i) {
+        QByteArray pointData(20, 0);
+        *reinterpret_cast<qint32*>(pointData.data() + 0) = i * 1247 + 1;
+        *reinterpret_cast<qint32*>(pointData.data() + 4) = i * 123 + 7;
+        *reinterpret_cast<qint32*>(pointData.data() + 8) = i * 10;
+        file.write(pointData);
+    }
+    file.close();
+
+    WallExtraction::CoordinateOrigin origin = m_reader->getCoordinateOrigin(testFile);
+    QCOMPARE(origin.x, 512000.0);
+    QCOMPARE(origin.y, 5403000.0);
+    QCOMPARE(origin.z, 0.0);
+
+    auto points = m_reader->readPointCloud(testFile);
+    QCOMPARE(points.size(), size_t(pointCount));
+    for (int i = 0; i < pointCount; ++i) {
+        double x, y, z;
+        origin.toGlobal(points[i], x, y, z);
+        QVERIFY(qAbs(x - (offsetX + (i * 1247 + 1) * scale)) < 1e-4);
+        QVERIFY(qAbs(y - (offsetY + (i * 123 + 7) * scale)) < 1e-4);
+        QVERIFY(qAbs(z - (offsetZ + i * 10 * scale)) < 1e-4);
+    }
+
+    // 解码变换：毫米→米并将Y轴向上转换为Z轴向上，原点按归一化后的包围盒中心确定
+    WallExtraction::PointDecodeTransform transform = WallExtraction::PointDecodeTransform::yUpToZUp();
+    transform.scale = 0.001;
+    m_reader->setDecodeTransform(transform);
+
+    WallExtraction::CoordinateOrigin scaledOrigin = m_reader->getCoordinateOrigin(testFile);
+    QCOMPARE(scaledOrigin.x, 0.0);
+    QCOMPARE(scaledOrigin.y, 0.0);
+    QCOMPARE(scaledOrigin.z, 5000.0);
+
+    auto scaledPoints = m_reader->readPointCloud(testFile);
+    QCOMPARE(scaledPoints.size(), size_t(pointCount));
+    for (int i = 0; i < pointCount; ++i) {
+        double x, y, z;
+        scaledOrigin.toGlobal(scaledPoints[i], x, y, z);
+        QVERIFY(qAbs(x - (offsetX + (i * 1247 + 1) * scale) * 0.001) < 1e-4);
+        QVERIFY(qAbs(y + (offsetZ + i * 10 * scale) * 0.001) < 1e-4);
+        QVERIFY(qAbs(z - (offsetY + (i * 123 + 7) * scale) * 0.001) < 1e-4);
+    }
+
+    m_reader->setDecodeTransform(WallExtraction::PointDecodeTransform::identity());
+}
+
 void LASReaderTest::testClassificationParsing()
 {
     QString testFile = m_testDataDir + "/classification_test.las";
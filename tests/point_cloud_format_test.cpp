@@ -2,9 +2,16 @@
 #include <QDebug>
 #include <QTemporaryDir>
 #include <QFile>
+#include <QElapsedTimer>
+#include <QtMath>
 #include <memory>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include "../src/wall_extraction/point_cloud_processor.h"
 #include "../src/wall_extraction/las_reader.h"
+#include "../src/wall_extraction/point_cloud_statistics.h"
+#include "../src/wall_extraction/oriented_bounding_box.h"
 
 /**
  * 手动测试程序，验证T1.2任务的完成情况
@@ -94,6 +101,30 @@ int main(int argc, char *argv[])
             qDebug() << "✗ UTM coordinate system not supported";
             allTestsPassed = false;
         }
+
+        // 平移到局部原点的点云：处理器须把原点传给LASReader，结果与直接调用一致
+        try {
+            using WallExtraction::CoordinateOrigin;
+            using WallExtraction::CoordinateSystem;
+            CoordinateOrigin origin{400000.0, 5500000.0, 0.0};
+            std::vector<QVector3D> localPoints = {QVector3D(1.0f, 2.0f, 3.0f), QVector3D(120.0f, -40.0f, 5.0f)};
+            CoordinateOrigin processorOrigin;
+            CoordinateOrigin readerOrigin;
+            auto viaProcessor = processor->transformCoordinates(localPoints, CoordinateSystem::UTM_Zone33N,
+                                                                CoordinateSystem::WGS84, origin, &processorOrigin);
+            auto viaReader = lasReader->transformCoordinates(localPoints, CoordinateSystem::UTM_Zone33N,
+                                                             CoordinateSystem::WGS84, origin, &readerOrigin);
+            if (viaProcessor == viaReader && processorOrigin.x == readerOrigin.x &&
+                processorOrigin.y == readerOrigin.y && qAbs(processorOrigin.x - 13.6) < 0.1) {
+                qDebug() << "✓ Processor coordinate transform honours the coordinate origin";
+            } else {
+                qDebug() << "✗ Processor coordinate transform ignores the coordinate origin";
+                allTestsPassed = false;
+            }
+        } catch (const std::exception& e) {
+            qDebug() << "✗ Exception in coordinate transform:" << e.what();
+            allTestsPassed = false;
+        }
         
         // 测试7: 创建测试文件并检测格式
         qDebug() << "\n7. Testing format detection...";
@@ -179,8 +210,410 @@ int main(int argc, char *argv[])
             allTestsPassed = false;
         }
         
-        // 测试10: 元数据获取
-        qDebug() << "\n10. Testing metadata extraction...";
+        // 测试10: 统计离群点滤波
+        qDebug() << "\n10. Testing statistical outlier removal...";
+        try {
+            // 规则网格上的点加上远离网格的孤立点
+            std::vector<QVector3D> gridPoints;
+            for (int x = 0; x < 40; ++x) {
+                for (int y = 0; y < 40; ++y) {
+                    gridPoints.emplace_back(x * 0.1f, y * 0.1f, 0.0f);
+                }
+            }
+            std::vector<QVector3D> noisyPoints = gridPoints;
+            noisyPoints.emplace_back(2.0f, 2.0f, 5.0f);
+            noisyPoints.emplace_back(-3.0f, 1.0f, 2.0f);
+            noisyPoints.emplace_back(8.0f, 8.0f, -4.0f);
+            
+            QElapsedTimer sorTimer;
+            sorTimer.start();
+            auto filteredPoints = processor->removeOutliers(noisyPoints, 8, 2.0f);
+            qint64 sorTime = sorTimer.elapsed();
+            
+            bool outliersRemoved = std::none_of(filteredPoints.begin(), filteredPoints.end(),
+                                                [](const QVector3D& p) { return p.z() != 0.0f; });
+            if (outliersRemoved && filteredPoints.size() >= gridPoints.size() * 9 / 10) {
+                qDebug() << "✓ Outlier removal works, kept" << filteredPoints.size() << "of" << noisyPoints.size()
+                         << "points in" << sorTime << "ms";
+            } else {
+                qDebug() << "✗ Outlier removal incorrect, kept" << filteredPoints.size() << "points";
+                allTestsPassed = false;
+            }
+        } catch (const std::exception& e) {
+            qDebug() << "✗ Exception in outlier removal:" << e.what();
+            allTestsPassed = false;
+        }
+        
+        // 测试11: 半径离群点滤波和体素密度滤波
+        qDebug() << "\n11. Testing radius and voxel density filters...";
+        try {
+            std::vector<QVector3D> gridPoints;
+            for (int x = 0; x < 40; ++x) {
+                for (int y = 0; y < 40; ++y) {
+                    gridPoints.emplace_back(x * 0.1f, y * 0.1f, 0.0f);
+                }
+            }
+            // 稀疏鬼影点：两两成对，但远离主体点云
+            std::vector<QVector3D> noisyPoints = gridPoints;
+            noisyPoints.emplace_back(1.0f, 1.0f, 1.5f);
+            noisyPoints.emplace_back(1.02f, 1.0f, 1.5f);
+            noisyPoints.emplace_back(3.0f, 2.0f, 2.0f);
+            noisyPoints.emplace_back(3.0f, 2.03f, 2.0f);
+            
+            auto isGridPoint = [](const QVector3D& p) { return p.z() == 0.0f; };
+            
+            auto radiusFiltered = processor->removeRadiusOutliers(noisyPoints, 0.15f, 3);
+            if (radiusFiltered.size() == gridPoints.size() &&
+                std::all_of(radiusFiltered.begin(), radiusFiltered.end(), isGridPoint)) {
+                qDebug() << "✓ Radius outlier removal works, kept" << radiusFiltered.size() << "points";
+            } else {
+                qDebug() << "✗ Radius outlier removal incorrect, kept" << radiusFiltered.size() << "points";
+                allTestsPassed = false;
+            }
+            
+            auto densityFiltered = processor->filterByVoxelDensity(noisyPoints, 0.2f, 4);
+            if (densityFiltered.size() == gridPoints.size() &&
+                std::all_of(densityFiltered.begin(), densityFiltered.end(), isGridPoint)) {
+                qDebug() << "✓ Voxel density filter works, kept" << densityFiltered.size() << "points";
+            } else {
+                qDebug() << "✗ Voxel density filter incorrect, kept" << densityFiltered.size() << "points";
+                allTestsPassed = false;
+            }
+
+            // 非有限点没有所在体素，直接移除，也不参与确定体素原点
+            std::vector<QVector3D> nonFinitePoints = gridPoints;
+            nonFinitePoints.emplace_back(std::numeric_limits<float>::quiet_NaN(), 1.0f, 0.0f);
+            nonFinitePoints.emplace_back(1.0f, -std::numeric_limits<float>::infinity(), 0.0f);
+            auto finiteFiltered = processor->filterByVoxelDensity(nonFinitePoints, 0.2f, 4);
+            if (finiteFiltered.size() == gridPoints.size() &&
+                std::all_of(finiteFiltered.begin(), finiteFiltered.end(), [](const QVector3D& p) {
+                    return std::isfinite(p.x()) && std::isfinite(p.y()) && std::isfinite(p.z());
+                })) {
+                qDebug() << "✓ Voxel density filter removes non-finite points";
+            } else {
+                qDebug() << "✗ Voxel density filter kept non-finite points, kept" << finiteFiltered.size() << "points";
+                allTestsPassed = false;
+            }
+
+            // 通过参数启用后，预处理流程中多个滤波器共用同一空间索引
+            QVariantMap parameters = processor->getProcessingParameters();
+            parameters["radius_outlier_enabled"] = true;
+            parameters["density_filter_enabled"] = true;
+            parameters["density_filter_min_points"] = 4;
+            processor->setProcessingParameters(parameters);
+            auto preprocessed = processor->preprocessPointCloud(noisyPoints, true, false);
+            if (std::all_of(preprocessed.begin(), preprocessed.end(), isGridPoint) &&
+                preprocessed.size() >= gridPoints.size() * 9 / 10) {
+                qDebug() << "✓ Combined preprocessing filters work, kept" << preprocessed.size() << "points";
+            } else {
+                qDebug() << "✗ Combined preprocessing filters incorrect, kept" << preprocessed.size() << "points";
+                allTestsPassed = false;
+            }
+            parameters["radius_outlier_enabled"] = false;
+            parameters["density_filter_enabled"] = false;
+            processor->setProcessingParameters(parameters);
+        } catch (const std::exception& e) {
+            qDebug() << "✗ Exception in radius/density filters:" << e.what();
+            allTestsPassed = false;
+        }
+        
+        // 测试12: PCA法向量估计
+        qDebug() << "\n12. Testing normal estimation...";
+        try {
+            // 倾斜平面：法向量应与平面法向一致，按+Z定向
+            const QVector3D planeNormal = QVector3D(0.3f, -0.2f, 1.0f).normalized();
+            std::vector<QVector3D> planePoints;
+            for (int x = 0; x < 50; ++x) {
+                for (int y = 0; y < 50; ++y) {
+                    float px = x * 0.05f;
+                    float py = y * 0.05f;
+                    float pz = -(planeNormal.x() * px + planeNormal.y() * py) / planeNormal.z();
+                    planePoints.emplace_back(px, py, pz);
+                }
+            }
+            
+            std::vector<float> curvatures;
+            auto planeNormals = processor->estimateNormals(planePoints, 10, 0.0f,
+                                                           WallExtraction::NormalOrientation::PositiveZ,
+                                                           QVector3D(), &curvatures);
+            bool planeCorrect = planeNormals.size() == planePoints.size() &&
+                std::all_of(planeNormals.begin(), planeNormals.end(), [&](const QVector3D& n) {
+                    return QVector3D::dotProduct(n, planeNormal) > 0.999f;
+                }) &&
+                *std::max_element(curvatures.begin(), curvatures.end()) < 1e-3f;
+            
+            // 球面：视点在球心，法向量应指向球心
+            std::vector<QVector3D> spherePoints;
+            for (int i = 0; i < 40; ++i) {
+                for (int j = 1; j < 40; ++j) {
+                    float theta = i * 2.0f * 3.14159265f / 40.0f;
+                    float phi = j * 3.14159265f / 40.0f;
+                    spherePoints.emplace_back(std::sin(phi) * std::cos(theta),
+                                              std::sin(phi) * std::sin(theta),
+                                              std::cos(phi));
+                }
+            }
+            auto sphereNormals = processor->estimateNormals(spherePoints, 0, 0.3f,
+                                                            WallExtraction::NormalOrientation::TowardViewpoint,
+                                                            QVector3D(0, 0, 0));
+            bool sphereCorrect = true;
+            for (size_t i = 0; i < spherePoints.size(); ++i) {
+                if (QVector3D::dotProduct(sphereNormals[i], -spherePoints[i]) < 0.9f) {
+                    sphereCorrect = false;
+                    break;
+                }
+            }
+            
+            if (planeCorrect && sphereCorrect) {
+                qDebug() << "✓ Normal estimation works for plane (kNN) and sphere (radius)";
+            } else {
+                qDebug() << "✗ Normal estimation incorrect, plane:" << planeCorrect << "sphere:" << sphereCorrect;
+                allTestsPassed = false;
+            }
+        } catch (const std::exception& e) {
+            qDebug() << "✗ Exception in normal estimation:" << e.what();
+            allTestsPassed = false;
+        }
+        
+        // 测试13: 地板/天花板检测和形态学地面滤波
+        qDebug() << "\n13. Testing floor/ceiling detection and ground filter...";
+        try {
+            // 两层建筑：楼板厚0.3米，每层有地板、天花板和四面墙
+            std::vector<QVector3D> buildingPoints;
+            std::vector<int> expectedLabels; // 1地板 2天花板 0墙面
+            for (int storey = 0; storey < 2; ++storey) {
+                float base = storey * 3.3f;
+                for (int x = 0; x < 50; ++x) {
+                    for (int y = 0; y < 40; ++y) {
+                        buildingPoints.emplace_back(x * 0.2f, y * 0.2f, base);
+                        expectedLabels.push_back(1);
+                        buildingPoints.emplace_back(x * 0.2f + 0.1f, y * 0.2f + 0.1f, base + 3.0f);
+                        expectedLabels.push_back(2);
+                    }
+                }
+                for (int i = 0; i < 180; ++i) {
+                    for (int z = 1; z < 30; ++z) {
+                        float t = i * 0.2f;
+                        QVector3D wallPoint = t < 10.0f ? QVector3D(t, 0.0f, 0.0f)
+                                            : t < 18.0f ? QVector3D(10.0f, t - 10.0f, 0.0f)
+                                            : t < 28.0f ? QVector3D(t - 18.0f, 8.0f, 0.0f)
+                                                        : QVector3D(0.0f, t - 28.0f, 0.0f);
+                        wallPoint.setZ(base + z * 0.1f);
+                        buildingPoints.push_back(wallPoint);
+                        expectedLabels.push_back(0);
+                    }
+                }
+            }
+            
+            auto floorResult = processor->detectFloorAndCeiling(buildingPoints);
+            int floorSurfaces = 0;
+            int ceilingSurfaces = 0;
+            for (const auto& surface : floorResult.surfaces) {
+                surface.isFloor ? ++floorSurfaces : ++ceilingSurfaces;
+            }
+            bool masksCorrect = floorResult.floorMask.size() == buildingPoints.size();
+            for (size_t i = 0; masksCorrect && i < buildingPoints.size(); ++i) {
+                if ((expectedLabels[i] == 1 && !floorResult.floorMask[i]) ||
+                    (expectedLabels[i] == 2 && !floorResult.ceilingMask[i]) ||
+                    (floorResult.floorMask[i] && floorResult.ceilingMask[i])) {
+                    masksCorrect = false;
+                }
+            }
+            if (floorSurfaces == 2 && ceilingSurfaces == 2 && masksCorrect) {
+                qDebug() << "✓ Floor/ceiling detection works for a two-storey building";
+            } else {
+                qDebug() << "✗ Floor/ceiling detection incorrect, floors:" << floorSurfaces
+                         << "ceilings:" << ceilingSurfaces << "masks:" << masksCorrect;
+                allTestsPassed = false;
+            }
+            
+            // 室外：坡地上的一栋高8米的建筑
+            std::vector<QVector3D> terrainPoints;
+            std::vector<char> expectedGround;
+            for (int x = 0; x < 200; ++x) {
+                for (int y = 0; y < 200; ++y) {
+                    float px = x * 0.25f;
+                    float py = y * 0.25f;
+                    bool onRoof = px > 20.0f && px < 30.0f && py > 20.0f && py < 28.0f;
+                    terrainPoints.emplace_back(px, py, 0.05f * px + (onRoof ? 8.0f : 0.0f));
+                    expectedGround.push_back(onRoof ? 0 : 1);
+                }
+            }
+            auto groundMask = processor->progressiveMorphologicalFilter(terrainPoints, 1.0f, 32.0f);
+            if (groundMask == expectedGround) {
+                qDebug() << "✓ Progressive morphological filter separates roof from sloped terrain";
+            } else {
+                qDebug() << "✗ Progressive morphological filter incorrect";
+                allTestsPassed = false;
+            }
+        } catch (const std::exception& e) {
+            qDebug() << "✗ Exception in floor/ceiling detection:" << e.what();
+            allTestsPassed = false;
+        }
+        
+        // 测试14: 滤波流水线
+        qDebug() << "\n14. Testing filter pipeline...";
+        try {
+            std::vector<QVector3D> cubePoints;
+            for (int x = 0; x < 40; ++x) {
+                for (int y = 0; y < 40; ++y) {
+                    for (int z = 0; z < 20; ++z) {
+                        cubePoints.emplace_back(x * 0.1f + 0.05f, y * 0.1f + 0.05f, z * 0.1f + 0.05f);
+                    }
+                }
+            }
+            
+            using WallExtraction::FilterStage;
+            std::vector<FilterStage> stages = {
+                FilterStage::heightRange(0.0f, 1.0f),
+                FilterStage::bounds(QVector3D(1.0f, 1.0f, -10.0f), QVector3D(3.0f, 3.0f, 10.0f)),
+                FilterStage::voxelDownsample(0.2f),
+                FilterStage::statisticalOutlier(8, 3.0f)
+            };
+            auto pipelineResult = processor->runFilterPipeline(cubePoints, stages);
+            
+            // 逐点阶段与体素下采样融合为一个阶段，邻域阶段单独统计
+            bool timingsCorrect = pipelineResult.stageTimings.size() == 2 &&
+                                  pipelineResult.stageTimings[0].fused &&
+                                  pipelineResult.stageTimings[0].name == "HeightRange+Bounds+VoxelDownsample" &&
+                                  pipelineResult.stageTimings[0].inputCount == cubePoints.size();
+            
+            // 高度和范围过滤后为20x20x10个点，每个0.2米体素保留一个原始点
+            auto sequential = processor->filterByHeight(cubePoints, 0.0f, 1.0f);
+            auto filtered = processor->applyFilterPipeline(cubePoints, stages);
+            bool selectionCorrect = pipelineResult.stageTimings.size() == 2 &&
+                                    pipelineResult.stageTimings[0].outputCount == 10 * 10 * 5 &&
+                                    pipelineResult.stageTimings[1].outputCount == pipelineResult.indices.size() &&
+                                    std::is_sorted(pipelineResult.indices.begin(), pipelineResult.indices.end()) &&
+                                    filtered.size() == pipelineResult.indices.size() &&
+                                    std::all_of(filtered.begin(), filtered.end(), [](const QVector3D& p) {
+                                        return p.z() <= 1.0f && p.x() >= 1.0f && p.x() <= 3.0f &&
+                                               p.y() >= 1.0f && p.y() <= 3.0f;
+                                    }) &&
+                                    sequential.size() == 40 * 40 * 10;
+            
+            if (timingsCorrect && selectionCorrect) {
+                qDebug() << "✓ Filter pipeline works, kept" << filtered.size() << "of" << cubePoints.size()
+                         << "points in" << pipelineResult.totalElapsedMs << "ms";
+            } else {
+                qDebug() << "✗ Filter pipeline incorrect, timings:" << timingsCorrect
+                         << "selection:" << selectionCorrect << "kept:" << pipelineResult.indices.size();
+                allTestsPassed = false;
+            }
+
+            // 非有限点与任何边界比较都为假，逐点阶段和体素下采样须显式排除
+            std::vector<QVector3D> nonFinitePoints = cubePoints;
+            nonFinitePoints.emplace_back(std::numeric_limits<float>::quiet_NaN(), 0.5f, 0.5f);
+            nonFinitePoints.emplace_back(0.5f, 0.5f, std::numeric_limits<float>::infinity());
+            bool nonFiniteRemoved = true;
+            for (const auto& nonFiniteStages : {std::vector<FilterStage>{FilterStage::voxelDownsample(0.2f)},
+                                                std::vector<FilterStage>{FilterStage::heightRange(-10.0f, 10.0f)}}) {
+                auto nonFiniteResult = processor->runFilterPipeline(nonFinitePoints, nonFiniteStages);
+                nonFiniteRemoved = nonFiniteRemoved &&
+                                   std::all_of(nonFiniteResult.indices.begin(), nonFiniteResult.indices.end(),
+                                               [&](quint32 index) { return index < cubePoints.size(); });
+            }
+            if (nonFiniteRemoved) {
+                qDebug() << "✓ Filter pipeline removes non-finite points";
+            } else {
+                qDebug() << "✗ Filter pipeline kept non-finite points";
+                allTestsPassed = false;
+            }
+        } catch (const std::exception& e) {
+            qDebug() << "✗ Exception in filter pipeline:" << e.what();
+            allTestsPassed = false;
+        }
+        
+        // 测试15: 点云统计（边界、均值、方差、高度分位数）
+        qDebug() << "\n15. Testing point cloud statistics...";
+        try {
+            std::vector<QVector3D> statPoints;
+            for (int i = 0; i < 100001; ++i) {
+                statPoints.emplace_back(static_cast<float>(i % 101), static_cast<float>(i % 7) - 3.0f,
+                                        static_cast<float>(i) * 1e-4f);
+            }
+            statPoints.emplace_back(std::numeric_limits<float>::quiet_NaN(), 0.0f, 0.0f);
+            statPoints.emplace_back(1e12f, 0.0f, 0.0f);
+            
+            auto bounds = WallExtraction::computePointCloudBounds(statPoints, 1e10f);
+            auto statistics = WallExtraction::computePointCloudStatistics(statPoints);
+            auto bbox = processor->computeBoundingBox(statPoints);
+            
+            bool boundsCorrect = bounds.validCount == 100001 &&
+                                 bounds.minPoint == QVector3D(0.0f, -3.0f, 0.0f) &&
+                                 bounds.maxPoint == QVector3D(100.0f, 3.0f, 10.0f);
+            // 未设置坐标上限时1e12的点仍然有效，NaN点始终被排除
+            bool statisticsCorrect = statistics.bounds.validCount == 100002 &&
+                                     bbox.second.x() == 1e12f &&
+                                     std::abs(WallExtraction::computePointCloudStatistics(
+                                         std::vector<QVector3D>(statPoints.begin(), statPoints.end() - 2))
+                                         .zPercentile(0.5) - 5.0f) < 0.1f;
+            
+            if (boundsCorrect && statisticsCorrect) {
+                qDebug() << "✓ Point cloud statistics work, bounds:" << bounds.minPoint << "-" << bounds.maxPoint;
+            } else {
+                qDebug() << "✗ Point cloud statistics incorrect, bounds:" << boundsCorrect
+                         << "statistics:" << statisticsCorrect;
+                allTestsPassed = false;
+            }
+        } catch (const std::exception& e) {
+            qDebug() << "✗ Exception in point cloud statistics:" << e.what();
+            allTestsPassed = false;
+        }
+        
+        // 测试16: 有向包围盒和主方向对齐
+        qDebug() << "\n16. Testing oriented bounding box and dominant axis alignment...";
+        try {
+            // 30m x 12m x 6m 的矩形建筑外墙，绕Z轴旋转27°
+            const float yaw = qDegreesToRadians(27.0f);
+            const float c = std::cos(yaw);
+            const float s = std::sin(yaw);
+            std::vector<QVector3D> buildingPoints;
+            for (int i = 0; i <= 300; ++i) {
+                for (int k = 0; k <= 30; ++k) {
+                    float t = i / 300.0f;
+                    float z = k * 0.2f;
+                    const QVector3D local[4] = {QVector3D(t * 30.0f, 0.0f, z), QVector3D(t * 30.0f, 12.0f, z),
+                                                QVector3D(0.0f, t * 12.0f, z), QVector3D(30.0f, t * 12.0f, z)};
+                    for (const QVector3D& p : local) {
+                        buildingPoints.emplace_back(c * p.x() - s * p.y() + 100.0f, s * p.x() + c * p.y() + 50.0f, p.z());
+                    }
+                }
+            }
+            
+            auto box = WallExtraction::computeOrientedBoundingBox(buildingPoints);
+            bool boxCorrect = box.valid &&
+                              std::abs(box.size().x() - 30.0f) < 0.01f &&
+                              std::abs(box.size().y() - 12.0f) < 0.01f &&
+                              std::abs(box.size().z() - 6.0f) < 0.01f &&
+                              std::abs(qRadiansToDegrees(box.yaw) - 27.0f) < 0.1f;
+            
+            auto alignment = processor->estimateDominantAxisAlignment(buildingPoints);
+            bool alignmentCorrect = alignment.valid &&
+                                    std::abs(qRadiansToDegrees(alignment.angle) - 27.0f) < 1.0f;
+            
+            // 对齐后轴对齐包围盒应接近建筑实际尺寸
+            auto alignedBounds = WallExtraction::computePointCloudBounds(
+                WallExtraction::alignPoints(buildingPoints, alignment));
+            QVector3D alignedSize = alignedBounds.size();
+            bool tighter = alignedSize.x() * alignedSize.y() < 30.0f * 12.0f * 1.05f;
+            
+            if (boxCorrect && alignmentCorrect && tighter) {
+                qDebug() << "✓ Oriented bounding box works, size:" << box.size()
+                         << "yaw:" << qRadiansToDegrees(box.yaw)
+                         << "alignment:" << qRadiansToDegrees(alignment.angle);
+            } else {
+                qDebug() << "✗ Oriented bounding box incorrect, box:" << boxCorrect
+                         << "alignment:" << alignmentCorrect << "aligned size:" << alignedSize;
+                allTestsPassed = false;
+            }
+        } catch (const std::exception& e) {
+            qDebug() << "✗ Exception in oriented bounding box:" << e.what();
+            allTestsPassed = false;
+        }
+        
+        // 测试17: 元数据获取
+        qDebug() << "\n17. Testing metadata extraction...";
         try {
             auto metadata = processor->getMetadata(xyzFile);
             if (metadata.isValid()) {
@@ -204,8 +637,8 @@ int main(int argc, char *argv[])
             allTestsPassed = false;
         }
         
-        // 测试11: 异常处理
-        qDebug() << "\n11. Testing exception handling...";
+        // 测试18: 异常处理
+        qDebug() << "\n18. Testing exception handling...";
         try {
             processor->readPointCloud("/nonexistent/file.xyz");
             qDebug() << "✗ Exception should have been thrown for nonexistent file";
@@ -3,6 +3,7 @@
 #include <QElapsedTimer>
 #include <QVector3D>
 #include <memory>
+#include <algorithm>
 #include "point_cloud_lod_manager.h"
 #include "spatial_index.h"
 #include "point_cloud_memory_manager.h"
@@ -30,12 +31,18 @@ private slots:
     void testKDTreeCreation();
     void testKDTreeQuery();
     void testSpatialIndexPerformance();
+    void testPointKDTreeQueries();
     
     // 内存管理测试
     void testMemoryManagerCreation();
     void testChunkedLoading();
     void testMemoryUsageOptimization();
     void testProgressiveRendering();
+    void testSpatialChunking();
+    void testAsyncPrefetch();
+    void testEvictionPolicies();
+    void testChunkCompression();
+    void testPointBudgetSelection();
     
     // 性能基准测试
     void testLargeDatasetPerformance();
@@ -248,6 +255,61 @@ void PointCloudPerformanceTest::testKDTreeQuery()
     }
 }
 
+void PointCloudPerformanceTest::testPointKDTreeQueries()
+{
+    auto points = generateTestPointCloud(5000);
+    WallExtraction::PointKDTree tree(points);
+    QCOMPARE(tree.size(), points.size());
+    
+    std::vector<quint32> indices;
+    std::vector<float> squaredDistances;
+    
+    for (int q = 0; q < 50; ++q) {
+        QVector3D queryPoint = points[q * 97 % points.size()] + QVector3D(0.3f, -0.2f, 0.1f);
+        
+        // 与暴力搜索结果比较
+        std::vector<float> bruteForce;
+        for (const auto& point : points) {
+            bruteForce.push_back((point - queryPoint).lengthSquared());
+        }
+        std::sort(bruteForce.begin(), bruteForce.end());
+        
+        QCOMPARE(tree.knnSearch(queryPoint, 10, indices, squaredDistances), size_t(10));
+        for (size_t j = 0; j < 10; ++j) {
+            QVERIFY(qAbs(squaredDistances[j] - bruteForce[j]) < 1e-3f);
+            QVERIFY(qAbs((points[indices[j]] - queryPoint).lengthSquared() - squaredDistances[j]) < 1e-3f);
+        }
+        
+        float radius = qSqrt(bruteForce[15]);
+        size_t expected = std::upper_bound(bruteForce.begin(), bruteForce.end(), radius * radius) - bruteForce.begin();
+        QCOMPARE(tree.radiusSearch(queryPoint, radius, indices), expected);
+        QCOMPARE(tree.radiusCount(queryPoint, radius), expected);
+        QCOMPARE(tree.radiusCount(queryPoint, radius, 5), size_t(5));
+    }
+
+    // 按选择索引建树：只包含选中的点，查询结果为点在选择中的位置
+    std::vector<quint32> selection;
+    for (quint32 i = 0; i < points.size(); i += 3) {
+        selection.push_back(i);
+    }
+    WallExtraction::PointKDTree subsetTree(points, selection);
+    QCOMPARE(subsetTree.size(), selection.size());
+
+    QVector3D queryPoint = points[1];
+    std::vector<float> bruteForce;
+    for (quint32 index : selection) {
+        bruteForce.push_back((points[index] - queryPoint).lengthSquared());
+    }
+    std::sort(bruteForce.begin(), bruteForce.end());
+
+    QCOMPARE(subsetTree.knnSearch(queryPoint, 10, indices, squaredDistances), size_t(10));
+    for (size_t j = 0; j < 10; ++j) {
+        QVERIFY(indices[j] < selection.size());
+        QVERIFY(qAbs(squaredDistances[j] - bruteForce[j]) < 1e-3f);
+        QVERIFY(qAbs((points[selection[indices[j]]] - queryPoint).lengthSquared() - squaredDistances[j]) < 1e-3f);
+    }
+}
+
 void PointCloudPerformanceTest::testSpatialIndexPerformance()
 {
     auto largePoints = generateLargeTestPointCloud(100000);
@@ -337,6 +399,172 @@ void PointCloudPerformanceTest::testProgressiveRendering()
     }
 }
 
+void PointCloudPerformanceTest::testSpatialChunking()
+{
+    auto largePoints = generateLargeTestPointCloud(200000);
+    m_memoryManager->loadPointCloudChunked(largePoints, 10000);
+    
+    QVERIFY(m_memoryManager->getTotalChunkCount() == 20);
+    
+    // 空间分块后每个块的边界框应远小于整体边界框
+    float totalVolume = 1000.0f * 1000.0f * 100.0f;
+    float chunkVolumeSum = 0.0f;
+    for (size_t i = 0; i < m_memoryManager->getTotalChunkCount(); ++i) {
+        auto bbox = m_memoryManager->getChunkBoundingBox(i);
+        QVector3D size = bbox.second - bbox.first;
+        chunkVolumeSum += size.x() * size.y() * size.z();
+    }
+    
+    QVERIFY(chunkVolumeSum < totalVolume * 5.0f); // 按文件顺序分块时约为块数倍
+    
+    qDebug() << "Spatial chunking - chunk volume sum ratio:" << chunkVolumeSum / totalVolume;
+}
+
+void PointCloudPerformanceTest::testAsyncPrefetch()
+{
+    auto largePoints = generateLargeTestPointCloud(200000);
+    m_memoryManager->loadPointCloudChunked(largePoints, 10000);
+    m_memoryManager->setPrefetchEnabled(true);
+    
+    // 区域预取在后台完成，不阻塞调用线程
+    QVERIFY(m_memoryManager->preloadRegion(QVector3D(500, 500, 50), 2000.0f));
+    QVERIFY(m_memoryManager->waitForPrefetch(5000));
+    QCOMPARE(m_memoryManager->getPendingPrefetchCount(), size_t(0));
+    
+    size_t residentCount = 0;
+    for (size_t i = 0; i < m_memoryManager->getTotalChunkCount(); ++i) {
+        if (m_memoryManager->isChunkResident(i)) {
+            residentCount++;
+        }
+    }
+    QVERIFY(residentCount > 4); // 初始只加载4个块
+    
+    // 相机运动状态由连续两次更新估计
+    m_memoryManager->updateCameraState(QVector3D(0, 0, 500), QVector3D(0, 0, -1));
+    QTest::qWait(20);
+    m_memoryManager->updateCameraState(QVector3D(100, 0, 500), QVector3D(0, 0, -1));
+    m_memoryManager->waitForPrefetch(5000);
+    
+    WallExtraction::CameraMotionState camera = m_memoryManager->getCameraMotionState();
+    QVERIFY(camera.isValid);
+    QVERIFY(camera.velocity.x() > 0.0f);
+}
+
+void PointCloudPerformanceTest::testEvictionPolicies()
+{
+    auto points = generateLargeTestPointCloud(200000);
+    
+    // 块的跨度达数百米，超出默认量化误差，按浮点存储：每块10000点×12字节，1MB预算约可容纳8个块
+    const QList<WallExtraction::MemoryStrategy> strategies = {
+        WallExtraction::MemoryStrategy::LFU,
+        WallExtraction::MemoryStrategy::ARC,
+        WallExtraction::MemoryStrategy::CostAware
+    };
+    
+    for (auto strategy : strategies) {
+        m_memoryManager->setPrefetchEnabled(false);
+        m_memoryManager->setMaxMemoryUsage(1);
+        m_memoryManager->setMemoryStrategy(strategy);
+        m_memoryManager->loadPointCloudChunked(points, 10000);
+        
+        // 热点块被反复访问后，一次顺序扫描不应将其淘汰
+        for (int i = 0; i < 10; ++i) {
+            m_memoryManager->getChunkPoints(0);
+        }
+        for (size_t i = 1; i < m_memoryManager->getTotalChunkCount(); ++i) {
+            m_memoryManager->getChunkPoints(i);
+        }
+        
+        QVERIFY(m_memoryManager->isChunkResident(0));
+        QVERIFY(m_memoryManager->getCurrentMemoryUsage() <= 1024 * 1024);
+        
+        QVariantMap stats = m_memoryManager->getMemoryStatistics();
+        QVariantMap policy = stats["policy_statistics"].toMap()
+            [WallExtraction::PointCloudMemoryManager::memoryStrategyName(strategy)].toMap();
+        QVERIFY(policy["hits"].toULongLong() >= 10);
+        QVERIFY(policy["misses"].toULongLong() > 0);
+        QVERIFY(policy["evictions"].toULongLong() > 0);
+    }
+}
+
+void PointCloudPerformanceTest::testChunkCompression()
+{
+    // 单块精度：x坐标间距远大于量化误差，排序后可逐点比较
+    std::vector<QVector3D> points;
+    for (int i = 0; i < 1000; ++i) {
+        points.emplace_back(i * 0.1f, (i * 37 % 1000) * 0.05f, (i % 17) * 0.3f);
+    }
+    
+    m_memoryManager->setPrefetchEnabled(false);
+    m_memoryManager->loadPointCloudChunked(points, 1000);
+    auto decoded = m_memoryManager->getChunkPoints(0);
+    QCOMPARE(decoded.size(), points.size());
+    
+    auto byX = [](const QVector3D& a, const QVector3D& b) { return a.x() < b.x(); };
+    std::sort(decoded.begin(), decoded.end(), byX);
+    for (size_t i = 0; i < points.size(); ++i) {
+        QVERIFY((decoded[i] - points[i]).length() < 0.002f);
+    }
+    
+    // 量化后驻留内存约为浮点存储的一半，冷数据进一步压缩
+    // 块的跨度可达1000m，16位量化误差约7.6mm，放宽允许误差使所有块都量化
+    auto largePoints = generateLargeTestPointCloud(200000);
+    m_memoryManager->setMaxQuantizationError(0.01f);
+    m_memoryManager->loadPointCloudChunked(largePoints, 10000);
+    for (size_t i = 0; i < m_memoryManager->getTotalChunkCount(); ++i) {
+        QCOMPARE(m_memoryManager->getChunkPoints(i).size(), size_t(10000));
+    }
+    
+    QVERIFY(m_memoryManager->getCurrentMemoryUsage() <= largePoints.size() * 3 * sizeof(quint16));
+    
+    QVariantMap stats = m_memoryManager->getMemoryStatistics();
+    QCOMPARE(stats["quantized_chunks"].toULongLong(), 20ULL);
+    QVERIFY(stats["cold_compression_ratio"].toDouble() > 1.8); // 均匀随机点是最差情况
+    
+    qDebug() << "Chunk compression - cold ratio:" << stats["cold_compression_ratio"].toDouble();
+}
+
+void PointCloudPerformanceTest::testPointBudgetSelection()
+{
+    auto largePoints = generateLargeTestPointCloud(200000);
+    m_memoryManager->setPrefetchEnabled(false);
+    m_memoryManager->loadPointCloudChunked(largePoints, 10000);
+    
+    // 从正上方俯视整个场景
+    const size_t budget = 50000;
+    auto views = m_memoryManager->selectPointBudget(QVector3D(500, 500, 2000), QVector3D(0, 0, -1),
+                                                    60.0f, 0.1f, 5000.0f, budget);
+    
+    // 整个场景可见时每个块都应参与，而不是丢弃部分区域
+    QCOMPARE(views.size(), m_memoryManager->getTotalChunkCount());
+    
+    size_t totalPoints = 0;
+    for (size_t k = 0; k < views.size(); ++k) {
+        const auto& view = views[k];
+        totalPoints += view.pointCount;
+        QVERIFY(view.stride > 1);
+        
+        if (k > 0) {
+            QVERIFY(view.screenCoverage <= views[k - 1].screenCoverage);
+        }
+        
+        // 视图直接引用块数据，解码出的点位于块边界框内
+        auto bbox = m_memoryManager->getChunkBoundingBox(view.chunkIndex);
+        QVector3D p = view.point(view.pointCount - 1);
+        QVERIFY(p.x() >= bbox.first.x() - 0.01f && p.x() <= bbox.second.x() + 0.01f);
+        QVERIFY(p.z() >= bbox.first.z() - 0.01f && p.z() <= bbox.second.z() + 0.01f);
+        
+        // 被视图引用的块不可卸载
+        QVERIFY(!m_memoryManager->unloadChunk(view.chunkIndex));
+    }
+    
+    QVERIFY(totalPoints <= budget);
+    QVERIFY(totalPoints > budget / 2);
+    
+    m_memoryManager->releaseRenderViews();
+    QVERIFY(m_memoryManager->unloadChunk(views.front().chunkIndex));
+}
+
 void PointCloudPerformanceTest::testLargeDatasetPerformance()
 {
     // 测试百万级点云的性能
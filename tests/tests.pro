@@ -16,13 +16,28 @@ INCLUDEPATH += ../
 
 # 测试源文件
 SOURCES += \
-    wall_extraction_manager_test.cpp
+    wall_extraction_manager_test.cpp \
+    wall_fitting_engine_test.cpp
+
+HEADERS += \
+    wall_fitting_engine_test.h
 
 # 包含被测试的源文件
 SOURCES += \
     ../src/wall_extraction/wall_extraction_manager.cpp \
     ../src/wall_extraction/line_drawing_tool.cpp \
     ../src/wall_extraction/wall_fitting_algorithm.cpp \
+    ../src/wall_extraction/efficient_ransac.cpp \
+    ../src/wall_extraction/region_growing.cpp \
+    ../src/wall_extraction/plane_fitting.cpp \
+    ../src/wall_extraction/wall_regularization.cpp \
+    ../src/wall_extraction/wall_thickness.cpp \
+    ../src/wall_extraction/incremental_wall_fitter.cpp \
+    ../src/wall_extraction/wall_fitting_job.cpp \
+    ../src/wall_extraction/spatial_index.cpp \
+    ../src/wall_extraction/normal_estimation.cpp \
+    ../src/wall_extraction/point_cloud_statistics.cpp \
+    ../src/wall_extraction/oriented_bounding_box.cpp \
     ../src/wall_extraction/wireframe_generator.cpp
 
 # 包含被测试的头文件
@@ -30,6 +45,17 @@ HEADERS += \
     ../src/wall_extraction/wall_extraction_manager.h \
     ../src/wall_extraction/line_drawing_tool.h \
     ../src/wall_extraction/wall_fitting_algorithm.h \
+    ../src/wall_extraction/efficient_ransac.h \
+    ../src/wall_extraction/region_growing.h \
+    ../src/wall_extraction/plane_fitting.h \
+    ../src/wall_extraction/wall_regularization.h \
+    ../src/wall_extraction/wall_thickness.h \
+    ../src/wall_extraction/incremental_wall_fitter.h \
+    ../src/wall_extraction/wall_fitting_job.h \
+    ../src/wall_extraction/spatial_index.h \
+    ../src/wall_extraction/normal_estimation.h \
+    ../src/wall_extraction/point_cloud_statistics.h \
+    ../src/wall_extraction/oriented_bounding_box.h \
     ../src/wall_extraction/wireframe_generator.h
 
 # 链接库（与主项目保持一致）
@@ -1,7 +1,9 @@
 #include <QtTest/QtTest>
+#include <QApplication>
 #include <QObject>
 #include <memory>
 #include "wall_extraction_manager.h"
+#include "wall_fitting_engine_test.h"
 
 class WallExtractionManagerTest : public QObject
 {
@@ -177,5 +179,22 @@ void WallExtractionManagerTest::testExceptionHandling()
     }
 }
 
-QTEST_MAIN(WallExtractionManagerTest)
+// 管理器测试和各引擎的测试编进同一个测试程序，依次执行
+int main(int argc, char* argv[])
+{
+    QApplication app(argc, argv);
+    QTEST_SET_MAIN_SOURCE_PATH
+
+    int status = 0;
+    {
+        WallExtractionManagerTest managerTest;
+        status |= QTest::qExec(&managerTest, argc, argv);
+    }
+    {
+        WallFittingEngineTest engineTest;
+        status |= QTest::qExec(&engineTest, argc, argv);
+    }
+    return status;
+}
+
 #include "wall_extraction_manager_test.moc"
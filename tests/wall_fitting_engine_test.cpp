@@ -0,0 +1,554 @@
+#include "wall_fitting_engine_test.h"
+#include <QtTest/QtTest>
+#include <QSignalSpy>
+#include <QtMath>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <set>
+#include "efficient_ransac.h"
+#include "region_growing.h"
+#include "spatial_index.h"
+#include "plane_fitting.h"
+#include "wall_regularization.h"
+#include "wall_thickness.h"
+#include "incremental_wall_fitter.h"
+#include "wall_fitting_job.h"
+
+namespace {
+
+// 合成房间：6m x 4m，墙高3m，点间距5cm，墙面法向噪声3mm
+const float kRoomWidth = 6.0f;
+const float kRoomDepth = 4.0f;
+const float kRoomHeight = 3.0f;
+const float kPointSpacing = 0.05f;
+const float kSurfaceNoise = 0.003f;
+
+// 检测结果中每面墙至少包含的点数（约为墙面点数的85%）
+const size_t kMinLongWallInliers = 6000;
+const size_t kMinShortWallInliers = 4000;
+const size_t kMinFloorInliers = 8000;
+
+} // namespace
+
+void WallFittingEngineTest::initTestCase()
+{
+    qDebug() << "Starting wall fitting engine test suite";
+}
+
+void WallFittingEngineTest::cleanupTestCase()
+{
+    qDebug() << "Finished wall fitting engine test suite";
+}
+
+void WallFittingEngineTest::testSequentialRansacDetectsRoomWalls()
+{
+    // 逐个平面RANSAC：假设并行评估、预检验淘汰和提前终止不能漏掉最优平面
+    WallExtraction::WallFittingAlgorithm algorithm;
+    QVERIFY(algorithm.initialize());
+    algorithm.setPlaneDetectionMethod(WallExtraction::PlaneDetectionMethod::SequentialRANSAC);
+
+    std::vector<WallExtraction::Plane3D> planes = algorithm.detectPlanes(generateRoomPointCloud(true));
+
+    // 地面被检测后移除，只保留四面墙
+    QCOMPARE(planes.size(), size_t(4));
+    QVERIFY(containsPlane(planes, QVector3D(0, 1, 0), 0.0f, kMinLongWallInliers));
+    QVERIFY(containsPlane(planes, QVector3D(0, 1, 0), kRoomDepth, kMinLongWallInliers));
+    QVERIFY(containsPlane(planes, QVector3D(1, 0, 0), 0.0f, kMinShortWallInliers));
+    QVERIFY(containsPlane(planes, QVector3D(1, 0, 0), kRoomWidth, kMinShortWallInliers));
+}
+
+void WallFittingEngineTest::testEfficientRansacDetectsRoomPlanes()
+{
+    // 高效RANSAC一次检测全部平面，内点互不重叠
+    const std::vector<QVector3D> points = generateRoomPointCloud(true);
+    WallExtraction::EfficientRANSAC detector;
+    std::vector<WallExtraction::Plane3D> planes = detector.detect(points);
+
+    QVERIFY(containsPlane(planes, QVector3D(0, 0, 1), 0.0f, kMinFloorInliers));
+    QVERIFY(containsPlane(planes, QVector3D(0, 1, 0), 0.0f, kMinLongWallInliers));
+    QVERIFY(containsPlane(planes, QVector3D(0, 1, 0), kRoomDepth, kMinLongWallInliers));
+    QVERIFY(containsPlane(planes, QVector3D(1, 0, 0), 0.0f, kMinShortWallInliers));
+    QVERIFY(containsPlane(planes, QVector3D(1, 0, 0), kRoomWidth, kMinShortWallInliers));
+
+    std::vector<char> assigned(points.size(), 0);
+    for (const WallExtraction::Plane3D& plane : planes) {
+        for (int index : plane.inlierIndices) {
+            QVERIFY(!assigned[index]);
+            assigned[index] = 1;
+        }
+    }
+
+    const QVariantMap statistics = detector.getStatistics();
+    QCOMPARE(statistics.value("planes_detected").toInt(), static_cast<int>(planes.size()));
+    QVERIFY(statistics.value("candidates_generated").toULongLong() > 0);
+}
+
+void WallFittingEngineTest::testRegionGrowingSegmentsRoomPlanes()
+{
+    // 区域生长：相交的墙面和地面分成不同区域，结果按内点数降序排列
+    const std::vector<QVector3D> points = generateRoomPointCloud(true);
+    WallExtraction::RegionGrowingSegmenter segmenter;
+    std::vector<WallExtraction::Plane3D> planes = segmenter.segment(points);
+
+    QCOMPARE(planes.size(), size_t(5));
+    QVERIFY(containsPlane(planes, QVector3D(0, 0, 1), 0.0f, kMinFloorInliers));
+    QVERIFY(containsPlane(planes, QVector3D(0, 1, 0), 0.0f, kMinLongWallInliers));
+    QVERIFY(containsPlane(planes, QVector3D(0, 1, 0), kRoomDepth, kMinLongWallInliers));
+    QVERIFY(containsPlane(planes, QVector3D(1, 0, 0), 0.0f, kMinShortWallInliers));
+    QVERIFY(containsPlane(planes, QVector3D(1, 0, 0), kRoomWidth, kMinShortWallInliers));
+
+    std::vector<char> assigned(points.size(), 0);
+    for (size_t i = 0; i < planes.size(); ++i) {
+        if (i > 0) {
+            QVERIFY(planes[i].inlierIndices.size() <= planes[i - 1].inlierIndices.size());
+        }
+        for (int index : planes[i].inlierIndices) {
+            QVERIFY(!assigned[index]);
+            assigned[index] = 1;
+        }
+    }
+    QCOMPARE(segmenter.getStatistics().value("regions_detected").toInt(), 5);
+}
+
+void WallFittingEngineTest::testCorridorSearchMatchesBruteForce()
+{
+    // 栅格走廊查询与逐点判断有向矩形的结果一致
+    std::mt19937 generator(3);
+    std::uniform_real_distribution<float> coordinate(-5.0f, 15.0f);
+    std::vector<QVector3D> points(20000);
+    for (QVector3D& point : points) {
+        point = QVector3D(coordinate(generator), coordinate(generator), coordinate(generator) * 0.2f);
+    }
+
+    WallExtraction::PointGrid2D grid(points);
+    QCOMPARE(grid.size(), points.size());
+
+    const float halfWidth = 0.5f;
+    const float extension = 0.25f;
+    for (int trial = 0; trial < 20; ++trial) {
+        const QVector2D start(coordinate(generator), coordinate(generator));
+        const QVector2D end(coordinate(generator), coordinate(generator));
+        const float length = (end - start).length();
+        if (length < 0.1f) {
+            continue;
+        }
+        const QVector2D direction = (end - start) / length;
+        const QVector2D normal(-direction.y(), direction.x());
+
+        // 离矩形边界1mm以内的点两种判断都可能成立，不参与比较
+        std::set<quint32> expected;
+        std::set<quint32> ambiguous;
+        for (size_t i = 0; i < points.size(); ++i) {
+            const QVector2D offset = QVector2D(points[i].x(), points[i].y()) - start;
+            const float along = QVector2D::dotProduct(offset, direction);
+            const float across = qAbs(QVector2D::dotProduct(offset, normal));
+            const float margin = qMin(qMin(along + extension, length + extension - along), halfWidth - across);
+            if (qAbs(margin) <= 1e-3f) {
+                ambiguous.insert(static_cast<quint32>(i));
+            } else if (margin > 0.0f) {
+                expected.insert(static_cast<quint32>(i));
+            }
+        }
+
+        std::vector<quint32> indices;
+        const size_t found = grid.corridorSearch(start, end, halfWidth, extension, indices);
+        QCOMPARE(found, indices.size());
+
+        std::set<quint32> actual;
+        for (quint32 index : indices) {
+            QVERIFY(actual.insert(index).second);
+            if (!ambiguous.count(index)) {
+                QVERIFY(expected.count(index));
+            }
+        }
+        for (quint32 index : expected) {
+            QVERIFY(actual.count(index));
+        }
+    }
+}
+
+void WallFittingEngineTest::testRobustPlaneFitRejectsOneSidedOutliers()
+{
+    // 平面x=1上的墙面点（噪声2mm），20%的点是墙前0.5~0.6m的单侧离群点
+    std::mt19937 generator(5);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::normal_distribution<float> noise(0.0f, 0.002f);
+    std::vector<QVector3D> points;
+    for (int i = 0; i < 4000; ++i) {
+        const float y = unit(generator) * 5.0f;
+        const float z = unit(generator) * 3.0f;
+        const float x = (i % 5 == 0) ? 0.5f + unit(generator) * 0.1f : noise(generator);
+        points.push_back(QVector3D(1.0f + x, y, z));
+    }
+
+    auto offsetError = [](const WallExtraction::PlaneFitResult& fit) {
+        return qAbs(QVector3D::dotProduct(fit.normal, fit.centroid - QVector3D(1, 0, 0)));
+    };
+
+    // 普通最小二乘被离群点拉偏约0.11m
+    const WallExtraction::PlaneFitResult plain = WallExtraction::fitPlaneLeastSquares(points);
+    QVERIFY(plain.valid);
+    QVERIFY(offsetError(plain) > 0.1f);
+
+    // IRLS/Tukey在4次重加权以内收敛到真实平面0.1mm以内
+    WallExtraction::PlaneFitOptions options;
+    options.robust = true;
+    const WallExtraction::PlaneFitResult robust = WallExtraction::fitPlaneLeastSquares(points, options);
+    QVERIFY(robust.valid);
+    QVERIFY(robust.iterations <= 4);
+    QVERIFY(offsetError(robust) < 1e-4f);
+    QVERIFY(qAbs(robust.normal.x()) > 0.99999f);
+    QVERIFY(robust.rms < 0.003);
+
+    // 结果与点的输入顺序无关
+    std::vector<QVector3D> reversed(points.rbegin(), points.rend());
+    const WallExtraction::PlaneFitResult reversedFit = WallExtraction::fitPlaneLeastSquares(reversed, options);
+    QVERIFY(qAbs(reversedFit.centroid.x() - robust.centroid.x()) < 1e-5f);
+    QVERIFY(qAbs(QVector3D::dotProduct(reversedFit.normal, robust.normal)) > 0.999999f);
+}
+
+void WallFittingEngineTest::testIncrementalFitterMatchesFullFit()
+{
+    auto points = std::make_shared<const std::vector<QVector3D>>(generateRoomPointCloud(true));
+    std::vector<WallExtraction::LineSegment> lines = generateRoomLines();
+
+    WallExtraction::WallFittingAlgorithm algorithm;
+    QVERIFY(algorithm.initialize());
+    const WallExtraction::WallFittingResult result = algorithm.fitWallsFromLines(*points, lines);
+    QVERIFY(result.success);
+    QCOMPARE(result.walls.size(), lines.size());
+
+    // 用完整拟合的结果填充缓存：不重新拟合，预览与完整结果一致
+    WallExtraction::IncrementalWallFitter fitter;
+    fitter.seedWalls(points, algorithm.getRANSACParameters(), lines, result.walls);
+    QVERIFY(fitter.waitForDone(30000));
+    QCOMPARE(fitter.getStatistics().value("refitted_lines").toInt(), 0);
+    QCOMPARE(fitter.getStatistics().value("corridor_queries").toInt(), 0);
+
+    auto compareWalls = [](const std::vector<WallExtraction::WallSegment>& actual,
+                           const std::vector<WallExtraction::WallSegment>& expected) {
+        if (actual.size() != expected.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < actual.size(); ++i) {
+            if (actual[i].sourceLineIds != expected[i].sourceLineIds ||
+                actual[i].startPoint.distanceToPoint(expected[i].startPoint) > 1e-4f ||
+                actual[i].endPoint.distanceToPoint(expected[i].endPoint) > 1e-4f) {
+                return false;
+            }
+        }
+        return true;
+    };
+    QVERIFY(compareWalls(fitter.getWalls(), result.walls));
+
+    // 平移一条线段，它与两个邻居脱开：这条线段和端点停在旧交点的两个邻居重新拟合，
+    // 对面的线段保留缓存，结果与完整重新拟合一致
+    lines[0].startPoint += QVector3D(0.0f, 0.02f, 0.0f);
+    lines[0].endPoint += QVector3D(0.0f, 0.02f, 0.0f);
+    fitter.onLineSegmentUpdated(lines[0].id, lines[0]);
+    QVERIFY(fitter.waitForDone(30000));
+    QCOMPARE(fitter.getStatistics().value("refitted_lines").toInt(), 3);
+    QCOMPARE(fitter.getStatistics().value("corridor_queries").toInt(), 3);
+
+    const WallExtraction::WallFittingResult refit = algorithm.fitWallsFromLines(*points, lines);
+    QVERIFY(refit.success);
+    QVERIFY(compareWalls(fitter.getWalls(), refit.walls));
+
+    // 属性变化（描述）不触发更新
+    lines[1].description = "north";
+    fitter.onLineSegmentUpdated(lines[1].id, lines[1]);
+    QVERIFY(!fitter.isBusy());
+}
+
+void WallFittingEngineTest::testJobCancellation()
+{
+    WallExtraction::WallFittingJobRunner runner;
+    runner.setMaxConcurrentJobs(1);
+    QSignalSpy cancelledSpy(&runner, &WallExtraction::WallFittingJobRunner::jobCancelled);
+    int completedJobs = 0;
+    connect(&runner, &WallExtraction::WallFittingJobRunner::jobCompleted, this, [&completedJobs]() {
+        ++completedJobs;
+    });
+
+    // 第一个任务执行中取消，第二个任务排队期间取消
+    auto points = std::make_shared<const std::vector<QVector3D>>(generateRoomPointCloud(true));
+    WallExtraction::WallFittingJobSettings settings;
+    const int runningJob = runner.submitPointCloudJob(points, settings);
+    const int queuedJob = runner.submitPointCloudJob(points, settings);
+    QVERIFY(runner.cancel(runningJob));
+    QVERIFY(runner.cancel(queuedJob));
+
+    QTRY_COMPARE_WITH_TIMEOUT(cancelledSpy.count(), 2, 30000);
+    QCOMPARE(completedJobs, 0);
+    std::set<int> cancelledJobs;
+    for (const QList<QVariant>& arguments : cancelledSpy) {
+        cancelledJobs.insert(arguments.at(0).toInt());
+        QCOMPARE(arguments.at(1).toBool(), false);
+    }
+    QVERIFY(cancelledJobs == std::set<int>({runningJob, queuedJob}));
+    QCOMPARE(runner.activeJobCount(), 0);
+    QVERIFY(!runner.cancel(runningJob));
+}
+
+void WallFittingEngineTest::testJobTimeout()
+{
+    WallExtraction::WallFittingJobRunner runner;
+    QSignalSpy cancelledSpy(&runner, &WallExtraction::WallFittingJobRunner::jobCancelled);
+
+    // 平面检测远超1ms，在下一个检查点按超时取消
+    WallExtraction::WallFittingJobSettings settings;
+    settings.timeoutMs = 1;
+    const int jobId = runner.submitPointCloudJob(generateRoomPointCloud(true), settings);
+
+    QTRY_COMPARE_WITH_TIMEOUT(cancelledSpy.count(), 1, 30000);
+    QCOMPARE(cancelledSpy.first().at(0).toInt(), jobId);
+    QCOMPARE(cancelledSpy.first().at(1).toBool(), true);
+    QVERIFY(!runner.isActive(jobId));
+}
+
+void WallFittingEngineTest::testMergeParallelWalls()
+{
+    // 起点相距0.3m的两面平行墙合并；相距4m的平行墙和垂直的墙保留
+    std::vector<WallExtraction::WallSegment> walls;
+    walls.push_back(makeWall(QVector3D(0, 0, 0), QVector3D(5, 0, 0), 1));
+    walls.push_back(makeWall(QVector3D(0, 4, 0), QVector3D(5, 4, 0), 2));
+    walls.push_back(makeWall(QVector3D(0.3f, 0.05f, 0), QVector3D(5, 0.05f, 0), 3));
+    walls.push_back(makeWall(QVector3D(0, 0, 0), QVector3D(0, 4, 0), 4));
+    walls[2].inlierIndices.resize(walls[0].inlierIndices.size() * 2);
+    const size_t totalSupport = walls[0].inlierIndices.size() + walls[2].inlierIndices.size();
+
+    WallExtraction::WallFittingAlgorithm algorithm;
+    algorithm.mergeParallelWalls(walls);
+
+    // 合并后的墙取支撑点最多的一面，沿其方向覆盖两面墙的端点；支撑点和来源线段取并集，按簇内最小下标排序
+    QCOMPARE(walls.size(), size_t(3));
+    QVERIFY(walls[0].sourceLineIds == std::vector<int>({1, 3}));
+    QCOMPARE(walls[0].startPoint, QVector3D(0, 0.05f, 0));
+    QCOMPARE(walls[0].endPoint, QVector3D(5, 0.05f, 0));
+    QCOMPARE(walls[0].inlierIndices.size(), totalSupport);
+    QVERIFY(walls[1].sourceLineIds == std::vector<int>({2}));
+    QVERIFY(walls[2].sourceLineIds == std::vector<int>({4}));
+}
+
+void WallFittingEngineTest::testRegularizeWallsSnapsToDominantAxes()
+{
+    // 偏离坐标轴1~3°的矩形房间：吸附到同一组互相垂直的主方向，角点连接
+    auto rotated = [](const QVector3D& start, float length, float degrees) {
+        const float angle = qDegreesToRadians(degrees);
+        return start + QVector3D(qCos(angle), qSin(angle), 0.0f) * length;
+    };
+    std::vector<WallExtraction::WallSegment> walls;
+    walls.push_back(makeWall(QVector3D(0, 0, 0), rotated(QVector3D(0, 0, 0), 6.0f, 2.0f), 1));
+    walls.push_back(makeWall(QVector3D(6, 0, 0), rotated(QVector3D(6, 0, 0), 4.0f, 91.0f), 2));
+    walls.push_back(makeWall(QVector3D(6, 4, 0), rotated(QVector3D(6, 4, 0), 6.0f, 178.5f), 3));
+    walls.push_back(makeWall(QVector3D(0, 4, 0), rotated(QVector3D(0, 4, 0), 4.0f, -87.0f), 4));
+
+    const WallExtraction::WallRegularizationResult result = WallExtraction::regularizeWalls(walls);
+
+    QCOMPARE(result.dominantAngles.size(), size_t(1));
+    QCOMPARE(result.snappedWalls, 4);
+    QVERIFY(result.junctions > 0);
+    const float dominant = result.dominantAngles.front();
+    for (const WallExtraction::WallSegment& wall : walls) {
+        const QVector3D direction = (wall.endPoint - wall.startPoint).normalized();
+        const float angle = std::atan2(direction.y(), direction.x()) - dominant;
+        const float deviation = qAbs(std::remainder(angle, static_cast<float>(M_PI_2)));
+        QVERIFY(deviation < 1e-4f);
+        QVERIFY(qAbs(QVector3D::dotProduct(direction, wall.normal)) < 1e-4f);
+        QVERIFY(qAbs(wall.normal.z()) < 1e-6f);
+    }
+}
+
+void WallFittingEngineTest::testRegularizeWallsFitsAngleToCollinearWalls()
+{
+    // 两面水平的墙沿墙方向相距10m、偏移相差0.08m：方向角和共面偏移联合求解，
+    // 主方向转向两墙中点的连线，墙面共线且中点几乎不移动
+    std::vector<WallExtraction::WallSegment> walls;
+    walls.push_back(makeWall(QVector3D(0, 0, 0), QVector3D(2, 0, 0), 1));
+    walls.push_back(makeWall(QVector3D(10, 0.08f, 0), QVector3D(12, 0.08f, 0), 2));
+    const QVector3D firstMid = (walls[0].startPoint + walls[0].endPoint) * 0.5f;
+    const QVector3D secondMid = (walls[1].startPoint + walls[1].endPoint) * 0.5f;
+
+    const WallExtraction::WallRegularizationResult result = WallExtraction::regularizeWalls(walls);
+
+    QCOMPARE(result.dominantAngles.size(), size_t(1));
+    QCOMPARE(result.coplanarGroups, 1);
+    QVERIFY(qAbs(result.dominantAngles.front() - std::atan2(0.08f, 10.0f)) < 5e-4f);
+    QVERIFY(((walls[0].startPoint + walls[0].endPoint) * 0.5f).distanceToPoint(firstMid) < 1e-3f);
+    QVERIFY(((walls[1].startPoint + walls[1].endPoint) * 0.5f).distanceToPoint(secondMid) < 1e-3f);
+    QVERIFY(qAbs(QVector3D::dotProduct(walls[0].normal, walls[1].startPoint - walls[0].startPoint)) < 1e-4f);
+}
+
+void WallFittingEngineTest::testLineFitsAreNotRegularizedByDefault()
+{
+    // 基于线段的拟合默认保留用户放置的方向：几何优化不做规则化
+    WallExtraction::WallFittingAlgorithm algorithm;
+    QVERIFY(!algorithm.getRegularizationOptions().applyToLineFits);
+
+    std::vector<WallExtraction::WallSegment> walls;
+    walls.push_back(makeWall(QVector3D(0, 0, 0), QVector3D(6, 0.2f, 0), 1));
+    walls.push_back(makeWall(QVector3D(6, 0, 0), QVector3D(6.1f, 4, 0), 2));
+    const std::vector<WallExtraction::WallSegment> original = walls;
+
+    algorithm.optimizeWallGeometry(walls, false);
+    QCOMPARE(walls.size(), original.size());
+    for (size_t i = 0; i < walls.size(); ++i) {
+        QCOMPARE(walls[i].startPoint, original[i].startPoint);
+        QCOMPARE(walls[i].endPoint, original[i].endPoint);
+    }
+    QCOMPARE(algorithm.getLastRegularization().snappedWalls, 0);
+
+    algorithm.optimizeWallGeometry(walls, true);
+    QCOMPARE(algorithm.getLastRegularization().snappedWalls, 2);
+}
+
+void WallFittingEngineTest::testWallThicknessFromTwoFaces()
+{
+    // 两个表面相距0.24m：检测到双面墙，墙厚和中面位置误差在1cm以内
+    std::vector<QVector3D> points;
+    addWallFace(points, QVector3D(0, 0, 0), QVector3D(4, 0, 0), 0.0f, 11);
+    const size_t firstFace = points.size();
+    addWallFace(points, QVector3D(0, 0, 0), QVector3D(4, 0, 0), 0.24f, 12);
+
+    std::vector<int> indices(points.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    const QVector3D normal(0, 1, 0);
+
+    WallExtraction::WallThicknessEstimate estimate =
+        WallExtraction::estimateWallThickness(points, indices, QVector3D(0, 0, 0), normal);
+    QVERIFY(estimate.doubleSided);
+    QVERIFY(qAbs(estimate.thickness - 0.24f) < 0.01f);
+    QVERIFY(qAbs(estimate.centerOffset - 0.12f) < 0.01f);
+    QVERIFY(qAbs(estimate.faceOffsets[0]) < 0.01f);
+    QVERIFY(qAbs(estimate.faceOffsets[1] - 0.24f) < 0.01f);
+
+    // 非有限点的法向偏移为NaN，不进入直方图
+    std::vector<QVector3D> withNonFinite = points;
+    withNonFinite.emplace_back(std::numeric_limits<float>::quiet_NaN(), 0.1f, 1.0f);
+    withNonFinite.emplace_back(1.0f, std::numeric_limits<float>::infinity(), 1.0f);
+    std::vector<int> allIndices(withNonFinite.size());
+    std::iota(allIndices.begin(), allIndices.end(), 0);
+    WallExtraction::WallThicknessEstimate finiteEstimate =
+        WallExtraction::estimateWallThickness(withNonFinite, allIndices, QVector3D(0, 0, 0), normal);
+    QCOMPARE(finiteEstimate.thickness, estimate.thickness);
+    QCOMPARE(finiteEstimate.facePoints[0] + finiteEstimate.facePoints[1],
+             estimate.facePoints[0] + estimate.facePoints[1]);
+
+    // 只有一个表面时使用默认墙厚
+    std::vector<int> singleFace(indices.begin(), indices.begin() + firstFace);
+    WallExtraction::WallThicknessOptions options;
+    options.defaultThickness = 0.15f;
+    estimate = WallExtraction::estimateWallThickness(points, singleFace, QVector3D(0, 0, 0), normal, options);
+    QVERIFY(!estimate.doubleSided);
+    QCOMPARE(estimate.thickness, 0.15f);
+    QVERIFY(estimate.facePoints[0] > 0);
+}
+
+void WallFittingEngineTest::testPairedWallFacesGiveThickness()
+{
+    // 同一面墙的两个表面（相距0.18m）配对为一面墙，墙厚由表面间距得到
+    std::vector<QVector3D> points;
+    addWallFace(points, QVector3D(0, 0, 0), QVector3D(5, 0, 0), 0.0f, 21);
+    addWallFace(points, QVector3D(0, 0, 0), QVector3D(5, 0, 0), 0.18f, 22);
+
+    WallExtraction::WallFittingAlgorithm algorithm;
+    QVERIFY(algorithm.initialize());
+    algorithm.setPlaneDetectionMethod(WallExtraction::PlaneDetectionMethod::SequentialRANSAC);
+    const WallExtraction::WallFittingResult result = algorithm.fitWallsFromPointCloud(points);
+
+    QVERIFY(result.success);
+    QCOMPARE(result.walls.size(), size_t(1));
+    QVERIFY(qAbs(result.walls.front().thickness - 0.18f) < 0.01f);
+    QVERIFY(qAbs(result.walls.front().startPoint.y() - 0.09f) < 0.01f);
+
+    // 配对后的平面按两个表面的内点重新拟合，位于墙体中面
+    QCOMPARE(result.planes.size(), size_t(1));
+    QVERIFY(qAbs(result.planes.front().point.y() - 0.09f) < 0.01f);
+}
+
+std::vector<QVector3D> WallFittingEngineTest::generateRoomPointCloud(bool withFloor, unsigned int seed)
+{
+    std::vector<QVector3D> points;
+    addWallFace(points, QVector3D(0, 0, 0), QVector3D(kRoomWidth, 0, 0), 0.0f, seed);
+    addWallFace(points, QVector3D(kRoomWidth, 0, 0), QVector3D(kRoomWidth, kRoomDepth, 0), 0.0f, seed + 1);
+    addWallFace(points, QVector3D(kRoomWidth, kRoomDepth, 0), QVector3D(0, kRoomDepth, 0), 0.0f, seed + 2);
+    addWallFace(points, QVector3D(0, kRoomDepth, 0), QVector3D(0, 0, 0), 0.0f, seed + 3);
+
+    if (withFloor) {
+        const int columns = qRound(kRoomWidth / kPointSpacing);
+        const int rows = qRound(kRoomDepth / kPointSpacing);
+        for (int i = 0; i <= columns; ++i) {
+            for (int j = 0; j <= rows; ++j) {
+                points.push_back(QVector3D(i * kPointSpacing, j * kPointSpacing, 0.0f));
+            }
+        }
+    }
+    return points;
+}
+
+void WallFittingEngineTest::addWallFace(std::vector<QVector3D>& points, const QVector3D& start,
+                                        const QVector3D& end, float offset, unsigned int seed)
+{
+    // 竖直表面：沿start->end每隔kPointSpacing取点，法向（方向左侧）偏移offset并叠加噪声
+    std::mt19937 generator(seed);
+    std::normal_distribution<float> noise(0.0f, kSurfaceNoise);
+
+    const QVector3D direction = (end - start).normalized();
+    const QVector3D normal(-direction.y(), direction.x(), 0.0f);
+    const int columns = qRound((end - start).length() / kPointSpacing);
+    const int rows = qRound(kRoomHeight / kPointSpacing);
+    for (int i = 0; i <= columns; ++i) {
+        for (int j = 0; j <= rows; ++j) {
+            points.push_back(start + direction * (i * kPointSpacing) +
+                             normal * (offset + noise(generator)) +
+                             QVector3D(0.0f, 0.0f, j * kPointSpacing));
+        }
+    }
+}
+
+std::vector<WallExtraction::LineSegment> WallFittingEngineTest::generateRoomLines()
+{
+    // 沿房间四面墙的闭合线段，ID按顺序递增
+    const QVector3D corners[4] = {
+        QVector3D(0, 0, 0), QVector3D(kRoomWidth, 0, 0),
+        QVector3D(kRoomWidth, kRoomDepth, 0), QVector3D(0, kRoomDepth, 0)
+    };
+    std::vector<WallExtraction::LineSegment> lines(4);
+    for (int i = 0; i < 4; ++i) {
+        lines[i].id = i + 1;
+        lines[i].startPoint = corners[i];
+        lines[i].endPoint = corners[(i + 1) % 4];
+    }
+    return lines;
+}
+
+WallExtraction::WallSegment WallFittingEngineTest::makeWall(const QVector3D& start, const QVector3D& end,
+                                                            int sourceLineId)
+{
+    WallExtraction::WallSegment wall;
+    wall.startPoint = start;
+    wall.endPoint = end;
+    const QVector3D direction = (end - start).normalized();
+    wall.normal = QVector3D(-direction.y(), direction.x(), 0.0f);
+    wall.height = kRoomHeight;
+    wall.thickness = 0.2f;
+    wall.sourceLineIds.push_back(sourceLineId);
+    wall.inlierIndices.assign(100, 0);
+    return wall;
+}
+
+bool WallFittingEngineTest::containsPlane(const std::vector<WallExtraction::Plane3D>& planes,
+                                          const QVector3D& normal, float distance, size_t minInliers) const
+{
+    for (const WallExtraction::Plane3D& plane : planes) {
+        const float alignment = QVector3D::dotProduct(plane.normal, normal);
+        const float offset = QVector3D::dotProduct(plane.normal, plane.point) * (alignment < 0.0f ? -1.0f : 1.0f);
+        if (qAbs(alignment) > 0.999f && qAbs(offset - distance) < 0.02f &&
+            plane.inlierIndices.size() >= minInliers) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,60 @@
+#ifndef WALL_FITTING_ENGINE_TEST_H
+#define WALL_FITTING_ENGINE_TEST_H
+
+#include <QObject>
+#include <QVector3D>
+#include <vector>
+#include "wall_fitting_algorithm.h"
+#include "line_drawing_tool.h"
+
+/**
+ * @brief 墙面拟合各引擎的测试
+ *
+ * 使用已知几何的合成点云，与管理器测试编进同一个测试程序（wall_extraction_tests）。
+ */
+class WallFittingEngineTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    // 平面检测
+    void testSequentialRansacDetectsRoomWalls();
+    void testEfficientRansacDetectsRoomPlanes();
+    void testRegionGrowingSegmentsRoomPlanes();
+
+    // 基于线段的拟合
+    void testCorridorSearchMatchesBruteForce();
+    void testRobustPlaneFitRejectsOneSidedOutliers();
+    void testIncrementalFitterMatchesFullFit();
+
+    // 后台任务
+    void testJobCancellation();
+    void testJobTimeout();
+
+    // 几何优化
+    void testMergeParallelWalls();
+    void testRegularizeWallsSnapsToDominantAxes();
+    void testRegularizeWallsFitsAngleToCollinearWalls();
+    void testLineFitsAreNotRegularizedByDefault();
+
+    // 墙厚估计
+    void testWallThicknessFromTwoFaces();
+    void testPairedWallFacesGiveThickness();
+
+private:
+    // 测试数据生成
+    std::vector<QVector3D> generateRoomPointCloud(bool withFloor, unsigned int seed = 1);
+    void addWallFace(std::vector<QVector3D>& points, const QVector3D& start, const QVector3D& end,
+                     float offset, unsigned int seed);
+    std::vector<WallExtraction::LineSegment> generateRoomLines();
+    WallExtraction::WallSegment makeWall(const QVector3D& start, const QVector3D& end, int sourceLineId);
+
+    // 检查检测结果中存在与给定平面一致的平面，且内点数不少于minInliers
+    bool containsPlane(const std::vector<WallExtraction::Plane3D>& planes,
+                       const QVector3D& normal, float distance, size_t minInliers) const;
+};
+
+#endif // WALL_FITTING_ENGINE_TEST_H